@@ -0,0 +1,172 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+#include "arena.hpp"
+#include "bench_util.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    // A frame of 32 batches of scratch vectors, like culling, skinning and
+    // particle passes would allocate
+    constexpr int batches = 32;
+
+
+    // 1K to 100K vectors per batch
+    void batch_sizes(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->RangeMultiplier(10)->Range(1'000, 100'000);
+    }
+
+
+    enum class source
+    {
+        heap,
+        arena
+    };
+
+
+    template <source Source>
+    std::pmr::memory_resource* memory_resource(frame_arena& arena)
+    {
+        if constexpr (Source == source::arena)
+        {
+            return &arena;
+        }
+        else
+        {
+            return std::pmr::new_delete_resource();
+        }
+    }
+
+
+    /**
+     * @brief Allocate batches std::vectors of state.range(0) vec3f per frame, fill
+     * them with offset points and sum them
+     *
+     * The arena is reset at the end of the frame, heap vectors are freed.
+     */
+    template <source Source>
+    void BM_FrameAoS(benchmark::State& state)
+    {
+        const auto   size = static_cast<std::size_t>(state.range(0));
+        std::mt19937 rng(bench::seed);
+
+        auto points = std::vector<vec3f>(size);
+        std::ranges::generate(points, [&] { return bench::random_vec<vec3f>(rng); });
+
+        auto  arena    = frame_arena();
+        auto* resource = memory_resource<Source>(arena);
+
+        for (auto _ : state)
+        {
+            auto sum = vec3f();
+
+            for (int batch = 0; batch < batches; ++batch)
+            {
+                auto scratch = std::pmr::vector<vec3f>(resource);
+                scratch.reserve(size);
+
+                const auto offset = vec3f(float(batch));
+                for (const auto& point : points)
+                {
+                    scratch.push_back(point + offset);
+                }
+
+                for (const auto& point : scratch)
+                {
+                    sum += point;
+                }
+            }
+
+            benchmark::DoNotOptimize(sum);
+            arena.reset();
+        }
+
+        state.SetItemsProcessed(state.iterations() * batches * state.range(0));
+    }
+
+
+    /**
+     * @brief Allocate batches vec3f_soa of state.range(0) elements per frame and
+     * normalize points into them
+     */
+    template <source Source>
+    void BM_FrameSoA(benchmark::State& state)
+    {
+        const auto   size = static_cast<std::size_t>(state.range(0));
+        std::mt19937 rng(bench::seed);
+
+        auto points = vec3f_soa(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            points[i] = bench::random_vec<vec3f>(rng);
+        }
+
+        auto  arena    = frame_arena();
+        auto* resource = memory_resource<Source>(arena);
+
+        for (auto _ : state)
+        {
+            for (int batch = 0; batch < batches; ++batch)
+            {
+                auto scratch = vec3f_soa(resource);
+                soa::normalized(points, scratch);
+
+                benchmark::DoNotOptimize(scratch.data(0));
+            }
+
+            arena.reset();
+        }
+
+        state.SetItemsProcessed(state.iterations() * batches * state.range(0));
+    }
+
+
+    /**
+     * @brief Allocate and free 256 small scratch buffers, the cost of the allocation
+     * alone
+     */
+    template <source Source>
+    void BM_Allocate(benchmark::State& state)
+    {
+        constexpr int allocations = 256;
+
+        auto  arena    = frame_arena();
+        auto* resource = memory_resource<Source>(arena);
+
+        for (auto _ : state)
+        {
+            for (int i = 0; i < allocations; ++i)
+            {
+                const std::size_t bytes     = 64 * (1 + i % 16);
+                constexpr auto    alignment = frame_arena::alignment;
+
+                void* pointer = resource->allocate(bytes, alignment);
+                benchmark::DoNotOptimize(pointer);
+                resource->deallocate(pointer, bytes, alignment);
+            }
+
+            arena.reset();
+        }
+
+        state.SetItemsProcessed(state.iterations() * allocations);
+    }
+}    // namespace
+
+
+BENCHMARK_TEMPLATE(BM_FrameAoS, source::heap)->Apply(batch_sizes);
+BENCHMARK_TEMPLATE(BM_FrameAoS, source::arena)->Apply(batch_sizes);
+BENCHMARK_TEMPLATE(BM_FrameSoA, source::heap)->Apply(batch_sizes);
+BENCHMARK_TEMPLATE(BM_FrameSoA, source::arena)->Apply(batch_sizes);
+BENCHMARK_TEMPLATE(BM_Allocate, source::heap);
+BENCHMARK_TEMPLATE(BM_Allocate, source::arena);
@@ -0,0 +1,140 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "binary.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    // 100K and 1M points
+    void point_counts(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->Arg(100'000)->Arg(1'000'000);
+    }
+
+
+    std::filesystem::path file_path(const std::string& name)
+    {
+        return std::filesystem::temp_directory_path() / ("ggmath_bench_" + name);
+    }
+
+
+    std::vector<vec3f> random_points(std::size_t count)
+    {
+        std::mt19937 rng(bench::seed);
+
+        auto points = std::vector<vec3f>();
+        points.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            points.push_back(bench::random_vec<vec3f>(rng));
+        }
+
+        return points;
+    }
+
+
+    /**
+     * @brief Parse a vector in the format of operator<<, "(x,y,z)"
+     */
+    std::istream& read(std::istream& is, vec3f& _vec)
+    {
+        char separator = 0;
+
+        return is >> separator >> _vec[0] >> separator >> _vec[1] >> separator
+               >> _vec[2] >> separator;
+    }
+
+
+    /**
+     * @brief Load state.range(0) points written one per line with operator<<
+     */
+    void BM_LoadText(benchmark::State& state)
+    {
+        const auto path = file_path("points.txt");
+        {
+            auto file = std::ofstream(path);
+            for (const auto& point :
+                 random_points(static_cast<std::size_t>(state.range(0))))
+            {
+                file << point << '\n';
+            }
+        }
+
+        for (auto _ : state)
+        {
+            auto file   = std::ifstream(path);
+            auto points = std::vector<vec3f>();
+            auto point  = vec3f();
+
+            while (read(file, point))
+            {
+                points.push_back(point);
+            }
+
+            benchmark::DoNotOptimize(points.data());
+        }
+
+        std::filesystem::remove(path);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+
+    /**
+     * @brief Load state.range(0) points written with binary::write
+     *
+     * The points are summed so every page of the mapping is faulted in, like a
+     * caller would.
+     */
+    void BM_LoadMapped(benchmark::State& state)
+    {
+        const auto path = file_path("points.bin");
+        binary::write<vec3f>(path,
+                             random_points(static_cast<std::size_t>(state.range(0))));
+
+        for (auto _ : state)
+        {
+            const auto mapped = binary::mapped_file<vec3f>(path);
+
+            auto sum = vec3f();
+            for (const auto& point : mapped.elements())
+            {
+                sum += point;
+            }
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        std::filesystem::remove(path);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}    // namespace
+
+
+BENCHMARK(BM_LoadText)->Apply(point_counts)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoadMapped)->Apply(point_counts)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,304 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "bvh.hpp"
+#include "intersection.hpp"
+#include "parallel.hpp"
+#include "ray.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    // Rays traced against the tree per iteration
+    constexpr int ray_count = 1'024;
+
+
+    // A scanned prop up to a large game level
+    void triangle_counts(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->Arg(100'000)->Arg(1'000'000)->Arg(10'000'000);
+    }
+
+
+    // The triangle counts built by one thread and by one thread per core
+    void build_arguments(benchmark::internal::Benchmark* benchmark)
+    {
+        for (auto threads : {1, 0})
+        {
+            for (auto size : {100'000, 1'000'000, 10'000'000})
+            {
+                benchmark->Args({size, threads});
+            }
+        }
+    }
+
+
+    float height(float x, float z)
+    {
+        return 2 * std::sin(x * 0.37F) * std::cos(z * 0.23F) + std::sin(x * z * 0.01F);
+    }
+
+
+    /**
+     * @brief Return a rolling terrain of about size triangles spanning [-50, 50] in x
+     * and z
+     */
+    std::vector<trianglef> terrain(std::size_t size)
+    {
+        const auto  quads = static_cast<int>(std::sqrt(static_cast<double>(size) / 2));
+        const float step  = 100.0F / static_cast<float>(quads);
+
+        const auto vertex = [&](int i, int j) {
+            const float x = -50 + static_cast<float>(i) * step;
+            const float z = -50 + static_cast<float>(j) * step;
+
+            return vec3f(x, height(x, z), z);
+        };
+
+        std::vector<trianglef> triangles;
+        triangles.reserve(2 * static_cast<std::size_t>(quads) * quads);
+        for (int i = 0; i < quads; ++i)
+        {
+            for (int j = 0; j < quads; ++j)
+            {
+                triangles.emplace_back(
+                    vertex(i, j), vertex(i + 1, j), vertex(i, j + 1));
+                triangles.emplace_back(
+                    vertex(i + 1, j), vertex(i + 1, j + 1), vertex(i, j + 1));
+            }
+        }
+
+        return triangles;
+    }
+
+
+    /**
+     * @brief Set the vertices of triangles to the ones of rest moved by waves
+     * running across them at time
+     *
+     * The waves fold the terrain sideways as well as up, like a flag.
+     */
+    void deform(std::vector<trianglef>&       triangles,
+                const std::vector<trianglef>& rest,
+                float                         time)
+    {
+        const auto move = [time](vec3f& vertex, const vec3f& at_rest) {
+            const float x = at_rest[0];
+            const float z = at_rest[2];
+
+            vertex[0] = x + 4 * std::sin(z * 0.13F + time);
+            vertex[1] = at_rest[1] + 6 * std::sin(x * 0.11F + 2 * time);
+            vertex[2] = z;
+        };
+
+        for (std::size_t i = 0; i < rest.size(); ++i)
+        {
+            move(triangles[i].a, rest[i].a);
+            move(triangles[i].b, rest[i].b);
+            move(triangles[i].c, rest[i].c);
+        }
+    }
+
+
+    /**
+     * @brief Build a tree over state.range(0) triangles on a pool of state.range(1)
+     * threads, 0 for one per core
+     */
+    void BM_Build(benchmark::State& state)
+    {
+        const auto triangles = terrain(static_cast<std::size_t>(state.range(0)));
+        const auto threads   = static_cast<std::size_t>(state.range(1));
+
+        auto       pool    = parallel::thread_pool(threads);
+        const auto options = bvh::build_options{.pool = &pool};
+
+        for (auto _ : state)
+        {
+            auto tree = bvh::build(triangles, options);
+            benchmark::DoNotOptimize(tree.nodes.data());
+        }
+
+        state.SetItemsProcessed(state.iterations()
+                                * static_cast<int64_t>(triangles.size()));
+    }
+
+
+    // region updates
+
+
+    struct refit
+    {
+        void operator()(bvh::tree& tree, const std::vector<trianglef>& triangles) const
+        {
+            bvh::refit(tree, triangles);
+        }
+    };
+
+
+    struct refit_and_rebuild
+    {
+        void operator()(bvh::tree& tree, const std::vector<trianglef>& triangles) const
+        {
+            bvh::refit(tree, triangles, {.rebuild_threshold = 1.3F});
+        }
+    };
+
+
+    struct rebuild
+    {
+        void operator()(bvh::tree& tree, const std::vector<trianglef>& triangles) const
+        {
+            tree = bvh::build(triangles);
+        }
+    };
+
+
+    // endregion updates
+
+
+    /**
+     * @brief Update a tree over a terrain of state.range(0) triangles with Update
+     * after waves moved its vertices
+     *
+     * Moving the vertices is not timed. The cost counter is the sah_cost() of the
+     * tree after the last frame.
+     */
+    template <typename Update>
+    void BM_Deform(benchmark::State& state)
+    {
+        const auto rest      = terrain(static_cast<std::size_t>(state.range(0)));
+        auto       triangles = terrain(static_cast<std::size_t>(state.range(0)));
+        auto       tree      = bvh::build(triangles);
+
+        Update update;
+        int    frame = 0;
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            deform(triangles, rest, static_cast<float>(frame++ % 64) * 0.1F);
+            state.ResumeTiming();
+
+            update(tree, triangles);
+            benchmark::DoNotOptimize(tree.nodes.data());
+        }
+
+        state.counters["cost"] = bvh::sah_cost(tree);
+        state.SetItemsProcessed(state.iterations()
+                                * static_cast<int64_t>(triangles.size()));
+    }
+
+
+    /**
+     * @brief Trace ray_count camera rays looking down onto a terrain of
+     * state.range(0) triangles
+     *
+     * The rays counter is the rays traced per second.
+     */
+    void BM_ClosestHit(benchmark::State& state)
+    {
+        const auto   triangles = terrain(static_cast<std::size_t>(state.range(0)));
+        const auto   tree      = bvh::build(triangles);
+        std::mt19937 rng(bench::seed);
+
+        std::uniform_real_distribution<float> position(-40, 40);
+        std::uniform_real_distribution<float> tilt(-1, 1);
+
+        std::vector<rayf> rays;
+        for (int i = 0; i < ray_count; ++i)
+        {
+            rays.emplace_back(vec3f(position(rng), 10, position(rng)),
+                              vec3f(tilt(rng), -1, tilt(rng)));
+        }
+
+        std::int64_t hits = 0;
+
+        for (auto _ : state)
+        {
+            for (const auto& _ray : rays)
+            {
+                auto hit = bvh::closest_hit(tree, _ray);
+                hits += hit ? 1 : 0;
+                benchmark::DoNotOptimize(hit);
+            }
+        }
+
+        const auto traced = state.iterations() * ray_count;
+        const auto rate   = benchmark::Counter::kIsRate;
+        state.counters["rays"] = benchmark::Counter(static_cast<double>(traced), rate);
+        state.counters["hits"] =
+            static_cast<double>(hits) / static_cast<double>(traced);
+    }
+
+
+    /**
+     * @brief Trace ray_count shadow rays from points on a terrain of state.range(0)
+     * triangles towards a low sun
+     *
+     * The rays counter is the rays traced per second, occluded is the share of the
+     * points in shadow.
+     */
+    void BM_AnyHit(benchmark::State& state)
+    {
+        const auto   triangles = terrain(static_cast<std::size_t>(state.range(0)));
+        const auto   tree      = bvh::build(triangles);
+        std::mt19937 rng(bench::seed);
+
+        std::uniform_real_distribution<float> position(-40, 40);
+
+        std::vector<rayf> rays;
+        for (int i = 0; i < ray_count; ++i)
+        {
+            const float x = position(rng);
+            const float z = position(rng);
+            rays.emplace_back(vec3f(x, height(x, z) + 0.1F, z), vec3f(1, 0.3F, 0.2F));
+        }
+
+        std::int64_t occluded = 0;
+
+        for (auto _ : state)
+        {
+            for (const auto& _ray : rays)
+            {
+                occluded += bvh::any_hit(tree, _ray) ? 1 : 0;
+            }
+
+            benchmark::DoNotOptimize(occluded);
+        }
+
+        const auto traced = state.iterations() * ray_count;
+        const auto rate   = benchmark::Counter::kIsRate;
+        state.counters["rays"] = benchmark::Counter(static_cast<double>(traced), rate);
+        state.counters["occluded"] =
+            static_cast<double>(occluded) / static_cast<double>(traced);
+    }
+}    // namespace
+
+
+BENCHMARK(BM_Build)
+    ->Apply(build_arguments)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Deform, refit)
+    ->Arg(100'000)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Deform, refit_and_rebuild)
+    ->Arg(100'000)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Deform, rebuild)
+    ->Arg(100'000)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ClosestHit)->Apply(triangle_counts);
+BENCHMARK(BM_AnyHit)->Apply(triangle_counts);
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <numeric>
+
+#include "bench_util.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+using bench::BM_Array;
+using bench::BM_Single;
+
+
+namespace
+{
+    // region legacy kernels
+
+
+    // The kernels as they were before dot(), length(), distance() and
+    // angle_between() followed the element types
+    namespace legacy
+    {
+        template <Scalar T_A, Scalar T_B, int n>
+        constexpr float dot(const vec<T_A, n>& a, const vec<T_B, n>& b)
+        {
+            return std::inner_product(std::begin(a), std::end(a), std::begin(b), 0.0);
+        }
+
+
+        template <Scalar T, int n>
+        constexpr float length(const vec<T, n>& _vec)
+        {
+            return std::abs(std::sqrt(dot(_vec, _vec)));
+        }
+
+
+        template <Scalar T_A, Scalar T_B, int n>
+        constexpr float distance(const vec<T_A, n>& a, const vec<T_B, n>& b)
+        {
+            return length(a - b);
+        }
+
+
+        template <Scalar T_A, Scalar T_B, int n>
+        constexpr float angle_between(const vec<T_A, n>& a, const vec<T_B, n>& b)
+        {
+            return std::acos(dot(a, b) / (std::abs(length(a)) * std::abs(length(b))));
+        }
+    }    // namespace legacy
+
+
+    // endregion legacy kernels
+
+
+    GGMATH_BENCH_BINARY_OP(legacy_dot, false, legacy::dot(a, b));
+    GGMATH_BENCH_BINARY_OP(dot, false, vector::dot(a, b));
+    GGMATH_BENCH_UNARY_OP(legacy_length, false, legacy::length(a));
+    GGMATH_BENCH_UNARY_OP(length, false, vector::length(a));
+    GGMATH_BENCH_BINARY_OP(legacy_distance, false, legacy::distance(a, b));
+    GGMATH_BENCH_BINARY_OP(distance, false, vector::distance(a, b));
+    GGMATH_BENCH_BINARY_OP(legacy_angle_between, false, legacy::angle_between(a, b));
+    GGMATH_BENCH_BINARY_OP(angle_between, false, vector::angle_between(a, b));
+}    // namespace
+
+
+GGMATH_BENCH_OP(legacy_dot);
+GGMATH_BENCH_OP(dot);
+GGMATH_BENCH_OP(legacy_length);
+GGMATH_BENCH_OP(length);
+GGMATH_BENCH_OP(legacy_distance);
+GGMATH_BENCH_OP(distance);
+GGMATH_BENCH_OP(legacy_angle_between);
+GGMATH_BENCH_OP(angle_between);
@@ -0,0 +1,50 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#include "bench_util.hpp"
+#include "expression.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+using bench::BM_Array;
+using bench::BM_Single;
+
+
+namespace
+{
+    // The eager operators of vec.hpp against expr::, which fuses the operators of
+    // an expression into one loop over the components
+
+
+    GGMATH_BENCH_BINARY_OP(eager_lerp, false, a + 0.3F * (b - a));
+    GGMATH_BENCH_BINARY_OP(lazy_lerp,
+                           false,
+                           expr::evaluate(expr::lazy(a)
+                                          + 0.3F * (expr::lazy(b) - expr::lazy(a))));
+
+    // The midpoint of a and b moved away from b, four operators
+    GGMATH_BENCH_BINARY_OP(eager_compound, false, (a + b) / 2 - (b - a) * 3);
+    GGMATH_BENCH_BINARY_OP(lazy_compound,
+                           false,
+                           expr::evaluate((expr::lazy(a) + b) / 2
+                                          - (expr::lazy(b) - a) * 3));
+}    // namespace
+
+
+GGMATH_BENCH_OP(eager_lerp);
+GGMATH_BENCH_OP(lazy_lerp);
+GGMATH_BENCH_OP(eager_compound);
+GGMATH_BENCH_OP(lazy_compound);
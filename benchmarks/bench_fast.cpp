@@ -0,0 +1,313 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "fast.hpp"
+#include "packet.hpp"
+#include "util.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+using namespace ggmath;
+
+
+// Register the precise, the fast and the fast batch benchmark of a function
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_FUNCTION(OP)                                                  \
+    BENCHMARK_TEMPLATE(BM_Function, OP, path::precise)->Arg(size);                 \
+    BENCHMARK_TEMPLATE(BM_Function, OP, path::fast)->Arg(size);                    \
+    BENCHMARK_TEMPLATE(BM_Function, OP, path::fast_batch)->Arg(size)
+
+
+namespace
+{
+    // A frame of lighting or steering, large enough to leave the caches
+    constexpr int size = 1'000'000;
+
+
+    enum class path
+    {
+        // The standard library or vector:: one value at a time
+        precise,
+        // vec_soa:: batches
+        precise_batch,
+        // fast:: one value at a time
+        fast,
+        // fast:: fast::batch_width values at a time
+        fast_batch
+    };
+
+
+    // region functions
+
+
+    // Every function has a range of inputs, the precise float implementation, the
+    // fast implementation for float and packets and an exact double reference
+
+
+    struct arc_cosine
+    {
+        static constexpr float first = -1;
+        static constexpr float last  = 1;
+
+
+        static float precise(float x)
+        {
+            return std::acos(x);
+        }
+
+
+        template <typename T>
+        static T fast(const T& x)
+        {
+            return fast::acos(x);
+        }
+
+
+        static double exact(double x)
+        {
+            return std::acos(x);
+        }
+    };
+
+
+    // atan2 of points whose x coordinate is derived from y, so they cover every
+    // quadrant
+    struct arc_tangent
+    {
+        static constexpr float first = -4;
+        static constexpr float last  = 4;
+
+
+        static float precise(float y)
+        {
+            return std::atan2(y, 1 - 0.25F * y * y);
+        }
+
+
+        template <typename T>
+        static T fast(const T& y)
+        {
+            return fast::atan2(y, T(1) - T(0.25F) * y * y);
+        }
+
+
+        static double exact(double y)
+        {
+            return std::atan2(y, double(1 - 0.25F * float(y) * float(y)));
+        }
+    };
+
+
+    struct sine
+    {
+        static constexpr float first = -100;
+        static constexpr float last  = 100;
+
+
+        static float precise(float x)
+        {
+            return std::sin(x);
+        }
+
+
+        template <typename T>
+        static T fast(const T& x)
+        {
+            return fast::sin(x);
+        }
+
+
+        static double exact(double x)
+        {
+            return std::sin(x);
+        }
+    };
+
+
+    struct cosine
+    {
+        static constexpr float first = -100;
+        static constexpr float last  = 100;
+
+
+        static float precise(float x)
+        {
+            return std::cos(x);
+        }
+
+
+        template <typename T>
+        static T fast(const T& x)
+        {
+            return fast::cos(x);
+        }
+
+
+        static double exact(double x)
+        {
+            return std::cos(x);
+        }
+    };
+
+
+    struct degrees_to_radians
+    {
+        static constexpr float first = -360;
+        static constexpr float last  = 360;
+
+
+        static float precise(float degrees)
+        {
+            return ggmath::deg_to_rad(degrees);
+        }
+
+
+        template <typename T>
+        static T fast(const T& degrees)
+        {
+            return fast::deg_to_rad(degrees);
+        }
+
+
+        static double exact(double degrees)
+        {
+            return degrees * std::numbers::pi / 180;
+        }
+    };
+
+
+    // endregion functions
+
+
+    /**
+     * @brief Evaluate Op for state.range(0) values along Path
+     *
+     * The max_error counter is the largest difference from the exact double
+     * reference.
+     */
+    template <typename Op, path Path>
+    void BM_Function(benchmark::State& state)
+    {
+        const auto   count = static_cast<std::size_t>(state.range(0));
+        std::mt19937 rng(bench::seed);
+
+        std::uniform_real_distribution<float> distribution(Op::first, Op::last);
+
+        auto in  = std::vector<float>(count);
+        auto out = std::vector<float>(count);
+        std::ranges::generate(in, [&] { return distribution(rng); });
+
+        for (auto _ : state)
+        {
+            if constexpr (Path == path::fast_batch)
+            {
+                using packet_t = simd_float<fast::batch_width>;
+
+                for (std::size_t i = 0; i < count; i += fast::batch_width)
+                {
+                    Op::fast(packet_t::load(in.data() + i)).store(out.data() + i);
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    out[i] = Path == path::fast ? Op::fast(in[i]) : Op::precise(in[i]);
+                }
+            }
+
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+
+        double max_error = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            max_error =
+                std::max(max_error, std::abs(double(out[i]) - Op::exact(in[i])));
+        }
+
+        state.counters["max_error"] = max_error;
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    }
+
+
+    /**
+     * @brief Scale state.range(0) vectors to a length of 1 along Path
+     *
+     * The max_error counter is the largest difference of a length from 1.
+     */
+    template <path Path>
+    void BM_Normalize(benchmark::State& state)
+    {
+        const auto   count = static_cast<std::size_t>(state.range(0));
+        std::mt19937 rng(bench::seed);
+
+        auto vectors = vec3f_soa(count);
+        auto out     = vec3f_soa(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            vectors[i] = bench::random_vec<vec3f>(rng);
+        }
+
+        for (auto _ : state)
+        {
+            if constexpr (Path == path::precise_batch)
+            {
+                soa::normalized(vectors, out);
+            }
+            else if constexpr (Path == path::fast_batch)
+            {
+                fast::normalized(vectors, out);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const auto vector = std::as_const(vectors)[i];
+
+                    out[i] = Path == path::fast ? fast::normalized(vector)
+                                                : vector::normalized(vector);
+                }
+            }
+
+            benchmark::DoNotOptimize(out.data(0));
+            benchmark::ClobberMemory();
+        }
+
+        double max_error = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto   vector = std::as_const(out)[i];
+            const double length = std::sqrt(double(vector[0]) * vector[0]
+                                            + double(vector[1]) * vector[1]
+                                            + double(vector[2]) * vector[2]);
+
+            max_error = std::max(max_error, std::abs(length - 1));
+        }
+
+        state.counters["max_error"] = max_error;
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    }
+}    // namespace
+
+
+BENCHMARK_TEMPLATE(BM_Normalize, path::precise)->Arg(size);
+BENCHMARK_TEMPLATE(BM_Normalize, path::precise_batch)->Arg(size);
+BENCHMARK_TEMPLATE(BM_Normalize, path::fast)->Arg(size);
+BENCHMARK_TEMPLATE(BM_Normalize, path::fast_batch)->Arg(size);
+GGMATH_BENCH_FUNCTION(arc_cosine);
+GGMATH_BENCH_FUNCTION(arc_tangent);
+GGMATH_BENCH_FUNCTION(sine);
+GGMATH_BENCH_FUNCTION(cosine);
+GGMATH_BENCH_FUNCTION(degrees_to_radians);
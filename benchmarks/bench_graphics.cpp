@@ -0,0 +1,153 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "graphics.hpp"
+#include "mat.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+// Register the per-vector and the batched variant of a transform benchmark
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_TRANSFORM(BENCH, VEC)                                         \
+    BENCHMARK_TEMPLATE(BENCH, VEC, false)->Apply(vertex_counts);                   \
+    BENCHMARK_TEMPLATE(BENCH, VEC, true)->Apply(vertex_counts)
+
+
+namespace
+{
+    // Up to the 2M vertices a frame skins and culls
+    void vertex_counts(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->Arg(10'000)->Arg(100'000)->Arg(2'000'000);
+    }
+
+
+    /**
+     * @brief Return a perspective projection times a rotation and a translation
+     */
+    template <typename T>
+    mat<T, 4, 4> model_view_projection()
+    {
+        const auto projection = mat<T, 4, 4>{
+            1, 0, 0, 0, 0, 1, 0, 0, 0, 0, T(-11) / 9, T(-20) / 9, 0, 0, -1, 0};
+        const auto model_view = mat<T, 4, 4>{
+            0.8F, -0.6F, 0, 1, 0.6F, 0.8F, 0, -2, 0, 0, 1, -5, 0, 0, 0, 1};
+
+        return projection * model_view;
+    }
+
+
+    template <typename Vec>
+    std::vector<Vec> random_points(std::size_t size)
+    {
+        std::mt19937     rng(bench::seed);
+        std::vector<Vec> points;
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            points.push_back(bench::random_vec<Vec>(rng));
+        }
+
+        return points;
+    }
+
+
+    /**
+     * @brief Project state.range(0) points to normalized device coordinates, one
+     * mat * vec at a time or with graphics::transform_points if Batched is true
+     *
+     * items_per_second is the number of vertices per second.
+     */
+    template <typename Vec, bool Batched>
+    void BM_TransformPoints(benchmark::State& state)
+    {
+        using T         = typename bench::vec_traits<Vec>::value_type;
+        constexpr int n = bench::vec_traits<Vec>::dimension;
+
+        const auto size   = static_cast<std::size_t>(state.range(0));
+        const auto mvp    = model_view_projection<T>();
+        const auto points = random_points<Vec>(size);
+        auto       out    = std::vector<Vec>(size);
+
+        for (auto _ : state)
+        {
+            if constexpr (Batched)
+            {
+                graphics::transform_points(mvp, points, out, true);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    if constexpr (n == 3)
+                    {
+                        const auto clip = mvp * vec<T, 4>(points[i], 1);
+                        const T    w    = clip[3];
+                        std::construct_at(&out[i], clip[0] / w, clip[1] / w, clip[2] / w);
+                    }
+                    else
+                    {
+                        const auto clip = mvp * points[i];
+                        std::construct_at(&out[i], clip / clip[3]);
+                    }
+                }
+            }
+
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+    }
+
+
+    /**
+     * @brief Rotate state.range(0) normals, one mat * vec at a time or with
+     * graphics::transform_directions if Batched is true
+     */
+    template <typename Vec, bool Batched>
+    void BM_TransformDirections(benchmark::State& state)
+    {
+        using T = typename bench::vec_traits<Vec>::value_type;
+
+        const auto size       = static_cast<std::size_t>(state.range(0));
+        const auto mvp        = model_view_projection<T>();
+        const auto directions = random_points<Vec>(size);
+        auto       out        = std::vector<Vec>(size);
+
+        for (auto _ : state)
+        {
+            if constexpr (Batched)
+            {
+                graphics::transform_directions(mvp, directions, out);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    const auto rotated = mvp * vec<T, 4>(directions[i], 0);
+                    std::construct_at(&out[i], rotated[0], rotated[1], rotated[2]);
+                }
+            }
+
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+    }
+}    // namespace
+
+
+GGMATH_BENCH_TRANSFORM(BM_TransformPoints, vec3f);
+GGMATH_BENCH_TRANSFORM(BM_TransformPoints, vec4f);
+GGMATH_BENCH_TRANSFORM(BM_TransformPoints, vec3d);
+GGMATH_BENCH_TRANSFORM(BM_TransformPoints, vec4d);
+GGMATH_BENCH_TRANSFORM(BM_TransformDirections, vec3f);
+GGMATH_BENCH_TRANSFORM(BM_TransformDirections, vec3d);
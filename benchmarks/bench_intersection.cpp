@@ -0,0 +1,337 @@
+#include <benchmark/benchmark.h>
+
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "intersection.hpp"
+#include "packet.hpp"
+#include "ray.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    // Rays tested against every box per iteration
+    constexpr int ray_count = 16;
+
+
+    // The boxes of a BVH level that fits into L1, L2 and L3
+    void box_counts(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->Arg(1'024)->Arg(16'384)->Arg(262'144);
+    }
+
+
+    // The triangles of a few BVH leaves up to a small mesh
+    void triangle_counts(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->Arg(16)->Arg(256)->Arg(4'096);
+    }
+
+
+    template <int W>
+    struct boxes_of
+    {
+        using type = aabb<simd_float<W>>;
+    };
+
+    template <>
+    struct boxes_of<1>
+    {
+        using type = aabbf;
+    };
+
+
+    template <int W>
+    struct spheres_of
+    {
+        using type = sphere<simd_float<W>>;
+    };
+
+    template <>
+    struct spheres_of<1>
+    {
+        using type = spheref;
+    };
+
+
+    template <int W>
+    struct triangles_of
+    {
+        using type = triangle<simd_float<W>>;
+    };
+
+    template <>
+    struct triangles_of<1>
+    {
+        using type = trianglef;
+    };
+
+
+    std::vector<aabbf> random_boxes(std::mt19937& rng, std::size_t size)
+    {
+        std::uniform_real_distribution<float> position(-10, 10);
+        std::uniform_real_distribution<float> extent(0.1F, 2);
+
+        std::vector<aabbf> boxes;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            auto min  = vec3f(position(rng), position(rng), position(rng));
+            auto size = vec3f(extent(rng), extent(rng), extent(rng));
+            boxes.emplace_back(min, min + size);
+        }
+
+        return boxes;
+    }
+
+
+    /**
+     * @brief Test ray_count rays against state.range(0) boxes grouped into packets
+     * of W
+     *
+     * The hits counter is the share of tests that hit.
+     */
+    template <int W>
+    void BM_RayAabb(benchmark::State& state)
+    {
+        using Boxes = typename boxes_of<W>::type;
+
+        const auto   size = static_cast<std::size_t>(state.range(0));
+        std::mt19937 rng(bench::seed);
+
+        const auto         boxes = random_boxes(rng, size);
+        std::vector<Boxes> packets;
+        for (std::size_t i = 0; i + W <= size; i += W)
+        {
+            if constexpr (W == 1)
+            {
+                packets.emplace_back(boxes[i].min, boxes[i].max);
+            }
+            else
+            {
+                auto span = std::span<const aabbf>(boxes).subspan(i);
+                packets.push_back(packet::load<W>(span));
+            }
+        }
+
+        std::vector<rayf> rays;
+        for (int i = 0; i < ray_count; ++i)
+        {
+            rays.emplace_back(bench::random_vec<vec3f>(rng) * 0.1F,
+                              bench::random_unit_vec<vec3f>(rng));
+        }
+
+        std::int64_t hits = 0;
+
+        for (auto _ : state)
+        {
+            for (const auto& _ray : rays)
+            {
+                for (const auto& packet : packets)
+                {
+                    if constexpr (W == 1)
+                    {
+                        hits += intersections::intersects(_ray, packet) ? 1 : 0;
+                    }
+                    else
+                    {
+                        auto mask = intersections::intersects(_ray, packet);
+                        hits += std::popcount(mask.bits());
+                    }
+                }
+            }
+
+            benchmark::DoNotOptimize(hits);
+        }
+
+        const auto tests = state.iterations() * ray_count * static_cast<int64_t>(size);
+        state.counters["hits"] = static_cast<double>(hits) / static_cast<double>(tests);
+        state.SetItemsProcessed(tests);
+    }
+
+
+    struct moller_trumbore
+    {
+        template <typename Triangles>
+        auto operator()(const rayf& _ray, Triangles triangles) const
+        {
+            return intersections::moller_trumbore(_ray, triangles);
+        }
+    };
+
+
+    struct watertight
+    {
+        template <typename Triangles>
+        auto operator()(const rayf& _ray, Triangles triangles) const
+        {
+            return intersections::watertight(_ray, triangles);
+        }
+    };
+
+
+    /**
+     * @brief Find the nearest hit of ray_count rays on state.range(0) triangles
+     * grouped into packets of W with Test
+     *
+     * The rays counter is the rays traced per second, items are ray-triangle
+     * tests.
+     */
+    template <int W, typename Test>
+    void BM_RayTriangles(benchmark::State& state)
+    {
+        using Triangles = typename triangles_of<W>::type;
+
+        const auto   size = static_cast<std::size_t>(state.range(0));
+        std::mt19937 rng(bench::seed);
+
+        std::uniform_real_distribution<float> position(-10, 10);
+        std::uniform_real_distribution<float> offset(-2, 2);
+
+        std::vector<trianglef> triangles;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            auto a = vec3f(position(rng), position(rng), position(rng));
+            auto b = vec3f(offset(rng), offset(rng), offset(rng));
+            auto c = vec3f(offset(rng), offset(rng), offset(rng));
+            triangles.emplace_back(a, a + b, a + c);
+        }
+
+        std::vector<Triangles> packets;
+        for (std::size_t i = 0; i < size; i += W)
+        {
+            if constexpr (W == 1)
+            {
+                packets.emplace_back(triangles[i].a, triangles[i].b, triangles[i].c);
+            }
+            else
+            {
+                auto span = std::span<const trianglef>(triangles).subspan(i);
+                packets.push_back(packet::load<W>(span));
+            }
+        }
+
+        std::vector<rayf> rays;
+        for (int i = 0; i < ray_count; ++i)
+        {
+            rays.emplace_back(bench::random_vec<vec3f>(rng) * 0.1F,
+                              bench::random_unit_vec<vec3f>(rng));
+        }
+
+        Test test;
+
+        for (auto _ : state)
+        {
+            for (const auto& _ray : rays)
+            {
+                auto hit = test(_ray, std::span<const Triangles>(packets));
+                benchmark::DoNotOptimize(hit);
+            }
+        }
+
+        const auto traced = state.iterations() * ray_count;
+        const auto rate   = benchmark::Counter::kIsRate;
+        state.counters["rays"] = benchmark::Counter(static_cast<double>(traced), rate);
+        state.SetItemsProcessed(traced * static_cast<int64_t>(size));
+    }
+
+
+    /**
+     * @brief Find the spheres of state.range(0) ones grouped into packets of W that
+     * ray_count query spheres overlap
+     *
+     * per_pair calls overlaps() for every pair and appends the hits itself, like a
+     * broad phase without the batch API, the others call overlapping() once per
+     * query. Items are sphere pairs, the hits counter is the share that overlaps.
+     */
+    template <int W, bool per_pair>
+    void BM_SphereOverlaps(benchmark::State& state)
+    {
+        using Spheres = typename spheres_of<W>::type;
+
+        const auto   size = static_cast<std::size_t>(state.range(0));
+        std::mt19937 rng(bench::seed);
+
+        std::uniform_real_distribution<float> position(-10, 10);
+        std::uniform_real_distribution<float> radius(0.1F, 1);
+
+        std::vector<spheref> spheres;
+        for (std::size_t i = 0; i < size + ray_count; ++i)
+        {
+            spheres.emplace_back(vec3f(position(rng), position(rng), position(rng)),
+                                 radius(rng));
+        }
+        const auto queries    = std::span<const spheref>(spheres).first(ray_count);
+        const auto candidates = std::span<const spheref>(spheres).subspan(ray_count);
+
+        std::vector<Spheres> packets;
+        for (std::size_t i = 0; i < size; i += W)
+        {
+            if constexpr (W == 1)
+            {
+                packets.emplace_back(candidates[i].center, candidates[i].radius);
+            }
+            else
+            {
+                packets.push_back(packet::load<W>(candidates.subspan(i)));
+            }
+        }
+
+        std::vector<std::uint32_t> hits(packets.size() * W);
+        std::int64_t               overlapping = 0;
+
+        for (auto _ : state)
+        {
+            for (const auto& query : queries)
+            {
+                std::size_t count = 0;
+
+                if constexpr (per_pair)
+                {
+                    for (std::size_t i = 0; i < packets.size(); ++i)
+                    {
+                        if (intersections::overlaps(query, packets[i]))
+                        {
+                            hits[count++] = static_cast<std::uint32_t>(i);
+                        }
+                    }
+                }
+                else
+                {
+                    count = intersections::overlapping(
+                        query, std::span<const Spheres>(packets), hits);
+                }
+
+                benchmark::DoNotOptimize(hits.data());
+                overlapping += static_cast<std::int64_t>(count);
+            }
+        }
+
+        const auto tests = state.iterations() * ray_count * static_cast<int64_t>(size);
+        state.counters["hits"] =
+            static_cast<double>(overlapping) / static_cast<double>(tests);
+        state.SetItemsProcessed(tests);
+    }
+}    // namespace
+
+
+BENCHMARK_TEMPLATE(BM_RayAabb, 1)->Apply(box_counts);
+BENCHMARK_TEMPLATE(BM_RayAabb, 4)->Apply(box_counts);
+BENCHMARK_TEMPLATE(BM_RayAabb, 8)->Apply(box_counts);
+
+BENCHMARK_TEMPLATE(BM_RayTriangles, 1, moller_trumbore)->Apply(triangle_counts);
+BENCHMARK_TEMPLATE(BM_RayTriangles, 4, moller_trumbore)->Apply(triangle_counts);
+BENCHMARK_TEMPLATE(BM_RayTriangles, 8, moller_trumbore)->Apply(triangle_counts);
+BENCHMARK_TEMPLATE(BM_RayTriangles, 1, watertight)->Apply(triangle_counts);
+BENCHMARK_TEMPLATE(BM_RayTriangles, 4, watertight)->Apply(triangle_counts);
+BENCHMARK_TEMPLATE(BM_RayTriangles, 8, watertight)->Apply(triangle_counts);
+
+BENCHMARK_TEMPLATE(BM_SphereOverlaps, 1, true)->Apply(box_counts);
+BENCHMARK_TEMPLATE(BM_SphereOverlaps, 1, false)->Apply(box_counts);
+BENCHMARK_TEMPLATE(BM_SphereOverlaps, 8, false)->Apply(box_counts);
@@ -0,0 +1,118 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+// Register a benchmark template for the vector types whose arrays are copied most
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_BULK(BENCH)                                                   \
+    BENCHMARK_TEMPLATE(BENCH, vec3f)->Apply(bench::array_sizes);                   \
+    BENCHMARK_TEMPLATE(BENCH, vec4f)->Apply(bench::array_sizes);                   \
+    BENCHMARK_TEMPLATE(BENCH, vec3d)->Apply(bench::array_sizes)
+
+
+namespace
+{
+    template <typename Vec>
+    std::vector<Vec> random_vecs(std::size_t size)
+    {
+        std::mt19937 rng(bench::seed);
+
+        auto vecs = std::vector<Vec>();
+        vecs.reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            vecs.push_back(bench::random_vec<Vec>(rng));
+        }
+
+        return vecs;
+    }
+
+
+    /**
+     * @brief Construct a std::vector of state.range(0) zero vectors
+     */
+    template <typename Vec>
+    void BM_Construct(benchmark::State& state)
+    {
+        const auto size = static_cast<std::size_t>(state.range(0));
+
+        for (auto _ : state)
+        {
+            auto vecs = std::vector<Vec>(size);
+            benchmark::DoNotOptimize(vecs.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(Vec));
+    }
+
+
+    /**
+     * @brief Copy construct a std::vector of state.range(0) vectors
+     */
+    template <typename Vec>
+    void BM_CopyConstruct(benchmark::State& state)
+    {
+        const auto source = random_vecs<Vec>(static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state)
+        {
+            auto copy = source;
+            benchmark::DoNotOptimize(copy.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(Vec));
+    }
+
+
+    /**
+     * @brief Copy state.range(0) vectors into an existing std::vector
+     */
+    template <typename Vec>
+    void BM_CopyAssign(benchmark::State& state)
+    {
+        const auto source = random_vecs<Vec>(static_cast<std::size_t>(state.range(0)));
+
+        auto destination = std::vector<Vec>(source.size());
+
+        for (auto _ : state)
+        {
+            std::ranges::copy(source, destination.begin());
+            benchmark::DoNotOptimize(destination.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(Vec));
+    }
+}    // namespace
+
+
+GGMATH_BENCH_BULK(BM_Construct);
+GGMATH_BENCH_BULK(BM_CopyConstruct);
+GGMATH_BENCH_BULK(BM_CopyAssign);
@@ -0,0 +1,243 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "mat.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+// Register both variants of a matrix benchmark for float and double
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_MAT(BENCH)                                                    \
+    BENCHMARK_TEMPLATE(BENCH, float, false)->Apply(matrix_counts);                 \
+    BENCHMARK_TEMPLATE(BENCH, float, true)->Apply(matrix_counts);                  \
+    BENCHMARK_TEMPLATE(BENCH, double, false)->Apply(matrix_counts);                \
+    BENCHMARK_TEMPLATE(BENCH, double, true)->Apply(matrix_counts)
+
+
+namespace
+{
+    // The vertices of one object, transformed by the same matrix
+    constexpr int vertices_per_object = 32;
+
+
+    // 1K to 100K matrices, a 4x4 double matrix is 128 bytes
+    void matrix_counts(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->RangeMultiplier(10)->Range(1'000, 100'000);
+    }
+
+
+    /**
+     * @brief Return a random affine transformation, which is always invertible
+     */
+    template <typename T>
+    mat<T, 4, 4> random_transform(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<T> distribution(-1, 1);
+
+        auto _mat = mat<T, 4, 4>::identity();
+
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                _mat[i][j] += distribution(rng);
+            }
+        }
+
+        // Diagonally dominant, so the linear part is not singular
+        _mat[0][0] += 4;
+        _mat[1][1] += 4;
+        _mat[2][2] += 4;
+
+        return _mat;
+    }
+
+
+    // region naive kernels
+
+
+    // The textbook triple loop
+    template <typename T>
+    mat<T, 4, 4> naive_multiply(const mat<T, 4, 4>& a, const mat<T, 4, 4>& b)
+    {
+        auto mat_out = mat<T, 4, 4>();
+
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                T sum = 0;
+
+                for (int k = 0; k < 4; ++k)
+                {
+                    sum += a[i][k] * b[k][j];
+                }
+
+                mat_out[i][j] = sum;
+            }
+        }
+
+        return mat_out;
+    }
+
+
+    template <typename T>
+    vec<T, 4> naive_transform(const mat<T, 4, 4>& _mat, const vec<T, 4>& _vec)
+    {
+        auto vec_out = vec<T, 4>();
+
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                vec_out[i] += _mat[i][j] * _vec[j];
+            }
+        }
+
+        return vec_out;
+    }
+
+
+    // endregion naive kernels
+
+
+    /**
+     * @brief out[i] = a[i] * b[i] over state.range(0) matrices
+     */
+    template <typename T, bool Naive>
+    void BM_MatMultiply(benchmark::State& state)
+    {
+        const auto   size = static_cast<size_t>(state.range(0));
+        std::mt19937 rng(bench::seed);
+
+        std::vector<mat<T, 4, 4>> a;
+        std::vector<mat<T, 4, 4>> b;
+        std::vector<mat<T, 4, 4>> out(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            a.push_back(random_transform<T>(rng));
+            b.push_back(random_transform<T>(rng));
+        }
+
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                // Constructs the result in place, copying it through a temporary
+                // stalls on store forwarding
+                std::construct_at(&out[i],
+                                  Naive ? naive_multiply(a[i], b[i]) : a[i] * b[i]);
+            }
+
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+    }
+
+
+    /**
+     * @brief Invert state.range(0) affine transformations with inverse, or with
+     * inverse_affine if Affine is true
+     */
+    template <typename T, bool Affine>
+    void BM_MatInverse(benchmark::State& state)
+    {
+        const auto   size = static_cast<size_t>(state.range(0));
+        std::mt19937 rng(bench::seed);
+
+        std::vector<mat<T, 4, 4>> a;
+        std::vector<mat<T, 4, 4>> out(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            a.push_back(random_transform<T>(rng));
+        }
+
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                std::construct_at(&out[i],
+                                  Affine ? matrix::inverse_affine(a[i])
+                                         : matrix::inverse(a[i]));
+            }
+
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+    }
+
+
+    /**
+     * @brief Combine projection * view * model for state.range(0) objects and
+     * transform the vertices of each by it
+     */
+    template <typename T, bool Naive>
+    void BM_TransformPipeline(benchmark::State& state)
+    {
+        const auto   size = static_cast<size_t>(state.range(0));
+        std::mt19937 rng(bench::seed);
+
+        const auto projection = random_transform<T>(rng);
+        const auto view       = random_transform<T>(rng);
+
+        std::vector<mat<T, 4, 4>> models;
+        std::vector<vec<T, 4>>    vertices;
+        std::vector<vec<T, 4>>    out(size * vertices_per_object);
+        for (size_t i = 0; i < size; ++i)
+        {
+            models.push_back(random_transform<T>(rng));
+        }
+        for (size_t i = 0; i < vertices_per_object; ++i)
+        {
+            vertices.emplace_back(bench::random_vec<vec<T, 3>>(rng), 1);
+        }
+
+        const auto view_projection =
+            Naive ? naive_multiply(projection, view) : projection * view;
+
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                const auto mvp = Naive ? naive_multiply(view_projection, models[i])
+                                       : view_projection * models[i];
+                auto*      object_out = &out[i * vertices_per_object];
+
+                for (size_t j = 0; j < vertices_per_object; ++j)
+                {
+                    if constexpr (Naive)
+                    {
+                        std::construct_at(&object_out[j],
+                                          naive_transform(mvp, vertices[j]));
+                    }
+                    else
+                    {
+                        std::construct_at(&object_out[j], mvp * vertices[j]);
+                    }
+                }
+            }
+
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size)
+                                * vertices_per_object);
+    }
+}    // namespace
+
+
+GGMATH_BENCH_MAT(BM_MatMultiply);
+GGMATH_BENCH_MAT(BM_MatInverse);
+GGMATH_BENCH_MAT(BM_TransformPipeline);
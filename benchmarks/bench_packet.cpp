@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "packet.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+// Register an operation for single vec3f and for packets of 4, 8 and 16 of them
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_PACKET_WIDTHS(OP)                                             \
+    BENCHMARK_TEMPLATE(BM_Packets, 1, OP)->Apply(bench::array_sizes);              \
+    BENCHMARK_TEMPLATE(BM_Packets, 4, OP)->Apply(bench::array_sizes);              \
+    BENCHMARK_TEMPLATE(BM_Packets, 8, OP)->Apply(bench::array_sizes);              \
+    BENCHMARK_TEMPLATE(BM_Packets, 16, OP)->Apply(bench::array_sizes)
+
+
+namespace
+{
+    template <int W>
+    struct packet_of
+    {
+        using type = vec<simd_float<W>, 3>;
+    };
+
+    template <>
+    struct packet_of<1>
+    {
+        using type = vec3f;
+    };
+
+
+    /**
+     * @brief Run Op over state.range(0) vec3f grouped into packets of W
+     */
+    template <int W, typename Op>
+    void BM_Packets(benchmark::State& state)
+    {
+        using Packet = typename packet_of<W>::type;
+
+        const auto   size = static_cast<size_t>(state.range(0));
+        std::mt19937 rng(bench::seed);
+
+        std::vector<vec3f> a;
+        std::vector<vec3f> b;
+        for (size_t i = 0; i < size; ++i)
+        {
+            a.push_back(bench::random_unit_vec<vec3f>(rng));
+            b.push_back(bench::random_unit_vec<vec3f>(rng));
+        }
+
+        std::vector<Packet> packets_a;
+        std::vector<Packet> packets_b;
+        std::vector<Packet> packets_out(size / W);
+        for (size_t i = 0; i + W <= size; i += W)
+        {
+            if constexpr (W == 1)
+            {
+                packets_a.push_back(bench::copy_of(a[i]));
+                packets_b.push_back(bench::copy_of(b[i]));
+            }
+            else
+            {
+                auto span_a = std::span<const vec3f>(a).subspan(i);
+                auto span_b = std::span<const vec3f>(b).subspan(i);
+                packets_a.push_back(packet::load<W>(span_a));
+                packets_b.push_back(packet::load<W>(span_b));
+            }
+        }
+
+        Op op;
+
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < packets_a.size(); ++i)
+            {
+                // Constructs the result in place, copying it through a temporary
+                // stalls on store forwarding
+                std::construct_at(&packets_out[i], op(packets_a[i], packets_b[i]));
+            }
+
+            benchmark::DoNotOptimize(packets_out.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+    }
+
+
+    GGMATH_BENCH_BINARY_OP(cross, true, vector::cross(a, b));
+    GGMATH_BENCH_BINARY_OP(reflect, true, vector::reflect(a, b));
+    GGMATH_BENCH_BINARY_OP(lerp, true, vector::lerp(a, b, 0.3F));
+    GGMATH_BENCH_BINARY_OP(normalized, true, vector::normalized(a + b));
+}    // namespace
+
+
+GGMATH_BENCH_PACKET_WIDTHS(cross);
+GGMATH_BENCH_PACKET_WIDTHS(reflect);
+GGMATH_BENCH_PACKET_WIDTHS(lerp);
+GGMATH_BENCH_PACKET_WIDTHS(normalized);
@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "parallel.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    // 10M vectors, far larger than the caches of all cores together
+    constexpr int size = 10'000'000;
+
+
+    // 1, 2, 4, ... threads up to one per core
+    void thread_counts(benchmark::internal::Benchmark* benchmark)
+    {
+        const auto cores =
+            static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+
+        for (int threads = 1; threads < cores; threads *= 2)
+        {
+            benchmark->Arg(threads);
+        }
+        benchmark->Arg(cores);
+        benchmark->UseRealTime();
+    }
+
+
+    vec3f_soa random_soa(std::size_t count, std::uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+
+        vec3f_soa soa(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            soa[i] = bench::random_vec<vec3f>(rng);
+        }
+
+        return soa;
+    }
+
+
+    /**
+     * @brief Run operation(pool) on a pool of range(0) threads, the per_core counter
+     * is vectors per second and thread
+     */
+    template <typename T_Operation>
+    void run(benchmark::State& state, T_Operation operation)
+    {
+        auto pool = parallel::thread_pool(static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state)
+        {
+            operation(pool);
+            benchmark::ClobberMemory();
+        }
+
+        const auto items = state.iterations() * size;
+
+        state.SetItemsProcessed(items);
+        state.counters["per_core"] = benchmark::Counter(
+            static_cast<double>(items) / static_cast<double>(state.range(0)),
+            benchmark::Counter::kIsRate);
+    }
+
+
+    void BM_Normalized(benchmark::State& state)
+    {
+        const auto a   = random_soa(size, bench::seed);
+        auto       out = vec3f_soa(size);
+
+        run(state, [&](auto& pool) {
+            soa::normalized(pool, a, out);
+            benchmark::DoNotOptimize(out.data(0));
+        });
+    }
+
+
+    void BM_Distance(benchmark::State& state)
+    {
+        const auto a   = random_soa(size, bench::seed);
+        const auto b   = random_soa(size, bench::seed + 1);
+        auto       out = std::vector<float>(size);
+
+        run(state, [&](auto& pool) {
+            soa::distance(pool, a, b, std::span(out));
+            benchmark::DoNotOptimize(out.data());
+        });
+    }
+
+
+    void BM_Lerp(benchmark::State& state)
+    {
+        const auto a   = random_soa(size, bench::seed);
+        const auto b   = random_soa(size, bench::seed + 1);
+        auto       out = vec3f_soa(size);
+
+        run(state, [&](auto& pool) {
+            soa::lerp(pool, a, b, 0.3F, out);
+            benchmark::DoNotOptimize(out.data(0));
+        });
+    }
+
+
+    /**
+     * @brief Sum the lengths of the vectors, a reduction without an output array
+     */
+    void BM_SumOfLengths(benchmark::State& state)
+    {
+        const auto a = random_soa(size, bench::seed);
+
+        run(state, [&](auto& pool) {
+            const auto sum = parallel::parallel_reduce(
+                pool,
+                a.size(),
+                parallel::grain_size(3 * sizeof(float), 16),
+                0.0,
+                [&](std::size_t first, std::size_t last) {
+                    double sum = 0;
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        sum += vector::length(a[i]);
+                    }
+                    return sum;
+                },
+                std::plus<>());
+
+            benchmark::DoNotOptimize(sum);
+        });
+    }
+}    // namespace
+
+
+BENCHMARK(BM_Normalized)->Apply(thread_counts);
+BENCHMARK(BM_Distance)->Apply(thread_counts);
+BENCHMARK(BM_Lerp)->Apply(thread_counts);
+BENCHMARK(BM_SumOfLengths)->Apply(thread_counts);
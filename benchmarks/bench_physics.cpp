@@ -0,0 +1,295 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "parallel.hpp"
+#include "physics.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    constexpr float dt = 1.0F / 60;
+
+
+    // The particle counts advanced by one thread and by one thread per core
+    void step_arguments(benchmark::internal::Benchmark* benchmark)
+    {
+        for (auto threads : {1, 0})
+        {
+            for (auto size : {10'000, 1'000'000})
+            {
+                benchmark->Args({size, threads});
+            }
+        }
+    }
+
+
+    /**
+     * @brief Gravity and linear drag, cheap enough not to hide the integrator
+     */
+    void falling_with_drag(const vec3f_soa& /*positions*/,
+                           const vec3f_soa& velocities,
+                           vec3f_soa&       accelerations)
+    {
+        constexpr float drag = 0.1F;
+
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            const float gravity = axis == 1 ? -9.81F : 0.0F;
+            const auto  v       = velocities.column(axis);
+            const auto  a       = accelerations.column(axis);
+
+            for (std::size_t i = 0; i < v.size(); ++i)
+            {
+                a[i] = gravity - drag * v[i];
+            }
+        }
+    }
+
+
+    physics::particles random_particles(std::size_t size)
+    {
+        std::mt19937                          rng(bench::seed);
+        std::uniform_real_distribution<float> coordinate(-10, 10);
+
+        physics::particles particles;
+        particles.resize(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            particles.positions[i] =
+                vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+            particles.velocities[i] =
+                vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+        }
+        falling_with_drag(
+            particles.positions, particles.velocities, particles.accelerations);
+
+        return particles;
+    }
+
+
+    /**
+     * @brief Advance range(0) particles on a pool of range(1) threads with step,
+     * items are particles, the per_core counter is particles per second and thread
+     */
+    template <typename T_Step>
+    void run(benchmark::State& state, T_Step step)
+    {
+        auto particles = random_particles(static_cast<std::size_t>(state.range(0)));
+        auto pool      = parallel::thread_pool(static_cast<std::size_t>(state.range(1)));
+        auto options   = physics::step_options{&pool};
+
+        for (auto _ : state)
+        {
+            step(particles, options);
+            benchmark::DoNotOptimize(particles.positions.data(0));
+        }
+
+        const auto items = state.iterations() * state.range(0);
+
+        state.SetItemsProcessed(items);
+        state.counters["per_core"] = benchmark::Counter(
+            static_cast<double>(items) / static_cast<double>(pool.size()),
+            benchmark::Counter::kIsRate);
+    }
+
+
+    void BM_SemiImplicitEuler(benchmark::State& state)
+    {
+        run(state, [](auto& particles, const auto& options) {
+            physics::semi_implicit_euler(particles, dt, options);
+        });
+    }
+
+
+    void BM_VelocityVerlet(benchmark::State& state)
+    {
+        run(state, [](auto& particles, const auto& options) {
+            physics::velocity_verlet(particles, dt, falling_with_drag, options);
+        });
+    }
+
+
+    void BM_RK4(benchmark::State& state)
+    {
+        auto workspace = physics::rk4_workspace();
+
+        run(state, [&](auto& particles, const auto& options) {
+            physics::rk4(particles, dt, falling_with_drag, workspace, options);
+        });
+    }
+
+
+    /**
+     * @brief Semi-implicit Euler on an array of vec3f, one particle at a time, the
+     * loop the batch integrators replace
+     */
+    void BM_SemiImplicitEulerAos(benchmark::State& state)
+    {
+        const auto size = static_cast<std::size_t>(state.range(0));
+        const auto soa  = random_particles(size);
+
+        std::vector<vec3f> positions;
+        std::vector<vec3f> velocities;
+        std::vector<vec3f> accelerations;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            positions.push_back(soa.positions[i]);
+            velocities.push_back(soa.velocities[i]);
+            accelerations.push_back(soa.accelerations[i]);
+        }
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                velocities[i] += accelerations[i] * dt;
+                positions[i] += velocities[i] * dt;
+            }
+
+            benchmark::DoNotOptimize(positions.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+
+    /**
+     * @brief Return size random unit vectors
+     */
+    vec3f_soa unit_vectors(std::mt19937& rng, std::size_t size)
+    {
+        std::normal_distribution<float> coordinate;
+
+        vec3f_soa vectors(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            vectors[i] = vector::normalized(
+                vec3f(coordinate(rng), coordinate(rng), coordinate(rng)));
+        }
+
+        return vectors;
+    }
+
+
+    /**
+     * @brief Surfaces lit and seen from random directions, for the shading
+     * benchmarks
+     */
+    struct shading_inputs
+    {
+        explicit shading_inputs(std::size_t size) :
+            rng(bench::seed),
+            normals(unit_vectors(rng, size)),
+            directions(unit_vectors(rng, size)),
+            to_viewers(unit_vectors(rng, size))
+        {}
+
+
+        std::mt19937 rng;
+        vec3f_soa    normals;
+        vec3f_soa    directions;
+        vec3f_soa    to_viewers;
+    };
+
+
+    /**
+     * @brief Refract range(0) directions, batch_width at a time if Batch and one
+     * at a time otherwise, items are directions
+     */
+    template <bool Batch>
+    void BM_Refract(benchmark::State& state)
+    {
+        const auto size   = static_cast<std::size_t>(state.range(0));
+        const auto inputs = shading_inputs(size);
+
+        vec3f_soa                  out(size);
+        std::vector<std::uint64_t> total_internal_reflection((size + 63) / 64);
+
+        for (auto _ : state)
+        {
+            if constexpr (Batch)
+            {
+                physics::refract(inputs.directions,
+                                 inputs.normals,
+                                 1.5F,
+                                 out,
+                                 total_internal_reflection);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    out[i] = physics::refract(
+                        inputs.directions[i], inputs.normals[i], 1.5F);
+                }
+            }
+
+            benchmark::DoNotOptimize(out.data(0));
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+
+    /**
+     * @brief Evaluate the Lambertian and Blinn-Phong BRDF of range(0) surfaces,
+     * batch_width at a time if Batch and one at a time otherwise, items are
+     * surfaces
+     */
+    template <bool Batch>
+    void BM_Shade(benchmark::State& state)
+    {
+        const auto size   = static_cast<std::size_t>(state.range(0));
+        const auto inputs = shading_inputs(size);
+
+        std::vector<float> diffuse(size);
+        std::vector<float> specular(size);
+
+        for (auto _ : state)
+        {
+            if constexpr (Batch)
+            {
+                physics::lambertian(inputs.normals, inputs.directions, diffuse);
+                physics::blinn_phong(
+                    inputs.normals, inputs.directions, inputs.to_viewers, 32, specular);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    const auto normal    = inputs.normals[i];
+                    const auto to_light  = inputs.directions[i];
+                    const auto to_viewer = inputs.to_viewers[i];
+
+                    diffuse[i] = physics::lambertian(normal, to_light);
+                    specular[i] =
+                        physics::blinn_phong(normal, to_light, to_viewer, 32.0F);
+                }
+            }
+
+            benchmark::DoNotOptimize(diffuse.data());
+            benchmark::DoNotOptimize(specular.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}    // namespace
+
+
+BENCHMARK(BM_SemiImplicitEuler)->Apply(step_arguments)->UseRealTime();
+BENCHMARK(BM_VelocityVerlet)->Apply(step_arguments)->UseRealTime();
+BENCHMARK(BM_RK4)->Apply(step_arguments)->UseRealTime();
+BENCHMARK(BM_SemiImplicitEulerAos)->Arg(10'000)->Arg(1'000'000);
+BENCHMARK_TEMPLATE(BM_Refract, false)->Arg(1'000'000);
+BENCHMARK_TEMPLATE(BM_Refract, true)->Arg(1'000'000);
+BENCHMARK_TEMPLATE(BM_Shade, false)->Arg(1'000'000);
+BENCHMARK_TEMPLATE(BM_Shade, true)->Arg(1'000'000);
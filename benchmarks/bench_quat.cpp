@@ -0,0 +1,184 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "quat.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+// Register an interpolation benchmark for float and double
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_INTERPOLATION(OP)                                             \
+    BENCHMARK_TEMPLATE(BM_Interpolate, float, OP)->Apply(bone_counts);             \
+    BENCHMARK_TEMPLATE(BM_Interpolate, double, OP)->Apply(bone_counts)
+
+
+namespace
+{
+    // A blended pose of a few hundred characters
+    void bone_counts(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->RangeMultiplier(10)->Range(1'000, 100'000);
+    }
+
+
+    template <typename T>
+    std::vector<quat<T>> random_rotations(std::mt19937& rng, std::size_t size)
+    {
+        std::normal_distribution<T> distribution;
+        std::vector<quat<T>>        rotations;
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            rotations.push_back(quaternion::normalized(quat<T>(distribution(rng),
+                                                               distribution(rng),
+                                                               distribution(rng),
+                                                               distribution(rng))));
+        }
+
+        return rotations;
+    }
+
+
+    // region interpolations
+
+
+    struct nlerp
+    {
+        template <typename T>
+        void operator()(const std::vector<quat<T>>& a,
+                        const std::vector<quat<T>>& b,
+                        T                           t,
+                        std::vector<quat<T>>&       out) const
+        {
+            quaternion::nlerp(a, b, t, out);
+        }
+    };
+
+
+    struct slerp
+    {
+        template <typename T>
+        void operator()(const std::vector<quat<T>>& a,
+                        const std::vector<quat<T>>& b,
+                        T                           t,
+                        std::vector<quat<T>>&       out) const
+        {
+            quaternion::slerp(a, b, t, out);
+        }
+    };
+
+
+    struct fast_slerp
+    {
+        template <typename T>
+        void operator()(const std::vector<quat<T>>& a,
+                        const std::vector<quat<T>>& b,
+                        T                           t,
+                        std::vector<quat<T>>&       out) const
+        {
+            quaternion::fast_slerp(a, b, t, out);
+        }
+    };
+
+
+    // endregion interpolations
+
+
+    /**
+     * @brief Blend state.range(0) pairs of bone rotations with Op
+     *
+     * The max_error counter is the largest angle in radians between the rotations
+     * of Op and of slerp. It is computed from the distance between the
+     * quaternions, since acos of their dot product is dominated by rounding for
+     * small angles.
+     */
+    template <typename T, typename Op>
+    void BM_Interpolate(benchmark::State& state)
+    {
+        const auto   size = static_cast<std::size_t>(state.range(0));
+        std::mt19937 rng(bench::seed);
+
+        const auto a   = random_rotations<T>(rng, size);
+        const auto b   = random_rotations<T>(rng, size);
+        auto       out = std::vector<quat<T>>(size);
+        const T    t   = T(0.3);
+
+        Op op;
+
+        for (auto _ : state)
+        {
+            op(a, b, t, out);
+
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+
+        auto exact = std::vector<quat<T>>(size);
+        quaternion::slerp(a, b, t, exact);
+
+        double max_error = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            // -exact[i] is the same rotation as exact[i]
+            const double sign = quaternion::dot(out[i], exact[i]) < 0 ? -1 : 1;
+
+            double distance = 0;
+            for (int axis = 0; axis < 4; ++axis)
+            {
+                const double difference = out[i][axis] - sign * exact[i][axis];
+                distance += difference * difference;
+            }
+
+            distance  = std::min(std::sqrt(distance), 2.0);
+            max_error = std::max(max_error, 4 * std::asin(distance / 2));
+        }
+
+        state.counters["max_error"] = max_error;
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+    }
+
+
+    /**
+     * @brief Rotate state.range(0) vectors by one rotation each
+     */
+    template <typename T>
+    void BM_RotateBatch(benchmark::State& state)
+    {
+        const auto   size = static_cast<std::size_t>(state.range(0));
+        std::mt19937 rng(bench::seed);
+
+        const auto rotations = random_rotations<T>(rng, size);
+
+        std::vector<vec<T, 3>> vectors;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            vectors.push_back(bench::random_vec<vec<T, 3>>(rng));
+        }
+        auto out = std::vector<vec<T, 3>>(size);
+
+        for (auto _ : state)
+        {
+            quaternion::rotate(std::span<const quat<T>>(rotations), vectors, out);
+
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+    }
+}    // namespace
+
+
+GGMATH_BENCH_INTERPOLATION(nlerp);
+GGMATH_BENCH_INTERPOLATION(slerp);
+GGMATH_BENCH_INTERPOLATION(fast_slerp);
+BENCHMARK_TEMPLATE(BM_RotateBatch, float)->Apply(bone_counts);
+BENCHMARK_TEMPLATE(BM_RotateBatch, double)->Apply(bone_counts);
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    constexpr float time_step = 0.25F;
+
+
+    /**
+     * @brief Move particles through the cube [-1, 1]^3 and bounce them off its walls
+     *
+     * If Checked is true, the unit vector check that reflect() performed
+     * unconditionally before debug::enabled existed is run in front of every
+     * reflection, which makes the difference to a release build measurable in one
+     * binary.
+     */
+    template <bool Checked>
+    void BM_ReflectBounce(benchmark::State& state)
+    {
+        const auto   size = static_cast<size_t>(state.range(0));
+        std::mt19937 rng(bench::seed);
+
+        const std::array<vec3f, 3> normals = {vector::unit_x<float, 3>(),
+                                              vector::unit_y<float, 3>(),
+                                              vector::unit_z<float, 3>()};
+
+        std::vector<vec3f> positions;
+        std::vector<vec3f> directions;
+        positions.reserve(size);
+        directions.reserve(size);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            positions.push_back(bench::random_vec<vec3f>(rng) / 100);
+            directions.push_back(bench::random_unit_vec<vec3f>(rng));
+        }
+
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                for (size_t axis = 0; axis < 3; ++axis)
+                {
+                    // Only bounce particles that are outside and moving further out
+                    if (std::abs(positions[i][axis]) < 1
+                        || positions[i][axis] * directions[i][axis] < 0)
+                    {
+                        continue;
+                    }
+
+                    if constexpr (Checked)
+                    {
+                        debug::throw_if_not_unit(directions[i]);
+                        debug::throw_if_not_unit(normals[axis]);
+                    }
+
+                    std::ranges::copy(vector::reflect(directions[i], normals[axis]),
+                                      std::begin(directions[i]));
+                }
+
+                positions[i] += directions[i] * time_step;
+            }
+
+            benchmark::DoNotOptimize(positions.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+    }
+}    // namespace
+
+
+BENCHMARK_TEMPLATE(BM_ReflectBounce, false)->Apply(bench::array_sizes);
+BENCHMARK_TEMPLATE(BM_ReflectBounce, true)->Apply(bench::array_sizes);
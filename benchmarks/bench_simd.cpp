@@ -0,0 +1,167 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <functional>
+
+#include "bench_util.hpp"
+#include "simd.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+using bench::BM_Array;
+using bench::BM_Single;
+
+
+// Register a benchmark template for the vector types with a full register of lanes
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_SIMD_TYPES(BENCH, OP, ...)                                    \
+    BENCHMARK_TEMPLATE(BENCH, ggmath::vec4f, OP) __VA_ARGS__;                      \
+    BENCHMARK_TEMPLATE(BENCH, ggmath::vec4d, OP) __VA_ARGS__
+
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_SIMD_OP(OP)                                                   \
+    GGMATH_BENCH_SIMD_TYPES(BM_Single, OP);                                        \
+    GGMATH_BENCH_SIMD_TYPES(BM_Array, OP, ->Apply(bench::array_sizes))
+
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_API_OP(OP)                                                    \
+    BENCHMARK_TEMPLATE(BM_Single, ggmath::vec3f, OP);                              \
+    GGMATH_BENCH_SIMD_TYPES(BM_Single, OP);                                        \
+    BENCHMARK_TEMPLATE(BM_Array, ggmath::vec3f, OP)->Apply(bench::array_sizes);    \
+    GGMATH_BENCH_SIMD_TYPES(BM_Array, OP, ->Apply(bench::array_sizes))
+
+
+namespace
+{
+    // region scalar kernels
+
+
+    // The element-wise loops vec.hpp runs when GGMATH_SIMD is 0
+    namespace scalar
+    {
+        template <typename Vec, typename T_Operation>
+        Vec map(const Vec& a, const Vec& b, T_Operation operation)
+        {
+            auto vec_out = Vec();
+            std::ranges::transform(a, b, std::begin(vec_out), operation);
+            return vec_out;
+        }
+
+
+        template <typename Vec>
+        Vec scale(const Vec& a, typename bench::vec_traits<Vec>::value_type scalar)
+        {
+            auto vec_out = Vec();
+            std::ranges::transform(a, std::begin(vec_out), [scalar](auto element) {
+                return element * scalar;
+            });
+            return vec_out;
+        }
+
+
+        template <typename Vec>
+        auto dot(const Vec& a, const Vec& b)
+        {
+            return (a[0] * b[0] + a[1] * b[1]) + (a[2] * b[2] + a[3] * b[3]);
+        }
+
+
+        template <typename Vec>
+        Vec normalize(const Vec& a)
+        {
+            auto length  = std::sqrt(dot(a, a));
+            auto vec_out = Vec();
+            std::ranges::transform(a, std::begin(vec_out), [length](auto element) {
+                return element / length;
+            });
+            return vec_out;
+        }
+
+
+        template <typename Vec>
+        Vec lerp(const Vec&                                   a,
+                 const Vec&                                   b,
+                 typename bench::vec_traits<Vec>::value_type t)
+        {
+            return map(a, b, [t](auto x, auto y) { return x + t * (y - x); });
+        }
+    }    // namespace scalar
+
+
+    // endregion scalar kernels
+
+
+    template <typename Vec>
+    auto load(const Vec& _vec)
+    {
+        return simd::load(_vec.data.data());
+    }
+
+
+    // region operations
+
+
+    GGMATH_BENCH_BINARY_OP(scalar_add, false, scalar::map(a, b, std::plus<>()));
+    GGMATH_BENCH_BINARY_OP(simd_add, false, simd::add(load(a), load(b)));
+    GGMATH_BENCH_BINARY_OP(scalar_sub, false, scalar::map(a, b, std::minus<>()));
+    GGMATH_BENCH_BINARY_OP(simd_sub, false, simd::sub(load(a), load(b)));
+    GGMATH_BENCH_UNARY_OP(scalar_scale, false, scalar::scale(a, 3));
+    GGMATH_BENCH_UNARY_OP(simd_scale, false, simd::scale(load(a), 3));
+    GGMATH_BENCH_BINARY_OP(scalar_dot, false, scalar::dot(a, b));
+    GGMATH_BENCH_BINARY_OP(simd_dot, false, simd::dot(load(a), load(b)));
+    GGMATH_BENCH_UNARY_OP(scalar_normalize, false, scalar::normalize(a));
+    GGMATH_BENCH_UNARY_OP(simd_normalize, false, simd::normalize(load(a)));
+    GGMATH_BENCH_BINARY_OP(scalar_min,
+                           false,
+                           scalar::map(a, b, [](auto x, auto y) {
+                               return std::min(x, y);
+                           }));
+    GGMATH_BENCH_BINARY_OP(simd_min, false, simd::min(load(a), load(b)));
+    GGMATH_BENCH_BINARY_OP(scalar_max,
+                           false,
+                           scalar::map(a, b, [](auto x, auto y) {
+                               return std::max(x, y);
+                           }));
+    GGMATH_BENCH_BINARY_OP(simd_max, false, simd::max(load(a), load(b)));
+    GGMATH_BENCH_BINARY_OP(scalar_lerp, false, scalar::lerp(a, b, 0.3F));
+    GGMATH_BENCH_BINARY_OP(simd_lerp, false, simd::lerp(load(a), load(b), 0.3F));
+
+    // Dispatched to the simd kernels if GGMATH_SIMD is 1
+    GGMATH_BENCH_BINARY_OP(api_add, false, a + b);
+    GGMATH_BENCH_BINARY_OP(api_dot, false, a * b);
+    GGMATH_BENCH_UNARY_OP(api_normalized, false, vector::normalized(a));
+    GGMATH_BENCH_BINARY_OP(api_min, false, vector::min(a, b));
+    GGMATH_BENCH_BINARY_OP(api_lerp, false, vector::lerp(a, b, 0.3F));
+    GGMATH_BENCH_BINARY_OP(api_cross, false, vector::cross(a, b));
+
+
+    // endregion operations
+}    // namespace
+
+
+GGMATH_BENCH_SIMD_OP(scalar_add);
+GGMATH_BENCH_SIMD_OP(simd_add);
+GGMATH_BENCH_SIMD_OP(scalar_sub);
+GGMATH_BENCH_SIMD_OP(simd_sub);
+GGMATH_BENCH_SIMD_OP(scalar_scale);
+GGMATH_BENCH_SIMD_OP(simd_scale);
+GGMATH_BENCH_SIMD_OP(scalar_dot);
+GGMATH_BENCH_SIMD_OP(simd_dot);
+GGMATH_BENCH_SIMD_OP(scalar_normalize);
+GGMATH_BENCH_SIMD_OP(simd_normalize);
+GGMATH_BENCH_SIMD_OP(scalar_min);
+GGMATH_BENCH_SIMD_OP(simd_min);
+GGMATH_BENCH_SIMD_OP(scalar_max);
+GGMATH_BENCH_SIMD_OP(simd_max);
+GGMATH_BENCH_SIMD_OP(scalar_lerp);
+GGMATH_BENCH_SIMD_OP(simd_lerp);
+
+GGMATH_BENCH_API_OP(api_add);
+GGMATH_BENCH_API_OP(api_dot);
+GGMATH_BENCH_API_OP(api_normalized);
+GGMATH_BENCH_API_OP(api_min);
+GGMATH_BENCH_API_OP(api_lerp);
+BENCHMARK_TEMPLATE(BM_Single, ggmath::vec3f, api_cross);
+BENCHMARK_TEMPLATE(BM_Array, ggmath::vec3f, api_cross)->Apply(bench::array_sizes);
@@ -0,0 +1,184 @@
+#include <benchmark/benchmark.h>
+
+#include <span>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+using namespace ggmath;
+
+
+// Define an operation as an AoS loop over std::vector<vec<T, 3>> and as a call of the
+// batch function on vec_soa<T, 3>
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_LAYOUT_OP(NAME, UNIT_INPUT, AOS_STATEMENT, SOA_STATEMENT)     \
+    struct NAME                                                                    \
+    {                                                                              \
+        static constexpr bool unit_input = UNIT_INPUT;                             \
+                                                                                   \
+        template <typename Batch>                                                  \
+        static void aos(Batch& d)                                                  \
+        {                                                                          \
+            for (size_t i = 0; i < d.a.size(); ++i)                                \
+            {                                                                      \
+                AOS_STATEMENT;                                                     \
+            }                                                                      \
+        }                                                                          \
+                                                                                   \
+        template <typename Batch>                                                  \
+        static void soa(Batch& d)                                                  \
+        {                                                                          \
+            SOA_STATEMENT;                                                         \
+        }                                                                          \
+    }
+
+
+// Register the AoS and SoA benchmark of an operation for float and double
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_LAYOUTS(OP)                                                   \
+    BENCHMARK_TEMPLATE(BM_AoS, float, OP)->Apply(bench::array_sizes);              \
+    BENCHMARK_TEMPLATE(BM_SoA, float, OP)->Apply(bench::array_sizes);              \
+    BENCHMARK_TEMPLATE(BM_AoS, double, OP)->Apply(bench::array_sizes);             \
+    BENCHMARK_TEMPLATE(BM_SoA, double, OP)->Apply(bench::array_sizes)
+
+
+namespace
+{
+    /**
+     * @brief The same random inputs in both layouts plus room for the results
+     */
+    template <typename T>
+    struct batch
+    {
+        static constexpr T weight = 0.3;
+
+        batch(size_t size, bool unit_input) : scalars(size)
+        {
+            std::mt19937 rng(bench::seed);
+
+            a.reserve(size);
+            b.reserve(size);
+            out.reserve(size);
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (unit_input)
+                {
+                    a.push_back(bench::random_unit_vec<vec<T, 3>>(rng));
+                    b.push_back(bench::random_unit_vec<vec<T, 3>>(rng));
+                }
+                else
+                {
+                    a.push_back(bench::random_vec<vec<T, 3>>(rng));
+                    b.push_back(bench::random_vec<vec<T, 3>>(rng));
+                }
+
+                out.emplace_back();
+            }
+
+            soa_a.assign(a);
+            soa_b.assign(b);
+            soa_out.resize(size);
+        }
+
+        std::vector<vec<T, 3>> a;
+        std::vector<vec<T, 3>> b;
+        std::vector<vec<T, 3>> out;
+        std::vector<T>         scalars;
+        vec_soa<T, 3>          soa_a;
+        vec_soa<T, 3>          soa_b;
+        vec_soa<T, 3>          soa_out;
+    };
+
+
+    template <typename T, typename Op, bool Soa>
+    void BM_Layout(benchmark::State& state)
+    {
+        const auto size = static_cast<size_t>(state.range(0));
+        auto       d    = batch<T>(size, Op::unit_input);
+
+        for (auto _ : state)
+        {
+            if constexpr (Soa)
+            {
+                Op::soa(d);
+            }
+            else
+            {
+                Op::aos(d);
+            }
+
+            benchmark::DoNotOptimize(d.scalars.data());
+            benchmark::DoNotOptimize(d.out.data());
+            benchmark::DoNotOptimize(d.soa_out.data(0));
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+    }
+
+
+    template <typename T, typename Op>
+    void BM_AoS(benchmark::State& state)
+    {
+        BM_Layout<T, Op, false>(state);
+    }
+
+
+    template <typename T, typename Op>
+    void BM_SoA(benchmark::State& state)
+    {
+        BM_Layout<T, Op, true>(state);
+    }
+
+
+    // region operations
+
+
+    GGMATH_BENCH_LAYOUT_OP(dot,
+                           false,
+                           d.scalars[i] = vector::dot(d.a[i], d.b[i]),
+                           soa::dot(d.soa_a, d.soa_b, std::span(d.scalars)));
+    GGMATH_BENCH_LAYOUT_OP(cross,
+                           false,
+                           std::ranges::copy(vector::cross(d.a[i], d.b[i]),
+                                             std::begin(d.out[i])),
+                           soa::cross(d.soa_a, d.soa_b, d.soa_out));
+    GGMATH_BENCH_LAYOUT_OP(length,
+                           false,
+                           d.scalars[i] = vector::length(d.a[i]),
+                           soa::length(d.soa_a, std::span(d.scalars)));
+    GGMATH_BENCH_LAYOUT_OP(distance,
+                           false,
+                           d.scalars[i] = vector::distance(d.a[i], d.b[i]),
+                           soa::distance(d.soa_a, d.soa_b, std::span(d.scalars)));
+    GGMATH_BENCH_LAYOUT_OP(normalized,
+                           false,
+                           std::ranges::copy(vector::normalized(d.a[i]),
+                                             std::begin(d.out[i])),
+                           soa::normalized(d.soa_a, d.soa_out));
+    GGMATH_BENCH_LAYOUT_OP(lerp,
+                           false,
+                           std::ranges::copy(vector::lerp(d.a[i], d.b[i], d.weight),
+                                             std::begin(d.out[i])),
+                           soa::lerp(d.soa_a, d.soa_b, d.weight, d.soa_out));
+    GGMATH_BENCH_LAYOUT_OP(reflect,
+                           true,
+                           std::ranges::copy(vector::reflect(d.a[i], d.b[i]),
+                                             std::begin(d.out[i])),
+                           soa::reflect(d.soa_a, d.soa_b, d.soa_out));
+
+
+    // endregion operations
+}    // namespace
+
+
+GGMATH_BENCH_LAYOUTS(dot);
+GGMATH_BENCH_LAYOUTS(cross);
+GGMATH_BENCH_LAYOUTS(length);
+GGMATH_BENCH_LAYOUTS(distance);
+GGMATH_BENCH_LAYOUTS(normalized);
+GGMATH_BENCH_LAYOUTS(lerp);
+GGMATH_BENCH_LAYOUTS(reflect);
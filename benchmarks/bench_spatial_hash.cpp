@@ -0,0 +1,195 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "parallel.hpp"
+#include "spatial_hash.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    // Points queried per iteration
+    constexpr int query_count = 1'024;
+
+    // The query radius and cell size
+    constexpr float radius = 1;
+
+    // The average number of points within radius of a point
+    constexpr float neighbor_count = 30;
+
+
+    // The point counts built by one thread and by one thread per core
+    void build_arguments(benchmark::internal::Benchmark* benchmark)
+    {
+        for (auto threads : {1, 0})
+        {
+            for (auto size : {100'000, 1'000'000, 4'000'000})
+            {
+                benchmark->Args({size, threads});
+            }
+        }
+    }
+
+
+    /**
+     * @brief Return size points spread uniformly over a cube that gives each about
+     * neighbor_count neighbors, like the particles of a fluid
+     */
+    std::vector<vec3f> particles(std::size_t size)
+    {
+        const double volume = 4 * std::numbers::pi / 3 * radius * radius * radius
+                              * static_cast<double>(size) / neighbor_count;
+        const auto   extent = static_cast<float>(std::cbrt(volume) / 2);
+
+        std::mt19937                          rng(bench::seed);
+        std::uniform_real_distribution<float> coordinate(-extent, extent);
+
+        std::vector<vec3f> points;
+        points.reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            points.emplace_back(coordinate(rng), coordinate(rng), coordinate(rng));
+        }
+
+        return points;
+    }
+
+
+    void BM_Build(benchmark::State& state)
+    {
+        const auto points = particles(static_cast<std::size_t>(state.range(0)));
+        const auto threads = static_cast<std::size_t>(state.range(1));
+
+        auto       pool    = parallel::thread_pool(threads);
+        const auto options = spatial_hash::build_options{.pool = &pool};
+
+        for (auto _ : state)
+        {
+            auto grid = spatial_hash::build(points, radius, options);
+            benchmark::DoNotOptimize(grid.entries.data());
+        }
+
+        state.SetItemsProcessed(state.iterations()
+                                * static_cast<int64_t>(points.size()));
+    }
+
+
+    /**
+     * @brief Query the neighbors of query_count random points one at a time
+     *
+     * The neighbors counter is the average number found per query.
+     */
+    void BM_WithinRadius(benchmark::State& state)
+    {
+        const auto points = particles(static_cast<std::size_t>(state.range(0)));
+        const auto grid   = spatial_hash::build(points, radius);
+
+        std::mt19937                               rng(bench::seed);
+        std::uniform_int_distribution<std::size_t> point(0, points.size() - 1);
+
+        std::vector<std::size_t> queries;
+        for (int i = 0; i < query_count; ++i)
+        {
+            queries.push_back(point(rng));
+        }
+
+        std::vector<std::uint32_t> neighbors;
+        std::int64_t               found = 0;
+
+        for (auto _ : state)
+        {
+            for (auto i : queries)
+            {
+                neighbors.clear();
+                spatial_hash::within_radius(grid, points[i], radius, neighbors);
+                found += static_cast<std::int64_t>(neighbors.size());
+            }
+
+            benchmark::DoNotOptimize(neighbors.data());
+        }
+
+        const auto queried = state.iterations() * query_count;
+        state.counters["neighbors"] =
+            static_cast<double>(found) / static_cast<double>(queried);
+        state.SetItemsProcessed(queried);
+    }
+
+
+    /**
+     * @brief Find the neighbor lists of all points, items are points
+     */
+    void BM_Neighbors(benchmark::State& state)
+    {
+        const auto points = particles(static_cast<std::size_t>(state.range(0)));
+        const auto grid   = spatial_hash::build(points, radius);
+        const auto threads = static_cast<std::size_t>(state.range(1));
+
+        auto       pool    = parallel::thread_pool(threads);
+        const auto options = spatial_hash::neighbor_options{.pool = &pool};
+
+        for (auto _ : state)
+        {
+            auto lists = spatial_hash::neighbors(grid, radius, options);
+            benchmark::DoNotOptimize(lists.indices.data());
+        }
+
+        state.SetItemsProcessed(state.iterations()
+                                * static_cast<int64_t>(points.size()));
+    }
+
+
+    /**
+     * @brief Find the neighbors of query_count points by checking the distance to
+     * every point, the loop the grid replaces
+     */
+    void BM_BruteForce(benchmark::State& state)
+    {
+        const auto points = particles(static_cast<std::size_t>(state.range(0)));
+
+        std::vector<std::uint32_t> neighbors;
+
+        for (auto _ : state)
+        {
+            for (int i = 0; i < query_count; ++i)
+            {
+                neighbors.clear();
+                const auto& center = points[static_cast<std::size_t>(i)];
+
+                for (std::uint32_t j = 0; j < points.size(); ++j)
+                {
+                    if (vector::distance(points[j], center) <= radius)
+                    {
+                        neighbors.push_back(j);
+                    }
+                }
+            }
+
+            benchmark::DoNotOptimize(neighbors.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * query_count);
+    }
+}    // namespace
+
+
+BENCHMARK(BM_Build)
+    ->Apply(build_arguments)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_WithinRadius)->Arg(100'000)->Arg(1'000'000)->Arg(4'000'000);
+BENCHMARK(BM_Neighbors)
+    ->Args({100'000, 1})
+    ->Args({1'000'000, 1})
+    ->Args({1'000'000, 0})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_BruteForce)->Arg(10'000)->Arg(100'000);
@@ -0,0 +1,203 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "intersection.hpp"
+#include "sweep_and_prune.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    // The edge length of the boxes
+    constexpr float box_size = 1;
+
+    // The average number of boxes a box overlaps
+    constexpr float overlap_count = 2;
+
+    // The distance a body moves per frame, relative to box_size
+    constexpr float speed = 0.05F;
+
+
+    /**
+     * @brief Bodies in a cube that gives each box about overlap_count overlaps,
+     * moving in random directions and bouncing off the walls of the cube
+     */
+    class bodies
+    {
+      public:
+        explicit bodies(std::size_t size)
+        {
+            const double volume =
+                8 * box_size * box_size * box_size * double(size) / overlap_count;
+            extent = static_cast<float>(std::cbrt(volume) / 2);
+
+            std::mt19937                          rng(bench::seed);
+            std::uniform_real_distribution<float> coordinate(-extent, extent);
+            std::uniform_real_distribution<float> velocity(-speed, speed);
+
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                positions.emplace_back(
+                    coordinate(rng), coordinate(rng), coordinate(rng));
+                velocities.emplace_back(velocity(rng), velocity(rng), velocity(rng));
+                boxes.push_back(box_at(positions.back()));
+            }
+        }
+
+
+        /**
+         * @brief Move every body one frame, its box is the one it sweeps
+         */
+        void step()
+        {
+            for (std::size_t i = 0; i < positions.size(); ++i)
+            {
+                const auto from = box_at(positions[i]);
+
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    positions[i][axis] += velocities[i][axis];
+                    if (std::abs(positions[i][axis]) > extent)
+                    {
+                        velocities[i][axis] = -velocities[i][axis];
+                    }
+                }
+
+                const auto box = sweep_and_prune::swept(from, box_at(positions[i]));
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    boxes[i].min[axis] = box.min[axis];
+                    boxes[i].max[axis] = box.max[axis];
+                }
+            }
+        }
+
+
+        std::vector<aabbf> boxes;
+
+      private:
+        static aabbf box_at(const vec3f& position)
+        {
+            const auto half = vec3f(box_size / 2);
+
+            return {position - half, position + half};
+        }
+
+
+        float              extent;
+        std::vector<vec3f> positions;
+        std::vector<vec3f> velocities;
+    };
+
+
+    /**
+     * @brief Update a broad phase with bodies that moved one frame, items are
+     * boxes
+     *
+     * Moving the bodies is not timed. The pairs counter is the average number of
+     * overlapping pairs per frame.
+     */
+    void BM_SweepAndPrune(benchmark::State& state)
+    {
+        auto world       = bodies(static_cast<std::size_t>(state.range(0)));
+        auto broad_phase = sweep_and_prune::broad_phase();
+        auto pairs       = std::vector<sweep_and_prune::pair>();
+        auto found       = std::int64_t(0);
+
+        sweep_and_prune::update(broad_phase, world.boxes, pairs);
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            world.step();
+            state.ResumeTiming();
+
+            sweep_and_prune::update(broad_phase, world.boxes, pairs);
+            found += static_cast<std::int64_t>(pairs.size());
+        }
+
+        state.counters["pairs"] =
+            static_cast<double>(found) / static_cast<double>(state.iterations());
+        state.SetItemsProcessed(state.iterations()
+                                * static_cast<int64_t>(world.boxes.size()));
+    }
+
+
+    /**
+     * @brief Sort the boxes from scratch every frame, without the order of the last
+     * one
+     */
+    void BM_SweepAndPruneFromScratch(benchmark::State& state)
+    {
+        auto world = bodies(static_cast<std::size_t>(state.range(0)));
+        auto pairs = std::vector<sweep_and_prune::pair>();
+
+        for (auto _ : state)
+        {
+            auto broad_phase = sweep_and_prune::broad_phase();
+            sweep_and_prune::update(broad_phase, world.boxes, pairs);
+            benchmark::DoNotOptimize(pairs.data());
+        }
+
+        state.SetItemsProcessed(state.iterations()
+                                * static_cast<int64_t>(world.boxes.size()));
+    }
+
+
+    /**
+     * @brief Test every box against the boxes after it, the loop sweep and prune
+     * replaces
+     */
+    void BM_BruteForce(benchmark::State& state)
+    {
+        auto world = bodies(static_cast<std::size_t>(state.range(0)));
+        auto boxes = std::span<const aabbf>(world.boxes);
+        auto hits  = std::vector<std::uint32_t>(boxes.size());
+        auto pairs = std::vector<sweep_and_prune::pair>();
+
+        for (auto _ : state)
+        {
+            pairs.clear();
+            for (std::uint32_t i = 0; i < boxes.size(); ++i)
+            {
+                const auto count = intersections::overlapping(
+                    boxes[i], boxes.subspan(i + 1), std::span(hits));
+
+                for (std::size_t k = 0; k < count; ++k)
+                {
+                    pairs.push_back({i, i + 1 + hits[k]});
+                }
+            }
+
+            benchmark::DoNotOptimize(pairs.data());
+        }
+
+        state.SetItemsProcessed(state.iterations()
+                                * static_cast<int64_t>(boxes.size()));
+    }
+}    // namespace
+
+
+BENCHMARK(BM_SweepAndPrune)
+    ->Arg(10'000)
+    ->Arg(30'000)
+    ->Arg(100'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SweepAndPruneFromScratch)
+    ->Arg(10'000)
+    ->Arg(30'000)
+    ->Arg(100'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BruteForce)
+    ->Arg(10'000)
+    ->Arg(30'000)
+    ->Arg(100'000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,162 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "text.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    // A telemetry dump
+    constexpr int size = 1'000'000;
+
+
+    std::vector<vec3f> random_points(std::size_t count)
+    {
+        std::mt19937 rng(bench::seed);
+
+        auto points = std::vector<vec3f>();
+        points.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            points.push_back(bench::random_vec<vec3f>(rng));
+        }
+
+        return points;
+    }
+
+
+    std::string stream_text(const std::vector<vec3f>& points)
+    {
+        std::stringstream ss;
+        for (const auto& point : points)
+        {
+            ss << point << '\n';
+        }
+
+        return ss.str();
+    }
+
+
+    /**
+     * @brief Write state.range(0) vectors with operator<<
+     */
+    void BM_FormatStream(benchmark::State& state)
+    {
+        const auto points = random_points(static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state)
+        {
+            std::stringstream ss;
+            for (const auto& point : points)
+            {
+                ss << point << '\n';
+            }
+
+            benchmark::DoNotOptimize(ss.rdbuf());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+
+    /**
+     * @brief Write state.range(0) vectors into a preallocated buffer with
+     * text::to_chars
+     */
+    void BM_FormatToChars(benchmark::State& state)
+    {
+        const auto points = random_points(static_cast<std::size_t>(state.range(0)));
+
+        auto buffer = std::string(points.size() * (text::max_chars<vec3f> + 1), '\0');
+
+        for (auto _ : state)
+        {
+            const auto result =
+                text::to_chars(buffer.data(), buffer.data() + buffer.size(), points);
+
+            benchmark::DoNotOptimize(result.ptr);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+
+    /**
+     * @brief Parse state.range(0) vectors written by operator<< with an istream
+     */
+    void BM_ParseStream(benchmark::State& state)
+    {
+        const auto text =
+            stream_text(random_points(static_cast<std::size_t>(state.range(0))));
+
+        for (auto _ : state)
+        {
+            std::stringstream ss(text);
+            auto              points    = std::vector<vec3f>();
+            auto              point     = vec3f();
+            char              separator = 0;
+
+            while (ss >> separator >> point[0] >> separator >> point[1] >> separator
+                   >> point[2] >> separator)
+            {
+                points.push_back(point);
+            }
+
+            benchmark::DoNotOptimize(points.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+
+    /**
+     * @brief Parse state.range(0) vectors written by operator<< with
+     * text::from_chars
+     */
+    void BM_ParseFromChars(benchmark::State& state)
+    {
+        const auto text =
+            stream_text(random_points(static_cast<std::size_t>(state.range(0))));
+
+        for (auto _ : state)
+        {
+            auto points = std::vector<vec3f>();
+            text::from_chars(text.data(), text.data() + text.size(), points);
+
+            benchmark::DoNotOptimize(points.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}    // namespace
+
+
+BENCHMARK(BM_FormatStream)->Arg(size)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FormatToChars)->Arg(size)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParseStream)->Arg(size)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParseFromChars)->Arg(size)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,296 @@
+#ifndef GG_MATH_BENCH_UTIL_HPP
+#define GG_MATH_BENCH_UTIL_HPP
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "vec.hpp"
+
+
+// region macros
+
+
+// Register a benchmark template for every vector type alias of vec.hpp
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_ALL_TYPES(BENCH, OP, ...)                                     \
+    BENCHMARK_TEMPLATE(BENCH, ggmath::vec2f, OP) __VA_ARGS__;                      \
+    BENCHMARK_TEMPLATE(BENCH, ggmath::vec3f, OP) __VA_ARGS__;                      \
+    BENCHMARK_TEMPLATE(BENCH, ggmath::vec4f, OP) __VA_ARGS__;                      \
+    BENCHMARK_TEMPLATE(BENCH, ggmath::vec2d, OP) __VA_ARGS__;                      \
+    BENCHMARK_TEMPLATE(BENCH, ggmath::vec3d, OP) __VA_ARGS__;                      \
+    BENCHMARK_TEMPLATE(BENCH, ggmath::vec4d, OP) __VA_ARGS__;                      \
+    BENCHMARK_TEMPLATE(BENCH, ggmath::vec2i, OP) __VA_ARGS__;                      \
+    BENCHMARK_TEMPLATE(BENCH, ggmath::vec3i, OP) __VA_ARGS__;                      \
+    BENCHMARK_TEMPLATE(BENCH, ggmath::vec4i, OP) __VA_ARGS__
+
+
+// Register a benchmark template for the three component vector type aliases
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_VEC3_TYPES(BENCH, OP, ...)                                    \
+    BENCHMARK_TEMPLATE(BENCH, ggmath::vec3f, OP) __VA_ARGS__;                      \
+    BENCHMARK_TEMPLATE(BENCH, ggmath::vec3d, OP) __VA_ARGS__;                      \
+    BENCHMARK_TEMPLATE(BENCH, ggmath::vec3i, OP) __VA_ARGS__
+
+
+// Register the single value and the array benchmark of an operation
+//
+// BENCHMARK_TEMPLATE pastes the function name into an identifier, so the harnesses
+// have to be brought into scope with `using bench::BM_Single` and `using
+// bench::BM_Array` before use
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_OP(OP)                                                        \
+    GGMATH_BENCH_ALL_TYPES(BM_Single, OP);                                  \
+    GGMATH_BENCH_ALL_TYPES(BM_Array, OP, ->Apply(bench::array_sizes))
+
+
+// Register the single value and the array benchmark of a vec3-only operation
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_VEC3_OP(OP)                                                   \
+    GGMATH_BENCH_VEC3_TYPES(BM_Single, OP);                                 \
+    GGMATH_BENCH_VEC3_TYPES(BM_Array, OP, ->Apply(bench::array_sizes))
+
+
+// Define a benchmarkable operation taking one vector
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_UNARY_OP(NAME, UNIT_INPUT, ...)                                \
+    struct NAME                                                                    \
+    {                                                                              \
+        static constexpr int  arity      = 1;                                      \
+        static constexpr bool unit_input = UNIT_INPUT;                             \
+                                                                                   \
+        template <typename A>                                                      \
+        constexpr auto operator()([[maybe_unused]] const A& a) const               \
+        {                                                                          \
+            return __VA_ARGS__;                                                    \
+        }                                                                          \
+    }
+
+
+// Define a benchmarkable operation taking two vectors
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define GGMATH_BENCH_BINARY_OP(NAME, UNIT_INPUT, ...)                               \
+    struct NAME                                                                    \
+    {                                                                              \
+        static constexpr int  arity      = 2;                                      \
+        static constexpr bool unit_input = UNIT_INPUT;                             \
+                                                                                   \
+        template <typename A, typename B>                                          \
+        constexpr auto operator()(const A& a, const B& b) const                    \
+        {                                                                          \
+            return __VA_ARGS__;                                                    \
+        }                                                                          \
+    }
+
+
+// endregion macros
+
+
+namespace bench
+{
+    constexpr std::uint32_t seed = 42;
+
+
+    // region input generation
+
+
+    template <typename T>
+    struct vec_traits;
+
+    template <ggmath::Scalar T, int n>
+    struct vec_traits<ggmath::vec<T, n>>
+    {
+        using value_type               = T;
+        static constexpr int dimension = n;
+    };
+
+
+    /**
+     * @brief Return a vector with components uniformly distributed in [-100, 100]
+     */
+    template <typename Vec>
+    Vec random_vec(std::mt19937& rng)
+    {
+        using T = typename vec_traits<Vec>::value_type;
+
+        auto _vec = Vec();
+
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            std::uniform_real_distribution<T> distribution(-100, 100);
+            std::ranges::generate(_vec, [&] { return distribution(rng); });
+        }
+        else
+        {
+            std::uniform_int_distribution<T> distribution(-100, 100);
+            std::ranges::generate(_vec, [&] { return distribution(rng); });
+        }
+
+        return _vec;
+    }
+
+
+    /**
+     * @brief Return a vector that passes ggmath::vector::is_unit_vector()
+     *
+     * Integer vectors can only be unit vectors along one axis, so a random signed
+     * axis is returned for them.
+     */
+    template <typename Vec>
+    Vec random_unit_vec(std::mt19937& rng)
+    {
+        using T                = typename vec_traits<Vec>::value_type;
+        constexpr int n        = vec_traits<Vec>::dimension;
+        constexpr int attempts = 64;
+
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            for (int i = 0; i < attempts; ++i)
+            {
+                auto candidate = Vec(ggmath::vector::normalized(random_vec<Vec>(rng)));
+
+                if (ggmath::vector::is_unit_vector(candidate))
+                {
+                    return candidate;
+                }
+            }
+        }
+
+        auto _vec = Vec();
+        auto axis = std::uniform_int_distribution<int>(0, n - 1)(rng);
+        auto sign = std::bernoulli_distribution()(rng);
+
+        _vec[axis] = sign ? 1 : -1;
+
+        return _vec;
+    }
+
+
+    template <typename Vec, typename Op>
+    Vec random_input(std::mt19937& rng)
+    {
+        if constexpr (Op::unit_input)
+        {
+            return random_unit_vec<Vec>(rng);
+        }
+        else
+        {
+            return random_vec<Vec>(rng);
+        }
+    }
+
+
+    /**
+     * @brief Return a copy of _vec
+     */
+    template <typename Vec>
+    Vec copy_of(const Vec& _vec)
+    {
+        using T         = typename vec_traits<Vec>::value_type;
+        constexpr int n = vec_traits<Vec>::dimension;
+
+        return ggmath::vector::from_other<T, T, n, n>(_vec);
+    }
+
+
+    // endregion input generation
+
+
+    // region harnesses
+
+
+    // 1K to 10M elements
+    inline void array_sizes(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->RangeMultiplier(10)->Range(1'000, 10'000'000);
+    }
+
+
+    /**
+     * @brief Benchmark Op on a single value (or pair of values)
+     */
+    template <typename Vec, typename Op>
+    void BM_Single(benchmark::State& state)
+    {
+        std::mt19937 rng(seed);
+        Op           op;
+        auto         a = random_input<Vec, Op>(rng);
+        auto         b = random_input<Vec, Op>(rng);
+
+        for (auto _ : state)
+        {
+            // Hide the inputs' values from the optimizer
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(b);
+
+            if constexpr (Op::arity == 1)
+            {
+                auto result = op(a);
+                benchmark::DoNotOptimize(result);
+            }
+            else
+            {
+                auto result = op(a, b);
+                benchmark::DoNotOptimize(result);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+
+    /**
+     * @brief Benchmark Op over arrays of state.range(0) values
+     */
+    template <typename Vec, typename Op>
+    void BM_Array(benchmark::State& state)
+    {
+        const auto   size = static_cast<size_t>(state.range(0));
+        std::mt19937 rng(seed);
+        Op           op;
+
+        std::vector<Vec> a;
+        std::vector<Vec> b;
+        a.reserve(size);
+        b.reserve(size);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            a.push_back(random_input<Vec, Op>(rng));
+
+            if constexpr (Op::arity == 2)
+            {
+                b.push_back(random_input<Vec, Op>(rng));
+            }
+        }
+
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                if constexpr (Op::arity == 1)
+                {
+                    auto result = op(a[i]);
+                    benchmark::DoNotOptimize(result);
+                }
+                else
+                {
+                    auto result = op(a[i], b[i]);
+                    benchmark::DoNotOptimize(result);
+                }
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size)
+                                * Op::arity * static_cast<int64_t>(sizeof(Vec)));
+    }
+
+
+    // endregion harnesses
+}    // namespace bench
+
+#endif    // GG_MATH_BENCH_UTIL_HPP
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include "bench_util.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+using bench::BM_Array;
+using bench::BM_Single;
+
+
+namespace
+{
+    // region named constructors
+
+
+    GGMATH_BENCH_UNARY_OP(unit_x, false, [] {
+        return vector::unit_x<typename bench::vec_traits<A>::value_type,
+                              bench::vec_traits<A>::dimension>();
+    }());
+    GGMATH_BENCH_UNARY_OP(unit_y, false, [] {
+        return vector::unit_y<typename bench::vec_traits<A>::value_type,
+                              bench::vec_traits<A>::dimension>();
+    }());
+    GGMATH_BENCH_UNARY_OP(from_other, false, bench::copy_of(a));
+
+
+    // endregion named constructors
+
+
+    // region functions
+
+
+    GGMATH_BENCH_BINARY_OP(cross, false, vector::cross(a, b));
+    GGMATH_BENCH_UNARY_OP(length, false, vector::length(a));
+    GGMATH_BENCH_UNARY_OP(length_squared, false, vector::length_squared(a));
+    GGMATH_BENCH_UNARY_OP(normalized, false, vector::normalized(a));
+    GGMATH_BENCH_UNARY_OP(scaled_by, false, vector::scaled_by(a, 3));
+    GGMATH_BENCH_UNARY_OP(scaled_to, false, vector::scaled_to(a, 3));
+    GGMATH_BENCH_BINARY_OP(distance, false, vector::distance(a, b));
+    GGMATH_BENCH_BINARY_OP(parallel, true, vector::parallel(a, b));
+    GGMATH_BENCH_BINARY_OP(anti_parallel, true, vector::anti_parallel(a, b));
+    GGMATH_BENCH_BINARY_OP(perpendicular, true, vector::perpendicular(a, b));
+    GGMATH_BENCH_BINARY_OP(angle_between, false, vector::angle_between(a, b));
+    GGMATH_BENCH_BINARY_OP(angle_between_unit,
+                           true,
+                           vector::angle_between_unit(a, b));
+    GGMATH_BENCH_UNARY_OP(is_unit_vector, false, vector::is_unit_vector(a));
+    GGMATH_BENCH_UNARY_OP(min, false, vector::min(a));
+    GGMATH_BENCH_UNARY_OP(max, false, vector::max(a));
+    GGMATH_BENCH_UNARY_OP(index_min, false, vector::index_min(a));
+    GGMATH_BENCH_UNARY_OP(index_max, false, vector::index_max(a));
+    GGMATH_BENCH_BINARY_OP(lerp, false, vector::lerp(a, b, 0.3F));
+    GGMATH_BENCH_BINARY_OP(reflect, true, vector::reflect(a, b));
+
+
+    // endregion functions
+}    // namespace
+
+
+GGMATH_BENCH_OP(unit_x);
+GGMATH_BENCH_OP(unit_y);
+GGMATH_BENCH_OP(from_other);
+
+GGMATH_BENCH_VEC3_OP(cross);
+GGMATH_BENCH_OP(length);
+GGMATH_BENCH_OP(length_squared);
+GGMATH_BENCH_OP(normalized);
+GGMATH_BENCH_OP(scaled_by);
+GGMATH_BENCH_OP(scaled_to);
+GGMATH_BENCH_OP(distance);
+GGMATH_BENCH_OP(parallel);
+GGMATH_BENCH_OP(anti_parallel);
+GGMATH_BENCH_OP(perpendicular);
+GGMATH_BENCH_OP(angle_between);
+GGMATH_BENCH_OP(angle_between_unit);
+GGMATH_BENCH_OP(is_unit_vector);
+GGMATH_BENCH_OP(min);
+GGMATH_BENCH_OP(max);
+GGMATH_BENCH_OP(index_min);
+GGMATH_BENCH_OP(index_max);
+GGMATH_BENCH_OP(lerp);
+GGMATH_BENCH_OP(reflect);
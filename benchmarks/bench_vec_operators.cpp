@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+
+#include "bench_util.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+using bench::BM_Array;
+using bench::BM_Single;
+
+
+namespace
+{
+    // region binary operators
+
+
+    GGMATH_BENCH_BINARY_OP(addition, false, a + b);
+    GGMATH_BENCH_BINARY_OP(subtraction, false, a - b);
+    GGMATH_BENCH_BINARY_OP(dot_product, false, a * b);
+    GGMATH_BENCH_BINARY_OP(cross_product, false, a % b);
+    GGMATH_BENCH_UNARY_OP(scalar_multiplication_left, false, 3 * a);
+    GGMATH_BENCH_UNARY_OP(scalar_multiplication_right, false, a * 3);
+    GGMATH_BENCH_UNARY_OP(scalar_division, false, a / 3);
+
+
+    // endregion binary operators
+
+
+    // region assignment operators
+
+
+    GGMATH_BENCH_BINARY_OP(addition_assignment, false, [&] {
+        auto c = bench::copy_of(a);
+        c += b;
+        return c;
+    }());
+    GGMATH_BENCH_BINARY_OP(subtraction_assignment, false, [&] {
+        auto c = bench::copy_of(a);
+        c -= b;
+        return c;
+    }());
+    GGMATH_BENCH_UNARY_OP(scalar_multiplication_assignment, false, [&] {
+        auto c = bench::copy_of(a);
+        c *= 3;
+        return c;
+    }());
+    GGMATH_BENCH_UNARY_OP(scalar_division_assignment, false, [&] {
+        auto c = bench::copy_of(a);
+        c /= 3;
+        return c;
+    }());
+
+
+    // endregion assignment operators
+
+
+    // region comparison operators
+
+
+    GGMATH_BENCH_BINARY_OP(equal, false, a == b);
+    GGMATH_BENCH_BINARY_OP(unequal, false, a != b);
+    GGMATH_BENCH_BINARY_OP(longer, false, a > b);
+    GGMATH_BENCH_BINARY_OP(shorter, false, a < b);
+    GGMATH_BENCH_BINARY_OP(longer_or_equal, false, a >= b);
+    GGMATH_BENCH_BINARY_OP(shorter_or_equal, false, a <= b);
+    GGMATH_BENCH_UNARY_OP(length_equal, false, a == 50);
+    GGMATH_BENCH_UNARY_OP(length_unequal, false, a != 50);
+    GGMATH_BENCH_UNARY_OP(length_longer, false, a > 50);
+    GGMATH_BENCH_UNARY_OP(length_shorter, false, a < 50);
+    GGMATH_BENCH_UNARY_OP(length_longer_or_equal, false, a >= 50);
+    GGMATH_BENCH_UNARY_OP(length_shorter_or_equal, false, a <= 50);
+
+
+    // endregion comparison operators
+
+
+    // region other operators
+
+
+    GGMATH_BENCH_UNARY_OP(negation, false, -bench::copy_of(a));
+
+
+    // endregion other operators
+}    // namespace
+
+
+GGMATH_BENCH_OP(addition);
+GGMATH_BENCH_OP(subtraction);
+GGMATH_BENCH_OP(dot_product);
+GGMATH_BENCH_VEC3_OP(cross_product);
+GGMATH_BENCH_OP(scalar_multiplication_left);
+GGMATH_BENCH_OP(scalar_multiplication_right);
+GGMATH_BENCH_OP(scalar_division);
+
+GGMATH_BENCH_OP(addition_assignment);
+GGMATH_BENCH_OP(subtraction_assignment);
+GGMATH_BENCH_OP(scalar_multiplication_assignment);
+GGMATH_BENCH_OP(scalar_division_assignment);
+
+GGMATH_BENCH_OP(equal);
+GGMATH_BENCH_OP(unequal);
+GGMATH_BENCH_OP(longer);
+GGMATH_BENCH_OP(shorter);
+GGMATH_BENCH_OP(longer_or_equal);
+GGMATH_BENCH_OP(shorter_or_equal);
+GGMATH_BENCH_OP(length_equal);
+GGMATH_BENCH_OP(length_unequal);
+GGMATH_BENCH_OP(length_longer);
+GGMATH_BENCH_OP(length_shorter);
+GGMATH_BENCH_OP(length_longer_or_equal);
+GGMATH_BENCH_OP(length_shorter_or_equal);
+
+GGMATH_BENCH_OP(negation);
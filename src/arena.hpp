@@ -0,0 +1,240 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#ifndef GG_MATH_ARENA_HPP
+#define GG_MATH_ARENA_HPP
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+#include "types.hpp"
+#include "vec.hpp"
+
+
+namespace ggmath
+{
+    // region classes
+
+
+    /**
+     * @brief A bump allocator for the scratch buffers of one frame, released all at
+     * once by reset()
+     *
+     * Allocating is a pointer increment, deallocating does nothing. Memory comes from
+     * the upstream resource in blocks, which reset() keeps, so a steady frame
+     * workload reuses the same, cache-warm memory without touching the heap. Every
+     * allocation is aligned to at least frame_arena::alignment bytes.
+     *
+     * As a std::pmr::memory_resource it backs std::pmr containers and vec_soa. It is
+     * not thread safe, each thread uses its own instance, see local().
+     */
+    class frame_arena : public std::pmr::memory_resource
+    {
+      public:
+        /**
+         * @brief The minimum alignment of allocations, wide enough for AVX-512
+         * registers and a cache line
+         */
+        static constexpr std::size_t alignment = 64;
+
+        static constexpr std::size_t default_block_size = std::size_t(1) << 20;
+
+
+        explicit frame_arena(
+            std::size_t                block_size = default_block_size,
+            std::pmr::memory_resource* upstream   = std::pmr::new_delete_resource()) :
+            block_size(std::max(block_size, alignment)), upstream(upstream)
+        {}
+
+
+        frame_arena(const frame_arena&)            = delete;
+        frame_arena& operator=(const frame_arena&) = delete;
+
+
+        ~frame_arena() override
+        {
+            release();
+        }
+
+
+        /**
+         * @brief The arena of the calling thread
+         */
+        static frame_arena& local()
+        {
+            thread_local frame_arena arena;
+
+            return arena;
+        }
+
+
+        /**
+         * @brief Return uninitialized storage for count elements of type T
+         *
+         * T has to be trivially copyable, like vec and mat, so the storage can be
+         * written without constructing the elements first.
+         */
+        template <TriviallyCopyable T>
+        [[nodiscard]] std::span<T> allocate_span(std::size_t count)
+        {
+            return {static_cast<T*>(allocate(count * sizeof(T), alignof(T))), count};
+        }
+
+
+        /**
+         * @brief Make all memory available again, invalidating every allocation
+         *
+         * Keeps the blocks for the next frame.
+         */
+        void reset() noexcept
+        {
+            current = 0;
+            offset  = 0;
+            _used   = 0;
+        }
+
+
+        /**
+         * @brief Return the blocks to the upstream resource, invalidating every
+         * allocation
+         */
+        void release() noexcept
+        {
+            for (const auto& _block : blocks)
+            {
+                upstream->deallocate(_block.data, _block.size, alignment);
+            }
+
+            blocks.clear();
+            reset();
+        }
+
+
+        /**
+         * @brief The bytes allocated since the last reset, including alignment
+         * padding
+         */
+        [[nodiscard]] std::size_t used() const noexcept
+        {
+            return _used;
+        }
+
+
+        /**
+         * @brief The bytes of all blocks
+         */
+        [[nodiscard]] std::size_t capacity() const noexcept
+        {
+            std::size_t bytes = 0;
+            for (const auto& _block : blocks)
+            {
+                bytes += _block.size;
+            }
+
+            return bytes;
+        }
+
+
+      protected:
+        void* do_allocate(std::size_t bytes, std::size_t _alignment) override
+        {
+            _alignment = std::max(_alignment, alignment);
+
+            // Continue with the next kept block, or a new one, if the request does not
+            // fit into the current one
+            while (current < blocks.size() && !fits(blocks[current], bytes, _alignment))
+            {
+                ++current;
+                offset = 0;
+            }
+
+            if (current == blocks.size())
+            {
+                const std::size_t size =
+                    std::max({block_size,
+                              blocks.empty() ? 0 : 2 * blocks.back().size,
+                              bytes + _alignment});
+
+                auto* data = static_cast<std::byte*>(upstream->allocate(size, alignment));
+                blocks.push_back({data, size});
+                offset = 0;
+            }
+
+            const std::size_t start = aligned_offset(blocks[current], _alignment);
+
+            _used += start - offset + bytes;
+            offset = start + bytes;
+
+            return blocks[current].data + start;
+        }
+
+
+        void do_deallocate(void* /*pointer*/,
+                           std::size_t /*bytes*/,
+                           std::size_t /*alignment*/) override
+        {}
+
+
+        [[nodiscard]] bool
+            do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+
+      private:
+        struct block
+        {
+            std::byte*  data;
+            std::size_t size;
+        };
+
+
+        std::vector<block>         blocks;
+        std::size_t                block_size;
+        std::pmr::memory_resource* upstream;
+
+        // The block allocations continue in and the offset of its free space
+        std::size_t current = 0;
+        std::size_t offset  = 0;
+        std::size_t _used   = 0;
+
+
+        // The offset of the first byte after offset in _block aligned to _alignment
+        [[nodiscard]] std::size_t aligned_offset(const block& _block,
+                                                 std::size_t  _alignment) const noexcept
+        {
+            const auto address = reinterpret_cast<std::uintptr_t>(_block.data) + offset;
+
+            return offset + (_alignment - address % _alignment) % _alignment;
+        }
+
+
+        [[nodiscard]] bool
+            fits(const block& _block, std::size_t bytes, std::size_t _alignment) const
+        {
+            const std::size_t start = aligned_offset(_block, _alignment);
+
+            return start <= _block.size && bytes <= _block.size - start;
+        }
+    };
+
+
+    // endregion classes
+}    // namespace ggmath
+#endif    // GG_MATH_ARENA_HPP
@@ -0,0 +1,544 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#ifndef GG_MATH_BINARY_HPP
+#define GG_MATH_BINARY_HPP
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mat.hpp"
+#include "types.hpp"
+#include "vec.hpp"
+
+
+// A versioned binary container for arrays of vectors and matrices
+//
+// A file is a header followed by the elements exactly as they are laid out in
+// memory, so reading maps the file and hands out a span over the mapping instead
+// of parsing or copying. In exchange, files only load on machines with the same
+// endianness and element layout as the one that wrote them, which the header
+// records and mapped_file checks. The mapping uses POSIX mmap.
+namespace ggmath::binary
+{
+    // region format
+
+
+    inline constexpr std::array<char, 4> magic   = {'G', 'G', 'M', 'B'};
+    inline constexpr std::uint16_t       version = 1;
+
+    // The elements start at a multiple of this, or of their alignment if larger
+    inline constexpr std::size_t data_alignment = 64;
+
+
+    enum class scalar_type : std::uint8_t
+    {
+        int8,
+        uint8,
+        int16,
+        uint16,
+        int32,
+        uint32,
+        int64,
+        uint64,
+        float32,
+        float64
+    };
+
+
+    enum class byte_order : std::uint8_t
+    {
+        little,
+        big
+    };
+
+
+    /**
+     * @brief The first 64 bytes of a file, in the byte order it records
+     */
+    struct header
+    {
+        std::array<char, 4> magic;
+        std::uint16_t       version;
+        byte_order          endianness;
+        scalar_type         scalar;
+        // 1 for vectors
+        std::uint32_t rows;
+        std::uint32_t columns;
+        // sizeof and alignof of an element, including the padding of vec3f
+        std::uint32_t element_size;
+        std::uint32_t element_alignment;
+        std::uint64_t count;
+        // Offset of the first element from the start of the file
+        std::uint64_t data_offset;
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+        std::uint8_t reserved[24];
+    };
+
+
+    static_assert(sizeof(header) == 64 && std::is_trivially_copyable_v<header>);
+
+
+    // endregion format
+
+
+    // region element_traits
+
+
+    /**
+     * @brief The scalar_type of T
+     */
+    template <typename T>
+    constexpr scalar_type scalar_type_of() noexcept
+    {
+        if constexpr (std::is_same_v<T, float>)
+        {
+            return scalar_type::float32;
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            return scalar_type::float64;
+        }
+        else
+        {
+            static_assert(std::is_integral_v<T> && sizeof(T) <= 8);
+
+            constexpr int exponent = std::countr_zero(sizeof(T));
+
+            // int8, uint8, int16, ... in order of size, signed first
+            return static_cast<scalar_type>(2 * exponent
+                                            + (std::is_signed_v<T> ? 0 : 1));
+        }
+    }
+
+
+    /**
+     * @brief The scalar type and shape of a storable element
+     *
+     * Specialized by vec and mat of arithmetic types.
+     */
+    template <typename T>
+    struct element_traits
+    {
+        static constexpr bool storable = false;
+    };
+
+
+    template <Scalar T, int n>
+    requires std::is_arithmetic_v<T>
+    struct element_traits<vec<T, n>>
+    {
+        static constexpr bool          storable = true;
+        static constexpr scalar_type   scalar   = scalar_type_of<T>();
+        static constexpr std::uint32_t rows     = n;
+        static constexpr std::uint32_t columns  = 1;
+    };
+
+
+    template <Scalar T, int n, int m>
+    requires std::is_arithmetic_v<T>
+    struct element_traits<mat<T, n, m>>
+    {
+        static constexpr bool          storable = true;
+        static constexpr scalar_type   scalar   = scalar_type_of<T>();
+        static constexpr std::uint32_t rows     = n;
+        static constexpr std::uint32_t columns  = m;
+    };
+
+
+    /**
+     * @brief Check if arrays of T can be written to and mapped from files
+     */
+    template <typename T>
+    concept Storable = element_traits<T>::storable && TriviallyCopyable<T>;
+
+
+    // endregion element_traits
+
+
+    // region helpers
+
+
+    namespace detail
+    {
+        constexpr byte_order native_byte_order() noexcept
+        {
+            static_assert(std::endian::native == std::endian::little
+                              || std::endian::native == std::endian::big,
+                          "mixed endian platforms are not supported");
+
+            return std::endian::native == std::endian::little ? byte_order::little
+                                                              : byte_order::big;
+        }
+
+
+        template <Storable Element>
+        constexpr std::uint64_t data_offset() noexcept
+        {
+            constexpr std::size_t alignment =
+                std::max(data_alignment, alignof(Element));
+
+            return (sizeof(header) + alignment - 1) / alignment * alignment;
+        }
+
+
+        template <Storable Element>
+        constexpr header header_of(std::uint64_t count) noexcept
+        {
+            using traits = element_traits<Element>;
+
+            auto _header              = header();
+            _header.magic             = magic;
+            _header.version           = version;
+            _header.endianness        = native_byte_order();
+            _header.scalar            = traits::scalar;
+            _header.rows              = traits::rows;
+            _header.columns           = traits::columns;
+            _header.element_size      = sizeof(Element);
+            _header.element_alignment = alignof(Element);
+            _header.count             = count;
+            _header.data_offset       = data_offset<Element>();
+
+            return _header;
+        }
+
+
+        /**
+         * @brief Throw a runtime_error describing why path can not be read as an
+         * array of Element if _header does not describe one
+         */
+        template <Storable Element>
+        void throw_if_incompatible(const header&                _header,
+                                   std::uint64_t                file_size,
+                                   const std::filesystem::path& path)
+        {
+            const auto expected = header_of<Element>(_header.count);
+
+            const auto fail = [&path](const std::string& reason) {
+                std::stringstream ss;
+
+                ss << "File " << path << " can not be mapped: " << reason;
+
+                throw std::runtime_error(ss.str());
+            };
+
+            if (_header.magic != magic)
+            {
+                fail("it is not a ggmath binary file");
+            }
+            if (_header.endianness != expected.endianness)
+            {
+                fail("it was written with a different byte order");
+            }
+            if (_header.version != version)
+            {
+                fail("it has version " + std::to_string(_header.version)
+                     + ", expected " + std::to_string(version));
+            }
+            if (_header.scalar != expected.scalar || _header.rows != expected.rows
+                || _header.columns != expected.columns)
+            {
+                fail("it holds a different element type");
+            }
+            if (_header.element_size != expected.element_size
+                || _header.element_alignment != expected.element_alignment)
+            {
+                fail("its elements have a different size or alignment, e.g. "
+                     "because GGMATH_SIMD differed");
+            }
+            if (_header.data_offset % alignof(Element) != 0
+                || _header.data_offset < sizeof(header))
+            {
+                fail("its elements are misaligned");
+            }
+            if (_header.data_offset > file_size
+                || _header.count > (file_size - _header.data_offset) / sizeof(Element))
+            {
+                fail("it is truncated");
+            }
+        }
+
+
+        [[noreturn]] inline void throw_system_error(const char*                  what,
+                                                    const std::filesystem::path& path)
+        {
+            throw std::system_error(
+                errno, std::generic_category(), what + (": " + path.string()));
+        }
+    }    // namespace detail
+
+
+    // endregion helpers
+
+
+    // region writing
+
+
+    /**
+     * @brief Stream arrays of Element into a file, the header is completed by
+     * close()
+     */
+    template <Storable Element>
+    class writer
+    {
+      public:
+        explicit writer(const std::filesystem::path& path) :
+            file(path, std::ios::binary | std::ios::trunc), path(path)
+        {
+            if (!file)
+            {
+                detail::throw_system_error("Could not open file", path);
+            }
+
+            // The count is not known yet, the header is rewritten on close
+            const auto placeholder = detail::header_of<Element>(0);
+            const auto padding =
+                std::array<char, detail::data_offset<Element>() - sizeof(header)>();
+
+            file.write(reinterpret_cast<const char*>(&placeholder), sizeof(header));
+            file.write(padding.data(), padding.size());
+        }
+
+
+        writer(const writer&)            = delete;
+        writer& operator=(const writer&) = delete;
+
+
+        // Closes the file, call close() to notice errors
+        ~writer()
+        {
+            if (file.is_open())
+            {
+                try
+                {
+                    close();
+                }
+                catch (...)    // NOLINT(bugprone-empty-catch)
+                {}
+            }
+        }
+
+
+        /**
+         * @brief Append the elements to the file
+         */
+        void write(std::span<const Element> elements)
+        {
+            file.write(reinterpret_cast<const char*>(elements.data()),
+                       static_cast<std::streamsize>(elements.size_bytes()));
+            count += elements.size();
+        }
+
+
+        /**
+         * @brief Write the header with the final count and close the file
+         */
+        void close()
+        {
+            const auto final_header = detail::header_of<Element>(count);
+
+            file.seekp(0);
+            file.write(reinterpret_cast<const char*>(&final_header), sizeof(header));
+            file.close();
+
+            if (file.fail())
+            {
+                detail::throw_system_error("Could not write file", path);
+            }
+        }
+
+
+        [[nodiscard]] std::uint64_t size() const noexcept
+        {
+            return count;
+        }
+
+
+      private:
+        std::ofstream         file;
+        std::filesystem::path path;
+        std::uint64_t         count = 0;
+    };
+
+
+    /**
+     * @brief Write the elements into a new file at path
+     */
+    template <Storable Element>
+    void write(const std::filesystem::path& path, std::span<const Element> elements)
+    {
+        auto _writer = writer<Element>(path);
+        _writer.write(elements);
+        _writer.close();
+    }
+
+
+    // endregion writing
+
+
+    // region reading
+
+
+    /**
+     * @brief A file written by writer mapped into memory read-only
+     *
+     * elements() points into the mapping, so it is valid as long as the
+     * mapped_file is. Throws a runtime_error if the file does not hold an array of
+     * Element laid out like on this machine.
+     */
+    template <Storable Element>
+    class mapped_file
+    {
+      public:
+        explicit mapped_file(const std::filesystem::path& path)
+        {
+            const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (descriptor == -1)
+            {
+                detail::throw_system_error("Could not open file", path);
+            }
+
+            struct stat status = {};
+            if (::fstat(descriptor, &status) == -1)
+            {
+                ::close(descriptor);
+                detail::throw_system_error("Could not stat file", path);
+            }
+
+            const auto file_size = static_cast<std::uint64_t>(status.st_size);
+            if (file_size < sizeof(binary::header))
+            {
+                ::close(descriptor);
+                throw std::runtime_error("File " + path.string()
+                                         + " can not be mapped: it is truncated");
+            }
+
+            mapping_size = file_size;
+            mapping      = ::mmap(
+                nullptr, mapping_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            // The mapping keeps the file alive
+            ::close(descriptor);
+
+            // NOLINTNEXTLINE(*-cstyle-cast,performance-no-int-to-ptr)
+            if (mapping == MAP_FAILED)
+            {
+                mapping = nullptr;
+                detail::throw_system_error("Could not map file", path);
+            }
+
+            std::memcpy(&_header, mapping, sizeof(binary::header));
+
+            try
+            {
+                detail::throw_if_incompatible<Element>(_header, file_size, path);
+            }
+            catch (...)
+            {
+                unmap();
+                throw;
+            }
+
+            const auto* bytes = static_cast<const std::byte*>(mapping);
+            _elements         = std::span<const Element>(
+                reinterpret_cast<const Element*>(bytes + _header.data_offset),
+                _header.count);
+        }
+
+
+        mapped_file(const mapped_file&)            = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+
+        mapped_file(mapped_file&& other) noexcept :
+            mapping(std::exchange(other.mapping, nullptr)),
+            mapping_size(std::exchange(other.mapping_size, 0)),
+            _header(other._header),
+            _elements(std::exchange(other._elements, {}))
+        {}
+
+
+        mapped_file& operator=(mapped_file&& other) noexcept
+        {
+            if (this != &other)
+            {
+                unmap();
+                mapping      = std::exchange(other.mapping, nullptr);
+                mapping_size = std::exchange(other.mapping_size, 0);
+                _header      = other._header;
+                _elements    = std::exchange(other._elements, {});
+            }
+
+            return *this;
+        }
+
+
+        ~mapped_file()
+        {
+            unmap();
+        }
+
+
+        [[nodiscard]] std::span<const Element> elements() const noexcept
+        {
+            return _elements;
+        }
+
+
+        [[nodiscard]] const binary::header& header() const noexcept
+        {
+            return _header;
+        }
+
+
+      private:
+        void*          mapping      = nullptr;
+        std::size_t    mapping_size = 0;
+        binary::header _header      = {};
+
+        std::span<const Element> _elements;
+
+
+        void unmap() noexcept
+        {
+            if (mapping != nullptr)
+            {
+                ::munmap(mapping, mapping_size);
+                mapping = nullptr;
+            }
+        }
+    };
+
+
+    // endregion reading
+}    // namespace ggmath::binary
+#endif    // GG_MATH_BINARY_HPP
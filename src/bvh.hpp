@@ -0,0 +1,1291 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#ifndef GG_MATH_BVH_HPP
+#define GG_MATH_BVH_HPP
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "intersection.hpp"
+#include "packet.hpp"
+#include "parallel.hpp"
+#include "ray.hpp"
+#include "vec.hpp"
+
+
+namespace ggmath::bvh
+{
+    /**
+     * @brief The number of children of a node and of triangles in a leaf
+     */
+    inline constexpr std::size_t width = 4;
+
+
+    // region classes
+
+
+    /**
+     * @brief The settings of build()
+     */
+    struct build_options
+    {
+        // The split planes per axis the surface area heuristic evaluates
+        std::size_t bins = 16;
+
+        // The pool building the tree, nullptr to build it on the calling thread
+        parallel::thread_pool* pool = &parallel::thread_pool::shared();
+    };
+
+
+    /**
+     * @brief A node of a tree, whose children are tested against a ray at once
+     *
+     * Lane i of bounds is the box of child i. A child is another node, or a leaf if
+     * leaf_bit is set. Unused lanes hold an empty box, which no ray hits. A node
+     * fills two cache lines.
+     */
+    struct alignas(64) node
+    {
+        static constexpr std::uint32_t leaf_bit = 1U << 31U;
+        static constexpr std::uint32_t no_child =
+            std::numeric_limits<std::uint32_t>::max();
+
+        aabbf_x4                         bounds;
+        std::array<std::uint32_t, width> children = {
+            no_child, no_child, no_child, no_child};
+    };
+
+
+    /**
+     * @brief The settings of refit()
+     */
+    struct refit_options
+    {
+        // The pool refitting the tree, nullptr to refit it on the calling thread
+        parallel::thread_pool* pool = &parallel::thread_pool::shared();
+
+        // Rebuild the subtrees whose sah_cost() grew by more than this factor since
+        // they were built, 0 to never rebuild
+        float rebuild_threshold = 0;
+    };
+
+
+    /**
+     * @brief A bounding volume hierarchy over triangles, made by build()
+     *
+     * nodes[0] is the root and the nodes of a subtree are stored in order after
+     * its root, and so are its leaves. A leaf is a packet of up to width
+     * triangles, lanes without one hold NaN vertices. Lane j of leaves[i] is the
+     * triangle at indices[i * width + j] of the ones the tree was built from.
+     * treelet_costs holds the cost of the subtrees refit() may rebuild, as of
+     * their last build.
+     */
+    struct tree
+    {
+        std::vector<node>          nodes;
+        std::vector<trianglef_x4>  leaves;
+        std::vector<std::uint32_t> indices;
+        std::vector<float>         treelet_costs;
+    };
+
+
+    // endregion classes
+
+
+    // region helpers
+
+
+    namespace detail
+    {
+        inline constexpr float infinity = std::numeric_limits<float>::infinity();
+
+        // Nodes deeper than this are split at the median instead of by the surface
+        // area heuristic, which bounds the depth of a tree to sah_depth + 32
+        inline constexpr std::size_t sah_depth = 40;
+
+        // Every level of a tree pushes at most width - 1 nodes onto the traversal
+        // stack
+        inline constexpr std::size_t stack_size = 256;
+
+        struct box
+        {
+            std::array<float, 3> min = {infinity, infinity, infinity};
+            std::array<float, 3> max = {-infinity, -infinity, -infinity};
+
+
+            constexpr void grow(const std::array<float, 3>& point) noexcept
+            {
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    min[axis] = std::min(min[axis], point[axis]);
+                    max[axis] = std::max(max[axis], point[axis]);
+                }
+            }
+
+
+            constexpr void grow(const box& other) noexcept
+            {
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    min[axis] = std::min(min[axis], other.min[axis]);
+                    max[axis] = std::max(max[axis], other.max[axis]);
+                }
+            }
+
+
+            [[nodiscard]] constexpr float half_area() const noexcept
+            {
+                const float x = max[0] - min[0];
+                const float y = max[1] - min[1];
+                const float z = max[2] - min[2];
+
+                return x * y + y * z + z * x;
+            }
+        };
+
+
+        // A triangle as seen by the builder
+        struct primitive
+        {
+            box                  bounds;
+            std::array<float, 3> centroid;
+            std::uint32_t        index;
+        };
+
+
+        // The primitives of a grain of the loops over them, nodes with fewer are built
+        // on one thread
+        inline constexpr std::size_t grain = parallel::grain_size(sizeof(primitive));
+
+
+        // The leaves of a grain of refit(), which writes a leaf and its box per leaf
+        inline constexpr std::size_t leaf_grain =
+            parallel::grain_size(sizeof(trianglef_x4) + sizeof(box));
+
+
+        // A node of the binary tree the builder makes, a leaf if count is not 0
+        struct binary_node
+        {
+            box           bounds;
+            std::uint32_t first = 0;
+            std::uint32_t count = 0;
+            std::uint32_t left  = 0;
+            std::uint32_t right = 0;
+        };
+
+
+        struct bin
+        {
+            box         bounds;
+            std::size_t count = 0;
+        };
+
+
+        /**
+         * @brief Return the box around primitives and the box around their centroids
+         */
+        inline std::pair<box, box> bounds(std::span<const primitive> primitives,
+                                          parallel::thread_pool*     pool)
+        {
+            const auto merge = [](std::pair<box, box> result,
+                                  const std::pair<box, box>& other) {
+                result.first.grow(other.first);
+                result.second.grow(other.second);
+
+                return result;
+            };
+
+            return parallel::parallel_reduce(
+                pool,
+                primitives.size(),
+                grain,
+                std::pair<box, box>(),
+                [primitives](std::size_t first, std::size_t last) {
+                    auto result = std::pair<box, box>();
+                    for (auto i = first; i < last; ++i)
+                    {
+                        result.first.grow(primitives[i].bounds);
+                        result.second.grow(primitives[i].centroid);
+                    }
+
+                    return result;
+                },
+                merge);
+        }
+
+
+        /**
+         * @brief Reorder primitives into two halves and return the size of the first
+         *
+         * The split plane is the one of bins per axis between the centroids, which
+         * minimizes the surface area heuristic, the sum of the surface areas of the
+         * halves weighted by their primitives. Primitives with a common centroid
+         * and nodes deeper than sah_depth are split at the median.
+         */
+        inline std::size_t split(std::span<primitive>   primitives,
+                                 const box&             centroids,
+                                 std::size_t            depth,
+                                 std::size_t            bins,
+                                 parallel::thread_pool* pool)
+        {
+            std::array<float, 3> extent = {};
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                extent[axis] = centroids.max[axis] - centroids.min[axis];
+            }
+            const auto largest = static_cast<std::size_t>(
+                std::max_element(extent.begin(), extent.end()) - extent.begin());
+
+            const auto median = [&] {
+                const std::size_t middle = primitives.size() / 2;
+                const auto        nth =
+                    primitives.begin() + static_cast<std::ptrdiff_t>(middle);
+                std::nth_element(primitives.begin(),
+                                 nth,
+                                 primitives.end(),
+                                 [largest](const primitive& a, const primitive& b) {
+                                     return a.centroid[largest] < b.centroid[largest];
+                                 });
+
+                return middle;
+            };
+
+            if (depth >= sah_depth || !(extent[largest] > 0))
+            {
+                return median();
+            }
+
+            std::array<float, 3> scale = {};
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                scale[axis] =
+                    extent[axis] > 0 ? static_cast<float>(bins) / extent[axis] : 0;
+            }
+
+            const auto bin_of = [&](const primitive& _primitive, std::size_t axis) {
+                const float offset = _primitive.centroid[axis] - centroids.min[axis];
+
+                return std::min(bins - 1,
+                                static_cast<std::size_t>(offset * scale[axis]));
+            };
+
+            // The identity is empty, so small nodes allocate their bins only once
+            const auto merge = [](std::vector<bin> result, std::vector<bin> other) {
+                if (result.empty())
+                {
+                    return other;
+                }
+
+                for (std::size_t i = 0; i < result.size(); ++i)
+                {
+                    result[i].bounds.grow(other[i].bounds);
+                    result[i].count += other[i].count;
+                }
+
+                return result;
+            };
+
+            const auto binned = parallel::parallel_reduce(
+                pool,
+                primitives.size(),
+                grain,
+                std::vector<bin>(),
+                [&](std::size_t first, std::size_t last) {
+                    auto result = std::vector<bin>(3 * bins);
+                    for (auto i = first; i < last; ++i)
+                    {
+                        for (std::size_t axis = 0; axis < 3; ++axis)
+                        {
+                            const auto index = bin_of(primitives[i], axis);
+
+                            auto& _bin = result[axis * bins + index];
+                            _bin.bounds.grow(primitives[i].bounds);
+                            ++_bin.count;
+                        }
+                    }
+
+                    return result;
+                },
+                merge);
+
+            float       best_cost = infinity;
+            std::size_t best_axis = 0;
+            std::size_t best_bin  = 0;
+
+            // right_cost[i] is the cost of the bins from i to the last one
+            auto right_cost = std::vector<float>(bins);
+
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                if (!(extent[axis] > 0))
+                {
+                    continue;
+                }
+
+                const auto axis_bins =
+                    std::span<const bin>(binned).subspan(axis * bins, bins);
+
+                auto        right       = box();
+                std::size_t right_count = 0;
+                for (std::size_t i = bins - 1; i > 0; --i)
+                {
+                    right.grow(axis_bins[i].bounds);
+                    right_count += axis_bins[i].count;
+                    right_cost[i] =
+                        right_count == 0
+                            ? infinity
+                            : right.half_area() * static_cast<float>(right_count);
+                }
+
+                auto        left       = box();
+                std::size_t left_count = 0;
+                for (std::size_t i = 0; i + 1 < bins; ++i)
+                {
+                    left.grow(axis_bins[i].bounds);
+                    left_count += axis_bins[i].count;
+                    if (left_count == 0)
+                    {
+                        continue;
+                    }
+
+                    const float cost = left.half_area() * static_cast<float>(left_count)
+                                     + right_cost[i + 1];
+                    if (cost < best_cost)
+                    {
+                        best_cost = cost;
+                        best_axis = axis;
+                        best_bin  = i;
+                    }
+                }
+            }
+
+            if (best_cost == infinity)
+            {
+                return median();
+            }
+
+            const auto middle = std::partition(
+                primitives.begin(), primitives.end(), [&](const primitive& _primitive) {
+                    return bin_of(_primitive, best_axis) <= best_bin;
+                });
+
+            return static_cast<std::size_t>(middle - primitives.begin());
+        }
+
+
+        /**
+         * @brief Append the binary tree over primitives, which start at first, to
+         * nodes
+         *
+         * On a pool the two halves of a node of at least grain primitives are built
+         * at once, the second into its own vector, which is appended when both are
+         * done.
+         */
+        // NOLINTNEXTLINE(misc-no-recursion)
+        inline void build(std::vector<binary_node>& nodes,
+                          std::span<primitive>      primitives,
+                          std::size_t               first,
+                          std::size_t               depth,
+                          const build_options&      options)
+        {
+            const auto index            = nodes.size();
+            const auto [node_bounds, centroids] = bounds(primitives, options.pool);
+
+            nodes.push_back({node_bounds});
+
+            if (primitives.size() <= width)
+            {
+                nodes[index].first = static_cast<std::uint32_t>(first);
+                nodes[index].count = static_cast<std::uint32_t>(primitives.size());
+                return;
+            }
+
+            const auto middle =
+                split(primitives, centroids, depth, options.bins, options.pool);
+            const auto left   = primitives.first(middle);
+            const auto right  = primitives.subspan(middle);
+
+            nodes[index].left = static_cast<std::uint32_t>(index + 1);
+
+            const bool fork = options.pool != nullptr && options.pool->size() > 1
+                           && primitives.size() >= grain;
+
+            if (fork)
+            {
+                auto subtree = std::vector<binary_node>();
+
+                // The right half is queued for another thread to steal
+                const auto build_halves = [&](std::size_t first_half,
+                                              std::size_t last_half) {
+                    for (auto half = first_half; half < last_half; ++half)
+                    {
+                        if (half == 0)
+                        {
+                            build(nodes, left, first, depth + 1, options);
+                        }
+                        else
+                        {
+                            build(subtree, right, first + middle, depth + 1, options);
+                        }
+                    }
+                };
+                parallel::parallel_for(options.pool, 2, 1, build_halves);
+
+                const auto offset = static_cast<std::uint32_t>(nodes.size());
+                for (auto& _node : subtree)
+                {
+                    if (_node.count == 0)
+                    {
+                        _node.left += offset;
+                        _node.right += offset;
+                    }
+                }
+
+                nodes[index].right = offset;
+                nodes.insert(nodes.end(), subtree.begin(), subtree.end());
+            }
+            else
+            {
+                build(nodes, left, first, depth + 1, options);
+                nodes[index].right = static_cast<std::uint32_t>(nodes.size());
+                build(nodes, right, first + middle, depth + 1, options);
+            }
+        }
+
+
+        /**
+         * @brief Append the leaf with the triangles of _node to _tree and return its
+         * index
+         */
+        inline std::uint32_t append_leaf(tree&                      _tree,
+                                         const binary_node&         _node,
+                                         std::span<const primitive> primitives,
+                                         std::span<const trianglef> triangles)
+        {
+            constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+
+            auto leaf = trianglef_x4();
+
+            for (std::size_t lane = 0; lane < width; ++lane)
+            {
+                const bool loaded = lane < _node.count;
+                const auto index =
+                    loaded ? primitives[_node.first + lane].index : node::no_child;
+
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    leaf.a[axis].lanes[lane] = loaded ? triangles[index].a[axis] : nan;
+                    leaf.b[axis].lanes[lane] = loaded ? triangles[index].b[axis] : nan;
+                    leaf.c[axis].lanes[lane] = loaded ? triangles[index].c[axis] : nan;
+                }
+
+                _tree.indices.push_back(index);
+            }
+
+            _tree.leaves.push_back(std::move(leaf));
+
+            return static_cast<std::uint32_t>(_tree.leaves.size() - 1);
+        }
+
+
+        /**
+         * @brief Append the node of width children made from the binary node at
+         * index and its descendants to _tree and return its index
+         *
+         * The interior child with the largest surface is replaced by its two
+         * children until there are width of them.
+         */
+        // NOLINTNEXTLINE(misc-no-recursion)
+        inline std::uint32_t collapse(tree&                           _tree,
+                                      const std::vector<binary_node>& nodes,
+                                      std::span<const primitive>      primitives,
+                                      std::span<const trianglef>      triangles,
+                                      std::uint32_t                   index)
+        {
+            std::array<std::uint32_t, width> children = {index};
+            std::size_t                      count    = 1;
+            if (nodes[index].count == 0)
+            {
+                children = {nodes[index].left, nodes[index].right};
+                count    = 2;
+            }
+
+            while (count < width)
+            {
+                std::size_t largest = width;
+                float       area    = -infinity;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const auto& child = nodes[children[i]];
+                    if (child.count == 0 && child.bounds.half_area() > area)
+                    {
+                        largest = i;
+                        area    = child.bounds.half_area();
+                    }
+                }
+
+                if (largest == width)
+                {
+                    break;
+                }
+
+                children[count++] = nodes[children[largest]].right;
+                children[largest] = nodes[children[largest]].left;
+            }
+
+            const auto node_index = static_cast<std::uint32_t>(_tree.nodes.size());
+            _tree.nodes.emplace_back();
+
+            for (std::size_t lane = 0; lane < count; ++lane)
+            {
+                const auto& child = nodes[children[lane]];
+
+                std::uint32_t link = 0;
+                if (child.count > 0)
+                {
+                    const auto leaf = append_leaf(_tree, child, primitives, triangles);
+                    link            = node::leaf_bit | leaf;
+                }
+                else
+                {
+                    link =
+                        collapse(_tree, nodes, primitives, triangles, children[lane]);
+                }
+
+                auto& _node = _tree.nodes[node_index];
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    _node.bounds.min[axis].lanes[lane] = child.bounds.min[axis];
+                    _node.bounds.max[axis].lanes[lane] = child.bounds.max[axis];
+                }
+                _node.children[lane] = link;
+            }
+
+            return node_index;
+        }
+
+
+        /**
+         * @brief Return the primitive of the triangle at index
+         */
+        inline primitive primitive_of(std::span<const trianglef> triangles,
+                                      std::uint32_t              index) noexcept
+        {
+            auto _primitive  = primitive();
+            _primitive.index = index;
+
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                const float a   = triangles[index].a[axis];
+                const float b   = triangles[index].b[axis];
+                const float c   = triangles[index].c[axis];
+                const float min = std::min({a, b, c});
+                const float max = std::max({a, b, c});
+
+                _primitive.bounds.min[axis] = min;
+                _primitive.bounds.max[axis] = max;
+                _primitive.centroid[axis]   = (min + max) / 2;
+            }
+
+            return _primitive;
+        }
+
+
+        /**
+         * @brief Return the tree over primitives, without treelet costs
+         *
+         * primitives is reordered, options must have at least 2 bins.
+         */
+        inline tree build_tree(std::span<primitive>       primitives,
+                               std::span<const trianglef> triangles,
+                               const build_options&       options)
+        {
+            auto _tree = tree();
+            if (primitives.empty())
+            {
+                _tree.nodes.emplace_back();
+                return _tree;
+            }
+
+            auto nodes = std::vector<binary_node>();
+            nodes.reserve(2 * primitives.size() / width + 1);
+            build(nodes, primitives, 0, 0, options);
+
+            _tree.nodes.reserve(nodes.size() / 2 + 1);
+            _tree.leaves.reserve(nodes.size() / 2 + 1);
+            _tree.indices.reserve(width * (nodes.size() / 2 + 1));
+            collapse(_tree, nodes, primitives, triangles, 0);
+
+            return _tree;
+        }
+
+
+        // The depth of the roots of the subtrees refit() may rebuild
+        inline constexpr std::size_t treelet_depth = 2;
+
+
+        // The nodes from root up to end, which make up a subtree
+        struct treelet
+        {
+            std::uint32_t root;
+            std::uint32_t end;
+        };
+
+
+        /**
+         * @brief Append the subtrees at treelet_depth below the subtree of nodes from
+         * index up to end to treelets, and the nodes above them to top, in order
+         */
+        // NOLINTNEXTLINE(misc-no-recursion)
+        inline void find_treelets(const tree&                 _tree,
+                                  treelet                     subtree,
+                                  std::size_t                 depth,
+                                  std::vector<treelet>&       treelets,
+                                  std::vector<std::uint32_t>& top)
+        {
+            if (depth == treelet_depth)
+            {
+                treelets.push_back(subtree);
+                return;
+            }
+
+            top.push_back(subtree.root);
+
+            // Leaves and unused lanes have leaf_bit set, the nodes come in the order
+            // they are stored in
+            std::array<std::uint32_t, width> children = {};
+            std::size_t                      count    = 0;
+            for (auto child : _tree.nodes[subtree.root].children)
+            {
+                if ((child & node::leaf_bit) == 0)
+                {
+                    children[count++] = child;
+                }
+            }
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto end = i + 1 < count ? children[i + 1] : subtree.end;
+                find_treelets(_tree, {children[i], end}, depth + 1, treelets, top);
+            }
+        }
+
+
+        /**
+         * @brief Return the box of the child in lane of _node
+         */
+        inline box lane_box(const node& _node, std::size_t lane) noexcept
+        {
+            auto _box = box();
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                _box.min[axis] = _node.bounds.min[axis][static_cast<int>(lane)];
+                _box.max[axis] = _node.bounds.max[axis][static_cast<int>(lane)];
+            }
+
+            return _box;
+        }
+
+
+        /**
+         * @brief Return the surface area heuristic cost of subtree
+         *
+         * The cost is the sum of the surface areas of all boxes in the subtree over
+         * the one of its root, counting the root once. It is the expected number of
+         * nodes and leaves visited by a ray through the root when no early exit
+         * happens.
+         */
+        inline float subtree_cost(const tree& _tree, treelet subtree) noexcept
+        {
+            auto root = box();
+            for (std::size_t lane = 0; lane < width; ++lane)
+            {
+                root.grow(lane_box(_tree.nodes[subtree.root], lane));
+            }
+
+            // An empty root has an infinite area
+            const float root_area = root.half_area();
+            if (!(root_area > 0 && root_area < infinity))
+            {
+                return 0;
+            }
+
+            float area = root_area;
+            for (auto i = subtree.root; i < subtree.end; ++i)
+            {
+                for (std::size_t lane = 0; lane < width; ++lane)
+                {
+                    if (_tree.nodes[i].children[lane] != node::no_child)
+                    {
+                        area += lane_box(_tree.nodes[i], lane).half_area();
+                    }
+                }
+            }
+
+            return area / root_area;
+        }
+
+
+        /**
+         * @brief Return the costs of the subtrees of _tree refit() may rebuild
+         */
+        inline std::vector<float> treelet_costs(const tree& _tree)
+        {
+            std::vector<treelet>       treelets;
+            std::vector<std::uint32_t> top;
+            find_treelets(_tree,
+                          {0, static_cast<std::uint32_t>(_tree.nodes.size())},
+                          0,
+                          treelets,
+                          top);
+
+            std::vector<float> costs;
+            for (const auto& subtree : treelets)
+            {
+                costs.push_back(subtree_cost(_tree, subtree));
+            }
+
+            return costs;
+        }
+
+
+        /**
+         * @brief Set the boxes of the children of the node at index from the boxes of
+         * their children and leaf_bounds
+         */
+        inline void refit_node(tree&                _tree,
+                               std::span<const box> leaf_bounds,
+                               std::uint32_t        index) noexcept
+        {
+            auto& _node = _tree.nodes[index];
+
+            for (std::size_t lane = 0; lane < width; ++lane)
+            {
+                const auto child = _node.children[lane];
+                if (child == node::no_child)
+                {
+                    continue;
+                }
+
+                auto _box = box();
+                if ((child & node::leaf_bit) != 0)
+                {
+                    _box = leaf_bounds[child & ~node::leaf_bit];
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < width; ++i)
+                    {
+                        _box.grow(lane_box(_tree.nodes[child], i));
+                    }
+                }
+
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    _node.bounds.min[axis].lanes[lane] = _box.min[axis];
+                    _node.bounds.max[axis].lanes[lane] = _box.max[axis];
+                }
+            }
+        }
+
+
+        /**
+         * @brief Return the first leaf of subtree and the one after its last
+         */
+        inline std::pair<std::uint32_t, std::uint32_t>
+            leaf_range(const tree& _tree, treelet subtree) noexcept
+        {
+            auto first = std::numeric_limits<std::uint32_t>::max();
+            auto last  = std::uint32_t(0);
+
+            for (auto i = subtree.root; i < subtree.end; ++i)
+            {
+                for (auto child : _tree.nodes[i].children)
+                {
+                    if (child != node::no_child && (child & node::leaf_bit) != 0)
+                    {
+                        first = std::min(first, child & ~node::leaf_bit);
+                        last  = std::max(last, (child & ~node::leaf_bit) + 1);
+                    }
+                }
+            }
+
+            return {std::min(first, last), last};
+        }
+
+
+        /**
+         * @brief Replace subtree and its leaves by the ones of replacement
+         */
+        inline void splice(tree& _tree, treelet subtree, tree&& replacement)
+        {
+            const auto [leaf_first, leaf_end] = leaf_range(_tree, subtree);
+
+            const auto node_count =
+                static_cast<std::uint32_t>(replacement.nodes.size());
+            const auto leaf_count =
+                static_cast<std::uint32_t>(replacement.leaves.size());
+
+            // Links past the subtree move by the change of its size, the ones of
+            // replacement by the position it is moved to
+            const auto relink = [&](std::uint32_t child, bool replaced) {
+                if (child == node::no_child)
+                {
+                    return child;
+                }
+
+                if ((child & node::leaf_bit) != 0)
+                {
+                    auto leaf = child & ~node::leaf_bit;
+                    if (replaced)
+                    {
+                        leaf += leaf_first;
+                    }
+                    else if (leaf >= leaf_end)
+                    {
+                        leaf = leaf - leaf_end + leaf_first + leaf_count;
+                    }
+
+                    return node::leaf_bit | leaf;
+                }
+
+                if (replaced)
+                {
+                    return child + subtree.root;
+                }
+
+                return child >= subtree.end
+                           ? child - subtree.end + subtree.root + node_count
+                           : child;
+            };
+
+            auto nodes = std::vector<node>();
+            nodes.reserve(_tree.nodes.size() - (subtree.end - subtree.root)
+                          + node_count);
+
+            const auto move_node = [&](node& _node, bool replaced) {
+                for (auto& child : _node.children)
+                {
+                    child = relink(child, replaced);
+                }
+                nodes.push_back(std::move(_node));
+            };
+
+            for (std::uint32_t i = 0; i < subtree.root; ++i)
+            {
+                move_node(_tree.nodes[i], false);
+            }
+            for (auto& _node : replacement.nodes)
+            {
+                move_node(_node, true);
+            }
+            for (auto i = subtree.end; i < _tree.nodes.size(); ++i)
+            {
+                move_node(_tree.nodes[i], false);
+            }
+
+            auto leaves = std::vector<trianglef_x4>();
+            leaves.reserve(_tree.leaves.size() - (leaf_end - leaf_first) + leaf_count);
+            for (std::uint32_t i = 0; i < leaf_first; ++i)
+            {
+                leaves.push_back(std::move(_tree.leaves[i]));
+            }
+            for (auto& leaf : replacement.leaves)
+            {
+                leaves.push_back(std::move(leaf));
+            }
+            for (auto i = leaf_end; i < _tree.leaves.size(); ++i)
+            {
+                leaves.push_back(std::move(_tree.leaves[i]));
+            }
+
+            const auto indices = _tree.indices.begin();
+            const auto first   = indices + std::ptrdiff_t(width * leaf_first);
+            const auto last    = indices + std::ptrdiff_t(width * leaf_end);
+            _tree.indices.insert(
+                _tree.indices.erase(first, last),
+                replacement.indices.begin(),
+                replacement.indices.end());
+
+            _tree.nodes  = std::move(nodes);
+            _tree.leaves = std::move(leaves);
+        }
+
+
+        /**
+         * @brief Rebuild the treelets of _tree whose cost grew by more than threshold
+         * times their cost as of their last build
+         */
+        inline void rebuild(tree&                      _tree,
+                            std::span<const trianglef> triangles,
+                            std::span<const treelet>   treelets,
+                            float                      threshold,
+                            parallel::thread_pool*     pool)
+        {
+            // Without a known cost the current one is the reference
+            if (_tree.treelet_costs.size() != treelets.size())
+            {
+                _tree.treelet_costs = treelet_costs(_tree);
+                return;
+            }
+
+            std::vector<std::size_t> degraded;
+            for (std::size_t i = 0; i < treelets.size(); ++i)
+            {
+                const float cost = subtree_cost(_tree, treelets[i]);
+                if (cost > threshold * _tree.treelet_costs[i])
+                {
+                    degraded.push_back(i);
+                }
+            }
+
+            auto replacements = std::vector<tree>(degraded.size());
+
+            const auto rebuild_treelet = [&](std::size_t i) {
+                const auto subtree       = treelets[degraded[i]];
+                const auto [first, last] = leaf_range(_tree, subtree);
+
+                std::vector<primitive> primitives;
+                for (auto j = width * first; j < width * last; ++j)
+                {
+                    if (_tree.indices[j] != node::no_child)
+                    {
+                        primitives.push_back(primitive_of(triangles, _tree.indices[j]));
+                    }
+                }
+
+                replacements[i] = build_tree(primitives, triangles, {.pool = nullptr});
+
+                const auto size =
+                    static_cast<std::uint32_t>(replacements[i].nodes.size());
+                _tree.treelet_costs[degraded[i]] =
+                    subtree_cost(replacements[i], {0, size});
+            };
+            parallel::parallel_for(
+                pool, degraded.size(), 1, [&](std::size_t first, std::size_t last) {
+                    for (auto i = first; i < last; ++i)
+                    {
+                        rebuild_treelet(i);
+                    }
+                });
+
+            // Later treelets first, so the nodes of the earlier ones do not move
+            for (auto i = degraded.size(); i-- > 0;)
+            {
+                splice(_tree, treelets[degraded[i]], std::move(replacements[i]));
+            }
+        }
+
+
+        // A node or leaf to visit and the distance at which the ray enters it
+        struct stack_entry
+        {
+            std::uint32_t child;
+            float         distance;
+        };
+    }    // namespace detail
+
+
+    // endregion helpers
+
+
+    // region build
+
+
+    /**
+     * @brief Build a tree over triangles
+     *
+     * Nodes are split by the binned surface area heuristic, subtrees of large
+     * nodes are built by the threads of options.pool at once. The binary tree
+     * that results is collapsed into nodes of width children. Throws
+     * std::length_error for 2^31 or more triangles.
+     */
+    inline tree build(std::span<const trianglef> triangles,
+                      const build_options&       options = {})
+    {
+        if (triangles.size() >= node::leaf_bit)
+        {
+            throw std::length_error("bvh::build: too many triangles");
+        }
+
+        auto _options = options;
+        _options.bins = std::max<std::size_t>(_options.bins, 2);
+
+        auto primitives = std::vector<detail::primitive>(triangles.size());
+        const auto initialize = [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i < last; ++i)
+            {
+                primitives[i] =
+                    detail::primitive_of(triangles, static_cast<std::uint32_t>(i));
+            }
+        };
+        parallel::parallel_for(
+            _options.pool, triangles.size(), detail::grain, initialize);
+
+        auto _tree          = detail::build_tree(primitives, triangles, _options);
+        _tree.treelet_costs = detail::treelet_costs(_tree);
+
+        return _tree;
+    }
+
+
+    // endregion build
+
+
+    // region refit
+
+
+    /**
+     * @brief Return the surface area heuristic cost of _tree
+     *
+     * It is the expected number of nodes and leaves visited by a ray through the
+     * box of the root when no early exit happens. Refitting a deforming mesh
+     * makes boxes grow and overlap, which raises the cost and slows down
+     * traversal, rebuild once it grew too much.
+     */
+    inline float sah_cost(const tree& _tree) noexcept
+    {
+        const auto size = static_cast<std::uint32_t>(_tree.nodes.size());
+
+        return detail::subtree_cost(_tree, {0, size});
+    }
+
+
+    /**
+     * @brief Move the triangles of _tree to triangles and update its boxes bottom
+     * up
+     *
+     * triangles are the ones _tree was built from, in the same order. The
+     * structure of the tree is kept, which makes refitting much cheaper than
+     * build() but lets the quality drop when triangles move apart. The subtrees
+     * at the second level below the root are refit by the threads of
+     * options.pool at once. The ones whose sah_cost() grew by more than
+     * options.rebuild_threshold since they were built are rebuilt.
+     */
+    inline void refit(tree&                      _tree,
+                      std::span<const trianglef> triangles,
+                      const refit_options&       options = {})
+    {
+        auto leaf_bounds = std::vector<detail::box>(_tree.leaves.size());
+
+        const auto move_leaves = [&](std::size_t first, std::size_t last) {
+            for (auto leaf = first; leaf < last; ++leaf)
+            {
+                auto& packet = _tree.leaves[leaf];
+                auto& _box   = leaf_bounds[leaf];
+
+                for (std::size_t lane = 0; lane < width; ++lane)
+                {
+                    const auto index = _tree.indices[leaf * width + lane];
+                    if (index == node::no_child)
+                    {
+                        continue;
+                    }
+
+                    const auto& _triangle = triangles[index];
+                    for (std::size_t axis = 0; axis < 3; ++axis)
+                    {
+                        const float a = _triangle.a[axis];
+                        const float b = _triangle.b[axis];
+                        const float c = _triangle.c[axis];
+
+                        packet.a[axis].lanes[lane] = a;
+                        packet.b[axis].lanes[lane] = b;
+                        packet.c[axis].lanes[lane] = c;
+                        _box.min[axis] = std::min({_box.min[axis], a, b, c});
+                        _box.max[axis] = std::max({_box.max[axis], a, b, c});
+                    }
+                }
+            }
+        };
+        parallel::parallel_for(
+            options.pool, _tree.leaves.size(), detail::leaf_grain, move_leaves);
+
+        std::vector<detail::treelet> treelets;
+        std::vector<std::uint32_t>   top;
+        detail::find_treelets(_tree,
+                              {0, static_cast<std::uint32_t>(_tree.nodes.size())},
+                              0,
+                              treelets,
+                              top);
+
+        // Children come after their parent, so refitting backwards sees them first
+        const auto refit_treelets = [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i < last; ++i)
+            {
+                for (auto index = treelets[i].end; index-- > treelets[i].root;)
+                {
+                    detail::refit_node(_tree, leaf_bounds, index);
+                }
+            }
+        };
+        const bool large = _tree.leaves.size() >= detail::leaf_grain;
+        parallel::parallel_for(
+            large ? options.pool : nullptr, treelets.size(), 1, refit_treelets);
+
+        for (auto index = top.rbegin(); index != top.rend(); ++index)
+        {
+            detail::refit_node(_tree, leaf_bounds, *index);
+        }
+
+        if (options.rebuild_threshold > 0)
+        {
+            detail::rebuild(
+                _tree, triangles, treelets, options.rebuild_threshold, options.pool);
+        }
+    }
+
+
+    // endregion refit
+
+
+    // region traversal
+
+
+    /**
+     * @brief Return the nearest hit of _ray on the triangles of _tree at a distance
+     * in (0, t_max]
+     *
+     * The hit is found with the watertight test, its index is the one of the
+     * triangle in the triangles the tree was built from. Children are visited
+     * nearest first and skipped once a nearer hit is known.
+     */
+    inline intersections::triangle_hit<float>
+        closest_hit(const tree& _tree, const rayf& _ray, float t_max = detail::infinity)
+    {
+        auto hit = intersections::triangle_hit<float>();
+
+        std::array<detail::stack_entry, detail::stack_size> stack;
+        std::size_t                                         size = 0;
+
+        stack[size++] = {0, 0};
+
+        while (size > 0)
+        {
+            const auto [child, distance] = stack[--size];
+            const float limit            = std::min(t_max, hit.distance);
+
+            if (distance > limit)
+            {
+                continue;
+            }
+
+            if ((child & node::leaf_bit) != 0)
+            {
+                const auto leaf     = child & ~node::leaf_bit;
+                const auto leaf_hit =
+                    intersections::watertight(_ray, _tree.leaves[leaf], limit);
+
+                if (leaf_hit.distance < hit.distance)
+                {
+                    hit       = leaf_hit;
+                    hit.index = _tree.indices[leaf * width + leaf_hit.index];
+                }
+
+                continue;
+            }
+
+            const auto& _node     = _tree.nodes[child];
+            const auto  distances =
+                intersections::entry_distance(_ray, _node.bounds, limit);
+
+            std::array<detail::stack_entry, width> hits;
+            std::size_t                            count = 0;
+
+            // Masked to width lanes, so count provably stays within hits
+            constexpr auto lanes = (std::uint64_t(1) << width) - 1;
+            const auto     bits  = (distances < detail::infinity).bits() & lanes;
+            for (auto remaining = bits; remaining != 0; remaining &= remaining - 1)
+            {
+                const int lane = std::countr_zero(remaining);
+                hits[count++]  = {_node.children[static_cast<std::size_t>(lane)],
+                                  distances[lane]};
+            }
+
+            // Push the farthest first, so the nearest is visited next. An insertion
+            // sort of at most width entries, which unlike std::sort has no paths
+            // the compiler sees reading past hits
+            for (std::size_t i = 1; i < count; ++i)
+            {
+                for (auto j = i; j > 0 && hits[j - 1].distance < hits[j].distance; --j)
+                {
+                    std::swap(hits[j - 1], hits[j]);
+                }
+            }
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                stack[size++] = hits[i];
+            }
+        }
+
+        return hit;
+    }
+
+
+    /**
+     * @brief Check if _ray hits any triangle of _tree at a distance in (0, t_max]
+     *
+     * Stops at the first hit found, which makes it cheaper than closest_hit() for
+     * shadow and visibility rays.
+     */
+    inline bool
+        any_hit(const tree& _tree, const rayf& _ray, float t_max = detail::infinity)
+    {
+        std::array<std::uint32_t, detail::stack_size> stack;
+        std::size_t                                   size = 0;
+
+        stack[size++] = 0;
+
+        while (size > 0)
+        {
+            const auto child = stack[--size];
+
+            if ((child & node::leaf_bit) != 0)
+            {
+                const auto& leaf = _tree.leaves[child & ~node::leaf_bit];
+                const auto  hits = intersections::detail::watertight(_ray, leaf, t_max);
+
+                if (intersections::detail::any(hits.distance < detail::infinity))
+                {
+                    return true;
+                }
+
+                continue;
+            }
+
+            const auto& _node = _tree.nodes[child];
+            const auto hit_mask = intersections::intersects(_ray, _node.bounds, t_max);
+            for (auto bits = hit_mask.bits(); bits != 0; bits &= bits - 1)
+            {
+                const auto lane = static_cast<std::size_t>(std::countr_zero(bits));
+                stack[size++]   = _node.children[lane];
+            }
+        }
+
+        return false;
+    }
+
+
+    // endregion traversal
+}    // namespace ggmath::bvh
+#endif    // GG_MATH_BVH_HPP
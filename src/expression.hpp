@@ -0,0 +1,334 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#ifndef GG_MATH_EXPRESSION_HPP
+#define GG_MATH_EXPRESSION_HPP
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "types.hpp"
+#include "vec.hpp"
+
+
+// Lazily evaluated vector arithmetic, opt in by wrapping the operands with lazy()
+//
+// The operators of vec.hpp return a vec each, so `a + t * (b - a)` stores two
+// temporaries. Here they return a node describing the operation instead, and
+// converting the outermost node to a vec calculates every component of the whole
+// expression in one loop:
+//
+//     const vec3f c = expr::lazy(a) + t * (expr::lazy(b) - expr::lazy(a));
+//
+// Nodes reference the vectors they were built from, so they must not outlive them.
+// Store the result in a vec, not in `auto`. Temporary vectors are rejected as
+// operands for the same reason.
+namespace ggmath::expr
+{
+    // region concepts
+
+
+    template <typename Derived>
+    struct node;
+
+
+    /**
+     * @brief Check if T is a node of an expression
+     */
+    template <typename T>
+    concept Expression = std::derived_from<std::remove_cvref_t<T>,
+                                           node<std::remove_cvref_t<T>>>;
+
+
+    template <typename T>
+    struct is_vec : std::false_type
+    {};
+
+
+    template <Scalar T, int n>
+    struct is_vec<vec<T, n>> : std::true_type
+    {};
+
+
+    /**
+     * @brief Check if T is a vec
+     */
+    template <typename T>
+    concept Vector = is_vec<std::remove_cvref_t<T>>::value;
+
+
+    /**
+     * @brief Check if T can be an operand of the operators below, a node or a vector
+     * which outlives the expression
+     */
+    template <typename T>
+    concept Operand = Expression<T> || (Vector<T> && std::is_lvalue_reference_v<T>);
+
+
+    // endregion concepts
+
+
+    // region nodes
+
+
+    /**
+     * @brief Base of the nodes, which converts them to vectors
+     *
+     * Derived provides the value_type and size of its result and operator[] to
+     * calculate one component of it.
+     */
+    template <typename Derived>
+    struct node
+    {
+        /**
+         * @brief Calculate the components of the expression in one loop
+         */
+        template <Scalar T_Out, int n>
+        requires(n == Derived::size)
+        // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+        constexpr operator vec<T_Out, n>() const
+        {
+            const auto& self    = static_cast<const Derived&>(*this);
+            auto        vec_out = vec<T_Out, n>(uninitialized);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                vec_out[i] = static_cast<T_Out>(self[i]);
+            }
+
+            return vec_out;
+        }
+    };
+
+
+    /**
+     * @brief A leaf of an expression, references a vector
+     */
+    template <Scalar T, int n>
+    struct terminal : node<terminal<T, n>>
+    {
+        using value_type           = T;
+        static constexpr int size = n;
+
+        const vec<T, n>& _vec;
+
+
+        constexpr explicit terminal(const vec<T, n>& _vec) noexcept : _vec(_vec) {}
+
+
+        constexpr value_type operator[](std::size_t i) const
+        {
+            return _vec[i];
+        }
+    };
+
+
+    /**
+     * @brief Op applied to the components of a and b
+     */
+    template <typename Op, Expression T_A, Expression T_B>
+    requires(T_A::size == T_B::size)
+    struct binary : node<binary<Op, T_A, T_B>>
+    {
+        using value_type = decltype(Op()(std::declval<typename T_A::value_type>(),
+                                         std::declval<typename T_B::value_type>()));
+        static constexpr int size = T_A::size;
+
+        T_A a;
+        T_B b;
+
+
+        constexpr binary(const T_A& a, const T_B& b) noexcept : a(a), b(b) {}
+
+
+        constexpr value_type operator[](std::size_t i) const
+        {
+            return Op()(a[i], b[i]);
+        }
+    };
+
+
+    /**
+     * @brief Op applied to the components of a and scalar
+     */
+    template <typename Op, Expression T_A, Scalar T_Scalar>
+    struct scalar_binary : node<scalar_binary<Op, T_A, T_Scalar>>
+    {
+        using value_type = decltype(Op()(std::declval<typename T_A::value_type>(),
+                                         std::declval<T_Scalar>()));
+        static constexpr int size = T_A::size;
+
+        T_A      a;
+        T_Scalar scalar;
+
+
+        constexpr scalar_binary(const T_A& a, T_Scalar scalar) noexcept :
+            a(a), scalar(scalar)
+        {}
+
+
+        constexpr value_type operator[](std::size_t i) const
+        {
+            return Op()(a[i], scalar);
+        }
+    };
+
+
+    /**
+     * @brief The negated components of a
+     */
+    template <Expression T_A>
+    struct negation : node<negation<T_A>>
+    {
+        using value_type           = typename T_A::value_type;
+        static constexpr int size = T_A::size;
+
+        T_A a;
+
+
+        constexpr explicit negation(const T_A& a) noexcept : a(a) {}
+
+
+        constexpr value_type operator[](std::size_t i) const
+        {
+            return -a[i];
+        }
+    };
+
+
+    // endregion nodes
+
+
+    // region functions
+
+
+    /**
+     * @brief Start an expression with the vector _vec, which has to outlive it
+     */
+    template <Scalar T, int n>
+    constexpr terminal<T, n> lazy(const vec<T, n>& _vec) noexcept
+    {
+        return terminal<T, n>(_vec);
+    }
+
+
+    template <Scalar T, int n>
+    constexpr terminal<T, n> lazy(const vec<T, n>&& _vec) = delete;
+
+
+    /**
+     * @brief Wrap vectors in a terminal, return nodes as they are
+     */
+    template <typename T>
+    requires Expression<T> || Vector<T>
+    constexpr auto as_expression(const T& operand) noexcept
+    {
+        if constexpr (Expression<T>)
+        {
+            return operand;
+        }
+        else
+        {
+            return lazy(operand);
+        }
+    }
+
+
+    template <typename T>
+    using expression_t = decltype(as_expression(std::declval<const T&>()));
+
+
+    /**
+     * @brief Calculate the components of the expression in one loop, the same as
+     * converting it to a vec of its value_type
+     */
+    template <Expression T>
+    constexpr vec<typename T::value_type, T::size> evaluate(const T& expression)
+    {
+        return expression;
+    }
+
+
+    // endregion functions
+
+
+    // region operator_overloads
+
+
+    // At least one operand has to be a node, so these never replace the operators of
+    // vec.hpp
+
+
+    // Vector-vector addition
+    template <Operand T_A, Operand T_B>
+    requires(Expression<T_A> || Expression<T_B>)
+    constexpr auto operator+(T_A&& a, T_B&& b) noexcept
+    {
+        return binary<std::plus<>,
+                      expression_t<std::remove_cvref_t<T_A>>,
+                      expression_t<std::remove_cvref_t<T_B>>>(as_expression(a),
+                                                               as_expression(b));
+    }
+
+
+    // Vector-vector subtraction
+    template <Operand T_A, Operand T_B>
+    requires(Expression<T_A> || Expression<T_B>)
+    constexpr auto operator-(T_A&& a, T_B&& b) noexcept
+    {
+        return binary<std::minus<>,
+                      expression_t<std::remove_cvref_t<T_A>>,
+                      expression_t<std::remove_cvref_t<T_B>>>(as_expression(a),
+                                                               as_expression(b));
+    }
+
+
+    // Scalar-vector multiplication
+    template <Expression T_A, Scalar T_Scalar>
+    constexpr auto operator*(const T_A& a, const T_Scalar scalar) noexcept
+    {
+        return scalar_binary<std::multiplies<>, T_A, T_Scalar>(a, scalar);
+    }
+
+
+    // Scalar-vector multiplication
+    template <Scalar T_Scalar, Expression T_A>
+    constexpr auto operator*(const T_Scalar scalar, const T_A& a) noexcept
+    {
+        return a * scalar;
+    }
+
+
+    // Scalar-vector division
+    template <Expression T_A, Scalar T_Scalar>
+    constexpr auto operator/(const T_A& a, const T_Scalar scalar) noexcept
+    {
+        return scalar_binary<std::divides<>, T_A, T_Scalar>(a, scalar);
+    }
+
+
+    // Invert vector
+    template <Expression T_A>
+    constexpr auto operator-(const T_A& a) noexcept
+    {
+        return negation<T_A>(a);
+    }
+
+
+    // endregion operator_overloads
+}    // namespace ggmath::expr
+#endif    // GG_MATH_EXPRESSION_HPP
@@ -0,0 +1,554 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#ifndef GG_MATH_FAST_HPP
+#define GG_MATH_FAST_HPP
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numbers>
+#include <span>
+
+#include "packet.hpp"
+#include "simd.hpp"
+#include "types.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+
+// Approximations trading a few bits of precision for speed, opt in by calling them
+// instead of their counterparts in vector:: and the standard library
+//
+// Every function is a template over float and simd::pack<float, W>, so the same
+// code evaluates one value or a packet of them. The maximum errors below are
+// measured against the double precision functions of the standard library.
+namespace ggmath::fast
+{
+    /**
+     * @brief The number of values the batch functions calculate at once
+     */
+    inline constexpr int batch_width = 8;
+
+
+    /**
+     * @brief float or a simd::pack of floats
+     */
+    template <typename T>
+    concept FloatLanes = Scalar<T> && std::same_as<lane_value_t<T>, float>;
+
+
+    // region helpers
+
+
+    namespace detail
+    {
+        // The first guess of the bit trick, its relative error is at most 3.4%
+        inline constexpr std::int32_t rsqrt_magic = 0x5F375A86;
+
+        // Adding and subtracting it rounds floats of a magnitude below 2^22 to the
+        // nearest integer
+        inline constexpr float round_magic = 12582912.0F;
+
+        // pi / 2 split into parts whose products with integers up to 2^13 are
+        // exact, so subtracting them loses no precision
+        inline constexpr float half_pi_1 = 1.5703125F;
+        inline constexpr float half_pi_2 = 4.837512969970703125e-4F;
+        inline constexpr float half_pi_3 = 7.54978995489188216e-8F;
+
+
+        // The counterpart of the select simd::pack provides
+        constexpr float select(bool condition, float a, float b) noexcept
+        {
+            return condition ? a : b;
+        }
+
+
+        /**
+         * @brief Refine the estimate of 1 / sqrt(x) by one Newton-Raphson step,
+         * which about doubles its correct bits
+         */
+        template <FloatLanes T>
+        constexpr T newton_step(const T& x, const T& estimate) noexcept
+        {
+            return estimate * (T(1.5F) - T(0.5F) * x * estimate * estimate);
+        }
+
+
+        /**
+         * @brief Estimate 1 / sqrt(x) with a relative error of at most 0.2%
+         *
+         * The rsqrt instruction if there is one, otherwise the bit trick refined by
+         * a Newton-Raphson step.
+         */
+        inline float rsqrt_estimate(float x) noexcept
+        {
+#if GGMATH_SIMD_SSE
+            return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+#else
+            const auto guess = std::bit_cast<float>(
+                rsqrt_magic - (std::bit_cast<std::int32_t>(x) >> 1));
+
+            return newton_step(x, guess);
+#endif
+        }
+
+
+        /**
+         * @brief Estimate 1 / sqrt(x) for every lane with a relative error of at most
+         * 0.2%
+         *
+         * One rsqrt instruction if the packet fits into a register of the
+         * instruction set the compiler targets, wider packets are split in halves
+         * like simd::sqrt_lanes, the remaining ones use the bit trick.
+         */
+        template <int W>
+        inline simd::pack<float, W>
+            rsqrt_estimate(const simd::pack<float, W>& x) noexcept
+        {
+            using lanes_t       = simd::native_t<float, W>;
+            constexpr auto size = sizeof(lanes_t);
+
+#if GGMATH_SIMD_SSE
+            if constexpr (size == 16)
+            {
+                return simd::pack<float, W>(lanes_t(_mm_rsqrt_ps(__m128(x.lanes))));
+            }
+#endif
+#if GGMATH_SIMD_AVX
+            if constexpr (size == 32)
+            {
+                return simd::pack<float, W>(lanes_t(_mm256_rsqrt_ps(__m256(x.lanes))));
+            }
+#endif
+#if defined(__AVX512F__)
+            if constexpr (size == 64)
+            {
+                return simd::pack<float, W>(
+                    lanes_t(_mm512_rsqrt14_ps(__m512(x.lanes))));
+            }
+#endif
+
+            if constexpr (GGMATH_SIMD_SSE && W % 2 == 0 && size > 16)
+            {
+                simd::pack<float, W / 2> halves[2];    // NOLINT(*-avoid-c-arrays)
+                std::memcpy(&halves, &x.lanes, size);
+                halves[0] = rsqrt_estimate(halves[0]);
+                halves[1] = rsqrt_estimate(halves[1]);
+
+                auto result = simd::pack<float, W>();
+                std::memcpy(&result.lanes, &halves, size);
+                return result;
+            }
+            else
+            {
+                using bits_t = simd::native_t<std::int32_t, W>;
+
+                const auto guess = simd::pack<float, W>(std::bit_cast<lanes_t>(
+                    rsqrt_magic - (std::bit_cast<bits_t>(x.lanes) >> 1)));
+
+                return newton_step(x, guess);
+            }
+        }
+
+
+        /**
+         * @brief Round x to the nearest integer, ties to even, x must have a
+         * magnitude below 2^22
+         */
+        template <FloatLanes T>
+        constexpr T round(const T& x) noexcept
+        {
+            return (x + T(round_magic)) - T(round_magic);
+        }
+
+
+        /**
+         * @brief Evaluate the polynomial with the coefficients, the constant one
+         * first, at x with Horner's method
+         */
+        template <FloatLanes T, std::size_t n>
+        constexpr T polynomial(const T& x, const float (&coefficients)[n]) noexcept
+        {
+            auto result = T(coefficients[n - 1]);
+
+            for (std::size_t i = n - 1; i > 0; --i)
+            {
+                result = result * x + T(coefficients[i - 1]);
+            }
+
+            return result;
+        }
+
+
+        /**
+         * @brief An angle reduced to [-pi / 4, pi / 4] and the quadrant, 0 to 3, of
+         * the angle it was reduced from
+         */
+        template <FloatLanes T>
+        struct reduced_angle
+        {
+            T angle;
+            T quadrant;
+        };
+
+
+        /**
+         * @brief Subtract the nearest multiple of pi / 2 from radians
+         */
+        template <FloatLanes T>
+        constexpr reduced_angle<T> reduce(const T& radians) noexcept
+        {
+            const T multiple = round(radians * T(2 * std::numbers::inv_pi_v<float>));
+            const T angle    = ((radians - multiple * T(half_pi_1))
+                             - multiple * T(half_pi_2))
+                            - multiple * T(half_pi_3);
+
+            // multiple modulo 4, floor(multiple / 4) rounds exactly since the
+            // quarters of integers are multiples of 0.25
+            const T quadrant =
+                multiple - T(4) * round(multiple * T(0.25F) - T(0.375F));
+
+            return {angle, quadrant};
+        }
+
+
+        /**
+         * @brief The sine of angles in [-pi / 4, pi / 4]
+         */
+        template <FloatLanes T>
+        constexpr T sin_reduced(const T& angle) noexcept
+        {
+            // Minimax coefficients of the Cephes library
+            constexpr float coefficients[] = {    // NOLINT(*-avoid-c-arrays)
+                -1.6666654611e-1F,
+                8.3321608736e-3F,
+                -1.9515295891e-4F};
+
+            const T squared = angle * angle;
+
+            return angle + angle * squared * polynomial(squared, coefficients);
+        }
+
+
+        /**
+         * @brief The cosine of angles in [-pi / 4, pi / 4]
+         */
+        template <FloatLanes T>
+        constexpr T cos_reduced(const T& angle) noexcept
+        {
+            constexpr float coefficients[] = {    // NOLINT(*-avoid-c-arrays)
+                4.166664568298827e-2F,
+                -1.388731625493765e-3F,
+                2.443315711809948e-5F};
+
+            const T squared = angle * angle;
+
+            return T(1) - T(0.5F) * squared
+                   + squared * squared * polynomial(squared, coefficients);
+        }
+
+
+        /**
+         * @brief Multiply the elements of values by factor, batch_width at a time
+         */
+        inline void
+            scale(std::span<const float> values, float factor, std::span<float> out)
+        {
+            debug::throw_if_not_equal_size(values.size(), out.size());
+
+            const auto factors = simd_float<batch_width>(factor);
+            for (std::size_t i = 0; i < values.size(); i += batch_width)
+            {
+                packet::store(packet::load<batch_width>(values, i) * factors, out, i);
+            }
+        }
+    }    // namespace detail
+
+
+    // endregion helpers
+
+
+    // region roots
+
+
+    /**
+     * @brief Return 1 / sqrt(x) with a relative error of at most 5e-6
+     *
+     * An estimate, the rsqrt instruction if there is one, refined by one
+     * Newton-Raphson step. The error is at most 3e-7 with the rsqrt instruction. x
+     * has to be positive and normal, zero results in NaN instead of infinity.
+     */
+    template <FloatLanes T>
+    inline T rsqrt(const T& x) noexcept
+    {
+        return detail::newton_step(x, detail::rsqrt_estimate(x));
+    }
+
+
+    /**
+     * @brief Return a copy of vec scaled to a length of 1 with a relative error of
+     * at most 5e-6, see rsqrt()
+     *
+     * Multiplies by rsqrt() of the squared length instead of dividing by the length
+     * like vector::normalized. The zero vector results in NaN like there.
+     */
+    template <FloatLanes T, int n>
+    inline vec<T, n> normalized(const vec<T, n>& _vec) noexcept
+    {
+        return _vec * rsqrt(vector::length_squared(_vec));
+    }
+
+
+    /**
+     * @brief Scale the elements of a to a length of 1, batch_width at a time, see
+     * normalized()
+     */
+    template <int n>
+    void normalized(const vec_soa<float, n>& a, vec_soa<float, n>& out)
+    {
+        using packet_t = simd_float<batch_width>;
+
+        out.resize(a.size());
+
+        // Whole batches are loaded from the columns directly, the copies of
+        // packet::load are only worth it for the rest
+        const std::size_t whole = a.size() - a.size() % batch_width;
+        for (std::size_t i = 0; i < whole; i += batch_width)
+        {
+            auto length_squared = packet_t(0.0F);
+            for (std::size_t axis = 0; axis < n; ++axis)
+            {
+                const auto component = packet_t::load(a.data(axis) + i);
+                length_squared       = length_squared + component * component;
+            }
+
+            const auto factor = rsqrt(length_squared);
+            for (std::size_t axis = 0; axis < n; ++axis)
+            {
+                (packet_t::load(a.data(axis) + i) * factor).store(out.data(axis) + i);
+            }
+        }
+
+        if (whole != a.size())
+        {
+            packet::store(normalized(packet::load<batch_width>(a, whole)), out, whole);
+        }
+    }
+
+
+    // endregion roots
+
+
+    // region trigonometry
+
+
+    /**
+     * @brief Return the arc cosine of x with an error of at most 5e-7 radians
+     *
+     * A polynomial of degree 7 times sqrt(1 - |x|), from Abramowitz and Stegun
+     * 4.4.46. x outside of [-1, 1] results in NaN like std::acos.
+     */
+    template <FloatLanes T>
+    inline T acos(const T& x) noexcept
+    {
+        using detail::select;
+        using std::abs;
+        using std::sqrt;
+
+        constexpr float coefficients[] = {    // NOLINT(*-avoid-c-arrays)
+            1.5707963050F,
+            -0.2145988016F,
+            0.0889789874F,
+            -0.0501743046F,
+            0.0308918810F,
+            -0.0170881256F,
+            0.0066700901F,
+            -0.0012624911F};
+
+        const T magnitude = abs(x);
+        const T angle =
+            sqrt(T(1) - magnitude) * detail::polynomial(magnitude, coefficients);
+
+        return select(x < T(0), T(std::numbers::pi_v<float>) - angle, angle);
+    }
+
+
+    /**
+     * @brief Return the angle of the point (x, y) to the x axis, in [-pi, pi], with
+     * an error of at most 3e-6 radians
+     *
+     * An odd polynomial of degree 11 approximates the arc tangent of the ratio of
+     * the smaller and the larger magnitude of x and y, which is in [0, 1]. Unlike
+     * std::atan2 the result does not depend on the signs of zeros, atan2(0, 0) is
+     * 0. x and y have to be finite.
+     */
+    template <FloatLanes T>
+    inline T atan2(const T& y, const T& x) noexcept
+    {
+        using detail::select;
+        using std::abs;
+        using std::max;
+        using std::min;
+
+        constexpr float coefficients[] = {    // NOLINT(*-avoid-c-arrays)
+            0.99997726F,
+            -0.33262347F,
+            0.19354346F,
+            -0.11643287F,
+            0.05265332F,
+            -0.01172120F};
+
+        const T x_magnitude = abs(x);
+        const T y_magnitude = abs(y);
+        const T larger      = max(x_magnitude, y_magnitude);
+        const T ratio =
+            select(larger == T(0), T(0), min(x_magnitude, y_magnitude) / larger);
+
+        T angle = ratio * detail::polynomial(ratio * ratio, coefficients);
+
+        angle = select(y_magnitude > x_magnitude,
+                       T(std::numbers::pi_v<float> / 2) - angle,
+                       angle);
+        angle = select(x < T(0), T(std::numbers::pi_v<float>) - angle, angle);
+
+        return select(y < T(0), -angle, angle);
+    }
+
+
+    /**
+     * @brief Return the sine of radians with an error of at most 2e-7 for
+     * magnitudes up to 8192
+     *
+     * radians is reduced to [-pi / 4, pi / 4] by subtracting the nearest multiple of
+     * pi / 2 in three parts, beyond 8192 the reduction is no longer exact and the
+     * error grows.
+     */
+    template <FloatLanes T>
+    inline T sin(const T& radians) noexcept
+    {
+        using detail::select;
+        using std::abs;
+
+        const auto [angle, quadrant] = detail::reduce(radians);
+        const T sine   = detail::sin_reduced(angle);
+        const T cosine = detail::cos_reduced(angle);
+
+        // Odd quadrants swap sine and cosine, the third and fourth negate them
+        const T result = select(abs(quadrant - T(2)) == T(1), cosine, sine);
+
+        return select(quadrant >= T(2), -result, result);
+    }
+
+
+    /**
+     * @brief Return the cosine of radians with an error of at most 2e-7 for
+     * magnitudes up to 8192, see sin()
+     */
+    template <FloatLanes T>
+    inline T cos(const T& radians) noexcept
+    {
+        using detail::select;
+        using std::abs;
+
+        const auto [angle, quadrant] = detail::reduce(radians);
+        const T sine   = detail::sin_reduced(angle);
+        const T cosine = detail::cos_reduced(angle);
+
+        // Odd quadrants swap sine and cosine, the second and third negate them
+        const T result = select(abs(quadrant - T(2)) == T(1), sine, cosine);
+
+        return select(abs(quadrant - T(1.5F)) < T(1), -result, result);
+    }
+
+
+    /**
+     * @brief Return the angle between the vectors, see acos()
+     *
+     * The cosine of the angle is calculated with rsqrt() and clamped to [-1, 1], so
+     * its error does not result in NaN for (anti-)parallel vectors. acos() is steep
+     * there, so like for vector::angle_between the error grows to about 1e-3
+     * radians for nearly (anti-)parallel vectors.
+     */
+    template <FloatLanes T, int n>
+    inline T angle_between(const vec<T, n>& a, const vec<T, n>& b) noexcept
+    {
+        using std::max;
+        using std::min;
+
+        const T cosine = vector::dot(a, b)
+                         * rsqrt(vector::length_squared(a) * vector::length_squared(b));
+
+        return acos(min(max(cosine, T(-1)), T(1)));
+    }
+
+
+    // endregion trigonometry
+
+
+    // region angles
+
+
+    /**
+     * @brief Convert the given measure of radians to degrees with a relative error
+     * of at most 2e-7
+     *
+     * Multiplies by 180 / pi rounded to a float instead of dividing by pi in double
+     * precision like ggmath::rad_to_deg.
+     */
+    template <FloatLanes T>
+    constexpr T rad_to_deg(const T& radians) noexcept
+    {
+        return radians * T(180 * std::numbers::inv_pi_v<float>);
+    }
+
+
+    /**
+     * @brief Convert the given measure of degrees to radians with a relative error
+     * of at most 2e-7, see rad_to_deg()
+     */
+    template <FloatLanes T>
+    constexpr T deg_to_rad(const T& degrees) noexcept
+    {
+        return degrees * T(std::numbers::pi_v<float> / 180);
+    }
+
+
+    /**
+     * @brief Convert the measures of radians to degrees, batch_width at a time, see
+     * rad_to_deg()
+     */
+    inline void rad_to_deg(std::span<const float> radians, std::span<float> out)
+    {
+        detail::scale(radians, 180 * std::numbers::inv_pi_v<float>, out);
+    }
+
+
+    /**
+     * @brief Convert the measures of degrees to radians, batch_width at a time, see
+     * deg_to_rad()
+     */
+    inline void deg_to_rad(std::span<const float> degrees, std::span<float> out)
+    {
+        detail::scale(degrees, std::numbers::pi_v<float> / 180, out);
+    }
+
+
+    // endregion angles
+}    // namespace ggmath::fast
+#endif    // GG_MATH_FAST_HPP
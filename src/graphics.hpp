@@ -15,6 +15,160 @@
 // OTHER DEALINGS IN THE SOFTWARE.
 #ifndef GG_MATH_GRAPHICS_HPP
 #define GG_MATH_GRAPHICS_HPP
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include "mat.hpp"
+#include "simd.hpp"
+#include "types.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+
 namespace ggmath::graphics
-{}        // namespace ggmath::graphics
+{
+    // region helpers
+
+
+    namespace detail
+    {
+        /**
+         * @brief Transform every vector of in by _mat into out
+         *
+         * If n_in is 3, the fourth component of the vectors is ignored and w is used
+         * in its place. If Divide is true, the results are divided by their fourth
+         * component.
+         */
+        template <int n_in, bool Divide, Scalar T, int n>
+        void transform(const mat<T, 4, 4>&        _mat,
+                       std::span<const vec<T, n>> in,
+                       std::span<vec<T, n>>       out,
+                       T                          w)
+        {
+            debug::throw_if_not_equal_size(in.size(), out.size());
+
+            if constexpr (simd::accelerated<T, n>)
+            {
+                // vec3f is padded to 4 floats, so all vectors are 4 values apart
+                simd::transform4x4<n_in, Divide>(&_mat[0][0],
+                                                 reinterpret_cast<const T*>(in.data()),
+                                                 reinterpret_cast<T*>(out.data()),
+                                                 in.size(),
+                                                 w);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < in.size(); ++i)
+                {
+                    const auto& _vec = in[i];
+                    T           w_in = w;
+                    if constexpr (n_in == 4)
+                    {
+                        w_in = _vec[3];
+                    }
+
+                    // Calculated completely before the first write, out may alias in
+                    std::array<T, 4> result{};
+                    for (int row = 0; row < 4; ++row)
+                    {
+                        result[row] = _mat[row][0] * _vec[0] + _mat[row][1] * _vec[1]
+                                      + _mat[row][2] * _vec[2] + _mat[row][3] * w_in;
+                    }
+
+                    for (int axis = 0; axis < n; ++axis)
+                    {
+                        out[i][axis] = Divide ? result[axis] / result[3] : result[axis];
+                    }
+                }
+            }
+        }
+    }    // namespace detail
+
+
+    // endregion helpers
+
+
+    // region functions
+
+
+    /**
+     * @brief Transform the points(w = 1) of points by _mat into out
+     *
+     * If perspective_divide is true, the results are divided by their w. points and
+     * out have to be of equal size, out may be points itself. float matrices and
+     * points that are simd::accelerated are transformed two at a time with AVX and
+     * one at a time otherwise.
+     */
+    template <Scalar T>
+    void transform_points(const mat<T, 4, 4>&                                _mat,
+                          std::type_identity_t<std::span<const vec<T, 3>>> points,
+                          std::type_identity_t<std::span<vec<T, 3>>>       out,
+                          bool perspective_divide = false)
+    {
+        if (perspective_divide)
+        {
+            detail::transform<3, true>(_mat, points, out, T(1));
+        }
+        else
+        {
+            detail::transform<3, false>(_mat, points, out, T(1));
+        }
+    }
+
+
+    /**
+     * @brief Transform the homogeneous points of points by _mat into out
+     *
+     * Their w is used as is, so directions with a w of 0 are transformed correctly
+     * too. If perspective_divide is true, the results are divided by their w.
+     */
+    template <Scalar T>
+    void transform_points(const mat<T, 4, 4>&                                _mat,
+                          std::type_identity_t<std::span<const vec<T, 4>>> points,
+                          std::type_identity_t<std::span<vec<T, 4>>>       out,
+                          bool perspective_divide = false)
+    {
+        if (perspective_divide)
+        {
+            detail::transform<4, true>(_mat, points, out, T(1));
+        }
+        else
+        {
+            detail::transform<4, false>(_mat, points, out, T(1));
+        }
+    }
+
+
+    /**
+     * @brief Transform the directions(w = 0) of directions by _mat into out, which
+     * ignores the translation of _mat
+     */
+    template <Scalar T>
+    void transform_directions(
+        const mat<T, 4, 4>&                                _mat,
+        std::type_identity_t<std::span<const vec<T, 3>>> directions,
+        std::type_identity_t<std::span<vec<T, 3>>>       out)
+    {
+        detail::transform<3, false>(_mat, directions, out, T(0));
+    }
+
+
+    /**
+     * @brief Transform the directions of directions by _mat into out, their w is
+     * ignored and taken to be 0
+     */
+    template <Scalar T>
+    void transform_directions(
+        const mat<T, 4, 4>&                                _mat,
+        std::type_identity_t<std::span<const vec<T, 4>>> directions,
+        std::type_identity_t<std::span<vec<T, 4>>>       out)
+    {
+        detail::transform<3, false>(_mat, directions, out, T(0));
+    }
+
+
+    // endregion functions
+}         // namespace ggmath::graphics
 #endif    // GG_MATH_GRAPHICS_HPP
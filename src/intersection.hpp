@@ -15,7 +15,1699 @@
 // OTHER DEALINGS IN THE SOFTWARE.
 #ifndef GG_MATH_INTERSECTION_HPP
 #define GG_MATH_INTERSECTION_HPP
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <utility>
+
+#include "packet.hpp"
+#include "ray.hpp"
+#include "types.hpp"
+#include "vec.hpp"
+
+
+namespace ggmath
+{
+    // region classes
+
+
+    /**
+     * @brief An axis-aligned bounding box from min to max
+     *
+     * T may be a simd::pack, then the box holds one box per lane and the
+     * intersection tests check all of them at once.
+     */
+    template <Scalar T>
+    struct aabb
+    {
+        vec<T, 3> min;
+        vec<T, 3> max;
+
+
+        // region constructors
+
+
+        // An empty box, which no ray hits
+        constexpr aabb() :
+            min(T(std::numeric_limits<lane_value_t<T>>::infinity())),
+            max(T(-std::numeric_limits<lane_value_t<T>>::infinity()))
+        {}
+
+
+        constexpr aabb(const vec<T, 3>& _min, const vec<T, 3>& _max) :
+            min(_min[0], _min[1], _min[2]), max(_max[0], _max[1], _max[2])
+        {}
+
+
+        // endregion constructors
+    };
+
+
+    /**
+     * @brief A triangle with the vertices a, b and c
+     *
+     * T may be a simd::pack, then the triangle holds one triangle per lane, with the
+     * coordinates of the vertices laid out as structure of arrays, and the
+     * intersection tests check all of them at once. The vertices are stored instead
+     * of edges, so triangles sharing an edge calculate it identically and the
+     * watertight test leaves no gaps between them.
+     */
+    template <Scalar T>
+    struct triangle
+    {
+        vec<T, 3> a;
+        vec<T, 3> b;
+        vec<T, 3> c;
+
+
+        // region constructors
+
+
+        constexpr triangle() = default;
+
+
+        constexpr triangle(const vec<T, 3>& _a,
+                           const vec<T, 3>& _b,
+                           const vec<T, 3>& _c) :
+            a(_a[0], _a[1], _a[2]), b(_b[0], _b[1], _b[2]), c(_c[0], _c[1], _c[2])
+        {}
+
+
+        // endregion constructors
+    };
+
+
+    /**
+     * @brief A ball around center
+     *
+     * T may be a simd::pack, then the sphere holds one sphere per lane.
+     */
+    template <Scalar T>
+    struct sphere
+    {
+        vec<T, 3> center;
+        T         radius = T(0);
+
+
+        // region constructors
+
+
+        constexpr sphere() = default;
+
+
+        constexpr sphere(const vec<T, 3>& _center, T _radius) :
+            center(_center[0], _center[1], _center[2]), radius(_radius)
+        {}
+
+
+        // endregion constructors
+    };
+
+
+    /**
+     * @brief The points p with dot(normal, p) == distance
+     *
+     * normal has to be normalized, distance is then the signed distance of the
+     * plane from the origin. T may be a simd::pack, then the plane holds one plane
+     * per lane.
+     */
+    template <Scalar T>
+    struct plane
+    {
+        vec<T, 3> normal;
+        T         distance = T(0);
+
+
+        // region constructors
+
+
+        constexpr plane() = default;
+
+
+        constexpr plane(const vec<T, 3>& _normal, T _distance) :
+            normal(_normal[0], _normal[1], _normal[2]), distance(_distance)
+        {}
+
+
+        // endregion constructors
+    };
+
+
+    /**
+     * @brief The points within radius of the segment from a to b
+     *
+     * T may be a simd::pack, then the capsule holds one capsule per lane.
+     */
+    template <Scalar T>
+    struct capsule
+    {
+        vec<T, 3> a;
+        vec<T, 3> b;
+        T         radius = T(0);
+
+
+        // region constructors
+
+
+        constexpr capsule() = default;
+
+
+        constexpr capsule(const vec<T, 3>& _a, const vec<T, 3>& _b, T _radius) :
+            a(_a[0], _a[1], _a[2]), b(_b[0], _b[1], _b[2]), radius(_radius)
+        {}
+
+
+        // endregion constructors
+    };
+
+
+    /**
+     * @brief An oriented bounding box around center
+     *
+     * The box extends half_extents[i] along both directions of axes[i], which have
+     * to be orthonormal. T may be a simd::pack, then the box holds one box per
+     * lane.
+     */
+    template <Scalar T>
+    struct obb
+    {
+        vec<T, 3>                center;
+        std::array<vec<T, 3>, 3> axes;
+        vec<T, 3>                half_extents;
+
+
+        // region constructors
+
+
+        constexpr obb() = default;
+
+
+        constexpr obb(const vec<T, 3>& _center,
+                      const vec<T, 3>& axis_x,
+                      const vec<T, 3>& axis_y,
+                      const vec<T, 3>& axis_z,
+                      const vec<T, 3>& _half_extents) :
+            center(_center[0], _center[1], _center[2]),
+            axes{vec<T, 3>(axis_x[0], axis_x[1], axis_x[2]),
+                 vec<T, 3>(axis_y[0], axis_y[1], axis_y[2]),
+                 vec<T, 3>(axis_z[0], axis_z[1], axis_z[2])},
+            half_extents(_half_extents[0], _half_extents[1], _half_extents[2])
+        {}
+
+
+        // endregion constructors
+    };
+
+
+    // endregion classes
+
+
+    // region using-directives
+
+
+    using aabbf = aabb<float>;
+    using aabbd = aabb<double>;
+
+    using aabbf_x4 = aabb<simd_float<4>>;
+    using aabbf_x8 = aabb<simd_float<8>>;
+    using aabbd_x4 = aabb<simd_double<4>>;
+
+    using trianglef = triangle<float>;
+    using triangled = triangle<double>;
+
+    using trianglef_x4 = triangle<simd_float<4>>;
+    using trianglef_x8 = triangle<simd_float<8>>;
+    using triangled_x4 = triangle<simd_double<4>>;
+
+
+    using spheref = sphere<float>;
+    using sphered = sphere<double>;
+
+    using spheref_x4 = sphere<simd_float<4>>;
+    using spheref_x8 = sphere<simd_float<8>>;
+    using sphered_x4 = sphere<simd_double<4>>;
+
+    using planef = plane<float>;
+    using planed = plane<double>;
+
+    using planef_x4 = plane<simd_float<4>>;
+    using planef_x8 = plane<simd_float<8>>;
+    using planed_x4 = plane<simd_double<4>>;
+
+    using capsulef = capsule<float>;
+    using capsuled = capsule<double>;
+
+    using capsulef_x4 = capsule<simd_float<4>>;
+    using capsulef_x8 = capsule<simd_float<8>>;
+    using capsuled_x4 = capsule<simd_double<4>>;
+
+    using obbf = obb<float>;
+    using obbd = obb<double>;
+
+    using obbf_x4 = obb<simd_float<4>>;
+    using obbf_x8 = obb<simd_float<8>>;
+    using obbd_x4 = obb<simd_double<4>>;
+
+    // endregion using-directives
+
+
+    // region operator_overloads
+
+
+    template <std::floating_point T>
+    std::ostream& operator<<(std::ostream& os, const aabb<T>& box)
+    {
+        return os << '[' << box.min << ',' << box.max << ']';
+    }
+
+
+    template <std::floating_point T>
+    std::ostream& operator<<(std::ostream& os, const triangle<T>& _triangle)
+    {
+        return os << '[' << _triangle.a << ',' << _triangle.b << ',' << _triangle.c
+                  << ']';
+    }
+
+
+    template <std::floating_point T>
+    std::ostream& operator<<(std::ostream& os, const sphere<T>& _sphere)
+    {
+        return os << '[' << _sphere.center << ',' << _sphere.radius << ']';
+    }
+
+
+    template <std::floating_point T>
+    std::ostream& operator<<(std::ostream& os, const plane<T>& _plane)
+    {
+        return os << '[' << _plane.normal << ',' << _plane.distance << ']';
+    }
+
+
+    template <std::floating_point T>
+    std::ostream& operator<<(std::ostream& os, const capsule<T>& _capsule)
+    {
+        return os << '[' << _capsule.a << ',' << _capsule.b << ',' << _capsule.radius
+                  << ']';
+    }
+
+
+    template <std::floating_point T>
+    std::ostream& operator<<(std::ostream& os, const obb<T>& box)
+    {
+        return os << '[' << box.center << ",[" << box.axes[0] << ',' << box.axes[1]
+                  << ',' << box.axes[2] << "]," << box.half_extents << ']';
+    }
+
+
+    // endregion operator_overloads
+}    // namespace ggmath
+
 
 namespace ggmath::intersections
-{}        // namespace ggmath::intersections
+{
+    // region classes
+
+
+    /**
+     * @brief The nearest hit of a ray on one or more triangles
+     *
+     * The point hit is a * (1 - u - v) + b * u + c * v of the triangle at index.
+     * Converts to false if no triangle was hit.
+     */
+    template <std::floating_point T>
+    struct triangle_hit
+    {
+        static constexpr auto no_triangle = std::numeric_limits<std::size_t>::max();
+
+        T           distance = std::numeric_limits<T>::infinity();
+        T           u        = 0;
+        T           v        = 0;
+        std::size_t index    = no_triangle;
+
+
+        constexpr explicit operator bool() const noexcept
+        {
+            return index != no_triangle;
+        }
+    };
+
+
+    // endregion classes
+
+
+    // region helpers
+
+
+    namespace detail
+    {
+        /**
+         * @brief Return the distances along _ray at which it enters and exits box,
+         * limited to [0, t_max]
+         *
+         * The ray misses box if it exits before it enters. The sign of the ray
+         * picks the near and far plane of every slab, so a box is tested without
+         * branches and R may be a packet of boxes. A ray parallel to a slab through
+         * its plane gives NaN, which the argument order of min and max drops, so
+         * the slab does not limit the distances. The exit distance is widened by a
+         * few ulps, so rounding does not make rays miss along the edges of a box
+         * (Ize, "Robust BVH Ray Traversal").
+         */
+        template <typename R, std::floating_point T>
+        constexpr std::pair<R, R>
+            slabs(const ray<T>& _ray, const aabb<R>& box, T t_max) noexcept
+        {
+            using std::max;
+            using std::min;
+
+            constexpr T rounding = std::numeric_limits<T>::epsilon() / 2;
+            constexpr T widening = 1 + 2 * (3 * rounding / (1 - 3 * rounding));
+
+            R t_enter = R(0);
+            R t_exit  = R(t_max);
+
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                const bool negative = _ray.sign[axis] != 0;
+                const R&   near     = negative ? box.max[axis] : box.min[axis];
+                const R&   far      = negative ? box.min[axis] : box.max[axis];
+
+                const T origin  = _ray.origin[axis];
+                const T inverse = _ray.inverse_direction[axis];
+
+                const R t_near = (near - origin) * inverse;
+                const R t_far  = (far - origin) * inverse;
+
+                // NaN as the second argument returns the first one
+                t_enter = max(t_enter, t_near);
+                t_exit  = min(t_exit, t_far * widening);
+            }
+
+            return {t_enter, t_exit};
+        }
+
+
+        /**
+         * @brief The distances and barycentric coordinates at which a ray hits one
+         * triangle or a packet of them, the distance is infinity for misses
+         */
+        template <typename R>
+        struct triangle_hits
+        {
+            R distance;
+            R u;
+            R v;
+        };
+
+
+        // The counterparts of the functions simd::pack and simd::mask provide
+        template <std::floating_point T>
+        constexpr T select(bool condition, T a, T b) noexcept
+        {
+            return condition ? a : b;
+        }
+
+
+        constexpr bool any(bool condition) noexcept
+        {
+            return condition;
+        }
+
+
+        template <std::floating_point T, int W>
+        constexpr bool any(const simd::mask<T, W>& condition) noexcept
+        {
+            return condition.any();
+        }
+
+
+        /**
+         * @brief Return a * b - c * d with the right sign
+         *
+         * Targets with FMA let the compiler contract the expression into an fma with
+         * only one of the products rounded, which can flip the sign, and differently
+         * so for swapped operands. Kahan's algorithm is used for them instead, which
+         * rounds only the result.
+         */
+        template <typename R>
+        inline R difference_of_products(const R& a,
+                                        const R& b,
+                                        const R& c,
+                                        const R& d) noexcept
+        {
+#if defined(__FMA__) || defined(__ARM_FEATURE_FMA)
+            using std::fma;
+
+            const R c_d   = c * d;
+            const R error = fma(-c, d, c_d);
+
+            return fma(a, b, -c_d) + error;
+#else
+            return a * b - c * d;
+#endif
+        }
+
+
+        /**
+         * @brief Return a * b - c * d calculated in double
+         *
+         * The products of floats are exact in double, so the sign of the result is
+         * right where float rounds it to zero.
+         */
+        template <typename R>
+        R difference_of_products_in_double(const R& a,
+                                           const R& b,
+                                           const R& c,
+                                           const R& d)
+        {
+            if constexpr (std::floating_point<R>)
+            {
+                const auto a_b = static_cast<double>(a) * static_cast<double>(b);
+                const auto c_d = static_cast<double>(c) * static_cast<double>(d);
+
+                return static_cast<R>(a_b - c_d);
+            }
+            else
+            {
+                using wide_type = simd::native_t<double, R::width>;
+
+                const auto a_b = __builtin_convertvector(a.lanes, wide_type)
+                                 * __builtin_convertvector(b.lanes, wide_type);
+                const auto c_d = __builtin_convertvector(c.lanes, wide_type)
+                                 * __builtin_convertvector(d.lanes, wide_type);
+
+                return R(__builtin_convertvector(a_b - c_d, typename R::native_type));
+            }
+        }
+
+
+        /**
+         * @brief Return where _ray hits _triangle at a distance in (0, t_max]
+         *
+         * Möller and Trumbore, "Fast, Minimum Storage Ray/Triangle Intersection".
+         * R may be a packet of triangles.
+         */
+        template <typename R, std::floating_point T>
+        constexpr triangle_hits<R> moller_trumbore(const ray<T>&      _ray,
+                                                   const triangle<R>& _triangle,
+                                                   T                  t_max) noexcept
+        {
+            const auto edge_1 = _triangle.b - _triangle.a;
+            const auto edge_2 = _triangle.c - _triangle.a;
+            const auto p      = vector::cross(_ray.direction, edge_2);
+            const auto s      = _ray.origin - _triangle.a;
+            const auto q      = vector::cross(s, edge_1);
+
+            // Infinite for rays parallel to the triangle, which fails the tests below
+            const R inverse_determinant = R(1) / vector::dot(edge_1, p);
+
+            const R u        = vector::dot(s, p) * inverse_determinant;
+            const R v        = vector::dot(_ray.direction, q) * inverse_determinant;
+            const R distance = vector::dot(edge_2, q) * inverse_determinant;
+
+            const auto hit = (u >= R(0)) & (v >= R(0)) & (u + v <= R(1))
+                             & (distance > R(0)) & (distance <= R(t_max));
+
+            return {select(hit, distance, R(std::numeric_limits<T>::infinity())), u, v};
+        }
+
+
+        /**
+         * @brief Return where _ray hits _triangle at a distance in (0, t_max],
+         * without gaps along shared edges
+         *
+         * Woop, Benthin and Wald, "Watertight Ray/Triangle Intersection". The
+         * vertices are sheared so the ray goes along z from the origin, then the
+         * edge functions in x and y decide the hit. Their signs are exact, since
+         * float results of zero are recalculated in double. R may be a packet of
+         * triangles.
+         */
+        template <typename R, std::floating_point T>
+        inline triangle_hits<R> watertight(const ray<T>&      _ray,
+                                           const triangle<R>& _triangle,
+                                           T                  t_max)
+        {
+            const auto& direction = _ray.direction;
+
+            // z is the axis the ray is the most parallel to, x and y are swapped if
+            // it goes along negative z to keep the winding of the triangle
+            const T abs_x = std::abs(direction[0]);
+            const T abs_y = std::abs(direction[1]);
+            const T abs_z = std::abs(direction[2]);
+
+            std::size_t z = 2;
+            if (abs_x > abs_y && abs_x > abs_z)
+            {
+                z = 0;
+            }
+            else if (abs_y > abs_z)
+            {
+                z = 1;
+            }
+            std::size_t x = (z + 1) % 3;
+            std::size_t y = (x + 1) % 3;
+            if (direction[z] < 0)
+            {
+                std::swap(x, y);
+            }
+
+            const T shear_x = direction[x] / direction[z];
+            const T shear_y = direction[y] / direction[z];
+            const T shear_z = 1 / direction[z];
+
+            const auto a = _triangle.a - _ray.origin;
+            const auto b = _triangle.b - _ray.origin;
+            const auto c = _triangle.c - _ray.origin;
+
+            const R a_x = a[x] - shear_x * a[z];
+            const R a_y = a[y] - shear_y * a[z];
+            const R b_x = b[x] - shear_x * b[z];
+            const R b_y = b[y] - shear_y * b[z];
+            const R c_x = c[x] - shear_x * c[z];
+            const R c_y = c[y] - shear_y * c[z];
+
+            // The weights of a, b and c, scaled by their sum
+            R u = difference_of_products(c_x, b_y, c_y, b_x);
+            R v = difference_of_products(a_x, c_y, a_y, c_x);
+            R w = difference_of_products(b_x, a_y, b_y, a_x);
+
+            if constexpr (std::same_as<T, float>)
+            {
+                if (any((u == R(0)) | (v == R(0)) | (w == R(0))))
+                {
+                    u = difference_of_products_in_double(c_x, b_y, c_y, b_x);
+                    v = difference_of_products_in_double(a_x, c_y, a_y, c_x);
+                    w = difference_of_products_in_double(b_x, a_y, b_y, a_x);
+                }
+            }
+
+            const auto same_signs = ((u >= R(0)) & (v >= R(0)) & (w >= R(0)))
+                                    | ((u <= R(0)) & (v <= R(0)) & (w <= R(0)));
+
+            const R determinant         = u + v + w;
+            const R inverse_determinant = R(1) / determinant;
+
+            const R distance = (u * (shear_z * a[z]) + v * (shear_z * b[z])
+                                + w * (shear_z * c[z]))
+                               * inverse_determinant;
+
+            const auto hit = same_signs & (determinant != R(0)) & (distance > R(0))
+                             & (distance <= R(t_max));
+
+            return {select(hit, distance, R(std::numeric_limits<T>::infinity())),
+                    v * inverse_determinant,
+                    w * inverse_determinant};
+        }
+
+
+        /**
+         * @brief Return the nearest of the hits, with the lane as index
+         */
+        template <std::floating_point T>
+        constexpr triangle_hit<T> nearest(const triangle_hits<T>& hits) noexcept
+        {
+            if (hits.distance == std::numeric_limits<T>::infinity())
+            {
+                return {};
+            }
+
+            return {hits.distance, hits.u, hits.v, 0};
+        }
+
+
+        template <std::floating_point T, int W>
+        constexpr triangle_hit<T>
+            nearest(const triangle_hits<simd::pack<T, W>>& hits) noexcept
+        {
+            const T distance = horizontal_min(hits.distance);
+
+            if (distance == std::numeric_limits<T>::infinity())
+            {
+                return {};
+            }
+
+            const int lane = std::countr_zero((hits.distance == distance).bits());
+
+            return {
+                distance, hits.u[lane], hits.v[lane], static_cast<std::size_t>(lane)};
+        }
+
+
+        /**
+         * @brief Return the nearest hit of _ray on triangles within t_max, tested
+         * with test
+         *
+         * The distance a test is limited to shrinks to the nearest hit so far.
+         */
+        template <std::floating_point T, typename R, typename T_Test>
+        triangle_hit<T> nearest(const ray<T>&                _ray,
+                                std::span<const triangle<R>> triangles,
+                                T                            t_max,
+                                T_Test                       test)
+        {
+            constexpr std::size_t lanes = sizeof(R) / sizeof(T);
+
+            auto nearest_hit = triangle_hit<T>();
+
+            for (std::size_t i = 0; i < triangles.size(); ++i)
+            {
+                const T    limit = std::min(t_max, nearest_hit.distance);
+                const auto hits  = test(_ray, triangles[i], limit);
+
+                if (any(hits.distance < R(nearest_hit.distance)))
+                {
+                    nearest_hit = nearest(hits);
+                    nearest_hit.index += i * lanes;
+                }
+            }
+
+            return nearest_hit;
+        }
+
+
+        // The result of comparing values of R, bool or a simd::mask
+        template <typename R>
+        using mask_t = decltype(std::declval<R>() <= std::declval<R>());
+
+
+        /**
+         * @brief Check which of the entry distances of a ray are hits, misses are
+         * infinite
+         */
+        template <typename R>
+        constexpr mask_t<R> hit(const R& entry) noexcept
+        {
+            return entry < R(std::numeric_limits<lane_value_t<R>>::infinity());
+        }
+
+
+        template <typename R>
+        constexpr R clamp(const R& value, const R& low, const R& high) noexcept
+        {
+            using std::max;
+            using std::min;
+
+            return min(max(value, low), high);
+        }
+
+
+        // region ray_shapes
+
+
+        /**
+         * @brief Return where _ray enters box in [0, t_max], infinity if it does not
+         */
+        template <typename R, std::floating_point T>
+        constexpr R entry(const ray<T>& _ray, const aabb<R>& box, T t_max) noexcept
+        {
+            const auto [t_enter, t_exit] = slabs(_ray, box, t_max);
+
+            return select(
+                t_enter <= t_exit, t_enter, R(std::numeric_limits<T>::infinity()));
+        }
+
+
+        /**
+         * @brief Return where _ray enters _sphere in [0, t_max], infinity if it does
+         * not
+         *
+         * The discriminant is calculated from the point of the ray nearest to the
+         * center and the nearer root from the farther one, which avoids the
+         * cancellation of the textbook formula for small or distant spheres (Haines
+         * et al., "Precision Improvements for Ray/Sphere Intersection").
+         */
+        template <typename R, std::floating_point T>
+        constexpr R entry(const ray<T>&    _ray,
+                          const sphere<R>& _sphere,
+                          T                t_max) noexcept
+        {
+            using std::max;
+            using std::min;
+            using std::sqrt;
+
+            const R radius_2 = _sphere.radius * _sphere.radius;
+
+            const auto f       = _ray.origin - _sphere.center;
+            const R    a       = R(vector::length_squared(_ray.direction));
+            const R    b       = -vector::dot(f, _ray.direction);
+            const R    c       = vector::length_squared(f) - radius_2;
+            const R    to_near = b / a;
+
+            R nearest_squared = R(0);
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                const R nearest = f[axis] + R(_ray.direction[axis]) * to_near;
+                nearest_squared += nearest * nearest;
+            }
+
+            // NaN for rays missing the sphere, which fails the tests below
+            const R root = sqrt(a * (radius_2 - nearest_squared));
+            const R q    = b + select(b >= R(0), root, -root);
+
+            const R t_0     = c / q;
+            const R t_1     = q / a;
+            const R t_enter = min(t_0, t_1);
+            const R t_exit  = max(t_0, t_1);
+
+            // Rays starting inside the sphere enter it at their origin
+            return select((t_exit >= R(0)) & (t_enter <= R(t_max)),
+                          max(t_enter, R(0)),
+                          R(std::numeric_limits<T>::infinity()));
+        }
+
+
+        /**
+         * @brief Return where _ray crosses _plane in [0, t_max], infinity if it does
+         * not
+         */
+        template <typename R, std::floating_point T>
+        constexpr R entry(const ray<T>& _ray, const plane<R>& _plane, T t_max) noexcept
+        {
+            constexpr T infinity = std::numeric_limits<T>::infinity();
+
+            // Rays parallel to the plane divide by zero, which is infinite or NaN
+            const R t = (_plane.distance - vector::dot(_plane.normal, _ray.origin))
+                        / vector::dot(_plane.normal, _ray.direction);
+
+            return select((t >= R(0)) & (t <= R(t_max)), t, R(infinity));
+        }
+
+
+        // endregion ray_shapes
+
+
+        // region segments
+
+
+        /**
+         * @brief Return the squared distance of point to the segment from a to b
+         */
+        template <typename R>
+        constexpr R segment_distance_squared(const vec<R, 3>& a,
+                                             const vec<R, 3>& b,
+                                             const vec<R, 3>& point) noexcept
+        {
+            const auto d        = b - a;
+            const R    length_2 = vector::length_squared(d);
+
+            const R t = clamp(vector::dot(point - a, d) / length_2, R(0), R(1));
+
+            // Segments that are points divide by zero
+            const auto difference = point - (a + d * select(length_2 > R(0), t, R(0)));
+
+            return vector::length_squared(difference);
+        }
+
+
+        /**
+         * @brief Return the squared distance between the segments from p_1 to q_1
+         * and from p_2 to q_2
+         *
+         * Ericson, "Real-Time Collision Detection" 5.1.9, with selects instead of
+         * branches so the segments may be packets. The nearest parameter on the
+         * first segment is found for the lines through them, the one on the second
+         * segment for it, and the one on the first once more for the clamped second
+         * one.
+         */
+        template <typename R>
+        constexpr R segment_distance_squared(const vec<R, 3>& p_1,
+                                             const vec<R, 3>& q_1,
+                                             const vec<R, 3>& p_2,
+                                             const vec<R, 3>& q_2) noexcept
+        {
+            const auto d_1 = q_1 - p_1;
+            const auto d_2 = q_2 - p_2;
+            const auto r   = p_1 - p_2;
+
+            const R a = vector::length_squared(d_1);
+            const R b = vector::dot(d_1, d_2);
+            const R c = vector::dot(d_1, r);
+            const R e = vector::length_squared(d_2);
+            const R f = vector::dot(d_2, r);
+
+            // Zero for parallel segments and for segments that are points, for which
+            // any parameter is as near as the others
+            const R denominator = a * e - b * b;
+
+            R s = select(denominator > R(0),
+                         clamp((b * f - c * e) / denominator, R(0), R(1)),
+                         R(0));
+            R t = select(e > R(0), clamp((b * s + f) / e, R(0), R(1)), R(0));
+            s   = select(a > R(0), clamp((b * t - c) / a, R(0), R(1)), R(0));
+
+            return vector::length_squared(r + d_1 * s - d_2 * t);
+        }
+
+
+        // endregion segments
+
+
+        // region overlaps
+
+
+        template <typename R>
+        constexpr mask_t<R> overlap(const sphere<R>& a, const sphere<R>& b) noexcept
+        {
+            const R radius = a.radius + b.radius;
+
+            return vector::length_squared(a.center - b.center) <= radius * radius;
+        }
+
+
+        /**
+         * @brief Check if _sphere overlaps box, by the squared distance of its center
+         * to the nearest point of the box (Arvo, "A Simple Method for Box-Sphere
+         * Intersection Testing")
+         */
+        template <typename R>
+        constexpr mask_t<R> overlap(const sphere<R>& _sphere,
+                                    const aabb<R>&   box) noexcept
+        {
+            R distance_squared = R(0);
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                const R center = _sphere.center[axis];
+                const R offset = center - clamp(center, box.min[axis], box.max[axis]);
+                distance_squared += offset * offset;
+            }
+
+            return distance_squared <= _sphere.radius * _sphere.radius;
+        }
+
+
+        template <typename R>
+        constexpr mask_t<R> overlap(const aabb<R>&   box,
+                                    const sphere<R>& _sphere) noexcept
+        {
+            return overlap(_sphere, box);
+        }
+
+
+        template <typename R>
+        constexpr mask_t<R> overlap(const aabb<R>& a, const aabb<R>& b) noexcept
+        {
+            mask_t<R> overlapping = (a.min[0] <= b.max[0]) & (b.min[0] <= a.max[0]);
+            for (std::size_t axis = 1; axis < 3; ++axis)
+            {
+                overlapping = overlapping & (a.min[axis] <= b.max[axis])
+                              & (b.min[axis] <= a.max[axis]);
+            }
+
+            return overlapping;
+        }
+
+
+        /**
+         * @brief Check if the boxes a and b overlap with the separating axis test
+         *
+         * Ericson, "Real-Time Collision Detection" 4.4.1. The boxes overlap unless
+         * their projections on one of the 3 face axes of a, the 3 of b or the 9 cross
+         * products of their edges are apart. Everything is expressed in the frame of
+         * a. The rotation gets an epsilon added, so cross products of near parallel
+         * edges, which are near zero, do not separate boxes falsely.
+         */
+        template <typename R>
+        mask_t<R> overlap(const obb<R>& a, const obb<R>& b) noexcept
+        {
+            using std::abs;
+
+            constexpr auto epsilon =
+                16 * std::numeric_limits<lane_value_t<R>>::epsilon();
+
+            std::array<std::array<R, 3>, 3> rotation;
+            std::array<std::array<R, 3>, 3> abs_rotation;
+            std::array<R, 3>                translation;
+
+            const auto offset = b.center - a.center;
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    rotation[i][j]     = vector::dot(a.axes[i], b.axes[j]);
+                    abs_rotation[i][j] = abs(rotation[i][j]) + R(epsilon);
+                }
+                translation[i] = vector::dot(offset, a.axes[i]);
+            }
+
+            // Each axis has the sum of the radii of the projections, NaN lanes fail
+            mask_t<R> overlapping = R(0) == R(0);
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                const R radius_b = b.half_extents[0] * abs_rotation[i][0]
+                                   + b.half_extents[1] * abs_rotation[i][1]
+                                   + b.half_extents[2] * abs_rotation[i][2];
+                overlapping = overlapping
+                              & (abs(translation[i]) <= a.half_extents[i] + radius_b);
+            }
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                const R radius_a = a.half_extents[0] * abs_rotation[0][j]
+                                   + a.half_extents[1] * abs_rotation[1][j]
+                                   + a.half_extents[2] * abs_rotation[2][j];
+                const R distance = translation[0] * rotation[0][j]
+                                   + translation[1] * rotation[1][j]
+                                   + translation[2] * rotation[2][j];
+                overlapping = overlapping
+                              & (abs(distance) <= radius_a + b.half_extents[j]);
+            }
+
+            // Most pairs of a broad phase are apart, usually on a face axis
+            if (!any(overlapping))
+            {
+                return overlapping;
+            }
+
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                const std::size_t i_1 = (i + 1) % 3;
+                const std::size_t i_2 = (i + 2) % 3;
+
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    const std::size_t j_1 = (j + 1) % 3;
+                    const std::size_t j_2 = (j + 2) % 3;
+
+                    const R radius_a = a.half_extents[i_1] * abs_rotation[i_2][j]
+                                       + a.half_extents[i_2] * abs_rotation[i_1][j];
+                    const R radius_b = b.half_extents[j_1] * abs_rotation[i][j_2]
+                                       + b.half_extents[j_2] * abs_rotation[i][j_1];
+                    const R distance = translation[i_2] * rotation[i_1][j]
+                                       - translation[i_1] * rotation[i_2][j];
+                    overlapping = overlapping & (abs(distance) <= radius_a + radius_b);
+                }
+            }
+
+            return overlapping;
+        }
+
+
+        template <typename R>
+        constexpr mask_t<R> overlap(const capsule<R>& _capsule,
+                                    const sphere<R>&  _sphere) noexcept
+        {
+            const R radius = _capsule.radius + _sphere.radius;
+
+            return segment_distance_squared(_capsule.a, _capsule.b, _sphere.center)
+                   <= radius * radius;
+        }
+
+
+        template <typename R>
+        constexpr mask_t<R> overlap(const sphere<R>&  _sphere,
+                                    const capsule<R>& _capsule) noexcept
+        {
+            return overlap(_capsule, _sphere);
+        }
+
+
+        template <typename R>
+        constexpr mask_t<R> overlap(const capsule<R>& a, const capsule<R>& b) noexcept
+        {
+            const R radius = a.radius + b.radius;
+
+            return segment_distance_squared(a.a, a.b, b.a, b.b) <= radius * radius;
+        }
+
+
+        // endregion overlaps
+
+
+        // region broadcasts
+
+
+        /**
+         * @brief Return query with every value converted to R, which copies a scalar
+         * query into every lane of a packet
+         */
+        template <typename R, std::floating_point T>
+        constexpr vec<R, 3> broadcast(const vec<T, 3>& query) noexcept
+        {
+            return {R(query[0]), R(query[1]), R(query[2])};
+        }
+
+
+        template <typename R, std::floating_point T>
+        constexpr aabb<R> broadcast(const aabb<T>& query) noexcept
+        {
+            return {broadcast<R>(query.min), broadcast<R>(query.max)};
+        }
+
+
+        template <typename R, std::floating_point T>
+        constexpr sphere<R> broadcast(const sphere<T>& query) noexcept
+        {
+            return {broadcast<R>(query.center), R(query.radius)};
+        }
+
+
+        template <typename R, std::floating_point T>
+        constexpr capsule<R> broadcast(const capsule<T>& query) noexcept
+        {
+            return {broadcast<R>(query.a), broadcast<R>(query.b), R(query.radius)};
+        }
+
+
+        template <typename R, std::floating_point T>
+        constexpr obb<R> broadcast(const obb<T>& query) noexcept
+        {
+            return {broadcast<R>(query.center),
+                    broadcast<R>(query.axes[0]),
+                    broadcast<R>(query.axes[1]),
+                    broadcast<R>(query.axes[2]),
+                    broadcast<R>(query.half_extents)};
+        }
+
+
+        // endregion broadcasts
+
+
+        // region batches
+
+
+        /**
+         * @brief Return a bit set with bit i set if lane i of condition is true
+         */
+        constexpr std::uint64_t lane_bits(bool condition) noexcept
+        {
+            return condition ? 1 : 0;
+        }
+
+
+        template <std::floating_point T, int W>
+        constexpr std::uint64_t lane_bits(const simd::mask<T, W>& condition) noexcept
+        {
+            return condition.bits();
+        }
+
+
+        /**
+         * @brief Set bit i of mask if test is true for candidate i and clear it
+         * otherwise, counting the lanes of packets as separate candidates
+         */
+        template <template <typename> typename Shape, typename R, typename T_Test>
+        void test_mask(std::span<const Shape<R>> candidates,
+                       std::span<std::uint64_t>  mask,
+                       T_Test                    test)
+        {
+            constexpr std::size_t lanes = sizeof(R) / sizeof(lane_value_t<R>);
+
+            const std::size_t words = (candidates.size() * lanes + 63) / 64;
+            debug::throw_if_too_small(mask.size(), words);
+
+            std::fill_n(mask.begin(), words, std::uint64_t(0));
+
+            for (std::size_t i = 0; i < candidates.size(); ++i)
+            {
+                const std::size_t first = i * lanes;
+                mask[first / 64] |= lane_bits(test(candidates[i])) << (first % 64);
+            }
+        }
+
+
+        /**
+         * @brief Write the indices of the candidates test is true for to hits and
+         * return their number, counting the lanes of packets as separate candidates
+         */
+        template <template <typename> typename Shape, typename R, typename T_Test>
+        std::size_t test_indices(std::span<const Shape<R>> candidates,
+                                 std::span<std::uint32_t>  hits,
+                                 T_Test                    test)
+        {
+            constexpr std::size_t lanes = sizeof(R) / sizeof(lane_value_t<R>);
+
+            debug::throw_if_too_small(hits.size(), candidates.size() * lanes);
+
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < candidates.size(); ++i)
+            {
+                auto bits = lane_bits(test(candidates[i]));
+
+                for (; bits != 0; bits &= bits - 1)
+                {
+                    const auto lane = static_cast<std::size_t>(std::countr_zero(bits));
+                    hits[count++]   = static_cast<std::uint32_t>(i * lanes + lane);
+                }
+            }
+
+            return count;
+        }
+
+
+        // endregion batches
+    }    // namespace detail
+
+
+    // endregion helpers
+
+
+    // region ray_aabb
+
+
+    /**
+     * @brief Check if _ray hits box at a distance of at most t_max
+     */
+    template <std::floating_point T>
+    constexpr bool intersects(const ray<T>&  _ray,
+                              const aabb<T>& box,
+                              T t_max = std::numeric_limits<T>::infinity()) noexcept
+    {
+        const auto [t_enter, t_exit] = detail::slabs(_ray, box, t_max);
+
+        return t_enter <= t_exit;
+    }
+
+
+    /**
+     * @brief Check which of the W boxes of boxes _ray hits at a distance of at most
+     * t_max
+     */
+    template <std::floating_point T, int W>
+    constexpr simd::mask<T, W>
+        intersects(const ray<T>&                 _ray,
+                   const aabb<simd::pack<T, W>>& boxes,
+                   T t_max = std::numeric_limits<T>::infinity()) noexcept
+    {
+        const auto [t_enter, t_exit] = detail::slabs(_ray, boxes, t_max);
+
+        return t_enter <= t_exit;
+    }
+
+
+    /**
+     * @brief Return the distance along _ray at which it enters box, or infinity if
+     * it misses box or enters it after t_max
+     *
+     * The distance is 0 if the origin of the ray is inside box.
+     */
+    template <std::floating_point T>
+    constexpr T entry_distance(const ray<T>&  _ray,
+                               const aabb<T>& box,
+                               T t_max = std::numeric_limits<T>::infinity()) noexcept
+    {
+        const auto [t_enter, t_exit] = detail::slabs(_ray, box, t_max);
+
+        return t_enter <= t_exit ? t_enter : std::numeric_limits<T>::infinity();
+    }
+
+
+    /**
+     * @brief Return the distances along _ray at which it enters the W boxes of
+     * boxes, infinity for the ones it misses or enters after t_max
+     *
+     * Traversals can visit the boxes that were hit nearest first.
+     */
+    template <std::floating_point T, int W>
+    constexpr simd::pack<T, W>
+        entry_distance(const ray<T>&                 _ray,
+                       const aabb<simd::pack<T, W>>& boxes,
+                       T t_max = std::numeric_limits<T>::infinity()) noexcept
+    {
+        const auto [t_enter, t_exit] = detail::slabs(_ray, boxes, t_max);
+
+        return select(t_enter <= t_exit,
+                      t_enter,
+                      simd::pack<T, W>(std::numeric_limits<T>::infinity()));
+    }
+
+
+    // endregion ray_aabb
+
+
+    // region ray_triangle
+
+
+    /**
+     * @brief Return where _ray hits _triangle at a distance in (0, t_max]
+     *
+     * The Möller–Trumbore test, which hits both sides of a triangle. For packets of
+     * triangles the nearest hit of all lanes is returned, with the lane as index.
+     * Rounding may let a ray through an edge miss both triangles sharing it, use
+     * watertight() where that matters.
+     */
+    template <std::floating_point T, Scalar R>
+    requires std::same_as<lane_value_t<R>, T>
+    constexpr triangle_hit<T>
+        moller_trumbore(const ray<T>&      _ray,
+                        const triangle<R>& _triangle,
+                        T t_max = std::numeric_limits<T>::infinity()) noexcept
+    {
+        return detail::nearest(detail::moller_trumbore(_ray, _triangle, t_max));
+    }
+
+
+    /**
+     * @brief Return the nearest hit of _ray on triangles at a distance in (0, t_max]
+     * with the Möller–Trumbore test
+     *
+     * The index of the hit counts the triangles of all packets before it.
+     */
+    template <std::floating_point T, Scalar R>
+    requires std::same_as<lane_value_t<R>, T>
+    triangle_hit<T> moller_trumbore(const ray<T>&                _ray,
+                                    std::span<const triangle<R>> triangles,
+                                    T t_max = std::numeric_limits<T>::infinity())
+    {
+        const auto test =
+            [](const ray<T>& tested, const triangle<R>& _triangle, T limit) {
+                return detail::moller_trumbore(tested, _triangle, limit);
+            };
+
+        return detail::nearest(_ray, triangles, t_max, test);
+    }
+
+
+    /**
+     * @brief Return where _ray hits _triangle at a distance in (0, t_max], without
+     * gaps between triangles sharing an edge
+     *
+     * Rays through a shared edge or vertex hit at least one of the triangles. Both
+     * sides of a triangle are hit. For packets of triangles the nearest hit of all
+     * lanes is returned, with the lane as index.
+     */
+    template <std::floating_point T, Scalar R>
+    requires std::same_as<lane_value_t<R>, T>
+    triangle_hit<T> watertight(const ray<T>&      _ray,
+                               const triangle<R>& _triangle,
+                               T t_max = std::numeric_limits<T>::infinity())
+    {
+        return detail::nearest(detail::watertight(_ray, _triangle, t_max));
+    }
+
+
+    /**
+     * @brief Return the nearest hit of _ray on triangles at a distance in (0, t_max]
+     * with the watertight test
+     *
+     * The index of the hit counts the triangles of all packets before it.
+     */
+    template <std::floating_point T, Scalar R>
+    requires std::same_as<lane_value_t<R>, T>
+    triangle_hit<T> watertight(const ray<T>&                _ray,
+                               std::span<const triangle<R>> triangles,
+                               T t_max = std::numeric_limits<T>::infinity())
+    {
+        const auto test =
+            [](const ray<T>& tested, const triangle<R>& _triangle, T limit) {
+                return detail::watertight(tested, _triangle, limit);
+            };
+
+        return detail::nearest(_ray, triangles, t_max, test);
+    }
+
+
+    // endregion ray_triangle
+
+
+    // region ray_shapes
+
+
+    /**
+     * @brief Check if _ray hits _sphere at a distance of at most t_max
+     *
+     * Rays starting inside the sphere hit it. For packets of spheres there is one
+     * bool per lane.
+     */
+    template <std::floating_point T, Scalar R>
+    requires std::same_as<lane_value_t<R>, T>
+    constexpr detail::mask_t<R>
+        intersects(const ray<T>&    _ray,
+                   const sphere<R>& _sphere,
+                   T t_max = std::numeric_limits<T>::infinity()) noexcept
+    {
+        return detail::hit(detail::entry(_ray, _sphere, t_max));
+    }
+
+
+    /**
+     * @brief Return the distance along _ray at which it enters _sphere, or infinity
+     * if it misses _sphere or enters it after t_max
+     *
+     * The distance is 0 if the origin of the ray is inside _sphere.
+     */
+    template <std::floating_point T, Scalar R>
+    requires std::same_as<lane_value_t<R>, T>
+    constexpr R entry_distance(const ray<T>&    _ray,
+                               const sphere<R>& _sphere,
+                               T t_max = std::numeric_limits<T>::infinity()) noexcept
+    {
+        return detail::entry(_ray, _sphere, t_max);
+    }
+
+
+    /**
+     * @brief Check if _ray crosses _plane at a distance of at most t_max
+     *
+     * Both sides of the plane are hit, rays parallel to it miss it. For packets of
+     * planes there is one bool per lane.
+     */
+    template <std::floating_point T, Scalar R>
+    requires std::same_as<lane_value_t<R>, T>
+    constexpr detail::mask_t<R>
+        intersects(const ray<T>&   _ray,
+                   const plane<R>& _plane,
+                   T t_max = std::numeric_limits<T>::infinity()) noexcept
+    {
+        return detail::hit(detail::entry(_ray, _plane, t_max));
+    }
+
+
+    /**
+     * @brief Return the distance along _ray at which it crosses _plane, or infinity
+     * if it does not cross it up to t_max
+     */
+    template <std::floating_point T, Scalar R>
+    requires std::same_as<lane_value_t<R>, T>
+    constexpr R entry_distance(const ray<T>&   _ray,
+                               const plane<R>& _plane,
+                               T t_max = std::numeric_limits<T>::infinity()) noexcept
+    {
+        return detail::entry(_ray, _plane, t_max);
+    }
+
+
+    // endregion ray_shapes
+
+
+    // region overlaps
+
+
+    /**
+     * @brief Check if the shapes query and candidate overlap, touching counts
+     *
+     * Tests spheres against spheres, boxes and capsules, boxes against boxes,
+     * capsules against capsules and oriented boxes against oriented boxes, in
+     * either order. candidate may be a packet, then there is one bool per lane.
+     */
+    template <template <typename> typename Query,
+              template <typename>
+              typename Candidate,
+              std::floating_point T,
+              Scalar              R>
+    requires std::same_as<lane_value_t<R>, T>
+             && requires(const Query<R>& query, const Candidate<R>& candidate) {
+                    detail::overlap(query, candidate);
+                }
+    constexpr detail::mask_t<R> overlaps(const Query<T>&     query,
+                                         const Candidate<R>& candidate) noexcept
+    {
+        return detail::overlap(detail::broadcast<R>(query), candidate);
+    }
+
+
+    // endregion overlaps
+
+
+    // region batches
+
+
+    /**
+     * @brief Set bit i % 64 of mask[i / 64] if query overlaps candidate i and clear
+     * it otherwise
+     *
+     * The lanes of packets count as separate candidates, so lane l of packet p is
+     * candidate p * W + l. mask has to hold a bit for every candidate, otherwise an
+     * invalid_argument exception is thrown. Testing all candidates in one call keeps
+     * the query in registers and lets the compiler unroll the loop, which a broad
+     * phase calling overlaps() per pair cannot.
+     */
+    template <template <typename> typename Query,
+              template <typename>
+              typename Candidate,
+              std::floating_point T,
+              Scalar              R>
+    requires std::same_as<lane_value_t<R>, T>
+             && requires(const Query<R>& query, const Candidate<R>& candidate) {
+                    detail::overlap(query, candidate);
+                }
+    void overlap_mask(const Query<T>&                query,
+                      std::span<const Candidate<R>>  candidates,
+                      std::span<std::uint64_t>       mask)
+    {
+        const auto broadcast_query = detail::broadcast<R>(query);
+
+        detail::test_mask(candidates, mask, [&](const Candidate<R>& candidate) {
+            return detail::overlap(broadcast_query, candidate);
+        });
+    }
+
+
+    /**
+     * @brief Write the indices of the candidates query overlaps to hits in
+     * ascending order and return their number
+     *
+     * The lanes of packets count as separate candidates, as for overlap_mask().
+     * hits has to hold an index for every candidate, otherwise an invalid_argument
+     * exception is thrown.
+     */
+    template <template <typename> typename Query,
+              template <typename>
+              typename Candidate,
+              std::floating_point T,
+              Scalar              R>
+    requires std::same_as<lane_value_t<R>, T>
+             && requires(const Query<R>& query, const Candidate<R>& candidate) {
+                    detail::overlap(query, candidate);
+                }
+    std::size_t overlapping(const Query<T>&               query,
+                            std::span<const Candidate<R>> candidates,
+                            std::span<std::uint32_t>      hits)
+    {
+        const auto broadcast_query = detail::broadcast<R>(query);
+
+        return detail::test_indices(
+            candidates, hits, [&](const Candidate<R>& candidate) {
+                return detail::overlap(broadcast_query, candidate);
+            });
+    }
+
+
+    /**
+     * @brief Set bit i % 64 of mask[i / 64] if _ray hits candidate i at a distance
+     * of at most t_max and clear it otherwise
+     *
+     * The candidates may be boxes, spheres or planes. The lanes of packets count as
+     * separate candidates, as for overlap_mask().
+     */
+    template <template <typename> typename Candidate, std::floating_point T, Scalar R>
+    requires std::same_as<lane_value_t<R>, T>
+             && requires(const ray<T>& _ray, const Candidate<R>& candidate) {
+                    detail::entry(_ray, candidate, T(0));
+                }
+    void intersection_mask(const ray<T>&                 _ray,
+                           std::span<const Candidate<R>> candidates,
+                           std::span<std::uint64_t>      mask,
+                           T t_max = std::numeric_limits<T>::infinity())
+    {
+        detail::test_mask(candidates, mask, [&](const Candidate<R>& candidate) {
+            return detail::hit(detail::entry(_ray, candidate, t_max));
+        });
+    }
+
+
+    /**
+     * @brief Write the indices of the candidates _ray hits at a distance of at
+     * most t_max to hits in ascending order and return their number
+     *
+     * The candidates may be boxes, spheres or planes. The lanes of packets count as
+     * separate candidates, as for overlap_mask().
+     */
+    template <template <typename> typename Candidate, std::floating_point T, Scalar R>
+    requires std::same_as<lane_value_t<R>, T>
+             && requires(const ray<T>& _ray, const Candidate<R>& candidate) {
+                    detail::entry(_ray, candidate, T(0));
+                }
+    std::size_t intersecting(const ray<T>&                 _ray,
+                             std::span<const Candidate<R>> candidates,
+                             std::span<std::uint32_t>      hits,
+                             T t_max = std::numeric_limits<T>::infinity())
+    {
+        return detail::test_indices(
+            candidates, hits, [&](const Candidate<R>& candidate) {
+                return detail::hit(detail::entry(_ray, candidate, t_max));
+            });
+    }
+
+
+    // endregion batches
+}    // namespace ggmath::intersections
+
+
+namespace ggmath::packet
+{
+    /**
+     * @brief Load up to W boxes into the lanes of a packet of boxes
+     *
+     * Lanes without a box hold an empty box, which no ray hits.
+     */
+    template <int W, std::floating_point T>
+    aabb<simd::pack<T, W>> load(std::span<const aabb<T>> boxes)
+    {
+        auto packet = aabb<simd::pack<T, W>>();
+        auto count  = std::min<std::size_t>(W, boxes.size());
+
+        for (std::size_t lane = 0; lane < count; ++lane)
+        {
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                packet.min[axis].lanes[lane] = boxes[lane].min[axis];
+                packet.max[axis].lanes[lane] = boxes[lane].max[axis];
+            }
+        }
+
+        return packet;
+    }
+
+
+    /**
+     * @brief Load up to W triangles into the lanes of a packet of triangles
+     *
+     * Lanes without a triangle hold NaN vertices, which no ray hits.
+     */
+    template <int W, std::floating_point T>
+    triangle<simd::pack<T, W>> load(std::span<const triangle<T>> triangles)
+    {
+        constexpr T nan = std::numeric_limits<T>::quiet_NaN();
+
+        auto packet = triangle<simd::pack<T, W>>();
+
+        for (std::size_t lane = 0; lane < W; ++lane)
+        {
+            const bool loaded = lane < triangles.size();
+
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                packet.a[axis].lanes[lane] = loaded ? triangles[lane].a[axis] : nan;
+                packet.b[axis].lanes[lane] = loaded ? triangles[lane].b[axis] : nan;
+                packet.c[axis].lanes[lane] = loaded ? triangles[lane].c[axis] : nan;
+            }
+        }
+
+        return packet;
+    }
+
+    /**
+     * @brief Load up to W spheres into the lanes of a packet of spheres
+     *
+     * Lanes without a sphere hold NaN, which nothing hits or overlaps.
+     */
+    template <int W, std::floating_point T>
+    sphere<simd::pack<T, W>> load(std::span<const sphere<T>> spheres)
+    {
+        constexpr T nan = std::numeric_limits<T>::quiet_NaN();
+
+        auto packet = sphere<simd::pack<T, W>>();
+
+        for (std::size_t lane = 0; lane < W; ++lane)
+        {
+            const bool loaded = lane < spheres.size();
+
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                packet.center[axis].lanes[lane] =
+                    loaded ? spheres[lane].center[axis] : nan;
+            }
+            packet.radius.lanes[lane] = loaded ? spheres[lane].radius : nan;
+        }
+
+        return packet;
+    }
+
+
+    /**
+     * @brief Load up to W planes into the lanes of a packet of planes
+     *
+     * Lanes without a plane hold NaN, which no ray hits.
+     */
+    template <int W, std::floating_point T>
+    plane<simd::pack<T, W>> load(std::span<const plane<T>> planes)
+    {
+        constexpr T nan = std::numeric_limits<T>::quiet_NaN();
+
+        auto packet = plane<simd::pack<T, W>>();
+
+        for (std::size_t lane = 0; lane < W; ++lane)
+        {
+            const bool loaded = lane < planes.size();
+
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                packet.normal[axis].lanes[lane] =
+                    loaded ? planes[lane].normal[axis] : nan;
+            }
+            packet.distance.lanes[lane] = loaded ? planes[lane].distance : nan;
+        }
+
+        return packet;
+    }
+
+
+    /**
+     * @brief Load up to W capsules into the lanes of a packet of capsules
+     *
+     * Lanes without a capsule hold NaN, which nothing overlaps.
+     */
+    template <int W, std::floating_point T>
+    capsule<simd::pack<T, W>> load(std::span<const capsule<T>> capsules)
+    {
+        constexpr T nan = std::numeric_limits<T>::quiet_NaN();
+
+        auto packet = capsule<simd::pack<T, W>>();
+
+        for (std::size_t lane = 0; lane < W; ++lane)
+        {
+            const bool loaded = lane < capsules.size();
+
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                packet.a[axis].lanes[lane] = loaded ? capsules[lane].a[axis] : nan;
+                packet.b[axis].lanes[lane] = loaded ? capsules[lane].b[axis] : nan;
+            }
+            packet.radius.lanes[lane] = loaded ? capsules[lane].radius : nan;
+        }
+
+        return packet;
+    }
+
+
+    /**
+     * @brief Load up to W oriented boxes into the lanes of a packet of oriented
+     * boxes
+     *
+     * Lanes without a box hold NaN, which nothing overlaps.
+     */
+    template <int W, std::floating_point T>
+    obb<simd::pack<T, W>> load(std::span<const obb<T>> boxes)
+    {
+        constexpr T nan = std::numeric_limits<T>::quiet_NaN();
+
+        auto packet = obb<simd::pack<T, W>>();
+
+        for (std::size_t lane = 0; lane < W; ++lane)
+        {
+            const bool loaded = lane < boxes.size();
+
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                packet.center[axis].lanes[lane] =
+                    loaded ? boxes[lane].center[axis] : nan;
+                packet.half_extents[axis].lanes[lane] =
+                    loaded ? boxes[lane].half_extents[axis] : nan;
+
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    packet.axes[i][axis].lanes[lane] =
+                        loaded ? boxes[lane].axes[i][axis] : nan;
+                }
+            }
+        }
+
+        return packet;
+    }
+}    // namespace ggmath::packet
 #endif    // GG_MATH_INTERSECTION_HPP
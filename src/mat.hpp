@@ -13,51 +13,941 @@
 // CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
 // OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
 // OTHER DEALINGS IN THE SOFTWARE.
-#ifndef MATH_LIB_MAT_HPP
-#define MATH_LIB_MAT_HPP
+#ifndef GG_MATH_MAT_HPP
+#define GG_MATH_MAT_HPP
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-template <typename T, int n, int m>
-struct mat
+#include "simd.hpp"
+#include "types.hpp"
+#include "vec.hpp"
+
+
+// region forward_declarations
+
+
+namespace ggmath
+{
+    template <Scalar T, int n, int m>
+    struct mat;
+}    // namespace ggmath
+
+
+namespace ggmath::debug
 {
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
-    T data[n][m];
-    // region constructors
-    constexpr explicit mat(T values);
-    constexpr mat();
-    // endregion constructors
-    // region static methods
-    // endregion static methods
-    // region operator overloads
-    // endregion operator overloads
-    // region methods
-    // endregion methods
-};
-
-template <typename T>
-struct mat<T, 3, 3>
+    template <ggmath::Scalar T>
+    void throw_if_singular(T determinant);
+
+    template <ggmath::Scalar T, int n>
+    void throw_if_not_affine(const ggmath::mat<T, n, n>& _mat);
+}    // namespace ggmath::debug
+
+
+// endregion forward_declarations
+
+
+namespace ggmath
 {
-    // region constructors
-    // endregion constructors
-    // region static methods
-    // endregion static methods
-    // region operator overloads
-    // endregion operator overloads
-    // region methods
-    // endregion methods
-};
-template <typename T>
-struct mat<T, 4, 4>
+    // region classes
+
+
+    /**
+     * @brief A matrix of n rows and m columns, stored row-major
+     *
+     * Vectors are column vectors, so a matrix transforms a vector by `_mat * _vec`
+     * and `a * b` applies b first. 4x4 floating point matrices are aligned to 64
+     * bytes, their size is a multiple of it, so they never straddle cache lines.
+     */
+    template <Scalar T, int n, int m>
+    struct alignas(n == 4 && m == 4 && std::is_floating_point_v<T> ? 64 : alignof(T))
+        mat
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+        T data[n][m];
+
+
+        // region constructors
+
+
+        constexpr mat() : data{} {}
+
+
+        constexpr explicit mat(T values)
+        {
+            for (auto& row : data)
+            {
+                std::ranges::fill(row, values);
+            }
+        }
+
+
+        // Values are given row by row, missing values are 0
+        constexpr mat(std::initializer_list<T> values) : data{}
+        {
+            std::size_t i = 0;
+
+            for (auto it = values.begin(); it != values.end() && i < n * m; ++it, ++i)
+            {
+                data[i / m][i % m] = *it;
+            }
+        }
+
+
+        template <Scalar T_In>
+        constexpr explicit mat(const mat<T_In, n, m>& other)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                std::ranges::copy(other[i], std::begin(data[i]));
+            }
+        }
+
+
+        // endregion constructors
+
+
+        // region static methods
+
+
+        static constexpr mat zero() noexcept
+        {
+            return mat();
+        }
+
+
+        static constexpr mat identity() noexcept
+        requires(n == m)
+        {
+            auto _mat = mat();
+
+            for (int i = 0; i < n; ++i)
+            {
+                _mat.data[i][i] = 1;
+            }
+
+            return _mat;
+        }
+
+
+        // endregion static methods
+
+
+        // region operator overloads
+
+
+        // Row i, so _mat[i][j] is the element in row i and column j
+        constexpr auto& operator[](std::size_t i) noexcept
+        {
+            return data[i];
+        }
+
+
+        constexpr const auto& operator[](std::size_t i) const noexcept
+        {
+            return data[i];
+        }
+
+
+        // endregion operator overloads
+
+
+        // region methods
+
+
+        constexpr vec<T, m> row(std::size_t i) const
+        {
+            auto _vec = vec<T, m>(uninitialized);
+            std::ranges::copy(data[i], std::begin(_vec));
+            return _vec;
+        }
+
+
+        constexpr vec<T, n> column(std::size_t j) const
+        {
+            auto _vec = vec<T, n>(uninitialized);
+
+            for (int i = 0; i < n; ++i)
+            {
+                _vec[i] = data[i][j];
+            }
+
+            return _vec;
+        }
+
+
+        // endregion methods
+    };
+
+
+    // endregion classes
+
+
+    // region using-directives
+
+
+    using mat22f = mat<float, 2, 2>;
+    using mat33f = mat<float, 3, 3>;
+    using mat44f = mat<float, 4, 4>;
+
+    using mat22d = mat<double, 2, 2>;
+    using mat33d = mat<double, 3, 3>;
+    using mat44d = mat<double, 4, 4>;
+
+
+    // endregion using-directives
+
+
+    // region operator_overloads
+
+
+    // region operator_overloads::binary::matrix-matrix
+
+
+    template <Scalar T_A,
+              Scalar T_B,
+              Scalar T_Out = decltype(std::declval<T_A>() + std::declval<T_B>()),
+              int    n,
+              int    m>
+    constexpr mat<T_Out, n, m> operator+(const mat<T_A, n, m>& a,
+                                         const mat<T_B, n, m>& b)
+    {
+        auto mat_out = mat<T_Out, n, m>();
+
+        for (int i = 0; i < n; ++i)
+        {
+            std::ranges::transform(a[i], b[i], std::begin(mat_out[i]), std::plus<>());
+        }
+
+        return mat_out;
+    }
+
+
+    template <Scalar T_A,
+              Scalar T_B,
+              Scalar T_Out = decltype(std::declval<T_A>() - std::declval<T_B>()),
+              int    n,
+              int    m>
+    constexpr mat<T_Out, n, m> operator-(const mat<T_A, n, m>& a,
+                                         const mat<T_B, n, m>& b)
+    {
+        auto mat_out = mat<T_Out, n, m>();
+
+        for (int i = 0; i < n; ++i)
+        {
+            std::ranges::transform(a[i], b[i], std::begin(mat_out[i]), std::minus<>());
+        }
+
+        return mat_out;
+    }
+
+
+    // Matrix product, applies b first
+    template <Scalar T_A,
+              Scalar T_B,
+              Scalar T_Out = decltype(std::declval<T_A>() * std::declval<T_B>()),
+              int    n,
+              int    m,
+              int    p>
+    constexpr mat<T_Out, n, p> operator*(const mat<T_A, n, m>& a,
+                                         const mat<T_B, m, p>& b)
+    {
+        auto mat_out = mat<T_Out, n, p>();
+
+        if constexpr (simd::dispatched<T_A, T_B, T_Out, 4> && n == 4 && m == 4
+                      && p == 4)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::multiply4x4(&a[0][0], &b[0][0], &mat_out[0][0]);
+                return mat_out;
+            }
+        }
+
+        // i-k-j order walks rows of b and out, which vectorizes
+        for (int i = 0; i < n; ++i)
+        {
+            for (int k = 0; k < m; ++k)
+            {
+                for (int j = 0; j < p; ++j)
+                {
+                    mat_out[i][j] += a[i][k] * b[k][j];
+                }
+            }
+        }
+
+        return mat_out;
+    }
+
+
+    // endregion operator_overloads::binary::matrix-matrix
+
+
+    // region operator_overloads::binary::matrix-vector
+
+
+    // Transform a column vector
+    template <Scalar T_Mat,
+              Scalar T_Vec,
+              Scalar T_Out = decltype(std::declval<T_Mat>() * std::declval<T_Vec>()),
+              int    n,
+              int    m>
+    constexpr vec<T_Out, n> operator*(const mat<T_Mat, n, m>& _mat,
+                                      const vec<T_Vec, m>&    _vec)
+    {
+        auto vec_out = vec<T_Out, n>();
+
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = 0; j < m; ++j)
+            {
+                vec_out[i] += _mat[i][j] * _vec[j];
+            }
+        }
+
+        return vec_out;
+    }
+
+
+    // Transform a row vector, the same as transposed(_mat) * _vec
+    template <Scalar T_Vec,
+              Scalar T_Mat,
+              Scalar T_Out = decltype(std::declval<T_Vec>() * std::declval<T_Mat>()),
+              int    n,
+              int    m>
+    constexpr vec<T_Out, m> operator*(const vec<T_Vec, n>&    _vec,
+                                      const mat<T_Mat, n, m>& _mat)
+    {
+        auto vec_out = vec<T_Out, m>();
+
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = 0; j < m; ++j)
+            {
+                vec_out[j] += _vec[i] * _mat[i][j];
+            }
+        }
+
+        return vec_out;
+    }
+
+
+    // endregion operator_overloads::binary::matrix-vector
+
+
+    // region operator_overloads::binary::scalar-matrix
+
+
+    template <Scalar T_Mat,
+              Scalar T_Scalar,
+              Scalar T_Out = decltype(std::declval<T_Mat>() * std::declval<T_Scalar>()),
+              int    n,
+              int    m>
+    constexpr mat<T_Out, n, m> operator*(const mat<T_Mat, n, m>& _mat, T_Scalar scalar)
+    {
+        auto mat_out = mat<T_Out, n, m>();
+
+        for (int i = 0; i < n; ++i)
+        {
+            std::ranges::transform(
+                _mat[i], std::begin(mat_out[i]), [scalar](T_Mat element) {
+                    return element * scalar;
+                });
+        }
+
+        return mat_out;
+    }
+
+
+    template <Scalar T_Scalar,
+              Scalar T_Mat,
+              Scalar T_Out = decltype(std::declval<T_Scalar>() * std::declval<T_Mat>()),
+              int    n,
+              int    m>
+    constexpr mat<T_Out, n, m> operator*(T_Scalar scalar, const mat<T_Mat, n, m>& _mat)
+    {
+        return _mat * scalar;
+    }
+
+
+    template <Scalar T_Mat,
+              Scalar T_Scalar,
+              Scalar T_Out = decltype(std::declval<T_Mat>() / std::declval<T_Scalar>()),
+              int    n,
+              int    m>
+    constexpr mat<T_Out, n, m> operator/(const mat<T_Mat, n, m>& _mat, T_Scalar scalar)
+    {
+        auto mat_out = mat<T_Out, n, m>();
+
+        for (int i = 0; i < n; ++i)
+        {
+            std::ranges::transform(
+                _mat[i], std::begin(mat_out[i]), [scalar](T_Mat element) {
+                    return element / scalar;
+                });
+        }
+
+        return mat_out;
+    }
+
+
+    // endregion operator_overloads::binary::scalar-matrix
+
+
+    // region operator_overloads::assignment
+
+
+    template <Scalar T_A, Scalar T_B, int n, int m>
+    constexpr mat<T_A, n, m>& operator+=(mat<T_A, n, m>& a, const mat<T_B, n, m>& b)
+    {
+        a = mat<T_A, n, m>(a + b);
+        return a;
+    }
+
+
+    template <Scalar T_A, Scalar T_B, int n, int m>
+    constexpr mat<T_A, n, m>& operator-=(mat<T_A, n, m>& a, const mat<T_B, n, m>& b)
+    {
+        a = mat<T_A, n, m>(a - b);
+        return a;
+    }
+
+
+    // a = a * b, so b is applied before the previous transformation of a
+    template <Scalar T_A, Scalar T_B, int n>
+    constexpr mat<T_A, n, n>& operator*=(mat<T_A, n, n>& a, const mat<T_B, n, n>& b)
+    {
+        a = mat<T_A, n, n>(a * b);
+        return a;
+    }
+
+
+    template <Scalar T_Mat, Scalar T_Scalar, int n, int m>
+    constexpr mat<T_Mat, n, m>& operator*=(mat<T_Mat, n, m>& _mat, T_Scalar scalar)
+    {
+        _mat = mat<T_Mat, n, m>(_mat * scalar);
+        return _mat;
+    }
+
+
+    template <Scalar T_Mat, Scalar T_Scalar, int n, int m>
+    constexpr mat<T_Mat, n, m>& operator/=(mat<T_Mat, n, m>& _mat, T_Scalar scalar)
+    {
+        _mat = mat<T_Mat, n, m>(_mat / scalar);
+        return _mat;
+    }
+
+
+    // endregion operator_overloads::assignment
+
+
+    // region operator_overloads::comparison
+
+
+    // Compare element-wise equality
+    template <Scalar T_A, Scalar T_B, int n, int m>
+    requires std::equality_comparable_with<T_A, T_B>
+    constexpr bool operator==(const mat<T_A, n, m>& a, const mat<T_B, n, m>& b)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            if (!std::ranges::equal(a[i], b[i]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    // Compare element-wise equality
+    template <Scalar T_A, Scalar T_B, int n, int m>
+    requires std::equality_comparable_with<T_A, T_B>
+    constexpr bool operator!=(const mat<T_A, n, m>& a, const mat<T_B, n, m>& b)
+    {
+        return !(a == b);
+    }
+
+
+    // endregion operator_overloads::comparison
+
+
+    // region operator_overloads::other
+
+
+    // Prints the rows like vectors, e.g. ((1,0),(0,1))
+    template <Scalar T, int n, int m>
+    std::ostream& operator<<(std::ostream& os, const mat<T, n, m>& _mat)
+    {
+        os << '(';
+
+        for (int i = 0; i < n; ++i)
+        {
+            os << (i == 0 ? "" : ",") << _mat.row(i);
+        }
+
+        os << ')';
+
+        return os;
+    }
+
+
+    // endregion operator_overloads::other
+
+
+    // endregion operator_overloads
+
+
+    namespace matrix
+    {
+        // region detail
+
+
+        namespace detail
+        {
+            template <typename T>
+            constexpr T magnitude(T x) noexcept
+            {
+                return x < 0 ? -x : x;
+            }
+
+
+            /**
+             * @brief Calculate the determinant by Gaussian elimination with partial
+             * pivoting
+             */
+            template <Scalar T, int n>
+            constexpr float_or_double<T> eliminated_determinant(const mat<T, n, n>& a)
+            {
+                using F = float_or_double<T>;
+
+                auto lu          = mat<F, n, n>();
+                F    determinant = 1;
+
+                for (int i = 0; i < n; ++i)
+                {
+                    std::ranges::copy(a[i], std::begin(lu[i]));
+                }
+
+                for (int k = 0; k < n; ++k)
+                {
+                    int pivot = k;
+
+                    for (int i = k + 1; i < n; ++i)
+                    {
+                        if (magnitude(lu[i][k]) > magnitude(lu[pivot][k]))
+                        {
+                            pivot = i;
+                        }
+                    }
+
+                    if (lu[pivot][k] == 0)
+                    {
+                        return 0;
+                    }
+
+                    if (pivot != k)
+                    {
+                        std::swap(lu[pivot], lu[k]);
+                        determinant = -determinant;
+                    }
+
+                    determinant *= lu[k][k];
+
+                    for (int i = k + 1; i < n; ++i)
+                    {
+                        const F factor = lu[i][k] / lu[k][k];
+
+                        for (int j = k + 1; j < n; ++j)
+                        {
+                            lu[i][j] -= factor * lu[k][j];
+                        }
+                    }
+                }
+
+                return determinant;
+            }
+
+
+            /**
+             * @brief Invert a by Gauss-Jordan elimination with partial pivoting
+             */
+            template <Scalar T, int n>
+            constexpr mat<float_or_double<T>, n, n> eliminated_inverse(
+                const mat<T, n, n>& a)
+            {
+                using F = float_or_double<T>;
+
+                auto left  = mat<F, n, n>();
+                auto right = mat<F, n, n>::identity();
+
+                for (int i = 0; i < n; ++i)
+                {
+                    std::ranges::copy(a[i], std::begin(left[i]));
+                }
+
+                for (int k = 0; k < n; ++k)
+                {
+                    int pivot = k;
+
+                    for (int i = k + 1; i < n; ++i)
+                    {
+                        if (magnitude(left[i][k]) > magnitude(left[pivot][k]))
+                        {
+                            pivot = i;
+                        }
+                    }
+
+                    std::swap(left[pivot], left[k]);
+                    std::swap(right[pivot], right[k]);
+
+                    const F reciprocal = 1 / left[k][k];
+
+                    for (int j = 0; j < n; ++j)
+                    {
+                        left[k][j] *= reciprocal;
+                        right[k][j] *= reciprocal;
+                    }
+
+                    for (int i = 0; i < n; ++i)
+                    {
+                        const F factor = left[i][k];
+
+                        if (i == k || factor == 0)
+                        {
+                            continue;
+                        }
+
+                        for (int j = 0; j < n; ++j)
+                        {
+                            left[i][j] -= factor * left[k][j];
+                            right[i][j] -= factor * right[k][j];
+                        }
+                    }
+                }
+
+                return right;
+            }
+
+
+            /**
+             * @brief Invert a 4x4 matrix by its 2x2 sub-determinants
+             */
+            template <Scalar T>
+            constexpr mat<float_or_double<T>, 4, 4> cofactor_inverse(
+                const mat<T, 4, 4>& a)
+            {
+                using F = float_or_double<T>;
+
+                // 2x2 determinants of the upper two rows
+                const F s0 = F(a[0][0]) * a[1][1] - F(a[1][0]) * a[0][1];
+                const F s1 = F(a[0][0]) * a[1][2] - F(a[1][0]) * a[0][2];
+                const F s2 = F(a[0][0]) * a[1][3] - F(a[1][0]) * a[0][3];
+                const F s3 = F(a[0][1]) * a[1][2] - F(a[1][1]) * a[0][2];
+                const F s4 = F(a[0][1]) * a[1][3] - F(a[1][1]) * a[0][3];
+                const F s5 = F(a[0][2]) * a[1][3] - F(a[1][2]) * a[0][3];
+
+                // 2x2 determinants of the lower two rows
+                const F c5 = F(a[2][2]) * a[3][3] - F(a[3][2]) * a[2][3];
+                const F c4 = F(a[2][1]) * a[3][3] - F(a[3][1]) * a[2][3];
+                const F c3 = F(a[2][1]) * a[3][2] - F(a[3][1]) * a[2][2];
+                const F c2 = F(a[2][0]) * a[3][3] - F(a[3][0]) * a[2][3];
+                const F c1 = F(a[2][0]) * a[3][2] - F(a[3][0]) * a[2][2];
+                const F c0 = F(a[2][0]) * a[3][1] - F(a[3][0]) * a[2][1];
+
+                const F reciprocal =
+                    1 / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+                return mat<F, 4, 4>{
+                    (a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3) * reciprocal,
+                    (-a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3) * reciprocal,
+                    (a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3) * reciprocal,
+                    (-a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3) * reciprocal,
+
+                    (-a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1) * reciprocal,
+                    (a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1) * reciprocal,
+                    (-a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1) * reciprocal,
+                    (a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1) * reciprocal,
+
+                    (a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0) * reciprocal,
+                    (-a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0) * reciprocal,
+                    (a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0) * reciprocal,
+                    (-a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0) * reciprocal,
+
+                    (-a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0) * reciprocal,
+                    (a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0) * reciprocal,
+                    (-a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0) * reciprocal,
+                    (a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0) * reciprocal};
+            }
+        }    // namespace detail
+
+
+        // endregion detail
+
+
+        // region functions
+
+
+        template <Scalar T, int n, int m>
+        constexpr mat<T, m, n> transposed(const mat<T, n, m>& _mat) noexcept
+        {
+            auto mat_out = mat<T, m, n>();
+
+            for (int i = 0; i < n; ++i)
+            {
+                for (int j = 0; j < m; ++j)
+                {
+                    mat_out[j][i] = _mat[i][j];
+                }
+            }
+
+            return mat_out;
+        }
+
+
+        /**
+         * @brief Calculate the determinant of a square matrix
+         *
+         * Matrices up to 4x4 use closed forms, larger ones Gaussian elimination,
+         * whose result is rounded for integral T.
+         */
+        template <Scalar T, int n>
+        constexpr T determinant(const mat<T, n, n>& _mat) noexcept
+        {
+            const auto& a = _mat;
+
+            if constexpr (n == 1)
+            {
+                return a[0][0];
+            }
+            else if constexpr (n == 2)
+            {
+                return a[0][0] * a[1][1] - a[0][1] * a[1][0];
+            }
+            else if constexpr (n == 3)
+            {
+                return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1])
+                     - a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0])
+                     + a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+            }
+            else if constexpr (n == 4)
+            {
+                const T s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+                const T s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+                const T s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+                const T s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+                const T s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+                const T s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+
+                const T c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+                const T c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+                const T c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+                const T c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+                const T c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+                const T c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+
+                return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            }
+            else
+            {
+                const auto determinant = detail::eliminated_determinant(a);
+
+                if constexpr (std::is_integral_v<T>)
+                {
+                    return static_cast<T>(determinant < 0 ? determinant - 0.5
+                                                          : determinant + 0.5);
+                }
+                else
+                {
+                    return static_cast<T>(determinant);
+                }
+            }
+        }
+
+
+        /**
+         * @brief Return the inverse of a square matrix
+         *
+         * If GGMATH_DEBUG is 1, throws if _mat is singular, otherwise the result
+         * contains infinities or NaNs then. 4x4 float matrices are inverted with SSE
+         * if GGMATH_SIMD is 1 and the target lacks AVX-512.
+         */
+        template <Scalar T, int n>
+        constexpr mat<float_or_double<T>, n, n> inverse(const mat<T, n, n>& _mat)
+            noexcept(!debug::enabled)
+        {
+            using F = float_or_double<T>;
+
+            if constexpr (debug::enabled)
+            {
+                debug::throw_if_singular(determinant(_mat));
+            }
+
+            const auto& a = _mat;
+
+            if constexpr (n == 1)
+            {
+                return mat<F, 1, 1>{1 / F(a[0][0])};
+            }
+            else if constexpr (n == 2)
+            {
+                const F reciprocal = 1 / F(determinant(a));
+
+                return mat<F, 2, 2>{a[1][1] * reciprocal,
+                                    -a[0][1] * reciprocal,
+                                    -a[1][0] * reciprocal,
+                                    a[0][0] * reciprocal};
+            }
+            else if constexpr (n == 3)
+            {
+                const F reciprocal = 1 / F(determinant(a));
+
+                // Transposed cofactors
+                return mat<F, 3, 3>{
+                    (a[1][1] * a[2][2] - a[1][2] * a[2][1]) * reciprocal,
+                    (a[0][2] * a[2][1] - a[0][1] * a[2][2]) * reciprocal,
+                    (a[0][1] * a[1][2] - a[0][2] * a[1][1]) * reciprocal,
+
+                    (a[1][2] * a[2][0] - a[1][0] * a[2][2]) * reciprocal,
+                    (a[0][0] * a[2][2] - a[0][2] * a[2][0]) * reciprocal,
+                    (a[0][2] * a[1][0] - a[0][0] * a[1][2]) * reciprocal,
+
+                    (a[1][0] * a[2][1] - a[1][1] * a[2][0]) * reciprocal,
+                    (a[0][1] * a[2][0] - a[0][0] * a[2][1]) * reciprocal,
+                    (a[0][0] * a[1][1] - a[0][1] * a[1][0]) * reciprocal};
+            }
+            else if constexpr (n == 4)
+            {
+                // With AVX-512, compilers vectorize the cofactors below over the whole
+                // matrix, which beats the 4 lane kernel
+#if GGMATH_SIMD_SSE && !defined(__AVX512F__)
+                if constexpr (simd::accelerated<T, 4> && std::same_as<T, float>)
+                {
+                    if (!std::is_constant_evaluated())
+                    {
+                        auto mat_out = mat<F, 4, 4>();
+                        simd::inverse4x4(&a[0][0], &mat_out[0][0]);
+                        return mat_out;
+                    }
+                }
+#endif
+
+                return detail::cofactor_inverse(a);
+            }
+            else
+            {
+                return detail::eliminated_inverse(a);
+            }
+        }
+
+
+        /**
+         * @brief Check if the last row of _mat is (0, ..., 0, 1)
+         */
+        template <Scalar T, int n>
+        constexpr bool is_affine(const mat<T, n, n>& _mat) noexcept
+        {
+            for (int j = 0; j < n - 1; ++j)
+            {
+                if (_mat[n - 1][j] != 0)
+                {
+                    return false;
+                }
+            }
+
+            return _mat[n - 1][n - 1] == 1;
+        }
+
+
+        /**
+         * @brief Return the inverse of an affine transformation
+         *
+         * Only inverts the upper left (n - 1)x(n - 1) block and transforms the
+         * negated translation in the last column by it. If GGMATH_DEBUG is 1, throws
+         * if _mat is not affine or its linear part is singular.
+         */
+        template <Scalar T, int n>
+        requires(n >= 2)
+        constexpr mat<float_or_double<T>, n, n> inverse_affine(const mat<T, n, n>& _mat)
+            noexcept(!debug::enabled)
+        {
+            using F = float_or_double<T>;
+
+            if constexpr (debug::enabled)
+            {
+                debug::throw_if_not_affine(_mat);
+            }
+
+            auto linear = mat<T, n - 1, n - 1>();
+
+            for (int i = 0; i < n - 1; ++i)
+            {
+                std::copy_n(std::begin(_mat[i]), n - 1, std::begin(linear[i]));
+            }
+
+            const auto inverse_linear = inverse(linear);
+            auto       mat_out        = mat<F, n, n>::identity();
+
+            for (int i = 0; i < n - 1; ++i)
+            {
+                for (int j = 0; j < n - 1; ++j)
+                {
+                    mat_out[i][j] = inverse_linear[i][j];
+                    mat_out[i][n - 1] -= inverse_linear[i][j] * _mat[j][n - 1];
+                }
+            }
+
+            return mat_out;
+        }
+
+
+        // endregion functions
+    }    // namespace matrix
+}    // namespace ggmath
+
+
+namespace ggmath::debug
 {
-    // region constructors
-    // endregion constructors
-    // region static methods
-    // endregion static methods
-    // region operator overloads
-    // endregion operator overloads
-    // region methods
-    // endregion methods
-};
-
-using mat33f = mat<float, 3, 3>;
-using mat44f = mat<float, 4, 4>;
-#endif    // MATH_LIB_MAT_HPP
+    /**
+     * @brief Throw an invalid_argument exception if a matrix with the given
+     * determinant is not invertible
+     */
+    template <ggmath::Scalar T>
+    void throw_if_singular(T determinant)
+    {
+        if (determinant == 0)
+        {
+            throw std::invalid_argument(
+                "Parameter was expected to be an invertible matrix. "
+                "Instead, it had a determinant of 0");
+        }
+    }
+
+
+    /**
+     * @brief Throw an invalid_argument exception if the last row of _mat is not
+     * (0, ..., 0, 1)
+     */
+    template <ggmath::Scalar T, int n>
+    void throw_if_not_affine(const ggmath::mat<T, n, n>& _mat)
+    {
+        if (!ggmath::matrix::is_affine(_mat))
+        {
+            std::stringstream ss;
+
+            ss << "Parameter was expected to be an affine transformation "
+                  "(A matrix with a last row of (0, ..., 0, 1)). "
+                  "Instead, its last row was "
+               << _mat.row(n - 1);
+
+            throw std::invalid_argument(ss.str());
+        }
+    }
+}    // namespace ggmath::debug
+#endif    // GG_MATH_MAT_HPP
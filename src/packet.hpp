@@ -0,0 +1,843 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#ifndef GG_MATH_PACKET_HPP
+#define GG_MATH_PACKET_HPP
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <span>
+#include <type_traits>
+
+#include "types.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+// Packets wider than the registers of the target are passed in memory, which GCC
+// reports as an ABI change. Everything here is inline, so there is no ABI to keep.
+#if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+
+// Packets hold W values of T, one per lane, and their operators work lane-wise, so
+// vec<simd::pack<float, 8>, 3> holds 8 vec3f and runs the algorithms of vec.hpp on
+// all of them at once. They are built on the vector extensions of GCC and clang,
+// which lower them to the widest registers the target has.
+namespace ggmath::simd
+{
+    // region register types
+
+
+    /**
+     * @brief The vector extension type holding W values of T
+     */
+    template <typename T, int W>
+    struct native
+    {
+        // NOLINTNEXTLINE(modernize-use-using)
+        typedef T type __attribute__((vector_size(W * sizeof(T))));
+    };
+
+
+    template <typename T, int W>
+    using native_t = typename native<T, W>::type;
+
+
+    /**
+     * @brief The result of comparing two packets, one bool per lane
+     */
+    template <std::floating_point T, int W>
+    struct mask
+    {
+        // All bits of a lane are set if it is true
+        using native_type =
+            decltype(std::declval<native_t<T, W>>() < std::declval<native_t<T, W>>());
+
+        native_type lanes;
+
+
+        constexpr bool operator[](int i) const noexcept
+        {
+            return lanes[i] != 0;
+        }
+
+
+        /**
+         * @brief Return a bit set with bit i set if lane i is true
+         *
+         * One movemask instruction if the mask fits into a register of the
+         * instruction set the compiler targets, which keeps loops branching on
+         * masks vectorized.
+         */
+        constexpr std::uint32_t bits() const noexcept
+        {
+            constexpr bool is_float = std::same_as<T, float>;
+            constexpr auto size     = sizeof(native_type);
+
+            if (!std::is_constant_evaluated())
+            {
+#if GGMATH_SIMD_SSE
+                if constexpr (size == 16)
+                {
+                    return static_cast<std::uint32_t>(
+                        is_float ? _mm_movemask_ps(__m128(lanes))
+                                 : _mm_movemask_pd(__m128d(lanes)));
+                }
+#endif
+#if GGMATH_SIMD_AVX
+                if constexpr (size == 32)
+                {
+                    return static_cast<std::uint32_t>(
+                        is_float ? _mm256_movemask_ps(__m256(lanes))
+                                 : _mm256_movemask_pd(__m256d(lanes)));
+                }
+#endif
+            }
+
+            std::uint32_t result = 0;
+
+            for (int i = 0; i < W; ++i)
+            {
+                result |= static_cast<std::uint32_t>(lanes[i] != 0) << i;
+            }
+
+            return result;
+        }
+
+
+        constexpr bool any() const noexcept
+        {
+            return bits() != 0;
+        }
+
+
+        constexpr bool all() const noexcept
+        {
+            return bits() == (std::uint64_t(1) << W) - 1;
+        }
+
+
+        constexpr bool none() const noexcept
+        {
+            return bits() == 0;
+        }
+
+
+        friend constexpr mask operator&(const mask& a, const mask& b) noexcept
+        {
+            return {a.lanes & b.lanes};
+        }
+
+
+        friend constexpr mask operator|(const mask& a, const mask& b) noexcept
+        {
+            return {a.lanes | b.lanes};
+        }
+
+
+        friend constexpr mask operator^(const mask& a, const mask& b) noexcept
+        {
+            return {a.lanes ^ b.lanes};
+        }
+
+
+        friend constexpr mask operator~(const mask& a) noexcept
+        {
+            return {~a.lanes};
+        }
+    };
+
+
+    /**
+     * @brief The square root of every lane, with one instruction if the packet fits
+     * into a register of the instruction set the compiler targets
+     *
+     * Wider packets are split in halves, the remaining ones are calculated lane by
+     * lane. A loop over std::sqrt does not vectorize, since it may set errno.
+     */
+    template <std::floating_point T, int W>
+    inline native_t<T, W> sqrt_lanes(const native_t<T, W>& lanes) noexcept
+    {
+        constexpr bool is_float = std::same_as<T, float>;
+        constexpr auto size     = sizeof(native_t<T, W>);
+
+#if GGMATH_SIMD_SSE
+        if constexpr (size == 16)
+        {
+            return is_float ? native_t<T, W>(_mm_sqrt_ps(__m128(lanes)))
+                            : native_t<T, W>(_mm_sqrt_pd(__m128d(lanes)));
+        }
+#endif
+#if GGMATH_SIMD_AVX
+        if constexpr (size == 32)
+        {
+            return is_float ? native_t<T, W>(_mm256_sqrt_ps(__m256(lanes)))
+                            : native_t<T, W>(_mm256_sqrt_pd(__m256d(lanes)));
+        }
+#endif
+#if defined(__AVX512F__)
+        if constexpr (size == 64)
+        {
+            return is_float ? native_t<T, W>(_mm512_sqrt_ps(__m512(lanes)))
+                            : native_t<T, W>(_mm512_sqrt_pd(__m512d(lanes)));
+        }
+#endif
+
+        auto result = lanes;
+
+        if constexpr (GGMATH_SIMD_SSE && W % 2 == 0 && size > 16)
+        {
+            native_t<T, W / 2> halves[2];    // NOLINT(*-avoid-c-arrays)
+            std::memcpy(&halves, &lanes, size);
+            halves[0] = sqrt_lanes<T, W / 2>(halves[0]);
+            halves[1] = sqrt_lanes<T, W / 2>(halves[1]);
+            std::memcpy(&result, &halves, size);
+        }
+        else
+        {
+            for (int i = 0; i < W; ++i)
+            {
+                result[i] = std::sqrt(lanes[i]);
+            }
+        }
+
+        return result;
+    }
+
+
+    /**
+     * @brief Transpose the 4x4 matrix with the rows a, b, c and d in place
+     *
+     * Turns 4 consecutive 4 component values, like quaternions, into one packet per
+     * component and back.
+     */
+    template <std::floating_point T>
+    inline void transpose4(native_t<T, 4>& a,
+                           native_t<T, 4>& b,
+                           native_t<T, 4>& c,
+                           native_t<T, 4>& d) noexcept
+    {
+        const auto ab_low  = __builtin_shufflevector(a, b, 0, 4, 1, 5);
+        const auto ab_high = __builtin_shufflevector(a, b, 2, 6, 3, 7);
+        const auto cd_low  = __builtin_shufflevector(c, d, 0, 4, 1, 5);
+        const auto cd_high = __builtin_shufflevector(c, d, 2, 6, 3, 7);
+
+        a = __builtin_shufflevector(ab_low, cd_low, 0, 1, 4, 5);
+        b = __builtin_shufflevector(ab_low, cd_low, 2, 3, 6, 7);
+        c = __builtin_shufflevector(ab_high, cd_high, 0, 1, 4, 5);
+        d = __builtin_shufflevector(ab_high, cd_high, 2, 3, 6, 7);
+    }
+
+
+    /**
+     * @brief W values of T whose operators work lane-wise
+     *
+     * Scalars convert to packets implicitly by broadcasting them to all lanes.
+     * Comparisons return a mask instead of a bool.
+     */
+    template <std::floating_point T, int W>
+    struct pack
+    {
+        using value_type  = T;
+        using native_type = native_t<T, W>;
+        using mask_type   = mask<T, W>;
+
+        static constexpr int width = W;
+
+        native_type lanes;
+
+
+        // region constructors
+
+
+        // Trivial, so packets can be members of the union in vec
+        pack() = default;
+
+
+        // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+        constexpr pack(T scalar) noexcept : lanes(native_type{} + scalar) {}
+
+
+        constexpr explicit pack(const native_type& _lanes) noexcept : lanes(_lanes) {}
+
+
+        // endregion constructors
+
+
+        /**
+         * @brief Load W values starting at data into the lanes of a packet
+         */
+        static pack load(const T* data) noexcept
+        {
+            auto result = pack();
+            std::memcpy(&result.lanes, data, sizeof(native_type));
+            return result;
+        }
+
+
+        /**
+         * @brief Store the lanes of the packet to W values starting at data
+         */
+        void store(T* data) const noexcept
+        {
+            std::memcpy(data, &lanes, sizeof(native_type));
+        }
+
+
+        constexpr T operator[](int i) const noexcept
+        {
+            return lanes[i];
+        }
+
+
+        // region arithmetic
+
+
+        friend constexpr pack operator+(const pack& a, const pack& b) noexcept
+        {
+            return pack(a.lanes + b.lanes);
+        }
+
+
+        friend constexpr pack operator-(const pack& a, const pack& b) noexcept
+        {
+            return pack(a.lanes - b.lanes);
+        }
+
+
+        friend constexpr pack operator*(const pack& a, const pack& b) noexcept
+        {
+            return pack(a.lanes * b.lanes);
+        }
+
+
+        friend constexpr pack operator/(const pack& a, const pack& b) noexcept
+        {
+            return pack(a.lanes / b.lanes);
+        }
+
+
+        friend constexpr pack operator-(const pack& a) noexcept
+        {
+            return pack(-a.lanes);
+        }
+
+
+        friend constexpr pack operator+(const pack& a) noexcept
+        {
+            return a;
+        }
+
+
+        constexpr pack& operator+=(const pack& other) noexcept
+        {
+            lanes += other.lanes;
+            return *this;
+        }
+
+
+        constexpr pack& operator-=(const pack& other) noexcept
+        {
+            lanes -= other.lanes;
+            return *this;
+        }
+
+
+        constexpr pack& operator*=(const pack& other) noexcept
+        {
+            lanes *= other.lanes;
+            return *this;
+        }
+
+
+        constexpr pack& operator/=(const pack& other) noexcept
+        {
+            lanes /= other.lanes;
+            return *this;
+        }
+
+
+        // endregion arithmetic
+
+
+        // region comparison
+
+
+        friend constexpr mask_type operator==(const pack& a, const pack& b) noexcept
+        {
+            return {a.lanes == b.lanes};
+        }
+
+
+        friend constexpr mask_type operator!=(const pack& a, const pack& b) noexcept
+        {
+            return {a.lanes != b.lanes};
+        }
+
+
+        friend constexpr mask_type operator<(const pack& a, const pack& b) noexcept
+        {
+            return {a.lanes < b.lanes};
+        }
+
+
+        friend constexpr mask_type operator>(const pack& a, const pack& b) noexcept
+        {
+            return {a.lanes > b.lanes};
+        }
+
+
+        friend constexpr mask_type operator<=(const pack& a, const pack& b) noexcept
+        {
+            return {a.lanes <= b.lanes};
+        }
+
+
+        friend constexpr mask_type operator>=(const pack& a, const pack& b) noexcept
+        {
+            return {a.lanes >= b.lanes};
+        }
+
+
+        // endregion comparison
+
+
+        // region functions
+
+
+        /**
+         * @brief Return the lanes of a where m is true and the lanes of b elsewhere
+         */
+        friend constexpr pack select(const mask_type& m, const pack& a, const pack& b)
+            noexcept
+        {
+            return pack(m.lanes ? a.lanes : b.lanes);
+        }
+
+
+        // Same as std::min, b is only returned if it is less than a
+        friend constexpr pack min(const pack& a, const pack& b) noexcept
+        {
+            return pack(b.lanes < a.lanes ? b.lanes : a.lanes);
+        }
+
+
+        // Same as std::max, b is only returned if a is less than it
+        friend constexpr pack max(const pack& a, const pack& b) noexcept
+        {
+            return pack(a.lanes < b.lanes ? b.lanes : a.lanes);
+        }
+
+
+        friend constexpr pack abs(const pack& a) noexcept
+        {
+            return pack(a.lanes < 0 ? -a.lanes : a.lanes);
+        }
+
+
+        friend pack sqrt(const pack& a) noexcept
+        {
+            return pack(sqrt_lanes<T, W>(a.lanes));
+        }
+
+
+        /**
+         * @brief Return a * b + c rounded once, with one instruction per register if
+         * the target has FMA
+         */
+        friend pack fma(const pack& a, const pack& b, const pack& c) noexcept
+        {
+            auto result = pack();
+
+            for (int i = 0; i < W; ++i)
+            {
+                result.lanes[i] = std::fma(a.lanes[i], b.lanes[i], c.lanes[i]);
+            }
+
+            return result;
+        }
+
+
+        /**
+         * @brief Sum up the lanes of a
+         */
+        friend constexpr T horizontal_sum(const pack& a) noexcept
+        {
+            T sum = 0;
+
+            for (int i = 0; i < W; ++i)
+            {
+                sum += a.lanes[i];
+            }
+
+            return sum;
+        }
+
+
+        /**
+         * @brief Return the smallest lane of a, NaN lanes are skipped unless they
+         * are first
+         */
+        friend constexpr T horizontal_min(const pack& a) noexcept
+        {
+            T result = a.lanes[0];
+
+            for (int i = 1; i < W; ++i)
+            {
+                result = a.lanes[i] < result ? a.lanes[i] : result;
+            }
+
+            return result;
+        }
+
+
+        // endregion functions
+
+
+        friend std::ostream& operator<<(std::ostream& os, const pack& a)
+        {
+            os << '[';
+
+            for (int i = 0; i < W - 1; ++i)
+            {
+                os << a.lanes[i] << ' ';
+            }
+
+            return os << a.lanes[W - 1] << ']';
+        }
+    };
+}    // namespace ggmath::simd
+
+
+namespace ggmath
+{
+    // region traits
+
+
+    template <std::floating_point T, int W>
+    struct is_lane_type<simd::pack<T, W>> : std::true_type
+    {};
+
+
+    template <std::floating_point T, int W>
+    struct floating_point_of<simd::pack<T, W>>
+    {
+        using type = simd::pack<T, W>;
+    };
+
+
+    template <std::floating_point T, int W>
+    struct lane_value<simd::pack<T, W>>
+    {
+        using type = T;
+    };
+
+
+    // endregion traits
+
+
+    // region using-directives
+
+
+    template <int W>
+    using simd_float = simd::pack<float, W>;
+
+    template <int W>
+    using simd_double = simd::pack<double, W>;
+
+
+    using vec2f_x4  = vec<simd_float<4>, 2>;
+    using vec2f_x8  = vec<simd_float<8>, 2>;
+    using vec2f_x16 = vec<simd_float<16>, 2>;
+
+    using vec3f_x4  = vec<simd_float<4>, 3>;
+    using vec3f_x8  = vec<simd_float<8>, 3>;
+    using vec3f_x16 = vec<simd_float<16>, 3>;
+
+    using vec4f_x4  = vec<simd_float<4>, 4>;
+    using vec4f_x8  = vec<simd_float<8>, 4>;
+    using vec4f_x16 = vec<simd_float<16>, 4>;
+
+    using vec3d_x2 = vec<simd_double<2>, 3>;
+    using vec3d_x4 = vec<simd_double<4>, 3>;
+    using vec3d_x8 = vec<simd_double<8>, 3>;
+
+
+    // endregion using-directives
+
+
+    // region operator_overloads
+
+
+    // The comparisons of vec.hpp require bool results, these return one bool per
+    // lane instead.
+
+
+    // Compare component-wise equality
+    template <std::floating_point T, int W, int n>
+    constexpr simd::mask<T, W> operator==(const vec<simd::pack<T, W>, n>& a,
+                                          const vec<simd::pack<T, W>, n>& b) noexcept
+    {
+        auto result = a[0] == b[0];
+
+        for (std::size_t axis = 1; axis < n; ++axis)
+        {
+            result = result & (a[axis] == b[axis]);
+        }
+
+        return result;
+    }
+
+
+    // Compare component-wise equality
+    template <std::floating_point T, int W, int n>
+    constexpr simd::mask<T, W> operator!=(const vec<simd::pack<T, W>, n>& a,
+                                          const vec<simd::pack<T, W>, n>& b) noexcept
+    {
+        return ~(a == b);
+    }
+
+
+    // Compare length
+    template <std::floating_point T, int W, int n>
+    constexpr simd::mask<T, W> operator>(const vec<simd::pack<T, W>, n>& a,
+                                         const vec<simd::pack<T, W>, n>& b) noexcept
+    {
+        return vector::length_squared(a) > vector::length_squared(b);
+    }
+
+
+    // Compare length
+    template <std::floating_point T, int W, int n>
+    constexpr simd::mask<T, W> operator<(const vec<simd::pack<T, W>, n>& a,
+                                         const vec<simd::pack<T, W>, n>& b) noexcept
+    {
+        return vector::length_squared(a) < vector::length_squared(b);
+    }
+
+
+    // Compare length
+    template <std::floating_point T, int W, int n>
+    constexpr simd::mask<T, W> operator>=(const vec<simd::pack<T, W>, n>& a,
+                                          const vec<simd::pack<T, W>, n>& b) noexcept
+    {
+        return vector::length_squared(a) >= vector::length_squared(b);
+    }
+
+
+    // Compare length
+    template <std::floating_point T, int W, int n>
+    constexpr simd::mask<T, W> operator<=(const vec<simd::pack<T, W>, n>& a,
+                                          const vec<simd::pack<T, W>, n>& b) noexcept
+    {
+        return vector::length_squared(a) <= vector::length_squared(b);
+    }
+
+
+    // endregion operator_overloads
+
+
+    namespace vector
+    {
+        /**
+         * @brief Return the component-wise minimum of a and b
+         */
+        template <std::floating_point T, int W, int n>
+        constexpr vec<simd::pack<T, W>, n> min(const vec<simd::pack<T, W>, n>& a,
+                                               const vec<simd::pack<T, W>, n>& b)
+        {
+            auto vec_out = vec<simd::pack<T, W>, n>();
+
+            std::ranges::transform(a, b, std::begin(vec_out), [](auto x, auto y) {
+                return min(x, y);
+            });
+
+            return vec_out;
+        }
+
+
+        /**
+         * @brief Return the component-wise maximum of a and b
+         */
+        template <std::floating_point T, int W, int n>
+        constexpr vec<simd::pack<T, W>, n> max(const vec<simd::pack<T, W>, n>& a,
+                                               const vec<simd::pack<T, W>, n>& b)
+        {
+            auto vec_out = vec<simd::pack<T, W>, n>();
+
+            std::ranges::transform(a, b, std::begin(vec_out), [](auto x, auto y) {
+                return max(x, y);
+            });
+
+            return vec_out;
+        }
+    }    // namespace vector
+
+
+    // Conversions between packets and spans or vec_soa of the vectors they hold
+    namespace packet
+    {
+        /**
+         * @brief Return the vectors of a where m is true and the vectors of b
+         * elsewhere
+         */
+        template <std::floating_point T, int W, int n>
+        constexpr vec<simd::pack<T, W>, n> select(const simd::mask<T, W>&           m,
+                                                  const vec<simd::pack<T, W>, n>& a,
+                                                  const vec<simd::pack<T, W>, n>& b)
+        {
+            auto vec_out = vec<simd::pack<T, W>, n>();
+
+            for (std::size_t axis = 0; axis < n; ++axis)
+            {
+                vec_out[axis] = select(m, a[axis], b[axis]);
+            }
+
+            return vec_out;
+        }
+
+
+        /**
+         * @brief Load up to W vectors into the lanes of a packet
+         *
+         * Lanes without a vector are zero.
+         */
+        template <int W, std::floating_point T, int n>
+        vec<simd::pack<T, W>, n> load(std::span<const vec<T, n>> vectors)
+        {
+            auto packet = vec<simd::pack<T, W>, n>();
+            auto count  = std::min<std::size_t>(W, vectors.size());
+
+            for (std::size_t lane = 0; lane < count; ++lane)
+            {
+                for (std::size_t axis = 0; axis < n; ++axis)
+                {
+                    packet[axis].lanes[lane] = vectors[lane][axis];
+                }
+            }
+
+            return packet;
+        }
+
+
+        /**
+         * @brief Load the vectors first, ..., first + W - 1 of soa into the lanes of
+         * a packet
+         *
+         * Lanes past the end of soa are zero.
+         */
+        template <int W, std::floating_point T, int n>
+        vec<simd::pack<T, W>, n> load(const vec_soa<T, n>& soa, std::size_t first)
+        {
+            auto packet = vec<simd::pack<T, W>, n>();
+            auto count  = std::min<std::size_t>(W, soa.size() - first);
+
+            for (std::size_t axis = 0; axis < n; ++axis)
+            {
+                const auto* column = soa.data(axis) + first;
+                std::memcpy(&packet[axis].lanes, column, count * sizeof(T));
+            }
+
+            return packet;
+        }
+
+
+        /**
+         * @brief Store the lanes of packet into up to W vectors
+         */
+        template <std::floating_point T, int W, int n>
+        void store(const vec<simd::pack<T, W>, n>& packet, std::span<vec<T, n>> out)
+        {
+            auto count = std::min<std::size_t>(W, out.size());
+
+            for (std::size_t lane = 0; lane < count; ++lane)
+            {
+                for (std::size_t axis = 0; axis < n; ++axis)
+                {
+                    out[lane][axis] = packet[axis][static_cast<int>(lane)];
+                }
+            }
+        }
+
+
+        /**
+         * @brief Store the lanes of packet into the vectors first, ..., first + W - 1
+         * of out
+         *
+         * Lanes past the end of out are dropped.
+         */
+        template <std::floating_point T, int W, int n>
+        void store(const vec<simd::pack<T, W>, n>& packet,
+                   vec_soa<T, n>&                  out,
+                   std::size_t                     first)
+        {
+            auto count = std::min<std::size_t>(W, out.size() - first);
+
+            for (std::size_t axis = 0; axis < n; ++axis)
+            {
+                auto* column = out.data(axis) + first;
+                std::memcpy(column, &packet[axis].lanes, count * sizeof(T));
+            }
+        }
+
+
+        /**
+         * @brief Load the values first, ..., first + W - 1 of values into the lanes
+         * of a packet
+         *
+         * Lanes past the end of values are zero.
+         */
+        template <int W, std::floating_point T>
+        simd::pack<T, W> load(std::span<const T> values, std::size_t first) noexcept
+        {
+            auto packet = simd::pack<T, W>(T(0));
+            auto count  = std::min<std::size_t>(W, values.size() - first);
+
+            std::memcpy(&packet.lanes, values.data() + first, count * sizeof(T));
+
+            return packet;
+        }
+
+
+        /**
+         * @brief Store the lanes of packet into the values first, ..., first + W - 1
+         * of out
+         *
+         * Lanes past the end of out are dropped.
+         */
+        template <std::floating_point T, int W>
+        void store(const simd::pack<T, W>& packet,
+                   std::span<T>            out,
+                   std::size_t             first) noexcept
+        {
+            auto count = std::min<std::size_t>(W, out.size() - first);
+
+            std::memcpy(out.data() + first, &packet.lanes, count * sizeof(T));
+        }
+    }    // namespace packet
+}    // namespace ggmath
+
+#if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic pop
+#endif
+
+#endif    // GG_MATH_PACKET_HPP
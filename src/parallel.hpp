@@ -0,0 +1,501 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#ifndef GG_MATH_PARALLEL_HPP
+#define GG_MATH_PARALLEL_HPP
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+// Execution of batch operations on a thread pool.
+//
+// parallel_for and parallel_reduce split [0, size) into grains and run them on an
+// executor, either parallel::sequenced, on the calling thread, or a thread_pool. The
+// batch functions in ggmath::soa take an executor as their first argument.
+namespace ggmath::parallel
+{
+    // region constants
+
+
+    /**
+     * @brief The bytes of a cache line, grains start on cache line boundaries so two
+     * threads never write to the same line
+     */
+    inline constexpr std::size_t cache_line_size = 64;
+
+
+    /**
+     * @brief A conservative size of the L2 cache of one core
+     *
+     * Grains touch about half of it, which keeps the data of a grain in L2 while
+     * making a grain large enough to amortize scheduling it.
+     */
+    inline constexpr std::size_t l2_cache_size = std::size_t(256) << 10;
+
+
+    // endregion constants
+
+
+    // region classes
+
+
+    /**
+     * @brief A pool of threads which steal work from each other
+     *
+     * Every worker owns a queue. It runs the tasks it queued itself last in, first
+     * out, so recently split ranges are still in its cache, and steals the oldest,
+     * largest tasks from the queues of the others when its own is empty. Threads
+     * waiting for work they queued run queued tasks instead of blocking, see
+     * run_pending(), which also makes nested parallel_for calls safe.
+     *
+     * A pool of size threads starts size - 1 workers, the thread calling
+     * parallel_for is the last one.
+     */
+    class thread_pool
+    {
+      public:
+        using task = std::function<void()>;
+
+
+        /**
+         * @brief Start threads - 1 workers, for one thread per core if threads is 0
+         */
+        explicit thread_pool(std::size_t threads = 0) :
+            queues(std::max<std::size_t>(thread_count(threads) - 1, 1))
+        {
+            const std::size_t count = thread_count(threads) - 1;
+
+            workers.reserve(count);
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                workers.emplace_back([this, index] { work(index); });
+            }
+        }
+
+
+        thread_pool(const thread_pool&)            = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+
+        ~thread_pool()
+        {
+            {
+                std::scoped_lock lock(sleep_mutex);
+                stopping = true;
+            }
+
+            wake.notify_all();
+            for (auto& thread : workers)
+            {
+                thread.join();
+            }
+        }
+
+
+        /**
+         * @brief The pool with one thread per core shared by the whole program
+         */
+        static thread_pool& shared()
+        {
+            static thread_pool pool;
+
+            return pool;
+        }
+
+
+        /**
+         * @brief The number of threads running tasks, including the calling thread
+         */
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return workers.size() + 1;
+        }
+
+
+        /**
+         * @brief Queue _task to be run by one of the workers
+         *
+         * Workers queue into their own queue, other threads spread their tasks over
+         * all of them.
+         */
+        void execute(task _task)
+        {
+            std::size_t index = current_index;
+            if (current_pool != this)
+            {
+                index = next_queue.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            auto& _queue = queues[index % queues.size()];
+
+            {
+                std::scoped_lock lock(_queue.mutex);
+                _queue.tasks.push_back(std::move(_task));
+            }
+
+            queued.fetch_add(1, std::memory_order_release);
+            {
+                std::scoped_lock lock(sleep_mutex);
+            }
+            wake.notify_one();
+        }
+
+
+        /**
+         * @brief Run one queued task on the calling thread, return false if there
+         * was none
+         *
+         * Workers take from their own queue first, then every thread steals from
+         * the others.
+         */
+        bool run_pending()
+        {
+            const bool is_worker = current_pool == this;
+            const auto first     = is_worker ? current_index : 0;
+
+            task _task;
+            for (std::size_t offset = 0; offset < queues.size() && !_task; ++offset)
+            {
+                auto& _queue = queues[(first + offset) % queues.size()];
+
+                std::scoped_lock lock(_queue.mutex);
+                if (_queue.tasks.empty())
+                {
+                    continue;
+                }
+
+                if (is_worker && offset == 0)
+                {
+                    _task = std::move(_queue.tasks.back());
+                    _queue.tasks.pop_back();
+                }
+                else
+                {
+                    _task = std::move(_queue.tasks.front());
+                    _queue.tasks.pop_front();
+                }
+            }
+
+            if (!_task)
+            {
+                return false;
+            }
+
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            _task();
+
+            return true;
+        }
+
+
+      private:
+        struct alignas(cache_line_size) queue
+        {
+            std::mutex       mutex;
+            std::deque<task> tasks;
+        };
+
+
+        // The pool and queue of the worker running on this thread
+        static inline thread_local const thread_pool* current_pool  = nullptr;
+        static inline thread_local std::size_t        current_index = 0;
+
+        std::vector<queue>       queues;
+        std::vector<std::thread> workers;
+        std::atomic<std::size_t> queued     = 0;
+        std::atomic<std::size_t> next_queue = 0;
+
+        std::mutex              sleep_mutex;
+        std::condition_variable wake;
+        bool                    stopping = false;
+
+
+        static std::size_t thread_count(std::size_t threads) noexcept
+        {
+            return threads != 0 ? threads
+                                : std::max(std::thread::hardware_concurrency(), 1U);
+        }
+
+
+        void work(std::size_t index)
+        {
+            current_pool  = this;
+            current_index = index;
+
+            while (true)
+            {
+                if (run_pending())
+                {
+                    continue;
+                }
+
+                std::unique_lock lock(sleep_mutex);
+                wake.wait(lock, [this] {
+                    return stopping || queued.load(std::memory_order_acquire) != 0;
+                });
+
+                if (stopping)
+                {
+                    return;
+                }
+            }
+        }
+    };
+
+
+    /**
+     * @brief The executor running everything on the calling thread
+     */
+    struct sequenced_t
+    {
+        explicit sequenced_t() = default;
+    };
+
+    inline constexpr sequenced_t sequenced{};
+
+
+    // endregion classes
+
+
+    // region concepts
+
+
+    /**
+     * @brief parallel::sequenced or a thread_pool
+     */
+    template <typename T>
+    concept Executor = std::same_as<std::remove_cvref_t<T>, sequenced_t> ||
+                       std::same_as<std::remove_cvref_t<T>, thread_pool>;
+
+
+    // endregion concepts
+
+
+    // region functions
+
+
+    /**
+     * @brief Return the number of elements of a grain if every element touches
+     * bytes_per_element bytes, a multiple of multiple
+     *
+     * multiple should be the number of elements of a cache line, or of a simd
+     * register if it is larger, so grains neither share cache lines nor registers.
+     */
+    constexpr std::size_t grain_size(std::size_t bytes_per_element,
+                                     std::size_t multiple = 1) noexcept
+    {
+        const std::size_t elements =
+            l2_cache_size / 2 / std::max<std::size_t>(bytes_per_element, 1);
+
+        return std::max(elements / multiple, std::size_t(1)) * multiple;
+    }
+
+
+    /**
+     * @brief Call function(first, last) for ranges covering [0, size) exactly once
+     *
+     * A thread_pool calls it once per grain, [i * grain, min((i + 1) * grain,
+     * size)), by splitting the grains in halves, queueing one half for other threads
+     * to steal and continuing with the other. parallel::sequenced calls it once
+     * for all of [0, size). The first exception thrown by function is rethrown once
+     * all threads are done, grains not started by then are skipped.
+     */
+    template <Executor T_Executor, typename T_Function>
+    void parallel_for(T_Executor&& executor,
+                      std::size_t  size,
+                      std::size_t  grain,
+                      T_Function   function)
+    {
+        grain = std::max<std::size_t>(grain, 1);
+
+        const std::size_t grains = (size + grain - 1) / grain;
+
+        if constexpr (std::same_as<std::remove_cvref_t<T_Executor>, sequenced_t>)
+        {
+            if (size != 0)
+            {
+                function(std::size_t(0), size);
+            }
+        }
+        else
+        {
+            if (grains <= 1 || executor.size() == 1)
+            {
+                if (size != 0)
+                {
+                    function(std::size_t(0), size);
+                }
+                return;
+            }
+
+            struct state
+            {
+                explicit state(std::size_t count) : remaining(count) {}
+
+                std::atomic<std::size_t> remaining;
+                std::atomic<bool>        failed = false;
+                std::exception_ptr       exception;
+                std::mutex               mutex;
+            };
+
+            state _state(grains);
+
+            // Run the grains [first, last), queueing the upper halves
+            std::function<void(std::size_t, std::size_t)> run;
+            run = [&](std::size_t first, std::size_t last) {
+                while (last - first > 1)
+                {
+                    const std::size_t middle = first + (last - first) / 2;
+                    executor.execute([&run, middle, last] { run(middle, last); });
+                    last = middle;
+                }
+
+                if (!_state.failed.load(std::memory_order_relaxed))
+                {
+                    try
+                    {
+                        function(first * grain, std::min((first + 1) * grain, size));
+                    }
+                    catch (...)
+                    {
+                        std::scoped_lock lock(_state.mutex);
+                        if (!_state.failed.exchange(true))
+                        {
+                            _state.exception = std::current_exception();
+                        }
+                    }
+                }
+
+                _state.remaining.fetch_sub(1, std::memory_order_acq_rel);
+            };
+
+            run(0, grains);
+            while (_state.remaining.load(std::memory_order_acquire) != 0)
+            {
+                if (!executor.run_pending())
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+            if (_state.exception)
+            {
+                std::rethrow_exception(_state.exception);
+            }
+        }
+    }
+
+
+    /**
+     * @brief Combine the results of map(first, last) of the grains of [0, size)
+     * with reduce, starting from identity
+     *
+     * The grains are the same for every executor and their results are combined
+     * in order, so the result does not depend on the number of threads, even for
+     * floating point sums.
+     */
+    template <Executor T_Executor, typename T, typename T_Map, typename T_Reduce>
+    T parallel_reduce(T_Executor&& executor,
+                      std::size_t  size,
+                      std::size_t  grain,
+                      T            identity,
+                      T_Map        map,
+                      T_Reduce     reduce)
+    {
+        grain = std::max<std::size_t>(grain, 1);
+
+        // A single grain needs neither threads nor a vector of results
+        if (size != 0 && size <= grain)
+        {
+            return reduce(std::move(identity), map(std::size_t(0), size));
+        }
+
+        std::vector<T> results((size + grain - 1) / grain, identity);
+
+        const auto map_grains = [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i += grain)
+            {
+                results[i / grain] = map(i, std::min(i + grain, last));
+            }
+        };
+
+        parallel_for(std::forward<T_Executor>(executor), size, grain, map_grains);
+
+        for (auto& result : results)
+        {
+            identity = reduce(std::move(identity), std::move(result));
+        }
+
+        return identity;
+    }
+
+
+    /**
+     * @brief parallel_for on *pool, or on parallel::sequenced if pool is nullptr
+     *
+     * For option structs which hold a pool, so nullptr opts out of threads.
+     */
+    template <typename T_Function>
+    void parallel_for(thread_pool* pool,
+                      std::size_t  size,
+                      std::size_t  grain,
+                      T_Function   function)
+    {
+        if (pool == nullptr)
+        {
+            parallel_for(sequenced, size, grain, std::move(function));
+        }
+        else
+        {
+            parallel_for(*pool, size, grain, std::move(function));
+        }
+    }
+
+
+    /**
+     * @brief parallel_reduce on *pool, or on parallel::sequenced if pool is nullptr
+     */
+    template <typename T, typename T_Map, typename T_Reduce>
+    T parallel_reduce(thread_pool* pool,
+                      std::size_t  size,
+                      std::size_t  grain,
+                      T            identity,
+                      T_Map        map,
+                      T_Reduce     reduce)
+    {
+        if (pool == nullptr)
+        {
+            return parallel_reduce(
+                sequenced, size, grain, std::move(identity), map, reduce);
+        }
+
+        return parallel_reduce(*pool, size, grain, std::move(identity), map, reduce);
+    }
+
+
+    // endregion functions
+}    // namespace ggmath::parallel
+#endif    // GG_MATH_PARALLEL_HPP
@@ -15,11 +15,786 @@
 // OTHER DEALINGS IN THE SOFTWARE.
 #ifndef GG_MATH_PHYSICS_HPP
 #define GG_MATH_PHYSICS_HPP
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <utility>
+
+#include "packet.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+#include "types.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+
 namespace ggmath::physics
 {
-    // TODO: implement refraction
-    // TODO: implement blinn-phong
-    // TODO: implement lambertian
-    // TODO: implement snells law
+    /**
+     * @brief The number of shading evaluations the optics batches do at once
+     */
+    inline constexpr int batch_width = 8;
+
+
+    // region classes
+
+
+    /**
+     * @brief The settings of the integrators
+     */
+    struct step_options
+    {
+        // The pool advancing the particles, nullptr to advance them on the calling
+        // thread. Its threads are reused by every step.
+        parallel::thread_pool* pool = &parallel::thread_pool::shared();
+    };
+
+
+    /**
+     * @brief The state of particles, particle i is element i of every column
+     *
+     * The integrators require the three to have the same size.
+     */
+    struct particles
+    {
+        vec3f_soa positions;
+        vec3f_soa velocities;
+        vec3f_soa accelerations;
+
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return positions.size();
+        }
+
+
+        /**
+         * @brief Resize to size particles, new particles are at rest at the origin
+         */
+        void resize(std::size_t size)
+        {
+            positions.resize(size);
+            velocities.resize(size);
+            accelerations.resize(size);
+        }
+    };
+
+
+    /**
+     * @brief The intermediate states of rk4(), kept between steps so they are not
+     * allocated again for every one
+     */
+    struct rk4_workspace
+    {
+        vec3f_soa positions;
+        vec3f_soa velocities;
+        vec3f_soa accelerations;
+        vec3f_soa position_sums;
+        vec3f_soa velocity_sums;
+    };
+
+
+    /**
+     * @brief The result of Snell's law for light hitting a surface
+     *
+     * T may be a simd::pack, then there is one result per lane.
+     */
+    template <Scalar T>
+    struct refraction
+    {
+        // The cosine of the angle between the transmitted direction and the
+        // reversed normal, 0 where all light is reflected
+        T cos_transmitted;
+
+        // Where all light is reflected and none is transmitted, bool or simd::mask
+        decltype(std::declval<T>() < std::declval<T>()) total_internal_reflection;
+    };
+
+
+    /**
+     * @brief A function writing the accelerations of particles at positions moving
+     * at velocities to accelerations, which has their size already
+     */
+    template <typename T>
+    concept acceleration_function =
+        std::invocable<T&, const vec3f_soa&, const vec3f_soa&, vec3f_soa&>;
+
+
+    // endregion classes
+
+
+    // region helpers
+
+
+    namespace detail
+    {
+        // The kernels read and write up to three columns of three floats per
+        // particle, grains are whole cache lines of every column
+        inline constexpr std::size_t grain = parallel::grain_size(
+            9 * sizeof(float), parallel::cache_line_size / sizeof(float));
+
+
+        /**
+         * @brief Call kernel(first, last) for the grains of the padded columns of
+         * size particles on the pool of options
+         *
+         * first and last are multiples of soa::lanes, so the kernels process whole
+         * registers, including the padding, without a remainder.
+         */
+        template <typename T_Kernel>
+        void for_blocks(std::size_t size, const step_options& options, T_Kernel kernel)
+        {
+            parallel::parallel_for(options.pool, soa::padded(size), grain, kernel);
+        }
+
+
+        inline void throw_if_not_equal_sizes(const particles& _particles)
+        {
+            debug::throw_if_not_equal_size(_particles.positions.size(),
+                                           _particles.velocities.size());
+            debug::throw_if_not_equal_size(_particles.positions.size(),
+                                           _particles.accelerations.size());
+        }
+
+
+        /**
+         * @brief Return a + b * c
+         */
+        inline simd::float4
+            multiply_add(simd::float4 a, simd::float4 b, simd::float4 c) noexcept
+        {
+            return simd::add(a, simd::mul(b, c));
+        }
+
+
+        /**
+         * @brief Advance the velocities by kick times the accelerations, then the
+         * positions by drift times the new velocities, for the elements first to
+         * last
+         */
+        inline void kick_drift(particles&  _particles,
+                               float       kick,
+                               float       drift,
+                               std::size_t first,
+                               std::size_t last) noexcept
+        {
+            using simd::load;
+            using simd::store;
+
+            const auto kick_step  = simd::broadcast(kick);
+            const auto drift_step = simd::broadcast(drift);
+
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                float*       x = _particles.positions.data(axis);
+                float*       v = _particles.velocities.data(axis);
+                const float* a = _particles.accelerations.data(axis);
+
+                for (auto i = first; i < last; i += soa::lanes)
+                {
+                    const auto velocity =
+                        multiply_add(load(v + i), load(a + i), kick_step);
+
+                    store(v + i, velocity);
+                    store(x + i, multiply_add(load(x + i), velocity, drift_step));
+                }
+            }
+        }
+
+
+        /**
+         * @brief Advance the velocities by kick times the accelerations for the
+         * elements first to last
+         */
+        inline void kick(particles&  _particles,
+                         float       kick,
+                         std::size_t first,
+                         std::size_t last) noexcept
+        {
+            using simd::load;
+            using simd::store;
+
+            const auto kick_step = simd::broadcast(kick);
+
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                float*       v = _particles.velocities.data(axis);
+                const float* a = _particles.accelerations.data(axis);
+
+                for (auto i = first; i < last; i += soa::lanes)
+                {
+                    store(v + i, multiply_add(load(v + i), load(a + i), kick_step));
+                }
+            }
+        }
+
+
+        /**
+         * @brief Add a stage of rk4() with the derivatives velocities and
+         * accelerations to the sums of workspace, weighted by weight, and put the
+         * state for the next stage h after the start of the step into workspace,
+         * for the elements first to last
+         *
+         * The first stage sets the sums instead of adding to them.
+         */
+        inline void rk4_stage(const particles& _particles,
+                              const vec3f_soa& velocities,
+                              const vec3f_soa& accelerations,
+                              rk4_workspace&   workspace,
+                              bool             first_stage,
+                              float            weight,
+                              float            h,
+                              std::size_t      first,
+                              std::size_t      last) noexcept
+        {
+            using simd::load;
+            using simd::store;
+
+            const auto zero    = simd::broadcast(0.0F);
+            const auto weights = simd::broadcast(weight);
+            const auto offset  = simd::broadcast(h);
+
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                const float* x_0 = _particles.positions.data(axis);
+                const float* v_0 = _particles.velocities.data(axis);
+                const float* v   = velocities.data(axis);
+                const float* a   = accelerations.data(axis);
+
+                float* x_next = workspace.positions.data(axis);
+                float* v_next = workspace.velocities.data(axis);
+                float* x_sum  = workspace.position_sums.data(axis);
+                float* v_sum  = workspace.velocity_sums.data(axis);
+
+                for (auto i = first; i < last; i += soa::lanes)
+                {
+                    const auto velocity     = load(v + i);
+                    const auto acceleration = load(a + i);
+
+                    const auto x_before = first_stage ? zero : load(x_sum + i);
+                    const auto v_before = first_stage ? zero : load(v_sum + i);
+
+                    store(x_sum + i, multiply_add(x_before, velocity, weights));
+                    store(v_sum + i, multiply_add(v_before, acceleration, weights));
+                    store(x_next + i, multiply_add(load(x_0 + i), velocity, offset));
+                    store(v_next + i,
+                          multiply_add(load(v_0 + i), acceleration, offset));
+                }
+            }
+        }
+
+
+        /**
+         * @brief Advance _particles by the weighted sums of the stages of rk4() and
+         * its last stage, for the elements first to last
+         */
+        inline void rk4_finish(particles&           _particles,
+                               const rk4_workspace& workspace,
+                               float                dt,
+                               std::size_t          first,
+                               std::size_t          last) noexcept
+        {
+            using simd::load;
+            using simd::store;
+
+            const auto sixth_step = simd::broadcast(dt / 6);
+
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                float* x = _particles.positions.data(axis);
+                float* v = _particles.velocities.data(axis);
+
+                const float* v_4   = workspace.velocities.data(axis);
+                const float* a_4   = workspace.accelerations.data(axis);
+                const float* x_sum = workspace.position_sums.data(axis);
+                const float* v_sum = workspace.velocity_sums.data(axis);
+
+                for (auto i = first; i < last; i += soa::lanes)
+                {
+                    const auto d_x = simd::add(load(x_sum + i), load(v_4 + i));
+                    const auto d_v = simd::add(load(v_sum + i), load(a_4 + i));
+
+                    store(x + i, multiply_add(load(x + i), d_x, sixth_step));
+                    store(v + i, multiply_add(load(v + i), d_v, sixth_step));
+                }
+            }
+        }
+
+
+        // region optics
+
+
+        // The counterparts of the functions simd::pack provides
+        template <std::floating_point T>
+        constexpr T select(bool condition, T a, T b) noexcept
+        {
+            return condition ? a : b;
+        }
+
+
+        template <std::floating_point T>
+        inline T pow(T base, T exponent) noexcept
+        {
+            return std::pow(base, exponent);
+        }
+
+
+        /**
+         * @brief Raise the lanes of base to exponent one at a time, there is no
+         * vector instruction for it
+         */
+        template <std::floating_point T, int W>
+        inline simd::pack<T, W> pow(const simd::pack<T, W>& base,
+                                    const simd::pack<T, W>& exponent) noexcept
+        {
+            auto result = simd::pack<T, W>();
+
+            for (int i = 0; i < W; ++i)
+            {
+                result.lanes[i] = std::pow(base.lanes[i], exponent.lanes[i]);
+            }
+
+            return result;
+        }
+
+
+        template <typename T>
+        constexpr T max(const T& a, const T& b) noexcept
+        {
+            using std::max;
+
+            return max(a, b);
+        }
+
+
+        template <std::floating_point T, int n>
+        void throw_if_not_unit(const vec<T, n>& _vec)
+        {
+            if constexpr (debug::enabled)
+            {
+                debug::throw_if_not_unit(_vec);
+            }
+        }
+
+
+        // Packets are not checked, a lane past the end of a batch is not a unit
+        // vector
+        template <std::floating_point T, int W, int n>
+        constexpr void
+            throw_if_not_unit(const vec<simd::pack<T, W>, n>& /*_vec*/) noexcept
+        {}
+
+
+        /**
+         * @brief Set the bits of mask for the lanes of condition that are true and
+         * are not past size, starting at bit first
+         */
+        inline void set_bits(std::span<std::uint64_t>          mask,
+                             std::size_t                       first,
+                             std::size_t                       size,
+                             const simd::mask<float, batch_width>& condition) noexcept
+        {
+            const auto lanes = std::min<std::size_t>(batch_width, size - first);
+            const auto bits  = condition.bits() & ((std::uint64_t(1) << lanes) - 1);
+
+            mask[first / 64] |= std::uint64_t(bits) << (first % 64);
+        }
+
+
+        /**
+         * @brief Return the direction of light going in direction through a surface
+         * with normal, given the result of snell() for it
+         */
+        template <Scalar T>
+        constexpr vec<T, 3> refracted(const vec<T, 3>&     direction,
+                                      const vec<T, 3>&     normal,
+                                      const T&             eta,
+                                      const T&             cos_incident,
+                                      const refraction<T>& _refraction) noexcept
+        {
+            const auto& total = _refraction.total_internal_reflection;
+
+            const T scale  = select(total, T(0), eta);
+            const T offset = select(
+                total, T(0), T(eta * cos_incident - _refraction.cos_transmitted));
+
+            return direction * scale + normal * offset;
+        }
+
+
+        // endregion optics
+    }    // namespace detail
+
+
+    // endregion helpers
+
+
+    // region integrators
+
+
+    /**
+     * @brief Advance _particles by dt with the semi-implicit Euler method
+     *
+     * The velocities are advanced by the accelerations and the positions by the
+     * new velocities, in one pass over the columns. First order, but unlike the
+     * explicit Euler method it keeps the energy of oscillations bounded. The
+     * threads of options.pool advance the particles at once.
+     */
+    inline void semi_implicit_euler(particles&          _particles,
+                                    float               dt,
+                                    const step_options& options = {})
+    {
+        detail::throw_if_not_equal_sizes(_particles);
+
+        const auto step = [&](std::size_t first, std::size_t last) {
+            detail::kick_drift(_particles, dt, dt, first, last);
+        };
+        detail::for_blocks(_particles.size(), options, step);
+    }
+
+
+    /**
+     * @brief Advance _particles by dt with the velocity Verlet method
+     *
+     * The accelerations of _particles have to be the ones at their positions, as
+     * left by the last step. The velocities are advanced by half a step and the
+     * positions by a whole one, then acceleration calculates the accelerations at
+     * the new positions, with the velocities of the half step, and the velocities
+     * are advanced by the other half. Second order and symplectic, exact for
+     * constant accelerations.
+     */
+    template <acceleration_function T_Acceleration>
+    void velocity_verlet(particles&          _particles,
+                         float               dt,
+                         T_Acceleration&&    acceleration,
+                         const step_options& options = {})
+    {
+        detail::throw_if_not_equal_sizes(_particles);
+
+        const auto kick_drift = [&](std::size_t first, std::size_t last) {
+            detail::kick_drift(_particles, dt / 2, dt, first, last);
+        };
+        const auto kick = [&](std::size_t first, std::size_t last) {
+            detail::kick(_particles, dt / 2, first, last);
+        };
+
+        detail::for_blocks(_particles.size(), options, kick_drift);
+        acceleration(std::as_const(_particles.positions),
+                     std::as_const(_particles.velocities),
+                     _particles.accelerations);
+        detail::for_blocks(_particles.size(), options, kick);
+    }
+
+
+    /**
+     * @brief Advance _particles by dt with the classic fourth order Runge-Kutta
+     * method
+     *
+     * acceleration is called four times, at the start of the step, twice at its
+     * middle and once at its end. The accelerations of _particles are set to the
+     * ones at the start. workspace holds the intermediate states and may be reused
+     * for every step.
+     */
+    template <acceleration_function T_Acceleration>
+    void rk4(particles&          _particles,
+             float               dt,
+             T_Acceleration&&    acceleration,
+             rk4_workspace&      workspace,
+             const step_options& options = {})
+    {
+        detail::throw_if_not_equal_sizes(_particles);
+
+        const auto size = _particles.size();
+        workspace.positions.resize(size);
+        workspace.velocities.resize(size);
+        workspace.accelerations.resize(size);
+        workspace.position_sums.resize(size);
+        workspace.velocity_sums.resize(size);
+
+        // Sum up the stage with the derivatives velocities and accelerations, then
+        // evaluate the next one h after the start of the step
+        const auto stage = [&](const vec3f_soa& velocities,
+                               const vec3f_soa& accelerations,
+                               bool             first_stage,
+                               float            weight,
+                               float            h) {
+            const auto kernel = [&](std::size_t first, std::size_t last) {
+                detail::rk4_stage(_particles,
+                                  velocities,
+                                  accelerations,
+                                  workspace,
+                                  first_stage,
+                                  weight,
+                                  h,
+                                  first,
+                                  last);
+            };
+            detail::for_blocks(size, options, kernel);
+
+            acceleration(std::as_const(workspace.positions),
+                         std::as_const(workspace.velocities),
+                         workspace.accelerations);
+        };
+
+        acceleration(std::as_const(_particles.positions),
+                     std::as_const(_particles.velocities),
+                     _particles.accelerations);
+
+        stage(_particles.velocities, _particles.accelerations, true, 1, dt / 2);
+        stage(workspace.velocities, workspace.accelerations, false, 2, dt / 2);
+        stage(workspace.velocities, workspace.accelerations, false, 2, dt);
+
+        const auto finish = [&](std::size_t first, std::size_t last) {
+            detail::rk4_finish(_particles, workspace, dt, first, last);
+        };
+        detail::for_blocks(size, options, finish);
+    }
+
+
+    // endregion integrators
+
+
+    // region optics
+
+
+    /**
+     * @brief Apply Snell's law to light arriving at an angle with the cosine
+     * cos_incident to the normal of a surface
+     *
+     * eta is the ratio of the refractive indices of the sides the light comes from
+     * and goes to. T may be a simd::pack, then every lane is refracted on its own.
+     */
+    template <Scalar T>
+    constexpr refraction<T> snell(const T& cos_incident, const T& eta) noexcept
+    {
+        using detail::select;
+        using std::sqrt;
+
+        const T sin_squared = eta * eta * (T(1) - cos_incident * cos_incident);
+        const auto total    = sin_squared > T(1);
+
+        return {select(total, T(0), T(sqrt(T(1) - sin_squared))), total};
+    }
+
+
+    /**
+     * @brief Return the direction of light going in direction through a surface
+     * with normal, or the zero vector where all light is reflected
+     *
+     * The vectors have to be unit vectors, normal pointing against direction to the
+     * side the light comes from. eta is the ratio of the refractive indices of that
+     * side and the other one. Set the macro GGMATH_DEBUG to 1 to throw an exception
+     * if one of the vectors is NOT a unit-vector, otherwise the check is compiled
+     * out. T may be a simd::pack, then every lane is refracted on its own.
+     */
+    template <Scalar T>
+    constexpr vec<T, 3> refract(const vec<T, 3>& direction,
+                                const vec<T, 3>& normal,
+                                const T&         eta) noexcept(!debug::enabled)
+    {
+        detail::throw_if_not_unit(direction);
+        detail::throw_if_not_unit(normal);
+
+        const T cos_incident = -vector::dot(direction, normal);
+
+        return detail::refracted(
+            direction, normal, eta, cos_incident, snell(cos_incident, eta));
+    }
+
+
+    /**
+     * @brief Return the reflectance of light hitting a surface head-on, for
+     * schlick()
+     *
+     * eta is the ratio of the refractive indices of the sides of the surface.
+     */
+    template <Scalar T>
+    constexpr T schlick_r0(const T& eta) noexcept
+    {
+        const T ratio = (T(1) - eta) / (T(1) + eta);
+
+        return ratio * ratio;
+    }
+
+
+    /**
+     * @brief Return Schlick's approximation of the Fresnel reflectance of light
+     * arriving at an angle with the cosine cos_theta to the normal
+     *
+     * r0 is the reflectance head-on, see schlick_r0(). Going into a less dense
+     * medium, cos_theta has to be the cosine of the transmitted direction.
+     */
+    template <Scalar T>
+    constexpr T schlick(const T& cos_theta, const T& r0) noexcept
+    {
+        const T x        = T(1) - cos_theta;
+        const T x_square = x * x;
+
+        return r0 + (T(1) - r0) * x_square * x_square * x;
+    }
+
+
+    /**
+     * @brief Return the Lambertian BRDF times the cosine between normal and
+     * to_light, which is 0 for light from behind the surface
+     *
+     * The vectors have to be unit vectors. Multiplied by the albedo and the
+     * irradiance of the light it gives the reflected radiance.
+     */
+    template <Scalar T>
+    constexpr T lambertian(const vec<T, 3>& normal, const vec<T, 3>& to_light) noexcept
+    {
+        return detail::max(vector::dot(normal, to_light), T(0))
+               * T(std::numbers::inv_pi_v<lane_value_t<T>>);
+    }
+
+
+    /**
+     * @brief Return the energy normalized Blinn-Phong BRDF times the cosine between
+     * normal and to_light, which is 0 for light from behind the surface
+     *
+     * The vectors have to be unit vectors. The highlight gets smaller and brighter
+     * with shininess, the normalization keeps the energy it reflects about the
+     * same.
+     */
+    template <Scalar T>
+    constexpr T blinn_phong(const vec<T, 3>& normal,
+                            const vec<T, 3>& to_light,
+                            const vec<T, 3>& to_viewer,
+                            const T&         shininess) noexcept
+    {
+        using detail::select;
+        using std::sqrt;
+
+        const auto halfway        = to_light + to_viewer;
+        const T    length_squared = vector::dot(halfway, halfway);
+
+        // Light and viewer opposite each other have no halfway vector
+        const T cos_halfway = select(
+            length_squared > T(0),
+            T(vector::dot(normal, halfway) / sqrt(length_squared)),
+            T(0));
+        const T normalization =
+            (shininess + T(8)) * T(std::numbers::inv_pi_v<lane_value_t<T>> / 8);
+
+        return normalization * detail::pow(detail::max(cos_halfway, T(0)), shininess)
+               * detail::max(vector::dot(normal, to_light), T(0));
+    }
+
+
+    /**
+     * @brief Refract the elements of directions through surfaces with the elements
+     * of normals, batch_width at a time, and set bit i % 64 of
+     * total_internal_reflection[i / 64] if element i is reflected entirely
+     *
+     * out is resized to the size of directions, elements that are reflected
+     * entirely are zero. total_internal_reflection has to hold a bit for every
+     * element, otherwise an invalid_argument exception is thrown.
+     */
+    inline void refract(const vec3f_soa&         directions,
+                        const vec3f_soa&         normals,
+                        float                    eta,
+                        vec3f_soa&               out,
+                        std::span<std::uint64_t> total_internal_reflection)
+    {
+        debug::throw_if_not_equal_size(directions.size(), normals.size());
+        out.resize(directions.size());
+
+        const std::size_t size  = directions.size();
+        const std::size_t words = (size + 63) / 64;
+        debug::throw_if_too_small(total_internal_reflection.size(), words);
+
+        std::fill_n(total_internal_reflection.begin(), words, 0);
+
+        const auto ratio = simd_float<batch_width>(eta);
+        for (std::size_t i = 0; i < size; i += batch_width)
+        {
+            const auto direction    = packet::load<batch_width>(directions, i);
+            const auto normal       = packet::load<batch_width>(normals, i);
+            const auto cos_incident = -vector::dot(direction, normal);
+            const auto _refraction  = snell(cos_incident, ratio);
+
+            packet::store(
+                detail::refracted(direction, normal, ratio, cos_incident, _refraction),
+                out,
+                i);
+            detail::set_bits(total_internal_reflection,
+                             i,
+                             size,
+                             _refraction.total_internal_reflection);
+        }
+    }
+
+
+    /**
+     * @brief Calculate Schlick's approximation of the Fresnel reflectance for the
+     * cosines cos_theta, batch_width at a time
+     */
+    inline void
+        schlick(std::span<const float> cos_theta, float r0, std::span<float> out)
+    {
+        debug::throw_if_not_equal_size(cos_theta.size(), out.size());
+
+        const auto reflectance = simd_float<batch_width>(r0);
+        for (std::size_t i = 0; i < cos_theta.size(); i += batch_width)
+        {
+            const auto cosines = packet::load<batch_width>(cos_theta, i);
+            packet::store(schlick(cosines, reflectance), out, i);
+        }
+    }
+
+
+    /**
+     * @brief Calculate the Lambertian BRDF times the cosine for the elements of
+     * normals and to_lights, batch_width at a time
+     */
+    inline void lambertian(const vec3f_soa& normals,
+                           const vec3f_soa& to_lights,
+                           std::span<float> out)
+    {
+        debug::throw_if_not_equal_size(normals.size(), to_lights.size());
+        debug::throw_if_not_equal_size(normals.size(), out.size());
+
+        for (std::size_t i = 0; i < normals.size(); i += batch_width)
+        {
+            packet::store(lambertian(packet::load<batch_width>(normals, i),
+                                     packet::load<batch_width>(to_lights, i)),
+                          out,
+                          i);
+        }
+    }
+
+
+    /**
+     * @brief Calculate the energy normalized Blinn-Phong BRDF times the cosine for
+     * the elements of normals, to_lights and to_viewers, batch_width at a time
+     */
+    inline void blinn_phong(const vec3f_soa& normals,
+                            const vec3f_soa& to_lights,
+                            const vec3f_soa& to_viewers,
+                            float            shininess,
+                            std::span<float> out)
+    {
+        debug::throw_if_not_equal_size(normals.size(), to_lights.size());
+        debug::throw_if_not_equal_size(normals.size(), to_viewers.size());
+        debug::throw_if_not_equal_size(normals.size(), out.size());
+
+        for (std::size_t i = 0; i < normals.size(); i += batch_width)
+        {
+            packet::store(blinn_phong(packet::load<batch_width>(normals, i),
+                                      packet::load<batch_width>(to_lights, i),
+                                      packet::load<batch_width>(to_viewers, i),
+                                      simd_float<batch_width>(shininess)),
+                          out,
+                          i);
+        }
+    }
+
+
+    // endregion optics
 }    // namespace ggmath::physics
 #endif    // GG_MATH_PHYSICS_HPP
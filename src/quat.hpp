@@ -0,0 +1,812 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#ifndef GG_MATH_QUAT_HPP
+#define GG_MATH_QUAT_HPP
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "mat.hpp"
+#include "packet.hpp"
+#include "simd.hpp"
+#include "types.hpp"
+#include "util.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+
+// region forward_declarations
+
+
+namespace ggmath
+{
+    template <std::floating_point T>
+    struct quat;
+}    // namespace ggmath
+
+
+namespace ggmath::debug
+{
+    template <std::floating_point T>
+    void throw_if_not_unit(const ggmath::quat<T>& _quat);
+}    // namespace ggmath::debug
+
+
+// endregion forward_declarations
+
+
+namespace ggmath
+{
+    // region classes
+
+
+    /**
+     * @brief A quaternion x * i + y * j + z * k + w, unit quaternions are rotations
+     *
+     * The components are stored in a vec<T, 4> with the real part w last, so both
+     * convert to each other without shuffling and the component-wise arithmetic
+     * runs on the vector kernels.
+     */
+    template <std::floating_point T>
+    struct quat
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+        union
+        {
+            vec<T, 4> xyzw;
+
+            struct
+            {
+                T x, y, z, w;
+            };
+        };
+
+
+        // region constructors
+
+
+        constexpr quat() : xyzw{} {}
+
+
+        constexpr quat(T x, T y, T z, T w) : xyzw{x, y, z, w} {}
+
+
+        // The imaginary part of vector and a real part of w
+        constexpr quat(const vec<T, 3>& vector, T w) : xyzw{vector, w} {}
+
+
+        constexpr explicit quat(const vec<T, 4>& _vec) : xyzw{_vec} {}
+
+
+        // endregion constructors
+
+
+        // region static methods
+
+
+        static constexpr quat identity() noexcept
+        {
+            return {0, 0, 0, 1};
+        }
+
+
+        // endregion static methods
+
+
+        // region operator overloads
+
+
+        constexpr T& operator[](std::size_t i) noexcept
+        {
+            return xyzw[i];
+        }
+
+
+        constexpr const T& operator[](std::size_t i) const noexcept
+        {
+            return xyzw[i];
+        }
+
+
+        // endregion operator overloads
+
+
+        // region methods
+
+
+        // The imaginary part
+        constexpr vec<T, 3> vector() const
+        {
+            return {x, y, z};
+        }
+
+
+        constexpr vec<T, 4> to_vec() const
+        {
+            return xyzw;
+        }
+
+
+        // endregion methods
+    };
+
+
+    // endregion classes
+
+
+    // region using-directives
+
+
+    using quatf = quat<float>;
+    using quatd = quat<double>;
+
+
+    // endregion using-directives
+
+
+    // region layout
+
+
+    static_assert(TriviallyCopyable<quatf> && TriviallyCopyable<quatd>);
+    static_assert(sizeof(quatf) == 4 * sizeof(float));
+    static_assert(sizeof(quatd) == 4 * sizeof(double));
+
+
+    // endregion layout
+
+
+    // region operator_overloads
+
+
+    // region operator_overloads::binary
+
+
+    template <std::floating_point T>
+    constexpr quat<T> operator+(const quat<T>& a, const quat<T>& b) noexcept
+    {
+        return quat<T>(a.xyzw + b.xyzw);
+    }
+
+
+    template <std::floating_point T>
+    constexpr quat<T> operator-(const quat<T>& a, const quat<T>& b) noexcept
+    {
+        return quat<T>(a.xyzw - b.xyzw);
+    }
+
+
+    /**
+     * @brief Return the Hamilton product of a and b, the rotation b followed by a
+     */
+    template <std::floating_point T>
+    constexpr quat<T> operator*(const quat<T>& a, const quat<T>& b) noexcept
+    {
+        return {a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+                a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z};
+    }
+
+
+    template <std::floating_point T>
+    constexpr quat<T> operator*(const quat<T>& _quat, T scalar) noexcept
+    {
+        return quat<T>(_quat.xyzw * scalar);
+    }
+
+
+    template <std::floating_point T>
+    constexpr quat<T> operator*(T scalar, const quat<T>& _quat) noexcept
+    {
+        return _quat * scalar;
+    }
+
+
+    template <std::floating_point T>
+    constexpr quat<T> operator/(const quat<T>& _quat, T scalar) noexcept
+    {
+        return quat<T>(_quat.xyzw / scalar);
+    }
+
+
+    // endregion operator_overloads::binary
+
+
+    // region operator_overloads::unary
+
+
+    template <std::floating_point T>
+    constexpr quat<T> operator-(const quat<T>& _quat) noexcept
+    {
+        return quat<T>(-_quat.xyzw);
+    }
+
+
+    // endregion operator_overloads::unary
+
+
+    // region operator_overloads::comparison
+
+
+    template <std::floating_point T>
+    constexpr bool operator==(const quat<T>& a, const quat<T>& b) noexcept
+    {
+        return a.xyzw == b.xyzw;
+    }
+
+
+    template <std::floating_point T>
+    constexpr bool operator!=(const quat<T>& a, const quat<T>& b) noexcept
+    {
+        return !(a == b);
+    }
+
+
+    // endregion operator_overloads::comparison
+
+
+    // region operator_overloads::other
+
+
+    template <std::floating_point T>
+    std::ostream& operator<<(std::ostream& os, const quat<T>& _quat)
+    {
+        os << '(' << _quat.x << ',' << _quat.y << ',' << _quat.z << ',' << _quat.w
+           << ')';
+
+        return os;
+    }
+
+
+    // endregion operator_overloads::other
+
+
+    // endregion operator_overloads
+
+
+    namespace quaternion
+    {
+        // region helpers
+
+
+        namespace detail
+        {
+            /**
+             * @brief The components x, y, z and w of a quaternion, or of 4
+             * quaternions with one simd::pack per component
+             *
+             * The interpolations are written once for both, so the batch functions
+             * run the same code lane-wise.
+             */
+            template <typename R>
+            using components = std::array<R, 4>;
+
+
+            template <typename R>
+            constexpr R dot(const components<R>& a, const components<R>& b) noexcept
+            {
+                return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+            }
+
+
+            // Return magnitude with the sign of sign, lane-wise for packets
+            template <typename R>
+            constexpr R with_sign_of(R magnitude, R sign) noexcept
+            {
+                if constexpr (std::floating_point<R>)
+                {
+                    return std::copysign(magnitude, sign);
+                }
+                else
+                {
+                    return select(sign < R(0), -magnitude, magnitude);
+                }
+            }
+
+
+            /**
+             * @brief Return a * weight_a + b * weight_b, normalized
+             */
+            template <typename R>
+            constexpr components<R> blend(const components<R>& a,
+                                          const components<R>& b,
+                                          R                    weight_a,
+                                          R                    weight_b) noexcept
+            {
+                using std::sqrt;
+
+                auto blended = components<R>();
+                for (int i = 0; i < 4; ++i)
+                {
+                    blended[i] = a[i] * weight_a + b[i] * weight_b;
+                }
+
+                const R inverse_length = R(1) / sqrt(dot(blended, blended));
+                for (auto& component : blended)
+                {
+                    component = component * inverse_length;
+                }
+
+                return blended;
+            }
+
+
+            template <typename R, std::floating_point T>
+            constexpr components<R>
+                nlerp(const components<R>& a, const components<R>& b, T t) noexcept
+            {
+                return blend(a, b, R(1 - t), with_sign_of(R(t), dot(a, b)));
+            }
+
+
+            /**
+             * @brief Return the weight of b for a slerp from a to b with a weight of
+             * t, approximated by a polynomial in t and the absolute cosine between
+             * them
+             *
+             * The nlerp weight t is corrected to follow the angle of a slerp, the
+             * polynomial was fitted by Arseny Kapoulkine ("Approximating slerp").
+             */
+            template <typename R, std::floating_point T>
+            constexpr R fast_slerp_weight(R abs_cos, T t) noexcept
+            {
+                // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+                const R a = T(1.0904)
+                            + abs_cos
+                                  * (T(-3.2452)
+                                     + abs_cos * (T(3.55645) - abs_cos * T(1.43519)));
+                const R b =
+                    T(0.848013) + abs_cos * (T(-1.06021) + abs_cos * T(0.215638));
+                const R k = a * ((t - T(0.5)) * (t - T(0.5))) + b;
+                // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+                return t + (t * (t - T(0.5)) * (t - 1)) * k;
+            }
+
+
+            template <typename R, std::floating_point T>
+            constexpr components<R>
+                fast_slerp(const components<R>& a, const components<R>& b, T t) noexcept
+            {
+                using std::abs;
+
+                const R cos_angle = dot(a, b);
+                const R weight_b  = fast_slerp_weight(abs(cos_angle), t);
+
+                return blend(a, b, R(1) - weight_b, with_sign_of(weight_b, cos_angle));
+            }
+
+
+            template <std::floating_point T>
+            constexpr quat<T> to_quat(const components<T>& _components) noexcept
+            {
+                return {_components[0], _components[1], _components[2], _components[3]};
+            }
+
+
+            /**
+             * @brief Load the 4 quaternions starting at quats with one packet per
+             * component
+             */
+            template <std::floating_point T>
+            components<simd::pack<T, 4>> load4(const quat<T>* quats) noexcept
+            {
+                // Through data, as quat has a non-trivial default constructor
+                std::array<simd::native_t<T, 4>, 4> rows;
+                for (std::size_t i = 0; i < rows.size(); ++i)
+                {
+                    std::memcpy(
+                        &rows[i], quats[i].xyzw.data.data(), sizeof(rows[i]));
+                }
+                simd::transpose4<T>(rows[0], rows[1], rows[2], rows[3]);
+
+                return {simd::pack<T, 4>(rows[0]),
+                        simd::pack<T, 4>(rows[1]),
+                        simd::pack<T, 4>(rows[2]),
+                        simd::pack<T, 4>(rows[3])};
+            }
+
+
+            template <std::floating_point T>
+            void store4(const components<simd::pack<T, 4>>& packets,
+                        quat<T>*                            quats) noexcept
+            {
+                std::array<simd::native_t<T, 4>, 4> rows = {packets[0].lanes,
+                                                            packets[1].lanes,
+                                                            packets[2].lanes,
+                                                            packets[3].lanes};
+                simd::transpose4<T>(rows[0], rows[1], rows[2], rows[3]);
+
+                for (std::size_t i = 0; i < rows.size(); ++i)
+                {
+                    std::memcpy(quats[i].xyzw.data.data(), &rows[i], sizeof(rows[i]));
+                }
+            }
+
+
+            /**
+             * @brief Set out[i] to op(a[i], b[i]) for every i, 4 quaternions at a time
+             *
+             * op is called with the components of 4 quaternions as packets, and with
+             * the ones of single quaternions for the remainder.
+             */
+            template <std::floating_point T, typename T_Operation>
+            void for_each_pair(std::span<const quat<T>> a,
+                               std::span<const quat<T>> b,
+                               std::span<quat<T>>       out,
+                               T_Operation              operation)
+            {
+                debug::throw_if_not_equal_size(a.size(), b.size());
+                debug::throw_if_not_equal_size(a.size(), out.size());
+
+                std::size_t i = 0;
+
+                for (; i + 4 <= a.size(); i += 4)
+                {
+                    store4(operation(load4(&a[i]), load4(&b[i])), &out[i]);
+                }
+
+                for (; i < a.size(); ++i)
+                {
+                    out[i] = to_quat(operation(a[i].xyzw.data, b[i].xyzw.data));
+                }
+            }
+        }    // namespace detail
+
+
+        // endregion helpers
+
+
+        // region functions
+
+
+        template <std::floating_point T>
+        constexpr T dot(const quat<T>& a, const quat<T>& b) noexcept
+        {
+            return vector::dot(a.xyzw, b.xyzw);
+        }
+
+
+        template <std::floating_point T>
+        constexpr T length(const quat<T>& _quat)
+        {
+            return std::sqrt(dot(_quat, _quat));
+        }
+
+
+        /**
+         * @brief Check if the given quaternion has a length of 1, so it is a
+         * rotation
+         */
+        template <std::floating_point T>
+        constexpr bool is_unit_quaternion(const quat<T>& _quat)
+        {
+            return difference_within_epsilon(length(_quat), 1);
+        }
+
+
+        template <std::floating_point T>
+        constexpr quat<T> conjugate(const quat<T>& _quat) noexcept
+        {
+            return {-_quat.x, -_quat.y, -_quat.z, _quat.w};
+        }
+
+
+        template <std::floating_point T>
+        constexpr quat<T> normalized(const quat<T>& _quat)
+        {
+            return quat<T>(vector::normalized(_quat.xyzw));
+        }
+
+
+        /**
+         * @brief Return the multiplicative inverse, which is the conjugate for unit
+         * quaternions
+         */
+        template <std::floating_point T>
+        constexpr quat<T> inverse(const quat<T>& _quat)
+        {
+            return conjugate(_quat) / dot(_quat, _quat);
+        }
+
+
+        /**
+         * @brief Return the rotation about axis by angle radians
+         *
+         * If axis has a length other than 1, the result will be incorrect.
+         * Set the macro GGMATH_DEBUG to 1 to throw an exception if it is NOT a
+         * unit-vector, otherwise the check is compiled out.
+         */
+        template <std::floating_point T>
+        quat<T> from_axis_angle(const vec<T, 3>& axis, T angle)
+            noexcept(!debug::enabled)
+        {
+            if constexpr (debug::enabled)
+            {
+                debug::throw_if_not_unit(axis);
+            }
+
+            const T half_angle = angle / 2;
+
+            return {axis * std::sin(half_angle), std::cos(half_angle)};
+        }
+
+
+        /**
+         * @brief Return the rotation about the unit vector axis by angle degrees
+         */
+        template <std::floating_point T>
+        quat<T> from_axis_angle_deg(const vec<T, 3>& axis, T angle)
+            noexcept(!debug::enabled)
+        {
+            return from_axis_angle(axis, static_cast<T>(deg_to_rad(angle)));
+        }
+
+
+        /**
+         * @brief Rotate _vec by the unit quaternion _quat
+         *
+         * Calculates v + w * t + u x t with t = 2 * u x v and u the imaginary part of
+         * _quat, which is cheaper than _quat * v * conjugate(_quat). Set the macro
+         * GGMATH_DEBUG to 1 to throw an exception if _quat is NOT a unit quaternion,
+         * otherwise the check is compiled out.
+         */
+        template <std::floating_point T>
+        constexpr vec<T, 3> rotate(const quat<T>& _quat, const vec<T, 3>& _vec)
+            noexcept(!debug::enabled)
+        {
+            if constexpr (debug::enabled)
+            {
+                debug::throw_if_not_unit(_quat);
+            }
+
+            const T t_x = 2 * (_quat.y * _vec[2] - _quat.z * _vec[1]);
+            const T t_y = 2 * (_quat.z * _vec[0] - _quat.x * _vec[2]);
+            const T t_z = 2 * (_quat.x * _vec[1] - _quat.y * _vec[0]);
+
+            return {_vec[0] + _quat.w * t_x + (_quat.y * t_z - _quat.z * t_y),
+                    _vec[1] + _quat.w * t_y + (_quat.z * t_x - _quat.x * t_z),
+                    _vec[2] + _quat.w * t_z + (_quat.x * t_y - _quat.y * t_x)};
+        }
+
+
+        /**
+         * @brief Return the rotation matrix of the unit quaternion _quat
+         */
+        template <std::floating_point T>
+        constexpr mat<T, 3, 3> to_mat33(const quat<T>& _quat) noexcept(!debug::enabled)
+        {
+            if constexpr (debug::enabled)
+            {
+                debug::throw_if_not_unit(_quat);
+            }
+
+            const auto [x, y, z, w] = _quat.xyzw.data;
+
+            return {1 - 2 * (y * y + z * z),
+                    2 * (x * y - z * w),
+                    2 * (x * z + y * w),
+                    2 * (x * y + z * w),
+                    1 - 2 * (x * x + z * z),
+                    2 * (y * z - x * w),
+                    2 * (x * z - y * w),
+                    2 * (y * z + x * w),
+                    1 - 2 * (x * x + y * y)};
+        }
+
+
+        /**
+         * @brief Return the rotation matrix of the unit quaternion _quat as an affine
+         * transformation
+         */
+        template <std::floating_point T>
+        constexpr mat<T, 4, 4> to_mat44(const quat<T>& _quat) noexcept(!debug::enabled)
+        {
+            const auto rotation = to_mat33(_quat);
+            auto       mat_out  = mat<T, 4, 4>::identity();
+
+            for (int i = 0; i < 3; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    mat_out[i][j] = rotation[i][j];
+                }
+            }
+
+            return mat_out;
+        }
+
+
+        /**
+         * @brief Return the normalized linear interpolation from a to b with a weight
+         * of t
+         *
+         * b is negated if that is closer to a, so the shorter of the two arcs is
+         * interpolated along. Faster than slerp, but the angular velocity is not
+         * constant.
+         */
+        template <std::floating_point T>
+        constexpr quat<T> nlerp(const quat<T>& a, const quat<T>& b, T t)
+        {
+            return detail::to_quat(detail::nlerp(a.xyzw.data, b.xyzw.data, t));
+        }
+
+
+        /**
+         * @brief Return the spherical linear interpolation from a to b with a weight
+         * of t
+         *
+         * Interpolates along the shorter arc with constant angular velocity. Falls
+         * back to nlerp if a and b are almost equal.
+         */
+        template <std::floating_point T>
+        quat<T> slerp(const quat<T>& a, const quat<T>& b, T t)
+        {
+            const T cos_angle = dot(a, b);
+            const T abs_cos   = std::abs(cos_angle);
+
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+            if (abs_cos > T(0.9995))
+            {
+                return nlerp(a, b, t);
+            }
+
+            const T angle     = std::acos(abs_cos);
+            const T sin_angle = std::sqrt(1 - abs_cos * abs_cos);
+
+            const T weight_a = std::sin((1 - t) * angle) / sin_angle;
+            const T weight_b = std::sin(t * angle) / sin_angle;
+
+            return detail::to_quat(detail::blend(a.xyzw.data,
+                                                 b.xyzw.data,
+                                                 weight_a,
+                                                 std::copysign(weight_b, cos_angle)));
+        }
+
+
+        /**
+         * @brief Return an approximation of slerp(a, b, t)
+         *
+         * An nlerp with a corrected weight, which has no branches or trigonometric
+         * functions. The rotation of the result is off by less than 1e-3 radians
+         * from the one of slerp for unit quaternions a and b.
+         */
+        template <std::floating_point T>
+        constexpr quat<T> fast_slerp(const quat<T>& a, const quat<T>& b, T t)
+        {
+            return detail::to_quat(detail::fast_slerp(a.xyzw.data, b.xyzw.data, t));
+        }
+
+
+        // endregion functions
+
+
+        // region batch functions
+
+
+        /**
+         * @brief Interpolate from every quaternion of a to the one at the same index
+         * of b with nlerp and a weight of t
+         *
+         * a, b and out have to be of equal size, out may be a or b itself. 4
+         * quaternions are interpolated at a time, with one packet per component.
+         */
+        template <std::floating_point T>
+        void nlerp(std::type_identity_t<std::span<const quat<T>>> a,
+                   std::type_identity_t<std::span<const quat<T>>> b,
+                   T                                              t,
+                   std::type_identity_t<std::span<quat<T>>>       out)
+        {
+            detail::for_each_pair(a, b, out, [t](const auto& a_i, const auto& b_i) {
+                return detail::nlerp(a_i, b_i, t);
+            });
+        }
+
+
+        /**
+         * @brief Interpolate from every quaternion of a to the one at the same index
+         * of b with slerp and a weight of t
+         *
+         * One quaternion at a time, since slerp branches and calls trigonometric
+         * functions.
+         */
+        template <std::floating_point T>
+        void slerp(std::type_identity_t<std::span<const quat<T>>> a,
+                   std::type_identity_t<std::span<const quat<T>>> b,
+                   T                                              t,
+                   std::type_identity_t<std::span<quat<T>>>       out)
+        {
+            debug::throw_if_not_equal_size(a.size(), b.size());
+            debug::throw_if_not_equal_size(a.size(), out.size());
+
+            for (std::size_t i = 0; i < a.size(); ++i)
+            {
+                out[i] = slerp(a[i], b[i], t);
+            }
+        }
+
+
+        /**
+         * @brief Interpolate from every quaternion of a to the one at the same index
+         * of b with fast_slerp and a weight of t
+         *
+         * 4 quaternions are interpolated at a time, with one packet per component.
+         */
+        template <std::floating_point T>
+        void fast_slerp(std::type_identity_t<std::span<const quat<T>>> a,
+                        std::type_identity_t<std::span<const quat<T>>> b,
+                        T                                              t,
+                        std::type_identity_t<std::span<quat<T>>>       out)
+        {
+            detail::for_each_pair(a, b, out, [t](const auto& a_i, const auto& b_i) {
+                return detail::fast_slerp(a_i, b_i, t);
+            });
+        }
+
+
+        /**
+         * @brief Rotate every vector of vectors by the unit quaternion at the same
+         * index of rotations
+         */
+        template <std::floating_point T>
+        void rotate(std::span<const quat<T>>                         rotations,
+                    std::type_identity_t<std::span<const vec<T, 3>>> vectors,
+                    std::type_identity_t<std::span<vec<T, 3>>>       out)
+        {
+            debug::throw_if_not_equal_size(rotations.size(), vectors.size());
+            debug::throw_if_not_equal_size(rotations.size(), out.size());
+
+            for (std::size_t i = 0; i < rotations.size(); ++i)
+            {
+                out[i] = rotate(rotations[i], vectors[i]);
+            }
+        }
+
+
+        // endregion batch functions
+    }    // namespace quaternion
+}    // namespace ggmath
+
+
+namespace ggmath::debug
+{
+    /**
+     * @brief Throw an invalid_argument exception if _quat has a length other than 1
+     */
+    template <std::floating_point T>
+    void throw_if_not_unit(const ggmath::quat<T>& _quat)
+    {
+        if (!ggmath::quaternion::is_unit_quaternion(_quat))
+        {
+            std::stringstream ss;
+
+            ss << "Parameter was expected to be a unit quaternion"
+                  "(A quaternion with a length of 1). "
+                  "Instead, it had a length of "
+               << ggmath::quaternion::length(_quat);
+
+            throw std::invalid_argument(ss.str());
+        }
+    }
+}    // namespace ggmath::debug
+#endif    // GG_MATH_QUAT_HPP
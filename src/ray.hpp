@@ -15,6 +15,97 @@
 // OTHER DEALINGS IN THE SOFTWARE.
 #ifndef GG_MATH_RAY_HPP
 #define GG_MATH_RAY_HPP
-namespace ggmath::ray
-{}        // namespace ggmath::ray
+#include <array>
+#include <concepts>
+#include <ostream>
+
+#include "vec.hpp"
+
+
+namespace ggmath
+{
+    // region classes
+
+
+    /**
+     * @brief A half-line starting at origin and going along direction
+     *
+     * The inverse of the direction and the signs of its components are calculated
+     * once on construction, so intersection tests multiply instead of divide and
+     * pick the near and far side of a box without comparing. direction does not
+     * have to be normalized, distances along the ray are multiples of it. Zero
+     * components of direction have an infinite inverse, which the intersection
+     * tests handle.
+     */
+    template <std::floating_point T>
+    struct ray
+    {
+        vec<T, 3> origin;
+        vec<T, 3> direction;
+        vec<T, 3> inverse_direction;
+
+        // 1 for the axes direction is negative along, 0 otherwise
+        std::array<int, 3> sign;
+
+
+        // region constructors
+
+
+        constexpr ray(const vec<T, 3>& _origin, const vec<T, 3>& _direction) :
+            origin(_origin[0], _origin[1], _origin[2]),
+            direction(_direction[0], _direction[1], _direction[2]),
+            inverse_direction(
+                1 / _direction[0], 1 / _direction[1], 1 / _direction[2]),
+            sign{inverse_direction[0] < 0,
+                 inverse_direction[1] < 0,
+                 inverse_direction[2] < 0}
+        {}
+
+
+        // endregion constructors
+
+
+        // region methods
+
+
+        /**
+         * @brief Return the point at distance t along the ray
+         */
+        constexpr vec<T, 3> at(T t) const
+        {
+            return {origin[0] + direction[0] * t,
+                    origin[1] + direction[1] * t,
+                    origin[2] + direction[2] * t};
+        }
+
+
+        // endregion methods
+    };
+
+
+    // endregion classes
+
+
+    // region using-directives
+
+
+    using rayf = ray<float>;
+    using rayd = ray<double>;
+
+
+    // endregion using-directives
+
+
+    // region operator_overloads
+
+
+    template <std::floating_point T>
+    std::ostream& operator<<(std::ostream& os, const ray<T>& _ray)
+    {
+        return os << _ray.origin << "->" << _ray.direction;
+    }
+
+
+    // endregion operator_overloads
+}    // namespace ggmath
 #endif    // GG_MATH_RAY_HPP
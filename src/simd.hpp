@@ -0,0 +1,1072 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#ifndef GG_MATH_SIMD_HPP
+#define GG_MATH_SIMD_HPP
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#ifndef GGMATH_SIMD
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#    define GGMATH_SIMD 0
+#endif
+
+#if defined(__AVX__)
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#    define GGMATH_SIMD_AVX 1
+#else
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#    define GGMATH_SIMD_AVX 0
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#    define GGMATH_SIMD_SSE 1
+#    include <immintrin.h>
+#else
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#    define GGMATH_SIMD_SSE 0
+#endif
+
+#if !GGMATH_SIMD_SSE && defined(__ARM_NEON) && defined(__aarch64__)
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#    define GGMATH_SIMD_NEON 1
+#    include <arm_neon.h>
+#else
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#    define GGMATH_SIMD_NEON 0
+#endif
+
+
+// The register types and kernels of this header are always available, using the best
+// instruction set the compiler targets, or plain loops if there is none. GGMATH_SIMD
+// only decides whether or not vec.hpp dispatches to them.
+namespace ggmath::simd
+{
+    // region configuration
+
+
+    /**
+     * @brief Whether or not vec.hpp dispatches to the kernels of this header
+     */
+    inline constexpr bool enabled = GGMATH_SIMD == 1;
+
+
+    /**
+     * @brief Check if operations on vec<T, n> are dispatched to the kernels of this
+     * header
+     *
+     * vec<float, 3> is padded to 16 bytes, its fourth lane is zeroed after every load.
+     */
+    template <typename T, int n>
+    concept accelerated = enabled
+                          && ((std::same_as<T, float> && (n == 3 || n == 4))
+                              || (std::same_as<T, double> && n == 4));
+
+
+    /**
+     * @brief The alignment of vec<T, n>, 16 or 32 bytes for accelerated vectors
+     */
+    template <typename T, int n>
+    inline constexpr std::size_t alignment =
+        accelerated<T, n> ? 4 * sizeof(T) : alignof(T);
+
+
+    /**
+     * @brief The number of elements the storage of vec<T, n> holds, 4 for
+     * accelerated vectors
+     */
+    template <typename T, int n>
+    inline constexpr int lanes = accelerated<T, n> ? 4 : n;
+
+
+    // endregion configuration
+
+
+    // region register types
+
+
+#if GGMATH_SIMD_SSE
+    using float4 = __m128;
+#elif GGMATH_SIMD_NEON
+    using float4 = float32x4_t;
+#else
+    struct float4
+    {
+        std::array<float, 4> lanes;
+    };
+#endif
+
+#if GGMATH_SIMD_AVX
+    using double4 = __m256d;
+#elif GGMATH_SIMD_SSE
+    struct double4
+    {
+        __m128d low;
+        __m128d high;
+    };
+#elif GGMATH_SIMD_NEON
+    struct double4
+    {
+        float64x2_t low;
+        float64x2_t high;
+    };
+#else
+    struct double4
+    {
+        std::array<double, 4> lanes;
+    };
+#endif
+
+
+    template <typename T>
+    struct register4;
+
+    template <>
+    struct register4<float>
+    {
+        using type = float4;
+    };
+
+    template <>
+    struct register4<double>
+    {
+        using type = double4;
+    };
+
+    /**
+     * @brief The register type holding 4 lanes of T
+     */
+    template <typename T>
+    using register4_t = typename register4<T>::type;
+
+
+    namespace detail
+    {
+        // Overloads instead of std::same_as, as naming __m128 or __m256d as a
+        // template argument drops their attributes and warns with -Wignored-attributes
+        void register_tag(const float4*) noexcept;
+        void register_tag(const double4*) noexcept;
+    }    // namespace detail
+
+
+    template <typename T_Register>
+    concept register_type = requires(const T_Register* a) { detail::register_tag(a); };
+
+
+    // endregion register types
+
+
+    // region float4
+
+
+#if GGMATH_SIMD_SSE
+
+
+    inline float4 load(const float* data) noexcept
+    {
+        return _mm_loadu_ps(data);
+    }
+
+
+    inline void store(float* data, float4 a) noexcept
+    {
+        _mm_storeu_ps(data, a);
+    }
+
+
+    inline float4 broadcast(float scalar) noexcept
+    {
+        return _mm_set1_ps(scalar);
+    }
+
+
+    inline float4 add(float4 a, float4 b) noexcept
+    {
+        return _mm_add_ps(a, b);
+    }
+
+
+    inline float4 sub(float4 a, float4 b) noexcept
+    {
+        return _mm_sub_ps(a, b);
+    }
+
+
+    inline float4 mul(float4 a, float4 b) noexcept
+    {
+        return _mm_mul_ps(a, b);
+    }
+
+
+    inline float4 div(float4 a, float4 b) noexcept
+    {
+        return _mm_div_ps(a, b);
+    }
+
+
+    inline float4 sqrt(float4 a) noexcept
+    {
+        return _mm_sqrt_ps(a);
+    }
+
+
+    // Operands are swapped to match std::min(a, b), which returns a unless b < a
+    inline float4 min(float4 a, float4 b) noexcept
+    {
+        return _mm_min_ps(b, a);
+    }
+
+
+    // Operands are swapped to match std::max(a, b), which returns a unless a < b
+    inline float4 max(float4 a, float4 b) noexcept
+    {
+        return _mm_max_ps(b, a);
+    }
+
+
+    inline float4 zero_w(float4 a) noexcept
+    {
+        return _mm_and_ps(a, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+    }
+
+
+    // Summation order: (a[0] + a[1]) + (a[2] + a[3])
+    inline float horizontal_sum(float4 a) noexcept
+    {
+        const float4 swapped = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+        const float4 pairs   = _mm_add_ps(a, swapped);
+
+        return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_movehl_ps(pairs, pairs)));
+    }
+
+
+    // Lane 3 of the result is a[3] * b[3] - a[3] * b[3]
+    inline float4 cross(float4 a, float4 b) noexcept
+    {
+        const float4 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+        const float4 a_zxy = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+        const float4 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+        const float4 b_zxy = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+
+        return _mm_sub_ps(_mm_mul_ps(a_yzx, b_zxy), _mm_mul_ps(a_zxy, b_yzx));
+    }
+
+
+#elif GGMATH_SIMD_NEON
+
+
+    inline float4 load(const float* data) noexcept
+    {
+        return vld1q_f32(data);
+    }
+
+
+    inline void store(float* data, float4 a) noexcept
+    {
+        vst1q_f32(data, a);
+    }
+
+
+    inline float4 broadcast(float scalar) noexcept
+    {
+        return vdupq_n_f32(scalar);
+    }
+
+
+    inline float4 add(float4 a, float4 b) noexcept
+    {
+        return vaddq_f32(a, b);
+    }
+
+
+    inline float4 sub(float4 a, float4 b) noexcept
+    {
+        return vsubq_f32(a, b);
+    }
+
+
+    inline float4 mul(float4 a, float4 b) noexcept
+    {
+        return vmulq_f32(a, b);
+    }
+
+
+    inline float4 div(float4 a, float4 b) noexcept
+    {
+        return vdivq_f32(a, b);
+    }
+
+
+    inline float4 sqrt(float4 a) noexcept
+    {
+        return vsqrtq_f32(a);
+    }
+
+
+    // Select lanes like std::min(a, b), which returns a unless b < a
+    inline float4 min(float4 a, float4 b) noexcept
+    {
+        return vbslq_f32(vcltq_f32(b, a), b, a);
+    }
+
+
+    // Select lanes like std::max(a, b), which returns a unless a < b
+    inline float4 max(float4 a, float4 b) noexcept
+    {
+        return vbslq_f32(vcltq_f32(a, b), b, a);
+    }
+
+
+    inline float4 zero_w(float4 a) noexcept
+    {
+        return vsetq_lane_f32(0.0F, a, 3);
+    }
+
+
+    // Summation order: (a[0] + a[1]) + (a[2] + a[3])
+    inline float horizontal_sum(float4 a) noexcept
+    {
+        const float4 pairs = vpaddq_f32(a, a);
+
+        return vgetq_lane_f32(pairs, 0) + vgetq_lane_f32(pairs, 1);
+    }
+
+
+    // Lane 3 of the result is a[3] * b[3] - a[3] * b[3]
+    inline float4 cross(float4 a, float4 b) noexcept
+    {
+        const float4 a_yzx = {vgetq_lane_f32(a, 1),
+                              vgetq_lane_f32(a, 2),
+                              vgetq_lane_f32(a, 0),
+                              vgetq_lane_f32(a, 3)};
+        const float4 a_zxy = {vgetq_lane_f32(a, 2),
+                              vgetq_lane_f32(a, 0),
+                              vgetq_lane_f32(a, 1),
+                              vgetq_lane_f32(a, 3)};
+        const float4 b_yzx = {vgetq_lane_f32(b, 1),
+                              vgetq_lane_f32(b, 2),
+                              vgetq_lane_f32(b, 0),
+                              vgetq_lane_f32(b, 3)};
+        const float4 b_zxy = {vgetq_lane_f32(b, 2),
+                              vgetq_lane_f32(b, 0),
+                              vgetq_lane_f32(b, 1),
+                              vgetq_lane_f32(b, 3)};
+
+        return vsubq_f32(vmulq_f32(a_yzx, b_zxy), vmulq_f32(a_zxy, b_yzx));
+    }
+
+
+#endif
+
+
+    // endregion float4
+
+
+    // region double4
+
+
+#if GGMATH_SIMD_AVX
+
+
+    inline double4 load(const double* data) noexcept
+    {
+        return _mm256_loadu_pd(data);
+    }
+
+
+    inline void store(double* data, double4 a) noexcept
+    {
+        _mm256_storeu_pd(data, a);
+    }
+
+
+    inline double4 broadcast(double scalar) noexcept
+    {
+        return _mm256_set1_pd(scalar);
+    }
+
+
+    inline double4 add(double4 a, double4 b) noexcept
+    {
+        return _mm256_add_pd(a, b);
+    }
+
+
+    inline double4 sub(double4 a, double4 b) noexcept
+    {
+        return _mm256_sub_pd(a, b);
+    }
+
+
+    inline double4 mul(double4 a, double4 b) noexcept
+    {
+        return _mm256_mul_pd(a, b);
+    }
+
+
+    inline double4 div(double4 a, double4 b) noexcept
+    {
+        return _mm256_div_pd(a, b);
+    }
+
+
+    inline double4 sqrt(double4 a) noexcept
+    {
+        return _mm256_sqrt_pd(a);
+    }
+
+
+    // Operands are swapped to match std::min(a, b), which returns a unless b < a
+    inline double4 min(double4 a, double4 b) noexcept
+    {
+        return _mm256_min_pd(b, a);
+    }
+
+
+    // Operands are swapped to match std::max(a, b), which returns a unless a < b
+    inline double4 max(double4 a, double4 b) noexcept
+    {
+        return _mm256_max_pd(b, a);
+    }
+
+
+    // Summation order: (a[0] + a[1]) + (a[2] + a[3])
+    inline double horizontal_sum(double4 a) noexcept
+    {
+        const __m128d low  = _mm256_castpd256_pd128(a);
+        const __m128d high = _mm256_extractf128_pd(a, 1);
+
+        return _mm_cvtsd_f64(_mm_add_sd(_mm_add_sd(low, _mm_unpackhi_pd(low, low)),
+                                        _mm_add_sd(high, _mm_unpackhi_pd(high, high))));
+    }
+
+
+#elif GGMATH_SIMD_SSE
+
+
+    inline double4 load(const double* data) noexcept
+    {
+        return {_mm_loadu_pd(data), _mm_loadu_pd(data + 2)};
+    }
+
+
+    inline void store(double* data, double4 a) noexcept
+    {
+        _mm_storeu_pd(data, a.low);
+        _mm_storeu_pd(data + 2, a.high);
+    }
+
+
+    inline double4 broadcast(double scalar) noexcept
+    {
+        return {_mm_set1_pd(scalar), _mm_set1_pd(scalar)};
+    }
+
+
+    inline double4 add(double4 a, double4 b) noexcept
+    {
+        return {_mm_add_pd(a.low, b.low), _mm_add_pd(a.high, b.high)};
+    }
+
+
+    inline double4 sub(double4 a, double4 b) noexcept
+    {
+        return {_mm_sub_pd(a.low, b.low), _mm_sub_pd(a.high, b.high)};
+    }
+
+
+    inline double4 mul(double4 a, double4 b) noexcept
+    {
+        return {_mm_mul_pd(a.low, b.low), _mm_mul_pd(a.high, b.high)};
+    }
+
+
+    inline double4 div(double4 a, double4 b) noexcept
+    {
+        return {_mm_div_pd(a.low, b.low), _mm_div_pd(a.high, b.high)};
+    }
+
+
+    inline double4 sqrt(double4 a) noexcept
+    {
+        return {_mm_sqrt_pd(a.low), _mm_sqrt_pd(a.high)};
+    }
+
+
+    // Operands are swapped to match std::min(a, b), which returns a unless b < a
+    inline double4 min(double4 a, double4 b) noexcept
+    {
+        return {_mm_min_pd(b.low, a.low), _mm_min_pd(b.high, a.high)};
+    }
+
+
+    // Operands are swapped to match std::max(a, b), which returns a unless a < b
+    inline double4 max(double4 a, double4 b) noexcept
+    {
+        return {_mm_max_pd(b.low, a.low), _mm_max_pd(b.high, a.high)};
+    }
+
+
+    // Summation order: (a[0] + a[1]) + (a[2] + a[3])
+    inline double horizontal_sum(double4 a) noexcept
+    {
+        return _mm_cvtsd_f64(
+            _mm_add_sd(_mm_add_sd(a.low, _mm_unpackhi_pd(a.low, a.low)),
+                       _mm_add_sd(a.high, _mm_unpackhi_pd(a.high, a.high))));
+    }
+
+
+#elif GGMATH_SIMD_NEON
+
+
+    inline double4 load(const double* data) noexcept
+    {
+        return {vld1q_f64(data), vld1q_f64(data + 2)};
+    }
+
+
+    inline void store(double* data, double4 a) noexcept
+    {
+        vst1q_f64(data, a.low);
+        vst1q_f64(data + 2, a.high);
+    }
+
+
+    inline double4 broadcast(double scalar) noexcept
+    {
+        return {vdupq_n_f64(scalar), vdupq_n_f64(scalar)};
+    }
+
+
+    inline double4 add(double4 a, double4 b) noexcept
+    {
+        return {vaddq_f64(a.low, b.low), vaddq_f64(a.high, b.high)};
+    }
+
+
+    inline double4 sub(double4 a, double4 b) noexcept
+    {
+        return {vsubq_f64(a.low, b.low), vsubq_f64(a.high, b.high)};
+    }
+
+
+    inline double4 mul(double4 a, double4 b) noexcept
+    {
+        return {vmulq_f64(a.low, b.low), vmulq_f64(a.high, b.high)};
+    }
+
+
+    inline double4 div(double4 a, double4 b) noexcept
+    {
+        return {vdivq_f64(a.low, b.low), vdivq_f64(a.high, b.high)};
+    }
+
+
+    inline double4 sqrt(double4 a) noexcept
+    {
+        return {vsqrtq_f64(a.low), vsqrtq_f64(a.high)};
+    }
+
+
+    // Select lanes like std::min(a, b), which returns a unless b < a
+    inline double4 min(double4 a, double4 b) noexcept
+    {
+        return {vbslq_f64(vcltq_f64(b.low, a.low), b.low, a.low),
+                vbslq_f64(vcltq_f64(b.high, a.high), b.high, a.high)};
+    }
+
+
+    // Select lanes like std::max(a, b), which returns a unless a < b
+    inline double4 max(double4 a, double4 b) noexcept
+    {
+        return {vbslq_f64(vcltq_f64(a.low, b.low), b.low, a.low),
+                vbslq_f64(vcltq_f64(a.high, b.high), b.high, a.high)};
+    }
+
+
+    // Summation order: (a[0] + a[1]) + (a[2] + a[3])
+    inline double horizontal_sum(double4 a) noexcept
+    {
+        return vaddvq_f64(a.low) + vaddvq_f64(a.high);
+    }
+
+
+#endif
+
+
+    // endregion double4
+
+
+    // region scalar fallback
+
+
+#if !GGMATH_SIMD_SSE && !GGMATH_SIMD_NEON
+
+
+    template <register_type T_Register, typename T_Operation>
+    inline T_Register map(T_Register a, T_Register b, T_Operation operation) noexcept
+    {
+        std::ranges::transform(a.lanes, b.lanes, std::begin(a.lanes), operation);
+        return a;
+    }
+
+
+    inline float4 load(const float* data) noexcept
+    {
+        float4 a;
+        std::copy_n(data, 4, std::begin(a.lanes));
+        return a;
+    }
+
+
+    inline double4 load(const double* data) noexcept
+    {
+        double4 a;
+        std::copy_n(data, 4, std::begin(a.lanes));
+        return a;
+    }
+
+
+    inline void store(float* data, float4 a) noexcept
+    {
+        std::ranges::copy(a.lanes, data);
+    }
+
+
+    inline void store(double* data, double4 a) noexcept
+    {
+        std::ranges::copy(a.lanes, data);
+    }
+
+
+    inline float4 broadcast(float scalar) noexcept
+    {
+        return {{scalar, scalar, scalar, scalar}};
+    }
+
+
+    inline double4 broadcast(double scalar) noexcept
+    {
+        return {{scalar, scalar, scalar, scalar}};
+    }
+
+
+    template <register_type T_Register>
+    inline T_Register add(T_Register a, T_Register b) noexcept
+    {
+        return map(a, b, std::plus<>());
+    }
+
+
+    template <register_type T_Register>
+    inline T_Register sub(T_Register a, T_Register b) noexcept
+    {
+        return map(a, b, std::minus<>());
+    }
+
+
+    template <register_type T_Register>
+    inline T_Register mul(T_Register a, T_Register b) noexcept
+    {
+        return map(a, b, std::multiplies<>());
+    }
+
+
+    template <register_type T_Register>
+    inline T_Register div(T_Register a, T_Register b) noexcept
+    {
+        return map(a, b, std::divides<>());
+    }
+
+
+    template <register_type T_Register>
+    inline T_Register sqrt(T_Register a) noexcept
+    {
+        std::ranges::transform(
+            a.lanes, std::begin(a.lanes), [](auto lane) { return std::sqrt(lane); });
+        return a;
+    }
+
+
+    template <register_type T_Register>
+    inline T_Register min(T_Register a, T_Register b) noexcept
+    {
+        return map(a, b, [](auto x, auto y) { return std::min(x, y); });
+    }
+
+
+    template <register_type T_Register>
+    inline T_Register max(T_Register a, T_Register b) noexcept
+    {
+        return map(a, b, [](auto x, auto y) { return std::max(x, y); });
+    }
+
+
+    inline float4 zero_w(float4 a) noexcept
+    {
+        a.lanes[3] = 0;
+        return a;
+    }
+
+
+    // Summation order: (a[0] + a[1]) + (a[2] + a[3])
+    template <register_type T_Register>
+    inline auto horizontal_sum(T_Register a) noexcept
+    {
+        return (a.lanes[0] + a.lanes[1]) + (a.lanes[2] + a.lanes[3]);
+    }
+
+
+    // Lane 3 of the result is a[3] * b[3] - a[3] * b[3]
+    inline float4 cross(float4 a, float4 b) noexcept
+    {
+        const auto& x = a.lanes;
+        const auto& y = b.lanes;
+
+        return {{x[1] * y[2] - x[2] * y[1],
+                 x[2] * y[0] - x[0] * y[2],
+                 x[0] * y[1] - x[1] * y[0],
+                 x[3] * y[3] - x[3] * y[3]}};
+    }
+
+
+#endif
+
+
+    // endregion scalar fallback
+
+
+    // region composite kernels
+
+
+    /**
+     * @brief The scalar type of one lane of T_Register
+     */
+    template <register_type T_Register>
+    using lane_t = decltype(horizontal_sum(std::declval<T_Register>()));
+
+
+    /**
+     * @brief Calculate the dot product of the 4 lanes of a and b
+     */
+    template <register_type T_Register>
+    inline auto dot(T_Register a, T_Register b) noexcept
+    {
+        return horizontal_sum(mul(a, b));
+    }
+
+
+    template <register_type T_Register, typename T>
+    inline T_Register scale(T_Register a, T scalar) noexcept
+    {
+        return mul(a, broadcast(static_cast<lane_t<T_Register>>(scalar)));
+    }
+
+
+    /**
+     * @brief Return a scaled to a length of 1
+     */
+    template <register_type T_Register>
+    inline T_Register normalize(T_Register a) noexcept
+    {
+        return div(a, sqrt(broadcast(dot(a, a))));
+    }
+
+
+    /**
+     * @brief Return the linear interpolation from a to b with a weight of t
+     */
+    template <register_type T_Register, typename T>
+    inline T_Register lerp(T_Register a, T_Register b, T t) noexcept
+    {
+        return add(a, mul(broadcast(static_cast<lane_t<T_Register>>(t)), sub(b, a)));
+    }
+
+
+    // endregion composite kernels
+
+
+    // region matrix kernels
+
+
+    /**
+     * @brief Multiply the row-major 4x4 matrices a and b into out
+     *
+     * Row i of out is the sum of the rows of b weighted by the elements of row i of
+     * a. out may alias a or b.
+     */
+    template <typename T>
+    requires std::same_as<T, float> || std::same_as<T, double>
+    inline void multiply4x4(const T* a, const T* b, T* out) noexcept
+    {
+#if GGMATH_SIMD_AVX
+        if constexpr (std::same_as<T, float>)
+        {
+            // Two rows of a and out per register, the rows of b in both halves
+            const auto row_of_b = [b](int i)
+            {
+                return _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4 * i));
+            };
+
+            const __m256 b0 = row_of_b(0);
+            const __m256 b1 = row_of_b(1);
+            const __m256 b2 = row_of_b(2);
+            const __m256 b3 = row_of_b(3);
+
+            const auto rows_times_b = [&](__m256 rows)
+            {
+                const __m256 x = _mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(0, 0, 0, 0));
+                const __m256 y = _mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(1, 1, 1, 1));
+                const __m256 z = _mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(2, 2, 2, 2));
+                const __m256 w = _mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(3, 3, 3, 3));
+
+                return _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(x, b0), _mm256_mul_ps(y, b1)),
+                    _mm256_add_ps(_mm256_mul_ps(z, b2), _mm256_mul_ps(w, b3)));
+            };
+
+            const __m256 out01 = rows_times_b(_mm256_loadu_ps(a));
+            const __m256 out23 = rows_times_b(_mm256_loadu_ps(a + 8));
+
+            _mm256_storeu_ps(out, out01);
+            _mm256_storeu_ps(out + 8, out23);
+            return;
+        }
+#endif
+
+        const auto b0 = load(b);
+        const auto b1 = load(b + 4);
+        const auto b2 = load(b + 8);
+        const auto b3 = load(b + 12);
+
+        const auto row_times_b = [&](const T* row)
+        {
+            return add(add(mul(broadcast(row[0]), b0), mul(broadcast(row[1]), b1)),
+                       add(mul(broadcast(row[2]), b2), mul(broadcast(row[3]), b3)));
+        };
+
+        // All rows are calculated before the first store, in case out aliases a
+        const auto out0 = row_times_b(a);
+        const auto out1 = row_times_b(a + 4);
+        const auto out2 = row_times_b(a + 8);
+        const auto out3 = row_times_b(a + 12);
+
+        store(out, out0);
+        store(out + 4, out1);
+        store(out + 8, out2);
+        store(out + 12, out3);
+    }
+
+
+#if GGMATH_SIMD_SSE
+
+
+    template <int x, int y, int z, int w>
+    inline float4 shuffle(float4 a, float4 b) noexcept
+    {
+        return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x));
+    }
+
+
+    /**
+     * @brief Invert the row-major 4x4 matrix a into out and return its determinant
+     *
+     * Calculates the cofactors from the 2x2 determinants of the upper and the lower
+     * two rows, one row of the adjugate per register. If the determinant is 0, out
+     * holds infinities or NaNs. out may alias a.
+     */
+    inline float inverse4x4(const float* a, float* out) noexcept
+    {
+        const float4 row0 = _mm_loadu_ps(a);
+        const float4 row1 = _mm_loadu_ps(a + 4);
+        const float4 row2 = _mm_loadu_ps(a + 8);
+        const float4 row3 = _mm_loadu_ps(a + 12);
+
+        // Column i as (a[1][i], a[0][i], a[3][i], a[2][i])
+        float4 x0 = row1;
+        float4 x1 = row0;
+        float4 x2 = row3;
+        float4 x3 = row2;
+        _MM_TRANSPOSE4_PS(x0, x1, x2, x3);
+
+        // The first and second rows of the lower and upper 2x2 blocks of column i,
+        // (a[2][i], a[2][i], a[0][i], a[0][i]) and (a[3][i], a[3][i], a[1][i], a[1][i])
+        const float4 first0  = shuffle<0, 0, 0, 0>(row2, row0);
+        const float4 first1  = shuffle<1, 1, 1, 1>(row2, row0);
+        const float4 first2  = shuffle<2, 2, 2, 2>(row2, row0);
+        const float4 first3  = shuffle<3, 3, 3, 3>(row2, row0);
+        const float4 second0 = shuffle<0, 0, 0, 0>(row3, row1);
+        const float4 second1 = shuffle<1, 1, 1, 1>(row3, row1);
+        const float4 second2 = shuffle<2, 2, 2, 2>(row3, row1);
+        const float4 second3 = shuffle<3, 3, 3, 3>(row3, row1);
+
+        // The 2x2 determinants of columns i and j, of the lower two rows in lanes 0
+        // and 1 and of the upper two rows in lanes 2 and 3
+        const auto determinant2x2 =
+            [](float4 first_i, float4 second_i, float4 first_j, float4 second_j)
+        {
+            return _mm_sub_ps(_mm_mul_ps(first_i, second_j),
+                              _mm_mul_ps(second_i, first_j));
+        };
+
+        const float4 d01 = determinant2x2(first0, second0, first1, second1);
+        const float4 d02 = determinant2x2(first0, second0, first2, second2);
+        const float4 d03 = determinant2x2(first0, second0, first3, second3);
+        const float4 d12 = determinant2x2(first1, second1, first2, second2);
+        const float4 d13 = determinant2x2(first1, second1, first3, second3);
+        const float4 d23 = determinant2x2(first2, second2, first3, second3);
+
+        const auto cofactors = [](float4 x, float4 d_x, float4 y, float4 d_y, float4 z,
+                                  float4 d_z)
+        {
+            return _mm_add_ps(_mm_sub_ps(_mm_mul_ps(x, d_x), _mm_mul_ps(y, d_y)),
+                              _mm_mul_ps(z, d_z));
+        };
+
+        // The rows of the adjugate, without their alternating signs
+        const float4 adjugate0 = cofactors(x1, d23, x2, d13, x3, d12);
+        const float4 adjugate1 = cofactors(x0, d23, x2, d03, x3, d02);
+        const float4 adjugate2 = cofactors(x0, d13, x1, d03, x3, d01);
+        const float4 adjugate3 = cofactors(x0, d12, x1, d02, x2, d01);
+
+        // Row 0 of the adjugate times column 0 of a
+        const float4 signs = _mm_setr_ps(1, -1, 1, -1);
+        const float  determinant =
+            horizontal_sum(_mm_mul_ps(_mm_mul_ps(adjugate0, signs),
+                                      _mm_shuffle_ps(x0, x0, _MM_SHUFFLE(2, 3, 0, 1))));
+
+        const float4 even = _mm_div_ps(signs, _mm_set1_ps(determinant));
+        const float4 odd  = _mm_sub_ps(_mm_setzero_ps(), even);
+
+        _mm_storeu_ps(out, _mm_mul_ps(adjugate0, even));
+        _mm_storeu_ps(out + 4, _mm_mul_ps(adjugate1, odd));
+        _mm_storeu_ps(out + 8, _mm_mul_ps(adjugate2, even));
+        _mm_storeu_ps(out + 12, _mm_mul_ps(adjugate3, odd));
+
+        return determinant;
+    }
+
+
+#endif
+
+
+    /**
+     * @brief Transform count vectors by the row-major 4x4 matrix a
+     *
+     * The vectors are 4 values apart, starting at in and out. If n is 3, their
+     * fourth lane is ignored and w is used in its place. If Divide is true, every
+     * result is divided by its fourth lane. out may alias in.
+     */
+    template <int n, bool Divide, typename T>
+    requires(std::same_as<T, float> || std::same_as<T, double>) && (n == 3 || n == 4)
+    inline void
+        transform4x4(const T* a, const T* in, T* out, std::size_t count, T w) noexcept
+    {
+        // The result is the sum of the columns of a weighted by the lanes of a vector
+        std::array<T, 16> columns{};
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                columns[4 * j + i] = a[4 * i + j];
+            }
+        }
+
+        std::size_t i = 0;
+
+#if GGMATH_SIMD_AVX
+        if constexpr (std::same_as<T, float>)
+        {
+            // Two vectors per register, the columns of a in both halves
+            const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(
+                columns.data()));
+            const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(
+                columns.data() + 4));
+            const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(
+                columns.data() + 8));
+            const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(
+                columns.data() + 12));
+            const __m256 c3_times_w = _mm256_mul_ps(c3, _mm256_set1_ps(w));
+
+            for (; i + 2 <= count; i += 2)
+            {
+                const __m256 v = _mm256_loadu_ps(in + 4 * i);
+                const __m256 x = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+                const __m256 y = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+                const __m256 z = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+
+                __m256 weighted_w = c3_times_w;
+                if constexpr (n == 4)
+                {
+                    weighted_w = _mm256_mul_ps(
+                        _mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), c3);
+                }
+
+                const __m256 xy =
+                    _mm256_add_ps(_mm256_mul_ps(x, c0), _mm256_mul_ps(y, c1));
+                const __m256 zw = _mm256_add_ps(_mm256_mul_ps(z, c2), weighted_w);
+                __m256 result   = _mm256_add_ps(xy, zw);
+
+                if constexpr (Divide)
+                {
+                    const __m256 w_out =
+                        _mm256_shuffle_ps(result, result, _MM_SHUFFLE(3, 3, 3, 3));
+                    result = _mm256_div_ps(result, w_out);
+                }
+
+                _mm256_storeu_ps(out + 4 * i, result);
+            }
+        }
+#endif
+
+        const auto c0         = load(columns.data());
+        const auto c1         = load(columns.data() + 4);
+        const auto c2         = load(columns.data() + 8);
+        const auto c3         = load(columns.data() + 12);
+        const auto c3_times_w = mul(c3, broadcast(w));
+
+        for (; i < count; ++i)
+        {
+            const T* v = in + 4 * i;
+
+            const T    w_in       = n == 4 ? v[3] : w;
+            const auto weighted_w = n == 4 ? mul(broadcast(w_in), c3) : c3_times_w;
+
+            auto result = add(add(mul(broadcast(v[0]), c0), mul(broadcast(v[1]), c1)),
+                              add(mul(broadcast(v[2]), c2), weighted_w));
+
+            if constexpr (Divide)
+            {
+                // The fourth row of a times the vector, instead of extracting a lane
+                const T w_out =
+                    a[12] * v[0] + a[13] * v[1] + a[14] * v[2] + a[15] * w_in;
+                result = div(result, broadcast(w_out));
+            }
+
+            store(out + 4 * i, result);
+        }
+    }
+
+
+    // endregion matrix kernels
+}    // namespace ggmath::simd
+
+#endif    // GG_MATH_SIMD_HPP
@@ -0,0 +1,622 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#ifndef GG_MATH_SPATIAL_HASH_HPP
+#define GG_MATH_SPATIAL_HASH_HPP
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+
+namespace ggmath::spatial_hash
+{
+    // region classes
+
+
+    /**
+     * @brief The settings of build()
+     */
+    struct build_options
+    {
+        // The pool building the grid, nullptr to build it on the calling thread
+        parallel::thread_pool* pool = &parallel::thread_pool::shared();
+    };
+
+
+    /**
+     * @brief The settings of neighbors()
+     */
+    struct neighbor_options
+    {
+        // The pool searching for neighbors, nullptr to search on the calling thread
+        parallel::thread_pool* pool = &parallel::thread_pool::shared();
+    };
+
+
+    /**
+     * @brief A point of a grid and its index in the points the grid was built from
+     *
+     * Position and index share 16 bytes, so a bucket, which is at a random place
+     * in memory, is read from as few cache lines as possible.
+     */
+    struct entry
+    {
+        std::array<float, 3> position;
+        std::uint32_t        index;
+    };
+
+
+    /**
+     * @brief Points sorted into the cubic cells of an unbounded grid, made by build()
+     *
+     * The cells are hashed into buckets, a power of two of them, at least 64 and
+     * at least twice as many as points. The points of bucket b are the entries
+     * from bucket_starts[b] up to bucket_starts[b + 1]. A bucket may hold the
+     * points of several cells.
+     */
+    struct grid
+    {
+        float                      cell_size = 1;
+        std::vector<std::uint32_t> bucket_starts;
+        std::vector<entry>         entries;
+    };
+
+
+    /**
+     * @brief The neighbors of several points stored back to back, made by
+     * neighbors()
+     *
+     * The neighbors of point i are indices[offsets[i]], ...,
+     * indices[offsets[i + 1] - 1].
+     */
+    struct neighbor_lists
+    {
+        std::vector<std::size_t>   offsets;
+        std::vector<std::uint32_t> indices;
+
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return offsets.empty() ? 0 : offsets.size() - 1;
+        }
+
+
+        std::span<const std::uint32_t> operator[](std::size_t i) const noexcept
+        {
+            return std::span<const std::uint32_t>(indices).subspan(
+                offsets[i], offsets[i + 1] - offsets[i]);
+        }
+    };
+
+
+    // endregion classes
+
+
+    // region helpers
+
+
+    namespace detail
+    {
+        // The points of a grain of the passes over them, which read a point and
+        // write its entry and bucket
+        inline constexpr std::size_t grain =
+            parallel::grain_size(2 * sizeof(entry) + sizeof(std::uint32_t));
+
+        // Cell coordinates are clamped to this, so they fit into an int32_t
+        inline constexpr float cell_limit = 1 << 30;
+
+        // Queries touching up to this many rows of blocks keep their bucket ranges
+        // on the stack
+        inline constexpr std::size_t local_ranges = 32;
+
+        /**
+         * @brief Check if parallel::parallel_for runs the grains of [0, size) on
+         * several threads of pool at once
+         */
+        inline bool concurrent(parallel::thread_pool* pool,
+                               std::size_t            size,
+                               std::size_t            _grain) noexcept
+        {
+            return pool != nullptr && pool->size() > 1 && size > _grain;
+        }
+
+
+        /**
+         * @brief Replace every value by the sum of it and the ones before it
+         *
+         * The grains are summed at once, then offset by the sums of the grains
+         * before them.
+         */
+        template <typename T>
+        void inclusive_scan(std::span<T> values, parallel::thread_pool* pool)
+        {
+            constexpr std::size_t scan_grain = parallel::grain_size(sizeof(T));
+
+            if (!concurrent(pool, values.size(), scan_grain))
+            {
+                std::inclusive_scan(values.begin(), values.end(), values.begin());
+                return;
+            }
+
+            std::vector<T> sums((values.size() + scan_grain - 1) / scan_grain);
+
+            const auto sum = [&](std::size_t first, std::size_t last) {
+                sums[first / scan_grain] =
+                    std::accumulate(values.begin() + static_cast<std::ptrdiff_t>(first),
+                                    values.begin() + static_cast<std::ptrdiff_t>(last),
+                                    T(0));
+            };
+            parallel::parallel_for(pool, values.size(), scan_grain, sum);
+
+            std::exclusive_scan(sums.begin(), sums.end(), sums.begin(), T(0));
+
+            const auto scan = [&](std::size_t first, std::size_t last) {
+                const auto begin = values.begin() + static_cast<std::ptrdiff_t>(first);
+                const auto end   = values.begin() + static_cast<std::ptrdiff_t>(last);
+                std::inclusive_scan(
+                    begin, end, begin, std::plus<>(), sums[first / scan_grain]);
+            };
+            parallel::parallel_for(pool, values.size(), scan_grain, scan);
+        }
+
+
+        /**
+         * @brief Add 1 to value and return the new value, atomically if concurrent
+         */
+        inline std::uint32_t increment(std::uint32_t& value, bool concurrent) noexcept
+        {
+            if (concurrent)
+            {
+                return std::atomic_ref(value).fetch_add(1, std::memory_order_relaxed)
+                       + 1;
+            }
+
+            return ++value;
+        }
+
+
+        /**
+         * @brief Subtract 1 from value and return the new value, atomically if
+         * concurrent
+         */
+        inline std::uint32_t decrement(std::uint32_t& value, bool concurrent) noexcept
+        {
+            if (concurrent)
+            {
+                return std::atomic_ref(value).fetch_sub(1, std::memory_order_relaxed)
+                       - 1;
+            }
+
+            return --value;
+        }
+
+
+        /**
+         * @brief Return the cell along one axis that coordinate is in
+         */
+        inline std::int32_t cell_of(float coordinate, float inverse_cell_size) noexcept
+        {
+            const float cell = std::floor(coordinate * inverse_cell_size);
+
+            // NaN goes to the lowest cell
+            return static_cast<std::int32_t>(
+                cell >= -cell_limit ? std::min(cell, cell_limit) : -cell_limit);
+        }
+
+
+        // The buckets from first up to last
+        struct bucket_range
+        {
+            std::uint32_t first;
+            std::uint32_t last;
+
+
+            constexpr auto operator<=>(const bucket_range&) const noexcept = default;
+        };
+
+
+        /**
+         * @brief Maps points and cells to the buckets of a grid
+         */
+        struct hasher
+        {
+            float         inverse_cell_size;
+            std::uint32_t mask;
+
+
+            hasher(float cell_size, std::size_t buckets) noexcept :
+                inverse_cell_size(1 / cell_size),
+                mask(static_cast<std::uint32_t>(buckets - 1))
+            {}
+
+
+            /**
+             * @brief Return the bucket of the cell x, y, z
+             *
+             * The cells are grouped into blocks of 4 x 4 x 4, which take up 64
+             * buckets in a row. So the 27 cells around a point are in a few places
+             * in memory, and points queried in the order of the buckets find their
+             * neighbors in the caches. The block is hashed by multiplying its
+             * coordinates with large primes and mixing their sum with the
+             * finalizer of MurmurHash3, which makes close blocks unrelated.
+             */
+            [[nodiscard]] std::uint32_t bucket(std::int32_t x,
+                                               std::int32_t y,
+                                               std::int32_t z) const noexcept
+            {
+                auto hash = static_cast<std::uint32_t>(x >> 2) * 0x8da6'b343U
+                            + static_cast<std::uint32_t>(y >> 2) * 0xd816'3841U
+                            + static_cast<std::uint32_t>(z >> 2) * 0xcb1a'b31fU;
+
+                hash ^= hash >> 16U;
+                hash *= 0x85eb'ca6bU;
+                hash ^= hash >> 13U;
+                hash *= 0xc2b2'ae35U;
+                hash ^= hash >> 16U;
+
+                const auto cell = static_cast<std::uint32_t>(x & 3)
+                                  | static_cast<std::uint32_t>(y & 3) << 2U
+                                  | static_cast<std::uint32_t>(z & 3) << 4U;
+
+                return (hash << 6U | cell) & mask;
+            }
+
+
+            [[nodiscard]] std::uint32_t
+                bucket(const std::array<float, 3>& point) const noexcept
+            {
+                return bucket(cell_of(point[0], inverse_cell_size),
+                              cell_of(point[1], inverse_cell_size),
+                              cell_of(point[2], inverse_cell_size));
+            }
+        };
+
+
+        /**
+         * @brief Return a grid of size points, point i is point_at(i)
+         *
+         * A counting sort: the points of every bucket are counted, the counts summed
+         * up to the end of every bucket, and then every point is put before the end
+         * of its bucket, which moves down to the start of the bucket. Each pass runs
+         * on the threads of pool at once, with atomic counts, so the order of the
+         * points within a bucket is only the order they were given in for a single
+         * thread.
+         */
+        template <typename T_Point_At>
+        grid build_grid(std::size_t            size,
+                        T_Point_At             point_at,
+                        float                  cell_size,
+                        parallel::thread_pool* pool)
+        {
+            if (size >= std::size_t(1) << 30U)
+            {
+                throw std::length_error("spatial_hash::build: too many points");
+            }
+            if (!(cell_size > 0))
+            {
+                throw std::invalid_argument(
+                    "spatial_hash::build: cell size not positive");
+            }
+
+            const auto buckets = std::bit_ceil(std::max<std::size_t>(2 * size, 64));
+            const auto _hasher = hasher(cell_size, buckets);
+
+            const bool _concurrent = concurrent(pool, size, grain);
+
+            auto _grid      = grid();
+            _grid.cell_size = cell_size;
+            _grid.bucket_starts.assign(buckets + 1, 0);
+            _grid.entries.resize(size);
+
+            auto& starts = _grid.bucket_starts;
+            auto  keys   = std::vector<std::uint32_t>(size);
+
+            const auto count = [&](std::size_t first, std::size_t last) {
+                for (auto i = first; i < last; ++i)
+                {
+                    keys[i] = _hasher.bucket(point_at(i));
+                    increment(starts[keys[i]], _concurrent);
+                }
+            };
+            parallel::parallel_for(pool, size, grain, count);
+
+            inclusive_scan(std::span(starts).first(buckets), pool);
+            starts[buckets] = static_cast<std::uint32_t>(size);
+
+            const auto sort = [&](std::size_t first, std::size_t last) {
+                // Backwards, so a single thread keeps the order of the points
+                for (auto i = last; i-- > first;)
+                {
+                    const auto slot = decrement(starts[keys[i]], _concurrent);
+
+                    _grid.entries[slot] = {point_at(i), static_cast<std::uint32_t>(i)};
+                }
+            };
+            parallel::parallel_for(pool, size, grain, sort);
+
+            return _grid;
+        }
+
+
+        /**
+         * @brief Append the indices of the points of _grid within radius of center
+         * to out
+         *
+         * The buckets of the cells the sphere of the query touches are collected
+         * as ranges, the cells of a row within a block are in consecutive buckets.
+         * Cells may share buckets, so overlapping ranges are merged, then every
+         * point of them is checked once. Queries touching more cells than there
+         * are buckets check all points.
+         */
+        inline void append_within(const grid&                 _grid,
+                                  const std::array<float, 3>& center,
+                                  float                       radius,
+                                  std::vector<std::uint32_t>& out)
+        {
+            if (!(radius >= 0) || _grid.entries.empty())
+            {
+                return;
+            }
+
+            const std::size_t buckets = _grid.bucket_starts.size() - 1;
+            const auto        _hasher = hasher(_grid.cell_size, buckets);
+            const float       radius_squared = radius * radius;
+
+            // Every point is written after the hits so far and kept if it is one,
+            // without a branch that is as unpredictable as the hits
+            const auto scan = [&](std::size_t first, std::size_t last) {
+                const auto before = out.size();
+                out.resize(before + last - first);
+
+                auto* hits  = out.data() + before;
+                auto  count = std::size_t(0);
+                for (auto k = first; k < last; ++k)
+                {
+                    const auto& _entry = _grid.entries[k];
+
+                    const float d_x = _entry.position[0] - center[0];
+                    const float d_y = _entry.position[1] - center[1];
+                    const float d_z = _entry.position[2] - center[2];
+
+                    const float distance_squared = d_x * d_x + d_y * d_y + d_z * d_z;
+
+                    hits[count] = _entry.index;
+                    count += distance_squared <= radius_squared ? 1 : 0;
+                }
+
+                out.resize(before + count);
+            };
+
+            std::array<std::int32_t, 3> low;
+            std::array<std::int32_t, 3> high;
+            std::uint64_t               cells = 1;
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                low[axis]  = cell_of(center[axis] - radius, _hasher.inverse_cell_size);
+                high[axis] = cell_of(center[axis] + radius, _hasher.inverse_cell_size);
+
+                const auto extent = static_cast<std::uint64_t>(
+                    std::int64_t(high[axis]) - std::int64_t(low[axis]) + 1);
+
+                // Saturate instead of wrapping around for huge spheres
+                cells = cells > buckets / extent ? buckets + 1 : cells * extent;
+            }
+
+            if (cells > buckets)
+            {
+                scan(0, _grid.entries.size());
+                return;
+            }
+
+            // Every row of cells is split into one range per block it spans
+            const auto row_length = static_cast<std::uint64_t>(
+                std::int64_t(high[0]) - std::int64_t(low[0]) + 1);
+            const auto row_blocks = static_cast<std::uint64_t>(
+                std::int64_t(high[0] >> 2) - std::int64_t(low[0] >> 2) + 1);
+            const auto count =
+                static_cast<std::size_t>(cells / row_length * row_blocks);
+
+            std::array<bucket_range, local_ranges> local;
+            std::vector<bucket_range>              heap;
+            if (count > local_ranges)
+            {
+                heap.resize(count);
+            }
+            const auto ranges =
+                count <= local_ranges ? std::span(local).first(count) : std::span(heap);
+
+            auto next = ranges.begin();
+            for (auto z = low[2]; z <= high[2]; ++z)
+            {
+                for (auto y = low[1]; y <= high[1]; ++y)
+                {
+                    for (auto x = low[0]; x <= high[0];)
+                    {
+                        const auto last_x = std::min(high[0], x | 3);
+                        const auto first  = _hasher.bucket(x, y, z);
+
+                        *next++ = {first, first + std::uint32_t(last_x - x) + 1};
+                        x       = last_x + 1;
+                    }
+                }
+            }
+
+            std::sort(ranges.begin(), ranges.end());
+
+            auto merged = ranges.front();
+            for (const auto& range : ranges.subspan(1))
+            {
+                if (range.first > merged.last)
+                {
+                    scan(_grid.bucket_starts[merged.first],
+                         _grid.bucket_starts[merged.last]);
+                    merged = range;
+                }
+                merged.last = std::max(merged.last, range.last);
+            }
+            scan(_grid.bucket_starts[merged.first], _grid.bucket_starts[merged.last]);
+        }
+    }    // namespace detail
+
+
+    // endregion helpers
+
+
+    // region build
+
+
+    /**
+     * @brief Return a grid of cells of cell_size over points
+     *
+     * Queries for a radius of about cell_size are the fastest, they scan the
+     * buckets of 8 to 27 cells. The threads of options.pool build the grid at
+     * once. Throws std::invalid_argument if cell_size is not positive and
+     * std::length_error for 2^30 or more points.
+     */
+    inline grid build(std::span<const vec3f> points,
+                      float                  cell_size,
+                      const build_options&   options = {})
+    {
+        const auto point_at = [points](std::size_t i) {
+            return std::array<float, 3>{points[i][0], points[i][1], points[i][2]};
+        };
+
+        return detail::build_grid(points.size(), point_at, cell_size, options.pool);
+    }
+
+
+    /**
+     * @brief Return a grid of cells of cell_size over points stored as structure of
+     * arrays
+     */
+    inline grid build(const vec_soa<float, 3>& points,
+                      float                    cell_size,
+                      const build_options&     options = {})
+    {
+        const auto x = points.column(0);
+        const auto y = points.column(1);
+        const auto z = points.column(2);
+
+        const auto point_at = [x, y, z](std::size_t i) {
+            return std::array<float, 3>{x[i], y[i], z[i]};
+        };
+
+        return detail::build_grid(points.size(), point_at, cell_size, options.pool);
+    }
+
+
+    // endregion build
+
+
+    // region queries
+
+
+    /**
+     * @brief Append the indices of the points of _grid within radius of center to
+     * neighbors and return their number
+     *
+     * The points are in no particular order, a point at center is included.
+     */
+    inline std::size_t within_radius(const grid&                 _grid,
+                                      const vec3f&                center,
+                                      float                       radius,
+                                      std::vector<std::uint32_t>& neighbors)
+    {
+        const auto before = neighbors.size();
+
+        detail::append_within(
+            _grid, {center[0], center[1], center[2]}, radius, neighbors);
+
+        return neighbors.size() - before;
+    }
+
+
+    /**
+     * @brief Return the points within radius of every point of _grid, indexed as
+     * the points _grid was built from
+     *
+     * Every point is its own neighbor. The points are queried in the order of the
+     * buckets, which keeps the buckets their neighbors are in in the caches, on
+     * the threads of options.pool at once.
+     */
+    inline neighbor_lists neighbors(const grid&             _grid,
+                                    float                   radius,
+                                    const neighbor_options& options = {})
+    {
+        const std::size_t size  = _grid.entries.size();
+        const std::size_t grain = detail::grain;
+
+        auto lists = neighbor_lists();
+        lists.offsets.assign(size + 1, 0);
+
+        // The neighbors found by each grain, in the order of the buckets. Both
+        // passes run on the same pool, so they see the same ranges.
+        auto found = std::vector<std::vector<std::uint32_t>>(size / grain + 1);
+
+        parallel::parallel_for(
+            options.pool, size, grain, [&](std::size_t first, std::size_t last) {
+                auto& out = found[first / grain];
+
+                for (auto k = first; k < last; ++k)
+                {
+                    const auto& _entry = _grid.entries[k];
+                    const auto  before = out.size();
+
+                    detail::append_within(_grid, _entry.position, radius, out);
+                    lists.offsets[_entry.index + 1] = out.size() - before;
+                }
+            });
+
+        detail::inclusive_scan(std::span(lists.offsets), options.pool);
+        lists.indices.resize(lists.offsets.back());
+
+        parallel::parallel_for(
+            options.pool, size, grain, [&](std::size_t first, std::size_t last) {
+                auto from = found[first / grain].begin();
+
+                for (auto k = first; k < last; ++k)
+                {
+                    const auto point = _grid.entries[k].index;
+                    const auto count = static_cast<std::ptrdiff_t>(
+                        lists.offsets[point + 1] - lists.offsets[point]);
+
+                    std::copy(from,
+                              from + count,
+                              lists.indices.begin()
+                                  + static_cast<std::ptrdiff_t>(lists.offsets[point]));
+                    from += count;
+                }
+            });
+
+        return lists;
+    }
+
+
+    // endregion queries
+}    // namespace ggmath::spatial_hash
+#endif    // GG_MATH_SPATIAL_HASH_HPP
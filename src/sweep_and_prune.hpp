@@ -0,0 +1,366 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#ifndef GG_MATH_SWEEP_AND_PRUNE_HPP
+#define GG_MATH_SWEEP_AND_PRUNE_HPP
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "intersection.hpp"
+#include "vec.hpp"
+
+
+namespace ggmath::sweep_and_prune
+{
+    /**
+     * @brief The number of boxes the sweep tests against a box at once
+     */
+    inline constexpr std::size_t width = 8;
+
+
+    // region classes
+
+
+    /**
+     * @brief Two overlapping boxes by their indices, first < second
+     */
+    struct pair
+    {
+        std::uint32_t first;
+        std::uint32_t second;
+
+
+        constexpr auto operator<=>(const pair& other) const noexcept = default;
+    };
+
+
+    /**
+     * @brief A box and its index in the boxes given to update()
+     *
+     * The sorts move proxies instead of indices into the boxes, so the sweep
+     * reads the boxes in sorted order from consecutive memory.
+     */
+    struct proxy
+    {
+        std::array<float, 3> min;
+        std::array<float, 3> max;
+        std::uint32_t        index;
+    };
+
+
+    /**
+     * @brief The boxes of the last update() sorted along one axis
+     *
+     * proxies are sorted by min[axis], the axis along which the centers of the
+     * boxes varied the most when it was chosen. Bodies move little from one frame
+     * to the next, so the order of the last frame is nearly sorted for the next,
+     * and update() only has to fix it up. packets holds the sorted boxes width
+     * at a time for the sweep.
+     */
+    struct broad_phase
+    {
+        std::size_t           axis = 0;
+        std::vector<proxy>    proxies;
+        std::vector<aabbf_x8> packets;
+    };
+
+
+    // endregion classes
+
+
+    // region helpers
+
+
+    namespace detail
+    {
+        // The sweep axis changes only once another axis varies this much more,
+        // so axes of similar variance do not make every frame sort from scratch
+        inline constexpr double axis_switch_ratio = 1.25;
+
+        // Insertion sorts moving more proxies than this per proxy give up and sort
+        // from scratch, the order of the last frame did not help
+        inline constexpr std::size_t moves_per_proxy = 8;
+
+
+        /**
+         * @brief Return the variances of the centers of the finite boxes along the
+         * axes
+         */
+        inline std::array<double, 3> variances(std::span<const aabbf> boxes) noexcept
+        {
+            std::array<double, 3> sum         = {0, 0, 0};
+            std::array<double, 3> sum_squared = {0, 0, 0};
+            std::size_t           count       = 0;
+
+            for (const auto& box : boxes)
+            {
+                const auto center = 0.5F * (box.min + box.max);
+                if (!std::isfinite(center[0]) || !std::isfinite(center[1])
+                    || !std::isfinite(center[2]))
+                {
+                    continue;
+                }
+
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    sum[axis] += center[axis];
+                    sum_squared[axis] += double(center[axis]) * center[axis];
+                }
+                ++count;
+            }
+
+            std::array<double, 3> result = {0, 0, 0};
+            for (std::size_t axis = 0; count != 0 && axis < 3; ++axis)
+            {
+                const double mean = sum[axis] / double(count);
+                result[axis]      = sum_squared[axis] / double(count) - mean * mean;
+            }
+
+            return result;
+        }
+
+
+        /**
+         * @brief Sort proxies by min[axis] with an insertion sort and return false
+         * if it gave up after max_moves moves, leaving them unsorted
+         *
+         * Nearly sorted proxies take a few moves each, so this is close to linear
+         * for coherent frames.
+         */
+        inline bool insertion_sort(std::span<proxy> proxies,
+                                   std::size_t      axis,
+                                   std::size_t      max_moves) noexcept
+        {
+            std::size_t moves = 0;
+            for (std::size_t i = 1; i < proxies.size(); ++i)
+            {
+                const float key = proxies[i].min[axis];
+                if (!(key < proxies[i - 1].min[axis]))
+                {
+                    continue;
+                }
+
+                const proxy moved = proxies[i];
+                std::size_t j     = i;
+                for (; j > 0 && key < proxies[j - 1].min[axis]; --j)
+                {
+                    proxies[j] = proxies[j - 1];
+                }
+                proxies[j] = moved;
+
+                moves += i - j;
+                if (moves > max_moves)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+
+        /**
+         * @brief Load the boxes of sorted proxies into packets of width boxes
+         *
+         * Lanes without a box hold an empty box, which overlaps nothing.
+         */
+        inline void load_packets(std::span<const proxy> proxies,
+                                 std::vector<aabbf_x8>& packets)
+        {
+            packets.clear();
+            packets.resize((proxies.size() + width - 1) / width);
+
+            for (std::size_t i = 0; i < proxies.size(); ++i)
+            {
+                auto& packet = packets[i / width];
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    packet.min[axis].lanes[i % width] = proxies[i].min[axis];
+                    packet.max[axis].lanes[i % width] = proxies[i].max[axis];
+                }
+            }
+        }
+
+
+        /**
+         * @brief Append the pairs of sorted proxies that overlap to pairs
+         *
+         * The boxes after a proxy up to the first one starting after it ends along
+         * axis, found by a binary search, are tested against it width at a time.
+         * packets holds the boxes of proxies.
+         */
+        inline void sweep(std::span<const proxy>    proxies,
+                          std::span<const aabbf_x8> packets,
+                          std::size_t               axis,
+                          std::vector<pair>&        pairs)
+        {
+            for (std::size_t i = 0; i < proxies.size(); ++i)
+            {
+                const auto& _proxy = proxies[i];
+                const auto  box    = aabbf(
+                    vec3f(_proxy.min[0], _proxy.min[1], _proxy.min[2]),
+                    vec3f(_proxy.max[0], _proxy.max[1], _proxy.max[2]));
+
+                const auto last = static_cast<std::size_t>(
+                    std::upper_bound(proxies.begin() + std::ptrdiff_t(i) + 1,
+                                     proxies.end(),
+                                     _proxy.max[axis],
+                                     [axis](float end, const proxy& other) {
+                                         return end < other.min[axis];
+                                     })
+                    - proxies.begin());
+
+                for (std::size_t first = i + 1; first < last;)
+                {
+                    const std::size_t packet = first / width;
+                    const std::size_t end    = std::min(last, (packet + 1) * width);
+
+                    // Lanes before first and from end on are not candidates
+                    const auto lanes = ((std::uint32_t(1) << (end - first)) - 1)
+                                       << (first % width);
+
+                    auto bits =
+                        intersections::overlaps(box, packets[packet]).bits() & lanes;
+                    for (; bits != 0; bits &= bits - 1)
+                    {
+                        const auto& other =
+                            proxies[packet * width
+                                    + static_cast<std::size_t>(std::countr_zero(bits))];
+
+                        pairs.push_back({std::min(_proxy.index, other.index),
+                                         std::max(_proxy.index, other.index)});
+                    }
+
+                    first = end;
+                }
+            }
+        }
+    }    // namespace detail
+
+
+    // endregion helpers
+
+
+    // region boxes
+
+
+    /**
+     * @brief Return the box enclosing the boxes from and to
+     *
+     * The box a body sweeps through between two frames, with which the broad
+     * phase also finds fast bodies that pass through each other between them.
+     */
+    inline aabbf swept(const aabbf& from, const aabbf& to)
+    {
+        return {vector::min(from.min, to.min), vector::max(from.max, to.max)};
+    }
+
+
+    // endregion boxes
+
+
+    // region update
+
+
+    /**
+     * @brief Sort boxes into _broad_phase and replace pairs by the pairs of boxes
+     * that overlap, touching counts
+     *
+     * If the number of boxes and the sweep axis are the same as in the last call,
+     * the order of the last call is fixed up by an insertion sort, which takes
+     * close to linear time when the boxes moved little. Otherwise, or if the
+     * insertion sort moves too many boxes, they are sorted from scratch. The pairs
+     * are in no particular order. Empty boxes overlap nothing, boxes must not
+     * hold NaN. Throws std::length_error for 2^32 or more boxes.
+     */
+    inline void update(broad_phase&           _broad_phase,
+                       std::span<const aabbf> boxes,
+                       std::vector<pair>&     pairs)
+    {
+        if (boxes.size() > std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::length_error("sweep_and_prune: too many boxes");
+        }
+
+        auto& proxies = _broad_phase.proxies;
+        auto& axis    = _broad_phase.axis;
+
+        const auto        last_axis  = axis;
+        const std::size_t size       = boxes.size();
+        const bool        same_boxes = proxies.size() == size;
+
+        const auto variances = detail::variances(boxes);
+        const auto widest    = static_cast<std::size_t>(
+            std::max_element(variances.begin(), variances.end()) - variances.begin());
+        if (!same_boxes
+            || variances[widest] > detail::axis_switch_ratio * variances[axis])
+        {
+            axis = widest;
+        }
+
+        if (same_boxes)
+        {
+            for (auto& _proxy : proxies)
+            {
+                const auto& box = boxes[_proxy.index];
+
+                _proxy.min = {box.min[0], box.min[1], box.min[2]};
+                _proxy.max = {box.max[0], box.max[1], box.max[2]};
+            }
+        }
+        else
+        {
+            proxies.clear();
+            proxies.reserve(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                const auto& box = boxes[i];
+
+                proxies.push_back({{box.min[0], box.min[1], box.min[2]},
+                                   {box.max[0], box.max[1], box.max[2]},
+                                   static_cast<std::uint32_t>(i)});
+            }
+        }
+
+        const bool coherent = same_boxes && axis == last_axis;
+        if (!coherent
+            || !detail::insertion_sort(
+                proxies, axis, detail::moves_per_proxy * proxies.size()))
+        {
+            std::sort(proxies.begin(),
+                      proxies.end(),
+                      [axis](const proxy& a, const proxy& b) {
+                          return a.min[axis] < b.min[axis];
+                      });
+        }
+
+        pairs.clear();
+        detail::load_packets(proxies, _broad_phase.packets);
+        detail::sweep(proxies, _broad_phase.packets, axis, pairs);
+    }
+
+
+    // endregion update
+}    // namespace ggmath::sweep_and_prune
+#endif    // GG_MATH_SWEEP_AND_PRUNE_HPP
@@ -0,0 +1,350 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#ifndef GG_MATH_TEXT_HPP
+#define GG_MATH_TEXT_HPP
+#include <charconv>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+#include <version>
+
+#ifdef __cpp_lib_format
+#    include <format>
+#endif
+
+#include "types.hpp"
+#include "vec.hpp"
+
+
+// Formatting and parsing of vectors in the "(a,b,c)" format of operator<<
+//
+// The functions below work on character buffers through std::to_chars and
+// std::from_chars instead of going through iostreams one element at a time.
+// Floating point elements are written in the shortest form that parses back to the
+// same value, so unlike operator<< they round-trip exactly.
+namespace ggmath::text
+{
+    // region concepts
+
+
+    template <typename T>
+    struct is_text_vec : std::false_type
+    {};
+
+
+    template <Scalar T, int n>
+    requires std::is_arithmetic_v<T> && (!std::is_same_v<T, bool>)
+    struct is_text_vec<vec<T, n>> : std::true_type
+    {
+        using element_type        = T;
+        static constexpr int size = n;
+    };
+
+
+    /**
+     * @brief Check if T is a vector of arithmetic elements, which can be formatted
+     * and parsed
+     */
+    template <typename T>
+    concept TextVector = is_text_vec<T>::value;
+
+
+    // endregion concepts
+
+
+    // region helpers
+
+
+    namespace detail
+    {
+        constexpr std::size_t decimal_digits(long long value) noexcept
+        {
+            std::size_t digits = 1;
+            for (; value >= 10; value /= 10)
+            {
+                ++digits;
+            }
+
+            return digits;
+        }
+
+
+        /**
+         * @brief The most characters std::to_chars writes for a T
+         */
+        template <typename T>
+        constexpr std::size_t max_chars() noexcept
+        {
+            using limits = std::numeric_limits<T>;
+
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                // Denormals reach exponents of min_exponent10 - digits10
+                constexpr auto exponent_digits =
+                    decimal_digits(limits::digits10 - limits::min_exponent10);
+
+                // Signs of the value and exponent, the point and the 'e'
+                return 4 + limits::max_digits10 + exponent_digits;
+            }
+            else
+            {
+                // The sign and digits10, which excludes a partial last digit
+                return 2 + limits::digits10;
+            }
+        }
+
+
+        // Character types are written as numbers, like operator<< does
+        template <typename T>
+        constexpr auto printable(T element) noexcept
+        {
+            if constexpr (Character<T>)
+            {
+                return +element;
+            }
+            else
+            {
+                return element;
+            }
+        }
+
+
+        constexpr bool is_space(char c) noexcept
+        {
+            return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+        }
+
+
+        constexpr const char* skip_spaces(const char* first, const char* last) noexcept
+        {
+            while (first != last && is_space(*first))
+            {
+                ++first;
+            }
+
+            return first;
+        }
+    }    // namespace detail
+
+
+    // endregion helpers
+
+
+    /**
+     * @brief The most characters to_chars() writes for one vector of type T
+     *
+     * Buffers for count vectors and their separators need count * (max_chars<T> + 1)
+     * characters.
+     */
+    template <TextVector T>
+    inline constexpr std::size_t max_chars =
+        // The elements, n - 1 commas and the parentheses
+        is_text_vec<T>::size
+            * (detail::max_chars<typename is_text_vec<T>::element_type>() + 1)
+        + 1;
+
+
+    // region formatting
+
+
+    /**
+     * @brief Write _vec into [first, last) as "(a,b,c)"
+     *
+     * Like std::to_chars, returns the end of the written characters, or last and
+     * std::errc::value_too_large if they do not fit.
+     */
+    template <Scalar T, int n>
+    requires TextVector<vec<T, n>>
+    std::to_chars_result
+        to_chars(char* first, char* last, const vec<T, n>& _vec) noexcept
+    {
+        if (first == last)
+        {
+            return {last, std::errc::value_too_large};
+        }
+
+        *first++ = '(';
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const auto [end, error] =
+                std::to_chars(first, last, detail::printable(_vec[i]));
+
+            if (error != std::errc() || end == last)
+            {
+                return {last, std::errc::value_too_large};
+            }
+
+            first    = end;
+            *first++ = i + 1 < n ? ',' : ')';
+        }
+
+        return {first, std::errc()};
+    }
+
+
+    /**
+     * @brief Write the vectors into [first, last), each followed by separator
+     *
+     * Size the buffer with max_chars to avoid running out of space, on which last
+     * and std::errc::value_too_large are returned.
+     */
+    template <std::ranges::input_range R>
+    requires TextVector<std::ranges::range_value_t<R>>
+    std::to_chars_result
+        to_chars(char* first, char* last, const R& vecs, char separator = '\n') noexcept
+    {
+        for (const auto& _vec : vecs)
+        {
+            const auto [end, error] = to_chars(first, last, _vec);
+
+            if (error != std::errc() || end == last)
+            {
+                return {last, std::errc::value_too_large};
+            }
+
+            first    = end;
+            *first++ = separator;
+        }
+
+        return {first, std::errc()};
+    }
+
+
+    // endregion formatting
+
+
+    // region parsing
+
+
+    /**
+     * @brief Parse a vector in the format "(a,b,c)" from the start of [first,
+     * last) into _vec
+     *
+     * Like std::from_chars, returns the end of the parsed characters. If they do not
+     * form a vector of n elements of type T, returns first and
+     * std::errc::invalid_argument, or std::errc::result_out_of_range if an element
+     * does not fit into T. _vec is only modified on success.
+     */
+    template <Scalar T, int n>
+    requires TextVector<vec<T, n>>
+    std::from_chars_result
+        from_chars(const char* first, const char* last, vec<T, n>& _vec) noexcept
+    {
+        auto parsed = vec<T, n>(uninitialized);
+
+        if (first == last || *first != '(')
+        {
+            return {first, std::errc::invalid_argument};
+        }
+
+        const char* it = first + 1;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const auto [end, error] = std::from_chars(it, last, parsed[i]);
+            const char expected    = i + 1 < n ? ',' : ')';
+
+            if (error != std::errc())
+            {
+                return {first, error};
+            }
+            if (end == last || *end != expected)
+            {
+                return {first, std::errc::invalid_argument};
+            }
+
+            it = end + 1;
+        }
+
+        _vec = parsed;
+
+        return {it, std::errc()};
+    }
+
+
+    /**
+     * @brief Parse the whitespace separated vectors in [first, last) and append them
+     * to out
+     *
+     * Stops at the first malformed vector, returning its start and the error of
+     * from_chars(), otherwise returns last.
+     */
+    template <Scalar T, int n>
+    requires TextVector<vec<T, n>>
+    std::from_chars_result
+        from_chars(const char* first, const char* last, std::vector<vec<T, n>>& out)
+    {
+        auto _vec = vec<T, n>(uninitialized);
+
+        for (first = detail::skip_spaces(first, last); first != last;
+             first = detail::skip_spaces(first, last))
+        {
+            const auto [end, error] = from_chars(first, last, _vec);
+
+            if (error != std::errc())
+            {
+                return {first, error};
+            }
+
+            out.push_back(_vec);
+            first = end;
+        }
+
+        return {last, std::errc()};
+    }
+
+
+    // endregion parsing
+}    // namespace ggmath::text
+
+
+#ifdef __cpp_lib_format
+/**
+ * @brief Format vectors as "(a,b,c)", the format spec applies to every element
+ *
+ * `std::format("{:.2f}", vec3f(1, 2, 3))` results in "(1.00,2.00,3.00)".
+ */
+template <ggmath::Scalar T, int n>
+requires ggmath::text::TextVector<ggmath::vec<T, n>>
+struct std::formatter<ggmath::vec<T, n>>
+    : std::formatter<decltype(ggmath::text::detail::printable(T()))>
+{
+    template <typename FormatContext>
+    auto format(const ggmath::vec<T, n>& _vec, FormatContext& context) const
+    {
+        using element_formatter =
+            std::formatter<decltype(ggmath::text::detail::printable(T()))>;
+
+        auto out = context.out();
+        *out++   = '(';
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            context.advance_to(out);
+            out = element_formatter::format(
+                ggmath::text::detail::printable(_vec[i]), context);
+            *out++ = i + 1 < n ? ',' : ')';
+        }
+
+        return out;
+    }
+};
+#endif
+#endif    // GG_MATH_TEXT_HPP
@@ -72,13 +72,52 @@ namespace ggmath
     };
 
 
+    /**
+     * The floating point type lengths and angles of T are calculated in
+     *
+     * Specialized by types that calculate them lane-wise, like simd::pack.
+     */
+    template <typename T>
+    struct floating_point_of
+    {
+        using type = typename std::
+            conditional<std::is_same<T, float>::value, float, double>::type;
+    };
+
+
+    template <typename T>
+    using float_or_double = typename floating_point_of<T>::type;
+
+
+    /**
+     * Check if T is a SIMD lane type, whose operators work lane-wise
+     *
+     * Specialized by simd::pack, which lets vec hold one packet of vectors per
+     * component.
+     */
+    template <typename T>
+    struct is_lane_type : std::false_type
+    {};
+
+
+    /**
+     * The type of the values in the lanes of T, T itself for scalars
+     *
+     * Specialized by simd::pack.
+     */
+    template <typename T>
+    struct lane_value
+    {
+        using type = T;
+    };
+
+
     template <typename T>
-    using float_or_double =
-        typename std::conditional<std::is_same<T, float>::value, float, double>::type;
+    using lane_value_t = typename lane_value<T>::type;
 
 
     template <typename T>
-    concept Scalar = std::is_scalar<T>::value;
+    concept Scalar = std::is_scalar<T>::value || is_lane_type<T>::value;
 
     template <typename T>
     concept Character = ggmath::
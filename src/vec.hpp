@@ -18,13 +18,16 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <initializer_list>
 #include <iostream>
 #include <numeric>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 
+#include "simd.hpp"
 #include "types.hpp"
 #include "util.hpp"
 
@@ -54,18 +57,56 @@ namespace ggmath
                   Scalar T_Out = decltype(std::declval<T_A>() * std::declval<T_B>())>
         constexpr vec<T_Out, 3> cross(const vec<T_A, 3>& a, const vec<T_B, 3>& b);
 
+        template <Scalar T_A,
+                  Scalar T_B,
+                  Scalar T_Out = decltype(std::declval<T_A>() * std::declval<T_B>()),
+                  int    n>
+        constexpr T_Out dot(const vec<T_A, n>& a, const vec<T_B, n>& b) noexcept;
+
+        template <Scalar T, int n>
+        constexpr float_or_double<T> length(const vec<T, n>& _vec);
+
         template <Scalar T, int n>
-        constexpr float length(const vec<T, n>& _vec);
+        constexpr auto length_squared(const vec<T, n>& _vec);
     }    // namespace vector
 }    // namespace ggmath
 
 
+namespace ggmath
+{
+    /**
+     * @brief Tag selecting the constructor of vec that does not zero-fill the
+     * components
+     *
+     * Used by operations which overwrite every component anyway.
+     */
+    struct uninitialized_t
+    {
+        explicit uninitialized_t() = default;
+    };
+
+
+    inline constexpr uninitialized_t uninitialized{};
+}    // namespace ggmath
+
+
 namespace ggmath::debug
 {
+    /**
+     * @brief Whether or not the checks of GGMATH_DEBUG are compiled in
+     *
+     * Functions guarding on this with `if constexpr` contain no checking code and are
+     * noexcept when it is false.
+     */
+    inline constexpr bool enabled = GGMATH_DEBUG == 1;
+
+
     template <ggmath::Scalar T, int n>
     void throw_if_not_unit(const ggmath::vec<T, n>& vec);
 
-    void throw_if_not_equal_length(int n_A, int n_B);
+    inline void throw_if_not_equal_length(int n_A, int n_B);
+
+    inline void throw_if_too_small(std::size_t size, std::size_t required);
 }    // namespace ggmath::debug
 
 
@@ -88,6 +129,17 @@ namespace ggmath::debug
     }                                                                                                      \
                                                                                                            \
                                                                                                            \
+    /* Leaves the components for the caller to write, they are only zero-filled */                         \
+    /* in constant evaluation, which does not allow uninitialized reads */                                 \
+    constexpr explicit vec(ggmath::uninitialized_t)                                                        \
+    {                                                                                                      \
+        if (std::is_constant_evaluated())                                                                  \
+        {                                                                                                  \
+            data.fill(0);                                                                                  \
+        }                                                                                                  \
+    }                                                                                                      \
+                                                                                                           \
+                                                                                                           \
     /*NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)*/     \
     constexpr explicit vec(T(&_data)[n])                                                                   \
     {                                                                                                      \
@@ -119,7 +171,12 @@ namespace ggmath::debug
     /* clang-format on */                                                                                  \
                                                                                                            \
                                                                                                            \
-    constexpr vec(const vec&& other) noexcept : data(std::move(other.data)) {}                             \
+    /* Defaulted, so vec stays trivially copyable and copies of arrays of it */                            \
+    /* become memmove */                                                                                   \
+    constexpr vec(const vec& other) = default;                                                             \
+                                                                                                           \
+                                                                                                           \
+    constexpr vec(vec&& other) noexcept = default;                                                         \
                                                                                                            \
                                                                                                            \
     constexpr vec(std::initializer_list<T> _data)                                                          \
@@ -212,24 +269,10 @@ namespace ggmath::debug
     /* region macros::other */                                                                             \
                                                                                                            \
                                                                                                            \
-    constexpr vec& operator=(const vec& other)                                                             \
-    {                                                                                                      \
-        if (this == &other)                                                                                \
-            return *this;                                                                                  \
+    constexpr vec& operator=(const vec& other) = default;                                                  \
                                                                                                            \
-        data = other;                                                                                      \
-        return *this;                                                                                      \
-    }                                                                                                      \
                                                                                                            \
-                                                                                                           \
-    constexpr vec& operator=(vec&& other) noexcept                                                         \
-    {                                                                                                      \
-        if (this == &other)                                                                                \
-            return *this;                                                                                  \
-                                                                                                           \
-        data = std::move(other);                                                                           \
-        return *this;                                                                                      \
-    }                                                                                                      \
+    constexpr vec& operator=(vec&& other) noexcept = default;                                              \
                                                                                                            \
                                                                                                            \
     constexpr T& operator[](size_t i)                                                                      \
@@ -292,14 +335,18 @@ namespace ggmath
 
         // endregion classes::constructors
     };
+    // Padded to 16 bytes if simd::accelerated<T, 3>
     template <Scalar T>
-    struct vec<T, 3>
+    struct alignas(simd::alignment<T, 3>) vec<T, 3>
     {
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
         union
         {
             std::array<T, 3> data;
 
+            // The register lanes of accelerated vectors, the fourth is padding
+            std::array<T, simd::lanes<T, 3>> lanes;
+
             struct
             {
                 T x, y, z;
@@ -328,7 +375,7 @@ namespace ggmath
     };
     // TODO: Find out how to correctly handle fourth component
     template <Scalar T>
-    struct vec<T, 4>
+    struct alignas(simd::alignment<T, 4>) vec<T, 4>
     {
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
         union
@@ -392,6 +439,110 @@ namespace ggmath
     // endregion using-directives
 
 
+    // region layout
+
+
+    /**
+     * @brief Check if T can be copied with memcpy and has no hidden members
+     *
+     * Bulk copies of std::vector<vec> become memmove and arrays of vectors can be
+     * serialized byte-wise only while the aliases below satisfy this.
+     */
+    template <typename T>
+    concept TriviallyCopyable = std::is_trivially_copyable_v<T>
+                                && std::is_trivially_destructible_v<T>
+                                && std::is_standard_layout_v<T>;
+
+
+    static_assert(TriviallyCopyable<vec2f> && TriviallyCopyable<vec3f>
+                  && TriviallyCopyable<vec4f>);
+    static_assert(TriviallyCopyable<vec2d> && TriviallyCopyable<vec3d>
+                  && TriviallyCopyable<vec4d>);
+    static_assert(TriviallyCopyable<vec2i> && TriviallyCopyable<vec3i>
+                  && TriviallyCopyable<vec4i>);
+    static_assert(TriviallyCopyable<color3> && TriviallyCopyable<color4>);
+    static_assert(TriviallyCopyable<vec<float, 8>>);
+
+    // No padding besides that of 3 component vectors
+    static_assert(sizeof(vec2f) == 2 * sizeof(float));
+    static_assert(sizeof(vec4f) == 4 * sizeof(float));
+    static_assert(sizeof(vec<double, 5>) == 5 * sizeof(double));
+
+
+    // endregion layout
+
+
+    // region simd
+
+
+    namespace simd
+    {
+        /**
+         * @brief Load the components of vec into a register
+         *
+         * The padding lane of 3 component vectors is zeroed.
+         */
+        template <Scalar T, int n>
+        requires accelerated<T, n>
+        inline register4_t<T> load(const vec<T, n>& _vec) noexcept
+        {
+            if constexpr (n == 3)
+            {
+                return zero_w(load(_vec.lanes.data()));
+            }
+            else
+            {
+                return load(_vec.data.data());
+            }
+        }
+
+
+        /**
+         * @brief Store the lanes of a register into vec
+         *
+         * 3 component vectors receive the fourth lane in their padding.
+         */
+        template <Scalar T, int n>
+        requires accelerated<T, n>
+        inline void store(vec<T, n>& _vec, register4_t<T> a) noexcept
+        {
+            if constexpr (n == 3)
+            {
+                store(_vec.lanes.data(), a);
+            }
+            else
+            {
+                store(_vec.data.data(), a);
+            }
+        }
+
+
+        /**
+         * @brief Store the lanes of a register into a new vector
+         */
+        template <Scalar T, int n>
+        requires accelerated<T, n>
+        inline vec<T, n> to_vec(register4_t<T> a) noexcept
+        {
+            auto _vec = vec<T, n>(uninitialized);
+            store(_vec, a);
+            return _vec;
+        }
+
+
+        /**
+         * @brief Check if an operation with operands of type T_A and T_B and result
+         * type T_Out on vectors of size n is dispatched to the simd kernels
+         */
+        template <typename T_A, typename T_B, typename T_Out, int n>
+        concept dispatched = accelerated<T_A, n> && std::same_as<T_A, T_B>
+                             && std::same_as<T_A, T_Out>;
+    }    // namespace simd
+
+
+    // endregion simd
+
+
     // region operator_overloads
 
 
@@ -402,10 +553,13 @@ namespace ggmath
 
 
     // Dot product
-    template <Scalar T_A, Scalar T_B, int n>
-    constexpr float operator*(const vec<T_A, n>& a, const vec<T_B, n>& b)
+    template <Scalar T_A,
+              Scalar T_B,
+              Scalar T_Out = decltype(std::declval<T_A>() * std::declval<T_B>()),
+              int    n>
+    constexpr T_Out operator*(const vec<T_A, n>& a, const vec<T_B, n>& b) noexcept
     {
-        return std::inner_product(std::begin(a), std::end(a), std::begin(b), 0.0);
+        return ggmath::vector::dot(a, b);
     }
 
 
@@ -427,9 +581,22 @@ namespace ggmath
               int    n>
     constexpr vec<T_Out, n> operator+(const vec<T_A, n>& a, const vec<T_B, n>& b)
     {
-        auto vec_out = vec<T_Out, n>();
+        if constexpr (simd::dispatched<T_A, T_B, T_Out, n>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                return simd::to_vec<T_Out, n>(simd::add(simd::load(a), simd::load(b)));
+            }
+        }
+
+        auto vec_out = vec<T_Out, n>(uninitialized);
 
-        std::ranges::transform(a, b, std::begin(vec_out), std::plus<>());
+        // A fixed trip count lets the compiler unroll and fuse the loops of chained
+        // operators, std::ranges::transform compares against both ends
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            vec_out[i] = a[i] + b[i];
+        }
 
         return vec_out;
     }
@@ -442,9 +609,20 @@ namespace ggmath
               int    n>
     constexpr vec<T_Out, n> operator-(const vec<T_A, n>& a, const vec<T_B, n>& b)
     {
-        auto vec_out = vec<T_Out, n>();
+        if constexpr (simd::dispatched<T_A, T_B, T_Out, n>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                return simd::to_vec<T_Out, n>(simd::sub(simd::load(a), simd::load(b)));
+            }
+        }
 
-        std::ranges::transform(a, b, std::begin(vec_out), std::minus<>());
+        auto vec_out = vec<T_Out, n>(uninitialized);
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            vec_out[i] = a[i] - b[i];
+        }
 
         return vec_out;
     }
@@ -463,11 +641,21 @@ namespace ggmath
               int    n>
     constexpr vec<T_Out, n> operator*(const T_Scalar scalar, const vec<T_Vec, n>& _vec)
     {
-        auto vec_out = vec<T_Out, n>();
+        if constexpr (simd::dispatched<T_Vec, T_Vec, T_Out, n>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                return simd::to_vec<T_Out, n>(
+                    simd::scale(simd::load(_vec), static_cast<T_Vec>(scalar)));
+            }
+        }
 
-        std::ranges::transform(_vec, std::begin(vec_out), [scalar](T_Vec element) {
-            return element * scalar;
-        });
+        auto vec_out = vec<T_Out, n>(uninitialized);
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            vec_out[i] = _vec[i] * scalar;
+        }
 
         return vec_out;
     }
@@ -491,11 +679,21 @@ namespace ggmath
               int    n>
     constexpr vec<T_Out, n> operator/(const vec<T_Vec, n>& _vec, const T_Scalar scalar)
     {
-        auto vec_out = vec<T_Out, n>();
+        if constexpr (simd::dispatched<T_Vec, T_Vec, T_Out, n>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                return simd::to_vec<T_Out, n>(simd::div(
+                    simd::load(_vec), simd::broadcast(static_cast<T_Vec>(scalar))));
+            }
+        }
 
-        std::ranges::transform(_vec, std::begin(vec_out), [scalar](T_Vec element) {
-            return element / scalar;
-        });
+        auto vec_out = vec<T_Out, n>(uninitialized);
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            vec_out[i] = _vec[i] / scalar;
+        }
 
         return vec_out;
     }
@@ -517,6 +715,18 @@ namespace ggmath
     template <Scalar T_Vec, Scalar T_Scalar, int n>
     constexpr vec<T_Vec, n>& operator*=(vec<T_Vec, n>& _vec, const T_Scalar scalar)
     {
+        using T_Product = decltype(std::declval<T_Vec>() * std::declval<T_Scalar>());
+
+        if constexpr (simd::dispatched<T_Vec, T_Vec, T_Product, n>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::store(_vec,
+                            simd::scale(simd::load(_vec), static_cast<T_Vec>(scalar)));
+                return _vec;
+            }
+        }
+
         std::ranges::transform(_vec, std::begin(_vec), [scalar](T_Vec element) {
             return element * scalar;
         });
@@ -527,6 +737,19 @@ namespace ggmath
     template <Scalar T_Vec, Scalar T_Scalar, int n>
     constexpr vec<T_Vec, n>& operator/=(vec<T_Vec, n>& _vec, const T_Scalar scalar)
     {
+        using T_Quotient = decltype(std::declval<T_Vec>() / std::declval<T_Scalar>());
+
+        if constexpr (simd::dispatched<T_Vec, T_Vec, T_Quotient, n>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::store(_vec,
+                            simd::div(simd::load(_vec),
+                                      simd::broadcast(static_cast<T_Vec>(scalar))));
+                return _vec;
+            }
+        }
+
         std::ranges::transform(_vec, std::begin(_vec), [scalar](T_Vec element) {
             return element / scalar;
         });
@@ -544,6 +767,15 @@ namespace ggmath
     template <Scalar T_A, Scalar T_B, int n>
     constexpr vec<T_A, n>& operator+=(vec<T_A, n>& a, const vec<T_B, n>& b)
     {
+        if constexpr (simd::dispatched<T_A, T_B, T_A, n>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::store(a, simd::add(simd::load(a), simd::load(b)));
+                return a;
+            }
+        }
+
         std::ranges::transform(a, b, std::begin(a), std::plus<>());
 
         return a;
@@ -554,6 +786,15 @@ namespace ggmath
     template <Scalar T_A, Scalar T_B, int n>
     constexpr vec<T_A, n>& operator-=(vec<T_A, n>& a, const vec<T_B, n>& b)
     {
+        if constexpr (simd::dispatched<T_A, T_B, T_A, n>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::store(a, simd::sub(simd::load(a), simd::load(b)));
+                return a;
+            }
+        }
+
         std::ranges::transform(a, b, std::begin(a), std::minus<>());
 
         return a;
@@ -595,7 +836,7 @@ namespace ggmath
     requires std::totally_ordered_with<T_A, T_B>
     constexpr bool operator>(const vec<T_A, n>& a, const vec<T_B, n>& b)
     {
-        return ggmath::vector::length(a) > ggmath::vector::length(b);
+        return ggmath::vector::length_squared(a) > ggmath::vector::length_squared(b);
     }
 
 
@@ -604,7 +845,7 @@ namespace ggmath
     requires std::totally_ordered_with<T_A, T_B>
     constexpr bool operator<(const vec<T_A, n>& a, const vec<T_B, n>& b)
     {
-        return ggmath::vector::length(a) < ggmath::vector::length(b);
+        return ggmath::vector::length_squared(a) < ggmath::vector::length_squared(b);
     }
 
 
@@ -613,7 +854,7 @@ namespace ggmath
     requires std::totally_ordered_with<T_A, T_B>
     constexpr bool operator>=(const vec<T_A, n>& a, const vec<T_B, n>& b)
     {
-        return ggmath::vector::length(a) >= ggmath::vector::length(b);
+        return ggmath::vector::length_squared(a) >= ggmath::vector::length_squared(b);
     }
 
 
@@ -622,7 +863,7 @@ namespace ggmath
     requires std::totally_ordered_with<T_A, T_B>
     constexpr bool operator<=(const vec<T_A, n>& a, const vec<T_B, n>& b)
     {
-        return ggmath::vector::length(a) <= ggmath::vector::length(b);
+        return ggmath::vector::length_squared(a) <= ggmath::vector::length_squared(b);
     }
 
 
@@ -853,19 +1094,72 @@ namespace ggmath
         template <Scalar T_A, Scalar T_B, Scalar T_Out>
         constexpr vec<T_Out, 3> cross(const vec<T_A, 3>& a, const vec<T_B, 3>& b)
         {
+            if constexpr (simd::dispatched<T_A, T_B, T_Out, 3>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    return simd::to_vec<T_Out, 3>(
+                        simd::cross(simd::load(a), simd::load(b)));
+                }
+            }
+
             return vec<T_Out, 3>(a[1] * b[2] - a[2] * b[1],
                                  a[2] * b[0] - a[0] * b[2],
                                  a[0] * b[1] - a[1] * b[0]);
         }
 
 
+        /**
+         * @brief Calculate the dot product(a * b) of two vectors a and b
+         *
+         * The products are accumulated in T_Out, so float vectors stay in float and
+         * double vectors keep their precision. Vectors with up to 4 components are
+         * summed in straight-line code, which lets the compiler contract it into
+         * fused multiply-adds.
+         */
+        template <Scalar T_A, Scalar T_B, Scalar T_Out, int n>
+        constexpr T_Out dot(const vec<T_A, n>& a, const vec<T_B, n>& b) noexcept
+        {
+            if constexpr (simd::dispatched<T_A, T_B, T_Out, n>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    return simd::dot(simd::load(a), simd::load(b));
+                }
+            }
+
+            if constexpr (n == 2)
+            {
+                return a[0] * b[0] + a[1] * b[1];
+            }
+            else if constexpr (n == 3)
+            {
+                return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+            }
+            else if constexpr (n == 4)
+            {
+                // Two independent chains halve the dependency chain length
+                return (a[0] * b[0] + a[1] * b[1]) + (a[2] * b[2] + a[3] * b[3]);
+            }
+            else
+            {
+                return std::inner_product(
+                    std::begin(a), std::end(a), std::begin(b), T_Out(0));
+            }
+        }
+
+
         /**
          * @brief Calculate the length of vec
+         *
+         * If T is a float, the return value is a float too, otherwise it is a double
          */
         template <Scalar T, int n>
-        constexpr float length(const vec<T, n>& _vec)
+        constexpr float_or_double<T> length(const vec<T, n>& _vec)
         {
-            return std::abs(std::sqrt(_vec * _vec));
+            // Unqualified, so lane types can provide their own sqrt
+            using std::sqrt;
+            return sqrt(static_cast<float_or_double<T>>(length_squared(_vec)));
         }
 
 
@@ -873,12 +1167,13 @@ namespace ggmath
          * @brief Calculate the squared length of vec
          *
          * This function is potentially faster than squaring the length after
-         * calculating it (length(vec) * length(vec))
+         * calculating it (length(vec) * length(vec)). The return type is the type of
+         * the dot product of vec with itself.
          */
         template <Scalar T, int n>
-        constexpr float length_squared(const vec<T, n>& _vec)
+        constexpr auto length_squared(const vec<T, n>& _vec)
         {
-            return _vec * _vec;
+            return dot(_vec, _vec);
         }
 
 
@@ -888,6 +1183,14 @@ namespace ggmath
         template <Scalar T_In, int n>
         constexpr auto normalized(const vec<T_In, n>& _vec)
         {
+            if constexpr (simd::accelerated<T_In, n>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    return simd::to_vec<T_In, n>(simd::normalize(simd::load(_vec)));
+                }
+            }
+
             return _vec / length(_vec);
         }
 
@@ -916,7 +1219,7 @@ namespace ggmath
         constexpr vec<T_Out, n> scaled_to(const vec<T_In, n>& _vec,
                                           T_Magnitude         wanted_magnitude)
         {
-            float factor = wanted_magnitude / length(_vec);
+            auto factor = wanted_magnitude / length(_vec);
 
             if (!std::isnormal(factor))
             {
@@ -927,9 +1230,11 @@ namespace ggmath
 
         /**
          * @brief Return the signed distance from a to b
+         *
+         * The return type is the type of length(a - b)
          */
         template <Scalar T_A, Scalar T_B, int n>
-        constexpr float distance(const vec<T_A, n>& a, const vec<T_B, n>& b)
+        constexpr auto distance(const vec<T_A, n>& a, const vec<T_B, n>& b)
         {
             return length((a - b));
         }
@@ -939,16 +1244,19 @@ namespace ggmath
          * the same direction)
          *
          * If the vectors have a length other than 1, the result will be incorrect.
-         * Define the macro GGMATH_DEBUG to throw an exception if one of the parameters
-         * is NOT a unit-vector.
+         * Set the macro GGMATH_DEBUG to 1 to throw an exception if one of the
+         * parameters is NOT a unit-vector, otherwise the check is compiled out.
          */
         template <Scalar T_A, Scalar T_B, int n>
         constexpr bool parallel(const vec<T_A, n>& a, const vec<T_B, n>& b)
+            noexcept(!debug::enabled)
         {
-#ifdef GGMATH_DEBUG
-            debug::throw_if_not_unit(a);
-            debug::throw_if_not_unit(b);
-#endif
+            if constexpr (debug::enabled)
+            {
+                debug::throw_if_not_unit(a);
+                debug::throw_if_not_unit(b);
+            }
+
             return a * b == 1;
         }
 
@@ -957,16 +1265,19 @@ namespace ggmath
          * in the opposite direction)
          *
          * If the vectors have a length other than 1, the result will be incorrect.
-         * Define the macro GGMATH_DEBUG to throw an exception if one of the parameters
-         * is NOT a unit-vector.
+         * Set the macro GGMATH_DEBUG to 1 to throw an exception if one of the
+         * parameters is NOT a unit-vector, otherwise the check is compiled out.
          */
         template <Scalar T_A, Scalar T_B, int n>
         constexpr bool anti_parallel(const vec<T_A, n>& a, const vec<T_B, n>& b)
+            noexcept(!debug::enabled)
         {
-#ifdef GGMATH_DEBUG
-            debug::throw_if_not_unit(a);
-            debug::throw_if_not_unit(b);
-#endif
+            if constexpr (debug::enabled)
+            {
+                debug::throw_if_not_unit(a);
+                debug::throw_if_not_unit(b);
+            }
+
             return a * b == -1;
         }
 
@@ -975,44 +1286,64 @@ namespace ggmath
          * angle between them is 90 deg)
          *
          * If the vectors have a length other than 1, the result will be incorrect.
-         * Define the macro GGMATH_DEBUG to throw an exception if one of the parameters
-         * is NOT a unit-vector.
+         * Set the macro GGMATH_DEBUG to 1 to throw an exception if one of the
+         * parameters is NOT a unit-vector, otherwise the check is compiled out.
          */
         template <Scalar T_A, Scalar T_B, int n>
         constexpr bool perpendicular(const vec<T_A, n>& a, const vec<T_B, n>& b)
+            noexcept(!debug::enabled)
         {
-#ifdef GGMATH_DEBUG
-            debug::throw_if_not_unit(a);
-            debug::throw_if_not_unit(b);
-#endif
-            return difference_within_epsilon(a * b, 0);
+            if constexpr (debug::enabled)
+            {
+                debug::throw_if_not_unit(a);
+                debug::throw_if_not_unit(b);
+            }
+
+            using T_Dot = decltype(a * b);
+
+            return difference_within_epsilon(a * b, float_or_double<T_Dot>(0));
         }
 
 
         /**
          * @brief Return the angle between the vectors
+         *
+         * If the dot product of a and b is a float, the return value is a float too,
+         * otherwise it is a double
          */
-        template <Scalar T_A, Scalar T_B, int n>
-        constexpr float angle_between(const vec<T_A, n>& a, const vec<T_B, n>& b)
+        template <Scalar T_A,
+                  Scalar T_B,
+                  Scalar T_Out = float_or_double<decltype(std::declval<T_A>()
+                                                          * std::declval<T_B>())>,
+                  int    n>
+        constexpr T_Out angle_between(const vec<T_A, n>& a, const vec<T_B, n>& b)
         {
-            return std::acos((a * b) / (std::abs(length(a)) * std::abs(length(b))));
+            return std::acos(static_cast<T_Out>(a * b)
+                             / static_cast<T_Out>(length(a) * length(b)));
         }
 
         /**
          * @brief Return the angle between the unit vectors*
          *
          * If the vectors have a length other than 1, the result will be incorrect.
-         * Define the macro GGMATH_DEBUG to throw an exception if one of the parameters
-         * is NOT a unit-vector.
+         * Set the macro GGMATH_DEBUG to 1 to throw an exception if one of the
+         * parameters is NOT a unit-vector, otherwise the check is compiled out.
          */
-        template <Scalar T_A, Scalar T_B, int n>
-        constexpr float angle_between_unit(const vec<T_A, n>& a, const vec<T_B, n>& b)
+        template <Scalar T_A,
+                  Scalar T_B,
+                  Scalar T_Out = float_or_double<decltype(std::declval<T_A>()
+                                                          * std::declval<T_B>())>,
+                  int    n>
+        constexpr T_Out angle_between_unit(const vec<T_A, n>& a, const vec<T_B, n>& b)
+            noexcept(!debug::enabled)
         {
-#ifdef GGMATH_DEBUG
-            debug::throw_if_not_unit(a);
-            debug::throw_if_not_unit(b);
-#endif
-            return std::acos(a * b);
+            if constexpr (debug::enabled)
+            {
+                debug::throw_if_not_unit(a);
+                debug::throw_if_not_unit(b);
+            }
+
+            return std::acos(static_cast<T_Out>(a * b));
         }
 
         /**
@@ -1042,6 +1373,54 @@ namespace ggmath
             return *std::ranges::max_element(_vec);
         }
 
+        /**
+         * @brief Return the component-wise minimum of a and b
+         */
+        template <Scalar T, int n>
+        constexpr vec<T, n> min(const vec<T, n>& a, const vec<T, n>& b)
+        {
+            if constexpr (simd::accelerated<T, n>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    return simd::to_vec<T, n>(simd::min(simd::load(a), simd::load(b)));
+                }
+            }
+
+            auto vec_out = vec<T, n>(uninitialized);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                vec_out[i] = std::min(a[i], b[i]);
+            }
+
+            return vec_out;
+        }
+
+        /**
+         * @brief Return the component-wise maximum of a and b
+         */
+        template <Scalar T, int n>
+        constexpr vec<T, n> max(const vec<T, n>& a, const vec<T, n>& b)
+        {
+            if constexpr (simd::accelerated<T, n>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    return simd::to_vec<T, n>(simd::max(simd::load(a), simd::load(b)));
+                }
+            }
+
+            auto vec_out = vec<T, n>(uninitialized);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                vec_out[i] = std::max(a[i], b[i]);
+            }
+
+            return vec_out;
+        }
+
         /**
          * @brief Return the 0-based index of the smallest element in the vector
          */
@@ -1079,6 +1458,15 @@ namespace ggmath
                                      const vec<T_B, n>& b,
                                      T_Weight           t)
         {
+            if constexpr (simd::dispatched<T_A, T_B, T_Out, n>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    return simd::to_vec<T_Out, n>(simd::lerp(
+                        simd::load(a), simd::load(b), static_cast<T_Out>(t)));
+                }
+            }
+
             return a + t * (b - a);
         }
 
@@ -1087,19 +1475,22 @@ namespace ggmath
          * Reflect the vector a about normal
          *
          * If the vectors have a length other than 1, the result will be incorrect.
-         * Define the macro GGMATH_DEBUG to throw an exception if one of the parameters
-         * is NOT a unit-vector.
+         * Set the macro GGMATH_DEBUG to 1 to throw an exception if one of the
+         * parameters is NOT a unit-vector, otherwise the check is compiled out.
          */
         template <Scalar T_A,
                   Scalar T_B,
                   Scalar T_Out = decltype(std::declval<T_A>() * std::declval<T_B>()),
                   int    n>
         constexpr vec<T_Out, n> reflect(const vec<T_A, n>& a, const vec<T_B, n>& normal)
+            noexcept(!debug::enabled)
         {
-#ifdef GGMATH_DEBUG
-            debug::throw_if_not_unit(a);
-            debug::throw_if_not_unit(normal);
-#endif
+            if constexpr (debug::enabled)
+            {
+                debug::throw_if_not_unit(a);
+                debug::throw_if_not_unit(normal);
+            }
+
             return a - 2 * (a * normal) * normal;
         }
 
@@ -1133,8 +1524,7 @@ namespace ggmath::debug
         }
     }
 
-    // NOLINTNEXTLINE(misc-definitions-in-headers)
-    void throw_if_not_equal_length(int n_A, int n_B)
+    inline void throw_if_not_equal_length(int n_A, int n_B)
     {
         // TODO: Probably better to solve with with std::format
         if (n_A != n_B)
@@ -1148,5 +1538,22 @@ namespace ggmath::debug
             throw std::invalid_argument(ss.str());
         }
     }
+
+    /**
+     * @brief Throw an invalid_argument exception if an output span holds less than
+     * required elements
+     */
+    inline void throw_if_too_small(std::size_t size, std::size_t required)
+    {
+        if (size < required)
+        {
+            std::stringstream ss;
+
+            ss << "Output was expected to hold at least " << required
+               << " elements but it had a size of " << size;
+
+            throw std::invalid_argument(ss.str());
+        }
+    }
 }    // namespace ggmath::debug
 #endif    // GG_MATH_VEC_HPP
@@ -0,0 +1,1237 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#ifndef GG_MATH_VEC_SOA_HPP
+#define GG_MATH_VEC_SOA_HPP
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <memory_resource>
+#include <new>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parallel.hpp"
+#include "simd.hpp"
+#include "types.hpp"
+#include "vec.hpp"
+
+
+namespace ggmath::debug
+{
+    inline void throw_if_not_equal_size(std::size_t size_A, std::size_t size_B);
+}    // namespace ggmath::debug
+
+
+namespace ggmath
+{
+    // region allocator
+
+
+    /**
+     * @brief Allocator returning storage aligned to Alignment bytes from a
+     * std::pmr::memory_resource, the aligned operator new by default
+     *
+     * Like std::pmr::polymorphic_allocator, copies of containers use the default
+     * resource, so they do not outlive the memory of e.g. a frame_arena.
+     */
+    template <typename T, std::size_t Alignment = 64>
+    struct aligned_allocator
+    {
+        using value_type = T;
+
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap            = std::true_type;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = aligned_allocator<U, Alignment>;
+        };
+
+
+        aligned_allocator() noexcept = default;
+
+
+        // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+        constexpr aligned_allocator(std::pmr::memory_resource* resource) noexcept :
+            resource(resource)
+        {}
+
+
+        template <typename U>
+        // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+        constexpr aligned_allocator(
+            const aligned_allocator<U, Alignment>& other) noexcept :
+            resource(other.resource)
+        {}
+
+
+        [[nodiscard]] T* allocate(std::size_t count)
+        {
+            return static_cast<T*>(resource->allocate(count * sizeof(T), Alignment));
+        }
+
+
+        void deallocate(T* pointer, std::size_t count) noexcept
+        {
+            resource->deallocate(pointer, count * sizeof(T), Alignment);
+        }
+
+
+        [[nodiscard]] aligned_allocator
+            select_on_container_copy_construction() const noexcept
+        {
+            return aligned_allocator();
+        }
+
+
+        template <typename U>
+        constexpr bool
+            operator==(const aligned_allocator<U, Alignment>& other) const noexcept
+        {
+            return resource == other.resource || resource->is_equal(*other.resource);
+        }
+
+
+        std::pmr::memory_resource* resource = std::pmr::new_delete_resource();
+    };
+
+
+    // endregion allocator
+
+
+    namespace soa
+    {
+        /**
+         * @brief The number of elements the batch functions process at once
+         *
+         * The columns of vec_soa are padded to a multiple of it.
+         */
+        inline constexpr std::size_t lanes = 4;
+
+
+        /**
+         * @brief Check if the batch functions use the simd kernels for T
+         */
+        template <typename T>
+        concept vectorized = std::same_as<T, float> || std::same_as<T, double>;
+
+
+        /**
+         * @brief Round size up to a multiple of lanes
+         */
+        constexpr std::size_t padded(std::size_t size) noexcept
+        {
+            return (size + lanes - 1) / lanes * lanes;
+        }
+    }    // namespace soa
+
+
+    // region classes
+
+
+    /**
+     * @brief A sequence of vec<T, n> stored as one aligned array per component
+     *
+     * Element i is made up of column(0)[i], column(1)[i], ... Every column is padded
+     * to a multiple of soa::lanes elements, the padding holds unspecified values.
+     */
+    template <Scalar T, int n>
+    class vec_soa
+    {
+      public:
+        using value_type  = vec<T, n>;
+        using column_type = std::vector<T, aligned_allocator<T>>;
+
+
+        /**
+         * @brief Proxy for one element of a vec_soa, which behaves like a vec<T, n>
+         * stored across the columns
+         */
+        class reference
+        {
+          public:
+            constexpr reference(vec_soa& soa, std::size_t index) noexcept :
+                soa(&soa), index(index)
+            {}
+
+
+            constexpr reference(const reference& other) noexcept = default;
+
+
+            constexpr T& operator[](std::size_t axis) const
+            {
+                return soa->columns[axis][index];
+            }
+
+
+            constexpr reference& operator=(const vec<T, n>& _vec)
+            {
+                for (std::size_t axis = 0; axis < n; ++axis)
+                {
+                    soa->columns[axis][index] = _vec[axis];
+                }
+
+                return *this;
+            }
+
+
+            // Assigns the referenced values, not the reference itself
+            // NOLINTNEXTLINE(bugprone-unhandled-self-assignment,cert-oop54-cpp)
+            constexpr reference& operator=(const reference& other)
+            {
+                return *this = static_cast<vec<T, n>>(other);
+            }
+
+
+            // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+            constexpr operator vec<T, n>() const
+            {
+                auto _vec = vec<T, n>(uninitialized);
+
+                for (std::size_t axis = 0; axis < n; ++axis)
+                {
+                    _vec[axis] = soa->columns[axis][index];
+                }
+
+                return _vec;
+            }
+
+
+            friend constexpr bool operator==(const reference& a, const vec<T, n>& b)
+            {
+                return static_cast<vec<T, n>>(a) == b;
+            }
+
+
+            friend std::ostream& operator<<(std::ostream& os, const reference& a)
+            {
+                return os << static_cast<vec<T, n>>(a);
+            }
+
+
+            ~reference() = default;
+
+          private:
+            vec_soa*    soa;
+            std::size_t index;
+        };
+
+
+        // region classes::constructors
+
+
+        vec_soa() = default;
+
+
+        explicit vec_soa(std::size_t size)
+        {
+            resize(size);
+        }
+
+
+        /**
+         * @brief Allocate the columns from resource, e.g. a frame_arena
+         */
+        explicit vec_soa(std::pmr::memory_resource* resource)
+        {
+            for (auto& column : columns)
+            {
+                column = column_type(aligned_allocator<T>(resource));
+            }
+        }
+
+
+        vec_soa(std::size_t size, std::pmr::memory_resource* resource) :
+            vec_soa(resource)
+        {
+            resize(size);
+        }
+
+
+        vec_soa(std::initializer_list<vec<T, n>> vectors)
+        {
+            assign(vectors);
+        }
+
+
+        template <std::ranges::input_range T_Range>
+        requires std::same_as<std::ranges::range_value_t<T_Range>, vec<T, n>>
+        explicit vec_soa(const T_Range& vectors)
+        {
+            assign(vectors);
+        }
+
+
+        // endregion classes::constructors
+
+
+        // region classes::capacity
+
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return count;
+        }
+
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return count == 0;
+        }
+
+
+        void reserve(std::size_t capacity)
+        {
+            for (auto& column : columns)
+            {
+                column.reserve(soa::padded(capacity));
+            }
+        }
+
+
+        /**
+         * @brief Resize to size elements, new elements are zero vectors
+         */
+        void resize(std::size_t size)
+        {
+            for (auto& column : columns)
+            {
+                column.resize(soa::padded(size));
+
+                // Padding may hold results of the batch functions
+                if (size > count)
+                {
+                    std::fill(column.begin() + static_cast<std::ptrdiff_t>(count),
+                              column.begin() + static_cast<std::ptrdiff_t>(size),
+                              T(0));
+                }
+            }
+
+            count = size;
+        }
+
+
+        void clear() noexcept
+        {
+            for (auto& column : columns)
+            {
+                column.clear();
+            }
+
+            count = 0;
+        }
+
+
+        // endregion classes::capacity
+
+
+        // region classes::modifiers
+
+
+        void push_back(const vec<T, n>& _vec)
+        {
+            resize(count + 1);
+            (*this)[count - 1] = _vec;
+        }
+
+
+        template <std::ranges::input_range T_Range>
+        requires std::same_as<std::ranges::range_value_t<T_Range>, vec<T, n>>
+        void assign(const T_Range& vectors)
+        {
+            clear();
+
+            if constexpr (std::ranges::sized_range<T_Range>)
+            {
+                reserve(std::ranges::size(vectors));
+            }
+
+            for (const auto& _vec : vectors)
+            {
+                push_back(_vec);
+            }
+        }
+
+
+        // endregion classes::modifiers
+
+
+        // region classes::access
+
+
+        constexpr reference operator[](std::size_t i) noexcept
+        {
+            return reference(*this, i);
+        }
+
+
+        constexpr vec<T, n> operator[](std::size_t i) const
+        {
+            auto _vec = vec<T, n>(uninitialized);
+
+            for (std::size_t axis = 0; axis < n; ++axis)
+            {
+                _vec[axis] = columns[axis][i];
+            }
+
+            return _vec;
+        }
+
+
+        /**
+         * @brief Return the values of component axis of all elements
+         */
+        std::span<T> column(std::size_t axis) noexcept
+        {
+            return {columns[axis].data(), count};
+        }
+
+
+        std::span<const T> column(std::size_t axis) const noexcept
+        {
+            return {columns[axis].data(), count};
+        }
+
+
+        /**
+         * @brief Return the storage of component axis including its padding
+         */
+        T* data(std::size_t axis) noexcept
+        {
+            return columns[axis].data();
+        }
+
+
+        const T* data(std::size_t axis) const noexcept
+        {
+            return columns[axis].data();
+        }
+
+
+        // endregion classes::access
+
+      private:
+        std::array<column_type, n> columns;
+        std::size_t                count = 0;
+    };
+
+
+    // endregion classes
+
+
+    // region using-directives
+
+
+    using vec2f_soa = vec_soa<float, 2>;
+    using vec3f_soa = vec_soa<float, 3>;
+    using vec4f_soa = vec_soa<float, 4>;
+
+    using vec2d_soa = vec_soa<double, 2>;
+    using vec3d_soa = vec_soa<double, 3>;
+    using vec4d_soa = vec_soa<double, 4>;
+
+    using vec2i_soa = vec_soa<int, 2>;
+    using vec3i_soa = vec_soa<int, 3>;
+    using vec4i_soa = vec_soa<int, 4>;
+
+
+    // endregion using-directives
+
+
+    // Batch versions of the ggmath::vector functions, which process whole columns.
+    //
+    // Results are written into the last parameter, which may be one of the inputs.
+    // vec_soa results are resized to the size of the inputs, span results must have
+    // that size already. float and double columns are processed soa::lanes elements
+    // at a time in simd registers, other types element by element. Every function
+    // has an overload taking a parallel::Executor as its first argument, with a
+    // thread_pool the elements are split into grains, see parallel::parallel_for.
+    namespace soa
+    {
+        // region helpers
+
+
+        namespace detail
+        {
+            template <vectorized T>
+            inline simd::register4_t<T> load(const T* column, std::size_t i) noexcept
+            {
+                return simd::load(column + i);
+            }
+
+
+            /**
+             * @brief Store the lanes of a to out[i], ... without writing past the end
+             * of out
+             */
+            template <vectorized T>
+            inline void store(std::span<T> out, std::size_t i, simd::register4_t<T> a)
+            {
+                if (i + lanes <= out.size())
+                {
+                    simd::store(out.data() + i, a);
+                    return;
+                }
+
+                std::array<T, lanes> block{};
+                simd::store(block.data(), a);
+                std::copy_n(block.begin(),
+                            out.size() - i,
+                            out.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+
+
+            /**
+             * @brief Calculate the dot products of the elements i to i + lanes of a
+             * and b
+             */
+            template <vectorized T, int n>
+            inline simd::register4_t<T>
+                dot(const vec_soa<T, n>& a, const vec_soa<T, n>& b, std::size_t i)
+            {
+                auto sum = simd::mul(load(a.data(0), i), load(b.data(0), i));
+
+                for (std::size_t axis = 1; axis < n; ++axis)
+                {
+                    sum = simd::add(
+                        sum, simd::mul(load(a.data(axis), i), load(b.data(axis), i)));
+                }
+
+                return sum;
+            }
+
+
+            /**
+             * @brief Call kernel(first, last) for the grains of [0, size) on executor
+             *
+             * Grains start on simd register and cache line boundaries, so kernels
+             * may process whole registers and threads never write to the same
+             * cache line. columns is the number of columns of T a kernel reads or
+             * writes per element.
+             */
+            template <typename T, typename T_Executor, typename T_Kernel>
+            void for_grains(T_Executor&& executor,
+                            std::size_t  size,
+                            std::size_t  columns,
+                            T_Kernel     kernel)
+            {
+                constexpr std::size_t multiple =
+                    std::max(lanes, parallel::cache_line_size / sizeof(T));
+
+                parallel::parallel_for(std::forward<T_Executor>(executor),
+                                       size,
+                                       parallel::grain_size(columns * sizeof(T),
+                                                            multiple),
+                                       kernel);
+            }
+        }    // namespace detail
+
+
+        // endregion helpers
+
+
+        // region functions
+
+
+        /**
+         * @brief Calculate the dot products of the elements of a and b on executor
+         */
+        template <parallel::Executor T_Executor, Scalar T, int n>
+        void dot(T_Executor&&         executor,
+                 const vec_soa<T, n>& a,
+                 const vec_soa<T, n>& b,
+                 std::span<T>         out)
+        {
+            debug::throw_if_not_equal_size(a.size(), b.size());
+            debug::throw_if_not_equal_size(a.size(), out.size());
+
+            const auto kernel = [&](std::size_t first, std::size_t last) {
+                if constexpr (vectorized<T>)
+                {
+                    for (std::size_t i = first; i < last; i += lanes)
+                    {
+                        detail::store(out, i, detail::dot(a, b, i));
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        out[i] = vector::dot(a[i], b[i]);
+                    }
+                }
+            };
+
+            detail::for_grains<T>(executor, a.size(), 2 * n + 1, kernel);
+        }
+
+
+        /**
+         * @brief Calculate the dot products of the elements of a and b
+         */
+        template <Scalar T, int n>
+        void dot(const vec_soa<T, n>& a, const vec_soa<T, n>& b, std::span<T> out)
+        {
+            dot(parallel::sequenced, a, b, out);
+        }
+
+
+        /**
+         * @brief Calculate the cross products(a x b) of the elements of a and b on
+         * executor
+         */
+        template <parallel::Executor T_Executor, Scalar T>
+        void cross(T_Executor&&         executor,
+                   const vec_soa<T, 3>& a,
+                   const vec_soa<T, 3>& b,
+                   vec_soa<T, 3>&       out)
+        {
+            debug::throw_if_not_equal_size(a.size(), b.size());
+            out.resize(a.size());
+
+            const auto kernel = [&](std::size_t first, std::size_t last) {
+                if constexpr (vectorized<T>)
+                {
+                    using detail::load;
+
+                    for (std::size_t i = first; i < last; i += lanes)
+                    {
+                        auto a_x = load(a.data(0), i);
+                        auto a_y = load(a.data(1), i);
+                        auto a_z = load(a.data(2), i);
+                        auto b_x = load(b.data(0), i);
+                        auto b_y = load(b.data(1), i);
+                        auto b_z = load(b.data(2), i);
+
+                        auto x = simd::sub(simd::mul(a_y, b_z), simd::mul(a_z, b_y));
+                        auto y = simd::sub(simd::mul(a_z, b_x), simd::mul(a_x, b_z));
+                        auto z = simd::sub(simd::mul(a_x, b_y), simd::mul(a_y, b_x));
+
+                        simd::store(out.data(0) + i, x);
+                        simd::store(out.data(1) + i, y);
+                        simd::store(out.data(2) + i, z);
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        out[i] = vector::cross(a[i], b[i]);
+                    }
+                }
+            };
+
+            detail::for_grains<T>(executor, a.size(), 9, kernel);
+        }
+
+
+        /**
+         * @brief Calculate the cross products(a x b) of the elements of a and b
+         */
+        template <Scalar T>
+        void cross(const vec_soa<T, 3>& a, const vec_soa<T, 3>& b, vec_soa<T, 3>& out)
+        {
+            cross(parallel::sequenced, a, b, out);
+        }
+
+
+        /**
+         * @brief Calculate the squared lengths of the elements of a on executor
+         */
+        template <parallel::Executor T_Executor, Scalar T, int n>
+        void length_squared(T_Executor&&         executor,
+                            const vec_soa<T, n>& a,
+                            std::span<T>         out)
+        {
+            dot(executor, a, a, out);
+        }
+
+
+        /**
+         * @brief Calculate the squared lengths of the elements of a
+         */
+        template <Scalar T, int n>
+        void length_squared(const vec_soa<T, n>& a, std::span<T> out)
+        {
+            dot(a, a, out);
+        }
+
+
+        /**
+         * @brief Calculate the lengths of the elements of a on executor
+         *
+         * If T is a float, the lengths are floats too, otherwise they are doubles
+         */
+        template <parallel::Executor T_Executor, Scalar T, int n>
+        void length(T_Executor&&                  executor,
+                    const vec_soa<T, n>&          a,
+                    std::span<float_or_double<T>> out)
+        {
+            debug::throw_if_not_equal_size(a.size(), out.size());
+
+            const auto kernel = [&](std::size_t first, std::size_t last) {
+                if constexpr (vectorized<T>)
+                {
+                    for (std::size_t i = first; i < last; i += lanes)
+                    {
+                        detail::store(out, i, simd::sqrt(detail::dot(a, a, i)));
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        out[i] = vector::length(a[i]);
+                    }
+                }
+            };
+
+            detail::for_grains<T>(executor, a.size(), n + 1, kernel);
+        }
+
+
+        /**
+         * @brief Calculate the lengths of the elements of a
+         *
+         * If T is a float, the lengths are floats too, otherwise they are doubles
+         */
+        template <Scalar T, int n>
+        void length(const vec_soa<T, n>& a, std::span<float_or_double<T>> out)
+        {
+            length(parallel::sequenced, a, out);
+        }
+
+
+        /**
+         * @brief Calculate the distances between the elements of a and b on executor
+         *
+         * If T is a float, the distances are floats too, otherwise they are doubles
+         */
+        template <parallel::Executor T_Executor, Scalar T, int n>
+        void distance(T_Executor&&                  executor,
+                      const vec_soa<T, n>&          a,
+                      const vec_soa<T, n>&          b,
+                      std::span<float_or_double<T>> out)
+        {
+            debug::throw_if_not_equal_size(a.size(), b.size());
+            debug::throw_if_not_equal_size(a.size(), out.size());
+
+            const auto kernel = [&](std::size_t first, std::size_t last) {
+                if constexpr (vectorized<T>)
+                {
+                    using detail::load;
+
+                    for (std::size_t i = first; i < last; i += lanes)
+                    {
+                        auto difference =
+                            simd::sub(load(a.data(0), i), load(b.data(0), i));
+                        auto sum = simd::mul(difference, difference);
+
+                        for (std::size_t axis = 1; axis < n; ++axis)
+                        {
+                            difference =
+                                simd::sub(load(a.data(axis), i), load(b.data(axis), i));
+                            sum = simd::add(sum, simd::mul(difference, difference));
+                        }
+
+                        detail::store(out, i, simd::sqrt(sum));
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        out[i] = vector::distance(a[i], b[i]);
+                    }
+                }
+            };
+
+            detail::for_grains<T>(executor, a.size(), 2 * n + 1, kernel);
+        }
+
+
+        /**
+         * @brief Calculate the distances between the elements of a and b
+         *
+         * If T is a float, the distances are floats too, otherwise they are doubles
+         */
+        template <Scalar T, int n>
+        void distance(const vec_soa<T, n>&          a,
+                      const vec_soa<T, n>&          b,
+                      std::span<float_or_double<T>> out)
+        {
+            distance(parallel::sequenced, a, b, out);
+        }
+
+
+        /**
+         * @brief Scale the elements of a to a length of 1 on executor
+         */
+        template <parallel::Executor T_Executor, std::floating_point T, int n>
+        void normalized(T_Executor&&         executor,
+                        const vec_soa<T, n>& a,
+                        vec_soa<T, n>&       out)
+        {
+            out.resize(a.size());
+
+            const auto kernel = [&](std::size_t first, std::size_t last) {
+                if constexpr (vectorized<T>)
+                {
+                    for (std::size_t i = first; i < last; i += lanes)
+                    {
+                        auto length = simd::sqrt(detail::dot(a, a, i));
+
+                        for (std::size_t axis = 0; axis < n; ++axis)
+                        {
+                            auto value = detail::load(a.data(axis), i);
+
+                            simd::store(out.data(axis) + i, simd::div(value, length));
+                        }
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        out[i] = vector::normalized(a[i]);
+                    }
+                }
+            };
+
+            detail::for_grains<T>(executor, a.size(), 2 * n, kernel);
+        }
+
+
+        /**
+         * @brief Scale the elements of a to a length of 1
+         */
+        template <std::floating_point T, int n>
+        void normalized(const vec_soa<T, n>& a, vec_soa<T, n>& out)
+        {
+            normalized(parallel::sequenced, a, out);
+        }
+
+
+        /**
+         * @brief Multiply the elements of a by factor on executor
+         */
+        template <parallel::Executor T_Executor, std::floating_point T, int n>
+        void scaled_by(T_Executor&&         executor,
+                       const vec_soa<T, n>& a,
+                       T                    factor,
+                       vec_soa<T, n>&       out)
+        {
+            out.resize(a.size());
+
+            const auto kernel = [&](std::size_t first, std::size_t last) {
+                if constexpr (vectorized<T>)
+                {
+                    auto factors = simd::broadcast(factor);
+
+                    for (std::size_t i = first; i < last; i += lanes)
+                    {
+                        for (std::size_t axis = 0; axis < n; ++axis)
+                        {
+                            auto value = detail::load(a.data(axis), i);
+
+                            simd::store(out.data(axis) + i, simd::mul(value, factors));
+                        }
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        out[i] = vector::scaled_by(a[i], factor);
+                    }
+                }
+            };
+
+            detail::for_grains<T>(executor, a.size(), 2 * n, kernel);
+        }
+
+
+        /**
+         * @brief Multiply the elements of a by factor
+         */
+        template <std::floating_point T, int n>
+        void scaled_by(const vec_soa<T, n>& a, T factor, vec_soa<T, n>& out)
+        {
+            scaled_by(parallel::sequenced, a, factor, out);
+        }
+
+
+        /**
+         * @brief Calculate the component-wise minimums of the elements of a and b on
+         * executor
+         */
+        template <parallel::Executor T_Executor, Scalar T, int n>
+        void min(T_Executor&&         executor,
+                 const vec_soa<T, n>& a,
+                 const vec_soa<T, n>& b,
+                 vec_soa<T, n>&       out)
+        {
+            debug::throw_if_not_equal_size(a.size(), b.size());
+            out.resize(a.size());
+
+            const auto kernel = [&](std::size_t first, std::size_t last) {
+                if constexpr (vectorized<T>)
+                {
+                    using detail::load;
+
+                    for (std::size_t i = first; i < last; i += lanes)
+                    {
+                        for (std::size_t axis = 0; axis < n; ++axis)
+                        {
+                            auto minimum =
+                                simd::min(load(a.data(axis), i), load(b.data(axis), i));
+
+                            simd::store(out.data(axis) + i, minimum);
+                        }
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        out[i] = vector::min(a[i], b[i]);
+                    }
+                }
+            };
+
+            detail::for_grains<T>(executor, a.size(), 3 * n, kernel);
+        }
+
+
+        /**
+         * @brief Calculate the component-wise minimums of the elements of a and b
+         */
+        template <Scalar T, int n>
+        void min(const vec_soa<T, n>& a, const vec_soa<T, n>& b, vec_soa<T, n>& out)
+        {
+            min(parallel::sequenced, a, b, out);
+        }
+
+
+        /**
+         * @brief Calculate the component-wise maximums of the elements of a and b on
+         * executor
+         */
+        template <parallel::Executor T_Executor, Scalar T, int n>
+        void max(T_Executor&&         executor,
+                 const vec_soa<T, n>& a,
+                 const vec_soa<T, n>& b,
+                 vec_soa<T, n>&       out)
+        {
+            debug::throw_if_not_equal_size(a.size(), b.size());
+            out.resize(a.size());
+
+            const auto kernel = [&](std::size_t first, std::size_t last) {
+                if constexpr (vectorized<T>)
+                {
+                    using detail::load;
+
+                    for (std::size_t i = first; i < last; i += lanes)
+                    {
+                        for (std::size_t axis = 0; axis < n; ++axis)
+                        {
+                            auto maximum =
+                                simd::max(load(a.data(axis), i), load(b.data(axis), i));
+
+                            simd::store(out.data(axis) + i, maximum);
+                        }
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        out[i] = vector::max(a[i], b[i]);
+                    }
+                }
+            };
+
+            detail::for_grains<T>(executor, a.size(), 3 * n, kernel);
+        }
+
+
+        /**
+         * @brief Calculate the component-wise maximums of the elements of a and b
+         */
+        template <Scalar T, int n>
+        void max(const vec_soa<T, n>& a, const vec_soa<T, n>& b, vec_soa<T, n>& out)
+        {
+            max(parallel::sequenced, a, b, out);
+        }
+
+
+        /**
+         * @brief Linearly interpolate from the elements of a to the elements of b
+         * with a weight of t on executor
+         */
+        template <parallel::Executor T_Executor, std::floating_point T, int n>
+        void lerp(T_Executor&&         executor,
+                  const vec_soa<T, n>& a,
+                  const vec_soa<T, n>& b,
+                  T                    t,
+                  vec_soa<T, n>&       out)
+        {
+            debug::throw_if_not_equal_size(a.size(), b.size());
+            out.resize(a.size());
+
+            const auto kernel = [&](std::size_t first, std::size_t last) {
+                if constexpr (vectorized<T>)
+                {
+                    using detail::load;
+
+                    auto weights = simd::broadcast(t);
+
+                    for (std::size_t i = first; i < last; i += lanes)
+                    {
+                        for (std::size_t axis = 0; axis < n; ++axis)
+                        {
+                            auto from = load(a.data(axis), i);
+                            auto to   = load(b.data(axis), i);
+
+                            auto step = simd::mul(weights, simd::sub(to, from));
+
+                            simd::store(out.data(axis) + i, simd::add(from, step));
+                        }
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        out[i] = vector::lerp(a[i], b[i], t);
+                    }
+                }
+            };
+
+            detail::for_grains<T>(executor, a.size(), 3 * n, kernel);
+        }
+
+
+        /**
+         * @brief Linearly interpolate from the elements of a to the elements of b
+         * with a weight of t
+         */
+        template <std::floating_point T, int n>
+        void lerp(const vec_soa<T, n>& a,
+                  const vec_soa<T, n>& b,
+                  T                    t,
+                  vec_soa<T, n>&       out)
+        {
+            lerp(parallel::sequenced, a, b, t, out);
+        }
+
+
+        /**
+         * @brief Reflect the elements of a about the elements of normals on executor
+         *
+         * If the vectors have a length other than 1, the results will be incorrect.
+         * Set the macro GGMATH_DEBUG to 1 to throw an exception if one of them is
+         * NOT a unit-vector, otherwise the check is compiled out.
+         */
+        template <parallel::Executor T_Executor, std::floating_point T, int n>
+        void reflect(T_Executor&&         executor,
+                     const vec_soa<T, n>& a,
+                     const vec_soa<T, n>& normals,
+                     vec_soa<T, n>&       out)
+        {
+            debug::throw_if_not_equal_size(a.size(), normals.size());
+
+            if constexpr (debug::enabled)
+            {
+                for (std::size_t i = 0; i < a.size(); ++i)
+                {
+                    debug::throw_if_not_unit(a[i]);
+                    debug::throw_if_not_unit(normals[i]);
+                }
+            }
+
+            out.resize(a.size());
+
+            const auto kernel = [&](std::size_t first, std::size_t last) {
+                if constexpr (vectorized<T>)
+                {
+                    using detail::load;
+
+                    for (std::size_t i = first; i < last; i += lanes)
+                    {
+                        auto twice_dot = simd::scale(detail::dot(a, normals, i), 2);
+
+                        for (std::size_t axis = 0; axis < n; ++axis)
+                        {
+                            auto projection =
+                                simd::mul(twice_dot, load(normals.data(axis), i));
+
+                            simd::store(out.data(axis) + i,
+                                        simd::sub(load(a.data(axis), i), projection));
+                        }
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        out[i] = vector::reflect(a[i], normals[i]);
+                    }
+                }
+            };
+
+            detail::for_grains<T>(executor, a.size(), 3 * n, kernel);
+        }
+
+
+        /**
+         * @brief Reflect the elements of a about the elements of normals
+         *
+         * If the vectors have a length other than 1, the results will be incorrect.
+         * Set the macro GGMATH_DEBUG to 1 to throw an exception if one of them is
+         * NOT a unit-vector, otherwise the check is compiled out.
+         */
+        template <std::floating_point T, int n>
+        void reflect(const vec_soa<T, n>& a,
+                     const vec_soa<T, n>& normals,
+                     vec_soa<T, n>&       out)
+        {
+            reflect(parallel::sequenced, a, normals, out);
+        }
+
+
+        /**
+         * @brief Reflect the elements of a about normal on executor
+         *
+         * If the vectors have a length other than 1, the results will be incorrect.
+         * Set the macro GGMATH_DEBUG to 1 to throw an exception if one of them is
+         * NOT a unit-vector, otherwise the check is compiled out.
+         */
+        template <parallel::Executor T_Executor, std::floating_point T, int n>
+        void reflect(T_Executor&&         executor,
+                     const vec_soa<T, n>& a,
+                     const vec<T, n>&     normal,
+                     vec_soa<T, n>&       out)
+        {
+            if constexpr (debug::enabled)
+            {
+                debug::throw_if_not_unit(normal);
+
+                for (std::size_t i = 0; i < a.size(); ++i)
+                {
+                    debug::throw_if_not_unit(a[i]);
+                }
+            }
+
+            out.resize(a.size());
+
+            const auto kernel = [&](std::size_t first, std::size_t last) {
+                if constexpr (vectorized<T>)
+                {
+                    using detail::load;
+
+                    // Not a std::array, which would drop the attributes of __m128
+                    // NOLINTNEXTLINE(*-avoid-c-arrays)
+                    simd::register4_t<T> normal_columns[n];
+                    for (std::size_t axis = 0; axis < n; ++axis)
+                    {
+                        normal_columns[axis] = simd::broadcast(normal[axis]);
+                    }
+
+                    for (std::size_t i = first; i < last; i += lanes)
+                    {
+                        auto sum = simd::mul(load(a.data(0), i), normal_columns[0]);
+
+                        for (std::size_t axis = 1; axis < n; ++axis)
+                        {
+                            sum = simd::add(sum,
+                                            simd::mul(load(a.data(axis), i),
+                                                      normal_columns[axis]));
+                        }
+
+                        auto twice_dot = simd::scale(sum, 2);
+
+                        for (std::size_t axis = 0; axis < n; ++axis)
+                        {
+                            auto projection =
+                                simd::mul(twice_dot, normal_columns[axis]);
+
+                            simd::store(out.data(axis) + i,
+                                        simd::sub(load(a.data(axis), i), projection));
+                        }
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        out[i] = vector::reflect(a[i], normal);
+                    }
+                }
+            };
+
+            detail::for_grains<T>(executor, a.size(), 2 * n, kernel);
+        }
+
+
+        /**
+         * @brief Reflect the elements of a about normal
+         *
+         * If the vectors have a length other than 1, the results will be incorrect.
+         * Set the macro GGMATH_DEBUG to 1 to throw an exception if one of them is
+         * NOT a unit-vector, otherwise the check is compiled out.
+         */
+        template <std::floating_point T, int n>
+        void reflect(const vec_soa<T, n>& a,
+                     const vec<T, n>&     normal,
+                     vec_soa<T, n>&       out)
+        {
+            reflect(parallel::sequenced, a, normal, out);
+        }
+
+
+        // endregion functions
+    }    // namespace soa
+}    // namespace ggmath
+
+
+namespace ggmath::debug
+{
+    /**
+     * @brief Throw an invalid_argument exception if two batches have different sizes
+     */
+    inline void throw_if_not_equal_size(std::size_t size_A, std::size_t size_B)
+    {
+        if (size_A != size_B)
+        {
+            std::stringstream ss;
+
+            ss << "Batches were expected to have equal sizes but they had a size of "
+               << size_A << " and " << size_B << " respectively";
+
+            throw std::invalid_argument(ss.str());
+        }
+    }
+}    // namespace ggmath::debug
+#endif    // GG_MATH_VEC_SOA_HPP
@@ -0,0 +1,125 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "arena.hpp"
+#include "mat.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    bool is_aligned(const void* pointer, std::size_t alignment)
+    {
+        return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+    }
+}    // namespace
+
+
+TEST(Arena, AllocationsAreAligned)
+{
+    auto arena = frame_arena(1'024);
+
+    for (std::size_t bytes : {1, 3, 12, 64, 100, 700})
+    {
+        ASSERT_TRUE(is_aligned(arena.allocate(bytes, 1), frame_arena::alignment))
+            << bytes;
+    }
+
+    ASSERT_TRUE(is_aligned(arena.allocate(10, 4'096), 4'096));
+    ASSERT_TRUE(is_aligned(arena.allocate_span<mat44f>(3).data(), alignof(mat44f)));
+}
+TEST(Arena, GrowsAndResetReusesBlocks)
+{
+    auto arena = frame_arena(1'024);
+
+    auto       first    = arena.allocate_span<vec3f>(10);
+    const auto large    = arena.allocate_span<vec4d>(1'000);
+    const auto capacity = arena.capacity();
+
+    first[9] = vec3f(1, 2, 3);
+    ASSERT_EQ(large.size(), 1'000);
+    ASSERT_GE(capacity, 1'000 * sizeof(vec4d));
+    ASSERT_GE(arena.used(), 10 * sizeof(vec3f) + 1'000 * sizeof(vec4d));
+
+    arena.reset();
+    ASSERT_EQ(arena.used(), 0);
+    ASSERT_EQ(arena.allocate_span<vec3f>(10).data(), first.data());
+
+    // A steady workload does not allocate new blocks
+    ASSERT_EQ(arena.allocate_span<vec4d>(1'000).size(), 1'000);
+    ASSERT_EQ(arena.capacity(), capacity);
+
+    arena.release();
+    ASSERT_EQ(arena.capacity(), 0);
+}
+TEST(Arena, BacksPmrContainers)
+{
+    auto arena  = frame_arena();
+    auto points = std::pmr::vector<vec3f>(&arena);
+
+    for (int i = 0; i < 1'000; ++i)
+    {
+        points.emplace_back(float(i), 0.0F, 0.0F);
+    }
+
+    ASSERT_EQ(points[999], vec3f(999, 0, 0));
+    ASSERT_TRUE(is_aligned(points.data(), frame_arena::alignment));
+    ASSERT_GT(arena.used(), 0);
+}
+TEST(Arena, BacksVecSoa)
+{
+    auto arena = frame_arena();
+
+    auto a   = vec3f_soa(100, &arena);
+    auto out = vec3f_soa(&arena);
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = vec3f(float(i) + 1, 0, 0);
+    }
+
+    const auto used = arena.used();
+    soa::normalized(a, out);
+
+    ASSERT_GT(arena.used(), used);
+    ASSERT_EQ(std::as_const(out)[50], vec3f(1, 0, 0));
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        ASSERT_TRUE(is_aligned(out.data(axis), frame_arena::alignment));
+    }
+
+    // Copies use the heap, so they outlive the frame
+    const auto copy = out;
+    arena.reset();
+    ASSERT_EQ(std::as_const(copy)[50], vec3f(1, 0, 0));
+}
+TEST(Arena, LocalIsPerThread)
+{
+    frame_arena* other = nullptr;
+    std::thread([&other] { other = &frame_arena::local(); }).join();
+
+    ASSERT_EQ(&frame_arena::local(), &frame_arena::local());
+    ASSERT_NE(&frame_arena::local(), other);
+}
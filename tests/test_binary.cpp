@@ -0,0 +1,152 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "binary.hpp"
+#include "mat.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    // A file in the temporary directory, removed when it goes out of scope
+    struct temporary_file
+    {
+        std::filesystem::path path;
+
+
+        explicit temporary_file(const std::string& name) :
+            path(std::filesystem::temp_directory_path() / ("ggmath_test_" + name))
+        {}
+
+
+        temporary_file(const temporary_file&)            = delete;
+        temporary_file& operator=(const temporary_file&) = delete;
+
+
+        ~temporary_file()
+        {
+            std::filesystem::remove(path);
+        }
+    };
+
+
+    std::vector<vec3f> random_points(std::size_t count)
+    {
+        std::mt19937                          rng(42);
+        std::uniform_real_distribution<float> coordinate(-100, 100);
+
+        auto points = std::vector<vec3f>();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            points.emplace_back(coordinate(rng), coordinate(rng), coordinate(rng));
+        }
+
+        return points;
+    }
+}    // namespace
+
+
+TEST(Binary, RoundTripVectors)
+{
+    const auto file   = temporary_file("vectors.bin");
+    const auto points = random_points(1'000);
+
+    binary::write<vec3f>(file.path, points);
+    const auto mapped = binary::mapped_file<vec3f>(file.path);
+
+    ASSERT_EQ(mapped.elements().size(), points.size());
+    ASSERT_TRUE(std::ranges::equal(mapped.elements(), points));
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(mapped.elements().data())
+                  % binary::data_alignment,
+              0);
+    ASSERT_EQ(mapped.header().scalar, binary::scalar_type::float32);
+    ASSERT_EQ(mapped.header().rows, 3);
+}
+TEST(Binary, RoundTripMatricesInParts)
+{
+    const auto file     = temporary_file("matrices.bin");
+    const auto matrices = std::vector<mat44f>{mat44f::identity(),
+                                              mat44f({1, 2, 3, 4, 5, 6, 7, 8}),
+                                              mat44f(3.0F)};
+
+    auto writer = binary::writer<mat44f>(file.path);
+    writer.write(std::span(matrices).first(1));
+    writer.write(std::span(matrices).subspan(1));
+    writer.close();
+
+    const auto mapped = binary::mapped_file<mat44f>(file.path);
+
+    ASSERT_EQ(mapped.elements().size(), 3);
+    for (std::size_t i = 0; i < matrices.size(); ++i)
+    {
+        ASSERT_EQ(mapped.elements()[i], matrices[i]) << i;
+    }
+    ASSERT_EQ(mapped.header().columns, 4);
+}
+TEST(Binary, Empty)
+{
+    const auto file = temporary_file("empty.bin");
+
+    binary::write<vec4d>(file.path, {});
+
+    ASSERT_TRUE(binary::mapped_file<vec4d>(file.path).elements().empty());
+}
+TEST(Binary, Move)
+{
+    const auto file = temporary_file("move.bin");
+    binary::write<vec3f>(file.path, random_points(10));
+
+    auto       mapped = binary::mapped_file<vec3f>(file.path);
+    const auto moved  = std::move(mapped);
+
+    ASSERT_EQ(moved.elements().size(), 10);
+    ASSERT_TRUE(mapped.elements().empty());    // NOLINT(bugprone-use-after-move)
+}
+TEST(Binary, RejectsOtherElementTypes)
+{
+    const auto file = temporary_file("other.bin");
+    binary::write<vec3f>(file.path, random_points(10));
+
+    ASSERT_THROW(binary::mapped_file<vec3d>(file.path), std::runtime_error);
+    ASSERT_THROW(binary::mapped_file<vec4f>(file.path), std::runtime_error);
+    ASSERT_THROW(binary::mapped_file<mat33f>(file.path), std::runtime_error);
+}
+TEST(Binary, RejectsTruncatedAndForeignFiles)
+{
+    const auto file = temporary_file("truncated.bin");
+    binary::write<vec3f>(file.path, random_points(10));
+    std::filesystem::resize_file(file.path, std::filesystem::file_size(file.path) - 1);
+
+    ASSERT_THROW(binary::mapped_file<vec3f>(file.path), std::runtime_error);
+
+    std::ofstream(file.path) << vec3f(1, 2, 3) << '\n';
+    ASSERT_THROW(binary::mapped_file<vec3f>(file.path), std::runtime_error);
+
+    ASSERT_THROW(binary::mapped_file<vec3f>(file.path.string() + ".missing"),
+                 std::system_error);
+}
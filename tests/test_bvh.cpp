@@ -0,0 +1,296 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bvh.hpp"
+#include "intersection.hpp"
+#include "parallel.hpp"
+#include "ray.hpp"
+#include "test_helpers.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+using helpers::random_triangles;
+
+
+namespace
+{
+    rayf random_ray(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> coordinate(-1, 1);
+
+        return {vec3f(coordinate(rng), coordinate(rng), coordinate(rng)) * 12.0F,
+                vec3f(coordinate(rng), coordinate(rng), coordinate(rng))};
+    }
+
+
+    // Move every triangle to the place of a random other one
+    std::vector<trianglef> scrambled(std::mt19937&                 rng,
+                                     const std::vector<trianglef>& triangles)
+    {
+        std::uniform_int_distribution<std::size_t> other(0, triangles.size() - 1);
+
+        std::vector<trianglef> moved;
+        for (const auto& _triangle : triangles)
+        {
+            const auto& target = triangles[other(rng)];
+            auto        offset = target.a - _triangle.a;
+            moved.emplace_back(
+                _triangle.a + offset, _triangle.b + offset, _triangle.c + offset);
+        }
+
+        return moved;
+    }
+
+
+    void expect_every_triangle_in_one_leaf(const bvh::tree& tree, std::size_t size)
+    {
+        ASSERT_EQ(tree.indices.size(), tree.leaves.size() * bvh::width);
+
+        std::vector<std::uint32_t> indices;
+        std::copy_if(tree.indices.begin(),
+                     tree.indices.end(),
+                     std::back_inserter(indices),
+                     [](auto index) { return index != bvh::node::no_child; });
+        std::sort(indices.begin(), indices.end());
+
+        ASSERT_EQ(indices.size(), size);
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            EXPECT_EQ(indices[i], i);
+        }
+    }
+
+
+    void expect_closest_hits_match_linear_search(
+        const bvh::tree& tree, const std::vector<trianglef>& triangles, int rays)
+    {
+        auto rng  = std::mt19937(3);
+        auto span = std::span<const trianglef>(triangles);
+
+        int hits = 0;
+        for (int i = 0; i < rays; ++i)
+        {
+            auto _ray   = random_ray(rng);
+            auto linear = intersections::watertight(_ray, span);
+            auto hit    = bvh::closest_hit(tree, _ray);
+
+            ASSERT_EQ(hit.index, linear.index) << i;
+            if (hit)
+            {
+                EXPECT_NEAR(hit.distance, linear.distance, 1e-4) << i;
+            }
+
+            hits += linear ? 1 : 0;
+        }
+
+        ASSERT_GT(hits, rays / 4);
+    }
+}    // namespace
+
+
+TEST(Bvh, NodeFillsTwoCacheLines)
+{
+    EXPECT_EQ(sizeof(bvh::node), 128);
+    EXPECT_EQ(alignof(bvh::node), 64);
+}
+
+
+TEST(Bvh, EmptyTreeHasNoHits)
+{
+    auto tree = bvh::build({});
+    auto _ray = rayf(vec3f(0), vec3f(0, 0, 1));
+
+    EXPECT_FALSE(bvh::closest_hit(tree, _ray));
+    EXPECT_FALSE(bvh::any_hit(tree, _ray));
+}
+
+
+TEST(Bvh, SingleTriangle)
+{
+    std::vector<trianglef> triangles;
+    triangles.emplace_back(vec3f(-1, -1, 2), vec3f(1, -1, 2), vec3f(0, 1, 2));
+
+    auto tree = bvh::build(triangles);
+    auto hit  = bvh::closest_hit(tree, rayf(vec3f(0), vec3f(0, 0, 1)));
+
+    EXPECT_EQ(tree.nodes.size(), 1);
+    EXPECT_EQ(tree.leaves.size(), 1);
+    ASSERT_TRUE(hit);
+    EXPECT_EQ(hit.index, 0);
+    EXPECT_FLOAT_EQ(hit.distance, 2);
+    EXPECT_FALSE(bvh::closest_hit(tree, rayf(vec3f(0), vec3f(0, 0, -1))));
+    EXPECT_FALSE(bvh::any_hit(tree, rayf(vec3f(0), vec3f(0, 0, 1)), 1.5F));
+}
+
+
+TEST(Bvh, EveryTriangleIsInOneLeaf)
+{
+    auto rng       = std::mt19937(42);
+    auto triangles = random_triangles(rng, 1'000, 10, 1);
+    auto tree      = bvh::build(triangles);
+
+    expect_every_triangle_in_one_leaf(tree, triangles.size());
+}
+
+
+TEST(Bvh, ChildrenComeAfterTheirParent)
+{
+    auto rng       = std::mt19937(42);
+    auto triangles = random_triangles(rng, 1'000, 10, 1);
+    auto tree      = bvh::build(triangles);
+
+    for (std::size_t i = 0; i < tree.nodes.size(); ++i)
+    {
+        for (auto child : tree.nodes[i].children)
+        {
+            if ((child & bvh::node::leaf_bit) == 0)
+            {
+                EXPECT_GT(child, i);
+                EXPECT_LT(child, tree.nodes.size());
+            }
+        }
+    }
+}
+
+
+TEST(Bvh, ClosestHitMatchesLinearSearch)
+{
+    auto rng       = std::mt19937(42);
+    auto triangles = random_triangles(rng, 20'000, 10, 1);
+    auto span      = std::span<const trianglef>(triangles);
+
+    // Enough triangles for the build to be split across threads
+    auto pool     = parallel::thread_pool(4);
+    auto serial   = bvh::build(triangles, {.pool = nullptr});
+    auto parallel = bvh::build(triangles, {.pool = &pool});
+
+    int hits = 0;
+    for (int i = 0; i < 200; ++i)
+    {
+        auto _ray   = random_ray(rng);
+        auto linear = intersections::watertight(_ray, span);
+
+        for (const auto* tree : {&serial, &parallel})
+        {
+            auto hit = bvh::closest_hit(*tree, _ray);
+
+            ASSERT_EQ(hit.index, linear.index) << i;
+            if (hit)
+            {
+                EXPECT_NEAR(hit.distance, linear.distance, 1e-4) << i;
+                EXPECT_NEAR(hit.u, linear.u, 1e-4) << i;
+                EXPECT_NEAR(hit.v, linear.v, 1e-4) << i;
+            }
+        }
+
+        hits += linear ? 1 : 0;
+    }
+
+    ASSERT_GT(hits, 50);
+}
+
+
+TEST(Bvh, AnyHitMatchesClosestHit)
+{
+    auto rng       = std::mt19937(7);
+    auto triangles = random_triangles(rng, 2'000, 10, 1);
+    auto tree      = bvh::build(triangles);
+
+    std::uniform_real_distribution<float> t_max(0, 30);
+    for (int i = 0; i < 500; ++i)
+    {
+        auto  _ray  = random_ray(rng);
+        float limit = t_max(rng);
+
+        EXPECT_EQ(bvh::any_hit(tree, _ray, limit),
+                  static_cast<bool>(bvh::closest_hit(tree, _ray, limit)))
+            << i;
+    }
+}
+
+
+TEST(Bvh, TrianglesWithCommonCentroid)
+{
+    std::vector<trianglef> triangles;
+    for (int i = 0; i < 100; ++i)
+    {
+        auto size = static_cast<float>(i + 1);
+        triangles.emplace_back(
+            vec3f(-size, -size, 5), vec3f(size, -size, 5), vec3f(0, 2 * size, 5));
+    }
+
+    auto tree = bvh::build(triangles);
+    auto hit  = bvh::closest_hit(tree, rayf(vec3f(0), vec3f(0, 0, 1)));
+
+    ASSERT_TRUE(hit);
+    EXPECT_FLOAT_EQ(hit.distance, 5);
+    EXPECT_LT(hit.index, triangles.size());
+}
+
+
+TEST(Bvh, RefitOfUnmovedTrianglesKeepsTheCost)
+{
+    auto rng       = std::mt19937(42);
+    auto triangles = random_triangles(rng, 1'000, 10, 1);
+    auto tree      = bvh::build(triangles);
+    auto cost      = bvh::sah_cost(tree);
+
+    bvh::refit(tree, triangles);
+
+    EXPECT_GT(cost, 1);
+    EXPECT_FLOAT_EQ(bvh::sah_cost(tree), cost);
+}
+
+
+TEST(Bvh, RefitMatchesLinearSearch)
+{
+    auto rng       = std::mt19937(42);
+    auto triangles = random_triangles(rng, 70'000, 10, 1);
+    auto tree      = bvh::build(triangles);
+
+    // Enough leaves for the subtrees to be refit by several threads
+    auto pool  = parallel::thread_pool(4);
+    auto moved = scrambled(rng, triangles);
+    bvh::refit(tree, moved, {.pool = &pool});
+
+    expect_closest_hits_match_linear_search(tree, moved, 100);
+}
+
+
+TEST(Bvh, RefitRebuildsDegradedSubtrees)
+{
+    auto rng       = std::mt19937(42);
+    auto triangles = random_triangles(rng, 5'000, 10, 1);
+    auto moved     = scrambled(rng, triangles);
+
+    auto refit   = bvh::build(triangles);
+    auto rebuilt = bvh::build(triangles);
+    auto cost    = bvh::sah_cost(refit);
+
+    bvh::refit(refit, moved);
+    bvh::refit(rebuilt, moved, {.rebuild_threshold = 1.5F});
+
+    EXPECT_GT(bvh::sah_cost(refit), 2 * cost);
+    EXPECT_LT(bvh::sah_cost(rebuilt), bvh::sah_cost(refit) / 2);
+    expect_every_triangle_in_one_leaf(rebuilt, moved.size());
+    expect_closest_hits_match_linear_search(rebuilt, moved, 200);
+
+    // The rebuilt subtrees are the reference now
+    auto nodes = rebuilt.nodes.size();
+    bvh::refit(rebuilt, moved, {.rebuild_threshold = 1.5F});
+    EXPECT_EQ(rebuilt.nodes.size(), nodes);
+}
+
+
+TEST(Bvh, EmptyTreeHasNoCost)
+{
+    auto tree = bvh::build({});
+    bvh::refit(tree, {}, {.rebuild_threshold = 1.5F});
+
+    EXPECT_EQ(bvh::sah_cost(tree), 0);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "mat.hpp"
+#include "physics.hpp"
+#include "quat.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+using namespace ggmath;
+
+static_assert(debug::enabled, "test_debug.cpp belongs to the GGMATH_DEBUG=1 target");
+
+
+namespace
+{
+    const vec3f unit     = vec3f(0, 0, 1);
+    const vec3f not_unit = vec3f(2, 3, 4);
+
+    const mat33f singular   = {1, 2, 3, 2, 4, 6, 0, 0, 1};
+    const mat33f not_affine = {1, 0, 2, 0, 1, 3, 1, 0, 1};
+
+    const quatf identity_rotation = quatf(0, 0, 0, 1);
+    const quatf not_a_rotation    = quatf(1, 2, 3, 4);
+}    // namespace
+
+
+// region noexcept
+
+
+TEST(Debug, CheckedFunctionsAreNotNoexcept)
+{
+    static_assert(!noexcept(vector::parallel(unit, not_unit)));
+    static_assert(!noexcept(vector::anti_parallel(unit, not_unit)));
+    static_assert(!noexcept(vector::perpendicular(unit, not_unit)));
+    static_assert(!noexcept(vector::angle_between_unit(unit, unit)));
+    static_assert(!noexcept(vector::reflect(unit, unit)));
+    static_assert(!noexcept(matrix::inverse(singular)));
+    static_assert(!noexcept(matrix::inverse_affine(not_affine)));
+    static_assert(!noexcept(quaternion::from_axis_angle(unit, 1.0F)));
+    static_assert(!noexcept(quaternion::from_axis_angle_deg(unit, 1.0F)));
+    static_assert(!noexcept(quaternion::rotate(identity_rotation, unit)));
+    static_assert(!noexcept(quaternion::to_mat33(identity_rotation)));
+    static_assert(!noexcept(quaternion::to_mat44(identity_rotation)));
+    static_assert(!noexcept(physics::refract(unit, unit, 1.0F)));
+}
+
+
+// endregion noexcept
+
+
+// region throws
+
+
+TEST(Debug, VectorThrowsForInvalidArguments)
+{
+    ASSERT_THROW(vector::angle_between_unit(unit, not_unit), std::invalid_argument);
+    ASSERT_THROW(vector::reflect(not_unit, unit), std::invalid_argument);
+    ASSERT_THROW(vector::reflect(unit, not_unit), std::invalid_argument);
+    ASSERT_NO_THROW(vector::reflect(unit, unit));
+}
+TEST(Debug, MatrixThrowsForInvalidArguments)
+{
+    ASSERT_THROW(matrix::inverse(singular), std::invalid_argument);
+    ASSERT_THROW(matrix::inverse_affine(not_affine), std::invalid_argument);
+    ASSERT_NO_THROW(matrix::inverse(mat33f::identity()));
+    ASSERT_NO_THROW(matrix::inverse_affine(mat33f::identity()));
+}
+TEST(Debug, QuaternionThrowsForInvalidArguments)
+{
+    ASSERT_THROW(quaternion::from_axis_angle(not_unit, 1.0F), std::invalid_argument);
+    ASSERT_THROW(quaternion::from_axis_angle_deg(not_unit, 1.0F),
+                 std::invalid_argument);
+    ASSERT_THROW(quaternion::rotate(not_a_rotation, unit), std::invalid_argument);
+    ASSERT_THROW(quaternion::to_mat33(not_a_rotation), std::invalid_argument);
+    ASSERT_THROW(quaternion::to_mat44(not_a_rotation), std::invalid_argument);
+    ASSERT_NO_THROW(quaternion::rotate(identity_rotation, unit));
+}
+TEST(Debug, RefractThrowsForInvalidArguments)
+{
+    ASSERT_THROW(physics::refract(not_unit, unit, 1.0F), std::invalid_argument);
+    ASSERT_THROW(physics::refract(unit, not_unit, 1.0F), std::invalid_argument);
+    ASSERT_NO_THROW(physics::refract(-unit, unit, 1.0F));
+}
+TEST(Debug, SoaReflectThrowsForInvalidArguments)
+{
+    auto a       = vec3f_soa{unit, unit};
+    auto normals = vec3f_soa{unit, not_unit};
+    auto result  = vec3f_soa();
+
+    ASSERT_THROW(soa::reflect(a, normals, result), std::invalid_argument);
+    ASSERT_THROW(soa::reflect(a, not_unit, result), std::invalid_argument);
+    ASSERT_NO_THROW(soa::reflect(a, unit, result));
+}
+
+
+// endregion throws
@@ -0,0 +1,102 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+#include "expression.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    template <typename T>
+    concept lazy_accepts = requires(T&& _vec)
+    {
+        expr::lazy(std::forward<T>(_vec));
+    };
+
+
+    template <typename T_A, typename T_B>
+    concept addable = requires(T_A&& a, T_B&& b)
+    {
+        std::forward<T_A>(a) + std::forward<T_B>(b);
+    };
+
+
+    constexpr vec3i lerp_at_compile_time()
+    {
+        const auto a = vec3i(1, 2, 3);
+        const auto b = vec3i(5, 6, 7);
+
+        return expr::lazy(a) + 2 * (expr::lazy(b) - expr::lazy(a)) / 4;
+    }
+}    // namespace
+
+
+TEST(Expression, Lerp)
+{
+    const auto a = vec3f(1, 2, 3);
+    const auto b = vec3f(5, -6, 9);
+
+    const vec3f lazy = expr::lazy(a) + 0.25F * (expr::lazy(b) - expr::lazy(a));
+
+    ASSERT_EQ(lazy, a + 0.25F * (b - a));
+    ASSERT_EQ(lazy, vector::lerp(a, b, 0.25F));
+}
+TEST(Expression, EveryOperatorMatchesEager)
+{
+    const auto a = vec<double, 7>({1, 2, 3, 4, 5, 6, 7});
+    const auto b = vec<double, 7>({-3, 0, 8, 2, 1, 9, -4});
+
+    const vec<double, 7> lazy = -(expr::lazy(a) * 2.0 - expr::lazy(b) / 4.0) + a;
+
+    ASSERT_EQ(lazy, -(a * 2.0 - b / 4.0) + a);
+    ASSERT_EQ(expr::evaluate(expr::lazy(a) - b), a - b);
+}
+TEST(Expression, ConvertsToOtherElementTypes)
+{
+    const auto a = vec2i(1, 2);
+    const auto b = vec2i(3, 5);
+
+    const vec2d converted = expr::lazy(a) + b;
+
+    ASSERT_EQ(converted, vec2d(4, 7));
+    ASSERT_TRUE((std::is_same_v<decltype(expr::evaluate(expr::lazy(a) * 0.5)),
+                                vec2d>));
+}
+TEST(Expression, AliasedAssignment)
+{
+    auto       a = vec3f(1, 2, 3);
+    const auto b = vec3f(3, 2, 1);
+
+    a = expr::lazy(b) - expr::lazy(a) * 2.0F;
+
+    ASSERT_EQ(a, vec3f(1, -2, -5));
+}
+TEST(Expression, ConstantEvaluation)
+{
+    static_assert(lerp_at_compile_time() == vec3i(3, 4, 5));
+}
+TEST(Expression, RejectsTemporaries)
+{
+    ASSERT_TRUE((lazy_accepts<const vec3f&>));
+    ASSERT_FALSE((lazy_accepts<vec3f>));
+    ASSERT_TRUE((addable<expr::terminal<float, 3>, const vec3f&>));
+    ASSERT_FALSE((addable<expr::terminal<float, 3>, vec3f>));
+}
@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "fast.hpp"
+#include "packet.hpp"
+#include "util.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    // The last lane of a packet, x itself for floats
+    float lane(float x)
+    {
+        return x;
+    }
+
+
+    template <int W>
+    float lane(const simd_float<W>& x)
+    {
+        return x[W - 1];
+    }
+
+
+    /**
+     * @brief Return the largest difference of f(x) from the double precision
+     * reference(x) for count values of x from first to last
+     */
+    template <typename T_Fast, typename T_Reference>
+    double
+        max_error(T_Fast f, T_Reference reference, float first, float last, int count)
+    {
+        double error = 0;
+        for (int i = 0; i <= count; ++i)
+        {
+            const float x = first + (last - first) * float(i) / float(count);
+
+            error = std::max(error, std::abs(double(f(x)) - reference(double(x))));
+        }
+
+        return error;
+    }
+
+
+    /**
+     * @brief Return the largest relative difference of rsqrt(x) from 1 / sqrt(x) for
+     * x from 1e-30 to 1e30, T is float or a packet holding x in every lane
+     */
+    template <typename T>
+    double max_rsqrt_error()
+    {
+        double error = 0;
+        for (float x = 1e-30F; x < 1e30F; x *= 1.0001F)
+        {
+            const double exact = 1 / std::sqrt(double(x));
+
+            error = std::max(error,
+                             std::abs(double(lane(fast::rsqrt(T(x)))) - exact) / exact);
+        }
+
+        return error;
+    }
+
+}    // namespace
+
+
+TEST(Fast, RsqrtIsWithinItsError)
+{
+    ASSERT_LT(max_rsqrt_error<float>(), 5e-6);
+    ASSERT_LT(max_rsqrt_error<simd_float<8>>(), 5e-6);
+
+    // Too narrow for an rsqrt instruction, estimated with the bit trick
+    ASSERT_LT(max_rsqrt_error<simd_float<2>>(), 5e-6);
+}
+TEST(Fast, NormalizedMatchesPrecise)
+{
+    std::mt19937                          rng(42);
+    std::uniform_real_distribution<float> coordinate(-100, 100);
+
+    for (int i = 0; i < 1'000; ++i)
+    {
+        const auto v        = vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+        const auto fast    = fast::normalized(v);
+        const auto precise = vector::normalized(v);
+        const auto packet  = fast::normalized(vec3f_x8(v[0], v[1], v[2]));
+
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            ASSERT_NEAR(fast[axis], precise[axis], 1e-5F);
+            ASSERT_NEAR(packet[axis][7], precise[axis], 1e-5F);
+        }
+    }
+}
+TEST(Fast, NormalizedBatchMatchesScalar)
+{
+    std::mt19937                          rng(42);
+    std::uniform_real_distribution<float> coordinate(-100, 100);
+
+    // Not a multiple of the batch width
+    vec3f_soa vectors(203);
+    for (std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        vectors[i] = vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+    }
+
+    vec3f_soa out;
+    fast::normalized(vectors, out);
+
+    ASSERT_EQ(out.size(), vectors.size());
+    for (std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        const auto expected = fast::normalized(std::as_const(vectors)[i]);
+
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            ASSERT_NEAR(out.column(axis)[i], expected[axis], 1e-6F) << i;
+        }
+    }
+}
+TEST(Fast, AcosIsWithinItsError)
+{
+    const auto acos = [](float x) {
+        return fast::acos(x);
+    };
+    const auto acos_x8 = [](float x) {
+        return fast::acos(simd_float<8>(x))[3];
+    };
+    const auto reference = [](double x) {
+        return std::acos(x);
+    };
+
+    ASSERT_LT(max_error(acos, reference, -1, 1, 1'000'000), 5e-7);
+    ASSERT_LT(max_error(acos_x8, reference, -1, 1, 100'000), 5e-7);
+    ASSERT_EQ(fast::acos(1.0F), 0);
+    ASSERT_TRUE(std::isnan(fast::acos(1.5F)));
+}
+TEST(Fast, Atan2IsWithinItsError)
+{
+    double error = 0;
+    for (int i = 0; i <= 400; ++i)
+    {
+        for (int j = 0; j <= 400; ++j)
+        {
+            const float y = -2 + 0.01F * float(i);
+            const float x = -2 + 0.01F * float(j);
+
+            const auto packet = fast::atan2(simd_float<8>(y), simd_float<8>(x));
+            ASSERT_FLOAT_EQ(packet[0], fast::atan2(y, x));
+
+            if (x != 0 || y != 0)
+            {
+                error = std::max(
+                    error, std::abs(fast::atan2(y, x) - std::atan2(double(y), x)));
+            }
+        }
+    }
+
+    ASSERT_LT(error, 3e-6);
+    ASSERT_EQ(fast::atan2(0.0F, 0.0F), 0);
+    ASSERT_NEAR(fast::atan2(0.0F, -1.0F), std::numbers::pi_v<float>, 1e-6F);
+    ASSERT_NEAR(fast::atan2(-1.0F, 0.0F), -std::numbers::pi_v<float> / 2, 1e-6F);
+}
+TEST(Fast, SinAndCosAreWithinTheirError)
+{
+    const auto sin = [](float x) {
+        return fast::sin(x);
+    };
+    const auto cos = [](float x) {
+        return fast::cos(x);
+    };
+    const auto sin_x8 = [](float x) {
+        return fast::sin(simd_float<8>(x))[5];
+    };
+    const auto cos_x8 = [](float x) {
+        return fast::cos(simd_float<8>(x))[5];
+    };
+    const auto sin_reference = [](double x) {
+        return std::sin(x);
+    };
+    const auto cos_reference = [](double x) {
+        return std::cos(x);
+    };
+
+    // Every quadrant densely, then the whole documented range
+    for (float extent : {7.0F, 8192.0F})
+    {
+        ASSERT_LT(max_error(sin, sin_reference, -extent, extent, 1'000'000), 2e-7);
+        ASSERT_LT(max_error(cos, cos_reference, -extent, extent, 1'000'000), 2e-7);
+        ASSERT_LT(max_error(sin_x8, sin_reference, -extent, extent, 100'000), 2e-7);
+        ASSERT_LT(max_error(cos_x8, cos_reference, -extent, extent, 100'000), 2e-7);
+    }
+}
+TEST(Fast, AngleBetweenMatchesPrecise)
+{
+    std::mt19937                          rng(42);
+    std::uniform_real_distribution<float> coordinate(-10, 10);
+
+    for (int i = 0; i < 1'000; ++i)
+    {
+        const auto a = vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+        const auto b = vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+
+        // The error of the cosine grows by 1 / sin of the angle
+        ASSERT_NEAR(fast::angle_between(a, b), vector::angle_between(a, b), 1e-4F);
+    }
+
+    // Clamped, not NaN
+    const auto v = vec3f(0.1F, 0.7F, 0.3F);
+    ASSERT_NEAR(fast::angle_between(v, v * 3.0F), 0, 2e-3F);
+    ASSERT_NEAR(fast::angle_between(v, v * -1.0F), std::numbers::pi_v<float>, 2e-3F);
+}
+TEST(Fast, DegreesAndRadiansBatchesMatchPrecise)
+{
+    std::mt19937                          rng(42);
+    std::uniform_real_distribution<float> angle(-1000, 1000);
+
+    std::vector<float> values(203);
+    for (auto& value : values)
+    {
+        value = angle(rng);
+    }
+
+    std::vector<float> radians(values.size());
+    std::vector<float> degrees(values.size());
+    fast::deg_to_rad(values, radians);
+    fast::rad_to_deg(values, degrees);
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        ASSERT_NEAR(radians[i], deg_to_rad(values[i]), 2e-7F * std::abs(radians[i]));
+        ASSERT_NEAR(degrees[i], rad_to_deg(values[i]), 2e-7F * std::abs(degrees[i]));
+        ASSERT_EQ(radians[i], fast::deg_to_rad(values[i]));
+        ASSERT_EQ(degrees[i], fast::rad_to_deg(values[i]));
+    }
+
+    ASSERT_THROW(fast::deg_to_rad(values, std::span(radians).first(10)),
+                 std::invalid_argument);
+}
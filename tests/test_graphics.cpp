@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "graphics.hpp"
+#include "mat.hpp"
+#include "test_helpers.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+using helpers::expect_near;
+
+
+namespace
+{
+    // Rotation about z, scale and translation
+    constexpr mat44f affine = {0, -2, 0, 5, 2, 0, 0, -3, 0, 0, 0.5F, 1, 0, 0, 0, 1};
+
+    // A perspective projection with a near plane at 1 and a far plane at 10
+    constexpr mat44f perspective = {
+        1, 0, 0, 0, 0, 1, 0, 0, 0, 0, -11.0F / 9, -20.0F / 9, 0, 0, -1, 0};
+
+
+    // 5 points, so the last one is transformed on its own if two fit into a register
+    template <typename T>
+    std::vector<vec<T, 3>> make_points()
+    {
+        std::vector<vec<T, 3>> points;
+        points.emplace_back(1, 2, -3);
+        points.emplace_back(-4, 5, -6);
+        points.emplace_back(7, -8, -9);
+        points.emplace_back(0, 0, -1);
+        points.emplace_back(3, 4, -2);
+
+        return points;
+    }
+
+
+    template <typename T>
+    vec<T, 3> xyz(const vec<T, 4>& _vec)
+    {
+        return {_vec[0], _vec[1], _vec[2]};
+    }
+}    // namespace
+
+
+// region functions
+
+
+TEST(Graphics, TransformPoints)
+{
+    auto points = make_points<float>();
+    auto out    = std::vector<vec3f>(points.size());
+
+    graphics::transform_points(affine, points, out);
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        expect_near(out[i], xyz(affine * vec4f(points[i], 1)));
+    }
+}
+TEST(Graphics, TransformPointsPerspectiveDivide)
+{
+    auto points = make_points<float>();
+    auto out    = std::vector<vec3f>(points.size());
+
+    graphics::transform_points(perspective, points, out, true);
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        auto clip = perspective * vec4f(points[i], 1);
+        expect_near(out[i], xyz(clip) / clip[3]);
+    }
+
+    // The near plane maps to a depth of -1
+    ASSERT_NEAR(out[3][2], -1, 1e-5);
+}
+TEST(Graphics, TransformPointsDouble)
+{
+    auto points = make_points<double>();
+    auto out    = std::vector<vec3d>(points.size());
+
+    graphics::transform_points(mat44d(perspective), points, out, true);
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        auto clip = mat44d(perspective) * vec4d(points[i], 1);
+        expect_near(out[i], xyz(clip) / clip[3]);
+    }
+}
+TEST(Graphics, TransformHomogeneousPoints)
+{
+    std::vector<vec4f> points;
+    for (const auto& point : make_points<float>())
+    {
+        points.emplace_back(point, 2);
+    }
+    auto out = std::vector<vec4f>(points.size());
+
+    graphics::transform_points(perspective, points, out);
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        expect_near(out[i], perspective * points[i]);
+    }
+
+    graphics::transform_points(perspective, points, out, true);
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        auto clip = perspective * points[i];
+        expect_near(out[i], clip / clip[3]);
+    }
+}
+TEST(Graphics, TransformDirectionsIgnoresTranslation)
+{
+    auto directions = make_points<float>();
+    auto out        = std::vector<vec3f>(directions.size());
+
+    graphics::transform_directions(affine, directions, out);
+
+    std::vector<vec4f> directions4;
+    auto               out4 = std::vector<vec4f>(directions.size());
+    for (const auto& direction : directions)
+    {
+        directions4.emplace_back(direction, 1);
+    }
+    graphics::transform_directions(affine, directions4, out4);
+
+    for (std::size_t i = 0; i < directions.size(); ++i)
+    {
+        auto expected = affine * vec4f(directions[i], 0);
+
+        expect_near(out[i], xyz(expected));
+        expect_near(out4[i], expected);
+    }
+}
+TEST(Graphics, TransformPointsInPlace)
+{
+    auto points   = make_points<float>();
+    auto expected = std::vector<vec3f>(points.size());
+
+    graphics::transform_points(affine, points, expected);
+    graphics::transform_points(affine, points, points);
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        expect_near(points[i], expected[i]);
+    }
+}
+TEST(Graphics, TransformPointsThrowsIfSizesDiffer)
+{
+    auto points = make_points<float>();
+    auto out    = std::vector<vec3f>(points.size() - 1);
+
+    ASSERT_THROW(graphics::transform_points(affine, points, out),
+                 std::invalid_argument);
+}
+
+
+// endregion functions
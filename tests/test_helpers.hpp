@@ -0,0 +1,65 @@
+#ifndef GG_MATH_TEST_HELPERS_HPP
+#define GG_MATH_TEST_HELPERS_HPP
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "intersection.hpp"
+#include "vec.hpp"
+
+
+namespace helpers
+{
+    // region expectations
+
+
+    /**
+     * @brief Expect every component of actual to be within tolerance of the one of
+     * expected
+     */
+    template <ggmath::Scalar T, int n>
+    void expect_near(const ggmath::vec<T, n>& actual,
+                     const ggmath::vec<T, n>& expected,
+                     double                   tolerance = 1e-5)
+    {
+        for (int axis = 0; axis < n; ++axis)
+        {
+            EXPECT_NEAR(actual[axis], expected[axis], tolerance) << axis;
+        }
+    }
+
+
+    // endregion expectations
+
+
+    // region input generation
+
+
+    /**
+     * @brief Return count triangles whose first vertex is uniformly distributed in
+     * [-spread, spread] and whose edges from it are in [-size, size] per axis
+     */
+    inline std::vector<ggmath::trianglef>
+        random_triangles(std::mt19937& rng, int count, float spread, float size)
+    {
+        std::uniform_real_distribution<float> position(-spread, spread);
+        std::uniform_real_distribution<float> offset(-size, size);
+
+        std::vector<ggmath::trianglef> triangles;
+        for (int i = 0; i < count; ++i)
+        {
+            auto a = ggmath::vec3f(position(rng), position(rng), position(rng));
+            auto b = ggmath::vec3f(offset(rng), offset(rng), offset(rng));
+            auto c = ggmath::vec3f(offset(rng), offset(rng), offset(rng));
+            triangles.emplace_back(a, a + b, a + c);
+        }
+
+        return triangles;
+    }
+
+
+    // endregion input generation
+}    // namespace helpers
+#endif    // GG_MATH_TEST_HELPERS_HPP
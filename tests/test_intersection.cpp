@@ -0,0 +1,823 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "intersection.hpp"
+#include "packet.hpp"
+#include "ray.hpp"
+#include "test_helpers.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+using helpers::random_triangles;
+
+
+namespace
+{
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+
+
+    // The unit cube from 0 to 1
+    aabbf unit_box()
+    {
+        return {vec3f(0), vec3f(1)};
+    }
+
+
+    std::vector<aabbf> random_boxes(std::mt19937& rng, int count)
+    {
+        std::uniform_real_distribution<float> position(-10, 10);
+        std::uniform_real_distribution<float> extent(0.5F, 4);
+
+        std::vector<aabbf> boxes;
+        for (int i = 0; i < count; ++i)
+        {
+            auto min = vec3f(position(rng), position(rng), position(rng));
+            auto size = vec3f(extent(rng), extent(rng), extent(rng));
+            boxes.emplace_back(min, min + size);
+        }
+
+        return boxes;
+    }
+
+
+    // The triangle from the origin to 1 on the x and y axis
+    trianglef unit_triangle()
+    {
+        return {vec3f(0), vec3f(1, 0, 0), vec3f(0, 1, 0)};
+    }
+
+
+    // The axis-aligned cube from -1 to 1
+    obbf centered_cube()
+    {
+        return {vec3f(0), vec3f(1, 0, 0), vec3f(0, 1, 0), vec3f(0, 0, 1), vec3f(1)};
+    }
+
+
+    template <int W>
+    std::vector<triangle<simd_float<W>>> load_packets(
+        const std::vector<trianglef>& triangles)
+    {
+        std::vector<triangle<simd_float<W>>> packets;
+        for (std::size_t i = 0; i < triangles.size(); i += W)
+        {
+            auto span = std::span<const trianglef>(triangles).subspan(i);
+            packets.push_back(packet::load<W>(span));
+        }
+
+        return packets;
+    }
+}    // namespace
+
+
+// region aabb
+
+
+TEST(Aabb, DefaultIsEmpty)
+{
+    auto box = aabbf();
+
+    ASSERT_EQ(box.min, vec3f(infinity));
+    ASSERT_EQ(box.max, vec3f(-infinity));
+    ASSERT_FALSE(intersections::intersects(rayf(vec3f(0), vec3f(1, 0, 0)), box));
+}
+TEST(Aabb, Print)
+{
+    std::stringstream ss;
+    ss << unit_box();
+
+    ASSERT_EQ(ss.str(), "[(0,0,0),(1,1,1)]");
+}
+TEST(Sphere, Print)
+{
+    std::stringstream ss;
+    ss << spheref(vec3f(1), 2);
+
+    ASSERT_EQ(ss.str(), "[(1,1,1),2]");
+}
+
+
+// endregion aabb
+
+
+// region ray_aabb
+
+
+TEST(Intersection, RayHitsBoxInFront)
+{
+    auto _ray = rayf(vec3f(-1, 0.5F, 0.5F), vec3f(1, 0, 0));
+
+    ASSERT_TRUE(intersections::intersects(_ray, unit_box()));
+    ASSERT_FLOAT_EQ(intersections::entry_distance(_ray, unit_box()), 1);
+}
+TEST(Intersection, RayMissesBoxBehind)
+{
+    auto _ray = rayf(vec3f(2, 0.5F, 0.5F), vec3f(1, 0, 0));
+
+    ASSERT_FALSE(intersections::intersects(_ray, unit_box()));
+    ASSERT_EQ(intersections::entry_distance(_ray, unit_box()), infinity);
+}
+TEST(Intersection, RayMissesBoxBeyondTMax)
+{
+    auto _ray = rayf(vec3f(-4, 0.5F, 0.5F), vec3f(2, 0, 0));
+
+    ASSERT_TRUE(intersections::intersects(_ray, unit_box(), 2.0F));
+    ASSERT_FALSE(intersections::intersects(_ray, unit_box(), 1.9F));
+}
+TEST(Intersection, RayMissesBoxBeside)
+{
+    auto _ray = rayf(vec3f(-1, 0.5F, 0.5F), vec3f(1, 1.1F, 0));
+
+    ASSERT_FALSE(intersections::intersects(_ray, unit_box()));
+}
+TEST(Intersection, RayStartingInsideBox)
+{
+    auto _ray = rayf(vec3f(0.5F), vec3f(0, -1, 0));
+
+    ASSERT_TRUE(intersections::intersects(_ray, unit_box()));
+    ASSERT_EQ(intersections::entry_distance(_ray, unit_box()), 0);
+}
+TEST(Intersection, RayParallelToSlab)
+{
+    // On the plane of a face, so 0 times an infinite inverse direction is NaN
+    auto on_face = rayf(vec3f(-1, 0, 0.5F), vec3f(1, 0, 0));
+    auto outside = rayf(vec3f(-1, 1.5F, 0.5F), vec3f(1, 0, 0));
+
+    ASSERT_TRUE(intersections::intersects(on_face, unit_box()));
+    ASSERT_FALSE(intersections::intersects(outside, unit_box()));
+}
+TEST(Intersection, RayThroughEdgeHits)
+{
+    // Every ray touches the box only along its edge at x = 0 and y = 0, where it
+    // enters the x slab as it exits the y slab, so rounding must not make it miss
+    for (int i = 1; i <= 1000; ++i)
+    {
+        const float x = 0.0137F * static_cast<float>(i);
+        const float y = 0.0291F * static_cast<float>(i);
+
+        auto _ray = rayf(vec3f(-x, y, 0.5F), vec3f(x, -y, 0));
+
+        EXPECT_TRUE(intersections::intersects(_ray, unit_box())) << i;
+    }
+}
+TEST(Intersection, PacketMatchesScalar)
+{
+    auto rng   = std::mt19937(42);
+    auto boxes = random_boxes(rng, 8);
+    auto x4    = packet::load<4>(std::span<const aabbf>(boxes));
+    auto x8    = packet::load<8>(std::span<const aabbf>(boxes));
+
+    std::uniform_real_distribution<float> coordinate(-1, 1);
+    for (int i = 0; i < 100; ++i)
+    {
+        auto _ray = rayf(vec3f(coordinate(rng), coordinate(rng), coordinate(rng)),
+                         vec3f(coordinate(rng), coordinate(rng), coordinate(rng)));
+
+        auto hits_x4      = intersections::intersects(_ray, x4, 15.0F);
+        auto hits_x8      = intersections::intersects(_ray, x8, 15.0F);
+        auto distances_x8 = intersections::entry_distance(_ray, x8, 15.0F);
+
+        for (int lane = 0; lane < 8; ++lane)
+        {
+            const auto& box = boxes[static_cast<std::size_t>(lane)];
+
+            ASSERT_EQ(hits_x8[lane], intersections::intersects(_ray, box, 15.0F));
+            ASSERT_EQ(distances_x8[lane],
+                      intersections::entry_distance(_ray, box, 15.0F));
+            if (lane < 4)
+            {
+                ASSERT_EQ(hits_x4[lane], hits_x8[lane]);
+            }
+        }
+    }
+}
+TEST(Intersection, LoadFillsMissingLanesWithEmptyBoxes)
+{
+    std::vector<aabbf> boxes;
+    boxes.emplace_back(vec3f(-100), vec3f(100));
+    boxes.emplace_back(vec3f(-100), vec3f(100));
+
+    auto x4   = packet::load<4>(std::span<const aabbf>(boxes));
+    auto _ray = rayf(vec3f(0), vec3f(1, 2, 3));
+
+    ASSERT_EQ(intersections::intersects(_ray, x4).bits(), 0b0011U);
+}
+
+
+// endregion ray_aabb
+
+
+// region ray_triangle
+
+
+TEST(Intersection, RayHitsTriangle)
+{
+    auto from_above = rayf(vec3f(0.25F, 0.5F, 1), vec3f(0, 0, -2));
+    auto from_below = rayf(vec3f(0.25F, 0.5F, -1), vec3f(0, 0, 1));
+
+    for (const auto& hit : {intersections::moller_trumbore(from_above, unit_triangle()),
+                            intersections::watertight(from_above, unit_triangle())})
+    {
+        ASSERT_TRUE(hit);
+        ASSERT_FLOAT_EQ(hit.distance, 0.5F);
+        ASSERT_FLOAT_EQ(hit.u, 0.25F);
+        ASSERT_FLOAT_EQ(hit.v, 0.5F);
+        ASSERT_EQ(hit.index, 0);
+    }
+
+    // Both sides are hit
+    ASSERT_TRUE(intersections::moller_trumbore(from_below, unit_triangle()));
+    ASSERT_TRUE(intersections::watertight(from_below, unit_triangle()));
+}
+TEST(Intersection, RayMissesTriangle)
+{
+    auto beside   = rayf(vec3f(0.75F, 0.5F, 1), vec3f(0, 0, -1));
+    auto away     = rayf(vec3f(0.25F, 0.5F, 1), vec3f(0, 0, 1));
+    auto parallel = rayf(vec3f(-1, 0.5F, 0), vec3f(1, 0, 0));
+    auto above    = rayf(vec3f(0.25F, 0.5F, 1), vec3f(0, 0, -1));
+
+    for (const auto* _ray : {&beside, &away, &parallel})
+    {
+        ASSERT_FALSE(intersections::moller_trumbore(*_ray, unit_triangle()));
+        ASSERT_FALSE(intersections::watertight(*_ray, unit_triangle()));
+    }
+
+    ASSERT_FALSE(intersections::moller_trumbore(above, unit_triangle(), 0.9F));
+    ASSERT_FALSE(intersections::watertight(above, unit_triangle(), 0.9F));
+    ASSERT_EQ(intersections::watertight(above, unit_triangle(), 0.9F).distance,
+              infinity);
+}
+TEST(Intersection, WatertightDouble)
+{
+    auto _triangle = triangled(vec3d(0, 0, 0), vec3d(0, 2, 0), vec3d(0, 0, 2));
+    auto _ray      = rayd(vec3d(-3, 1, 0.5), vec3d(1, 0, 0));
+    auto hit       = intersections::watertight(_ray, _triangle);
+
+    ASSERT_DOUBLE_EQ(hit.distance, 3);
+    ASSERT_DOUBLE_EQ(hit.u, 0.5);
+    ASSERT_DOUBLE_EQ(hit.v, 0.25);
+}
+TEST(Intersection, WatertightHasNoGapsAlongSharedEdges)
+{
+    // A quad split along the edge from a to c
+    auto a = vec3f(0.1F, 0.3F, 0.7F);
+    auto b = vec3f(3.3F, 0.2F, 0.9F);
+    auto c = vec3f(2.9F, 1.7F, 0.1F);
+    auto d = vec3f(0.3F, 2.1F, 0.3F);
+
+    std::vector<trianglef> triangles;
+    triangles.emplace_back(a, b, c);
+    triangles.emplace_back(a, c, d);
+
+    auto span = std::span<const trianglef>(triangles);
+    auto rng  = std::mt19937(42);
+    std::uniform_real_distribution<float> coordinate(-5, 5);
+
+    for (int i = 0; i < 10'000; ++i)
+    {
+        // Aim at the shared edge from a random origin, its ends are on the border of
+        // the quad, where rays may miss it
+        const auto t      = (static_cast<float>(i) + 0.5F) / 10'000;
+        const auto target = a + (c - a) * t;
+        const auto origin = vec3f(coordinate(rng), coordinate(rng), 5);
+        auto       _ray   = rayf(origin, target - origin);
+
+        EXPECT_TRUE(intersections::watertight(_ray, span)) << i;
+    }
+}
+TEST(Intersection, TrianglePacketsMatchScalar)
+{
+    auto rng       = std::mt19937(42);
+    auto triangles = random_triangles(rng, 13, 4, 5);
+    auto packets_4 = load_packets<4>(triangles);
+    auto packets_8 = load_packets<8>(triangles);
+    auto span      = std::span<const trianglef>(triangles);
+    auto x4        = std::span<const trianglef_x4>(packets_4);
+    auto x8        = std::span<const trianglef_x8>(packets_8);
+
+    std::uniform_real_distribution<float> coordinate(-1, 1);
+    int                                   hits = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto _ray = rayf(vec3f(coordinate(rng), coordinate(rng), coordinate(rng)),
+                         vec3f(coordinate(rng), coordinate(rng), coordinate(rng)));
+
+        auto scalar = intersections::watertight(_ray, span, 20.0F);
+        auto mt     = intersections::moller_trumbore(_ray, span, 20.0F);
+
+        for (const auto& hit :
+             {intersections::watertight(_ray, x4, 20.0F),
+              intersections::watertight(_ray, x8, 20.0F),
+              intersections::moller_trumbore(_ray, x8, 20.0F),
+              mt})
+        {
+            ASSERT_EQ(hit.index, scalar.index) << i;
+            if (hit)
+            {
+                EXPECT_NEAR(hit.distance, scalar.distance, 1e-4) << i;
+                EXPECT_NEAR(hit.u, scalar.u, 1e-4) << i;
+                EXPECT_NEAR(hit.v, scalar.v, 1e-4) << i;
+            }
+        }
+
+        hits += scalar ? 1 : 0;
+    }
+
+    // Enough rays hit to compare the barycentric coordinates
+    ASSERT_GT(hits, 100);
+}
+TEST(Intersection, LoadFillsMissingLanesWithNan)
+{
+    std::vector<trianglef> triangles;
+    triangles.emplace_back(vec3f(0), vec3f(1, 0, 0), vec3f(0, 1, 0));
+
+    auto x4  = packet::load<4>(std::span<const trianglef>(triangles));
+    auto hit = rayf(vec3f(0.2F, 0.2F, 1), vec3f(0, 0, -1));
+    auto out = rayf(vec3f(2, 2, 1), vec3f(0, 0, -1));
+
+    ASSERT_TRUE(std::isnan(x4.a[0][3]));
+    ASSERT_EQ(intersections::watertight(hit, x4).index, 0);
+    ASSERT_EQ(intersections::moller_trumbore(hit, x4).index, 0);
+    ASSERT_FALSE(intersections::watertight(out, x4));
+    ASSERT_FALSE(intersections::moller_trumbore(out, x4));
+}
+
+
+// endregion ray_triangle
+
+
+// region ray_shapes
+
+
+TEST(Intersection, RayHitsSphere)
+{
+    auto unit_sphere = spheref(vec3f(0), 1);
+
+    auto from_left = rayf(vec3f(-5, 0, 0), vec3f(1, 0, 0));
+    auto scaled    = rayf(vec3f(-5, 0, 0), vec3f(2, 0, 0));
+    auto inside    = rayf(vec3f(0.5F, 0, 0), vec3f(0, 1, 0));
+
+    ASSERT_TRUE(intersections::intersects(from_left, unit_sphere));
+    ASSERT_FLOAT_EQ(intersections::entry_distance(from_left, unit_sphere), 4);
+    ASSERT_FLOAT_EQ(intersections::entry_distance(scaled, unit_sphere), 2);
+    ASSERT_EQ(intersections::entry_distance(inside, unit_sphere), 0);
+}
+TEST(Intersection, RayMissesSphere)
+{
+    auto unit_sphere = spheref(vec3f(0), 1);
+
+    auto behind = rayf(vec3f(5, 0, 0), vec3f(1, 0, 0));
+    auto beside = rayf(vec3f(-5, 1.01F, 0), vec3f(1, 0, 0));
+    auto far    = rayf(vec3f(-5, 0, 0), vec3f(1, 0, 0));
+
+    ASSERT_FALSE(intersections::intersects(behind, unit_sphere));
+    ASSERT_FALSE(intersections::intersects(beside, unit_sphere));
+    ASSERT_FALSE(intersections::intersects(far, unit_sphere, 3.9F));
+    ASSERT_EQ(intersections::entry_distance(far, unit_sphere, 3.9F), infinity);
+}
+TEST(Intersection, RayHitsSmallDistantSphere)
+{
+    // b * b - 4 * a * c cancels to zero in float for this sphere
+    auto small = spheref(vec3f(10'000, 0, 0), 0.01F);
+
+    auto centered = rayf(vec3f(0), vec3f(1, 0, 0));
+    auto inside   = rayf(vec3f(0, 0.009F, 0), vec3f(1, 0, 0));
+    auto outside  = rayf(vec3f(0, 0.011F, 0), vec3f(1, 0, 0));
+
+    EXPECT_NEAR(intersections::entry_distance(centered, small), 9'999.99F, 2e-3);
+    EXPECT_TRUE(intersections::intersects(inside, small));
+    EXPECT_FALSE(intersections::intersects(outside, small));
+}
+TEST(Intersection, RayCrossesPlane)
+{
+    auto floor = planef(vec3f(0, 0, 1), 2);
+
+    auto up       = rayf(vec3f(0), vec3f(0, 0, 1));
+    auto down     = rayf(vec3f(1, 1, 5), vec3f(0, 0, -1));
+    auto away     = rayf(vec3f(0), vec3f(0, 0, -1));
+    auto parallel = rayf(vec3f(0), vec3f(1, 0, 0));
+    auto in_plane = rayf(vec3f(0, 0, 2), vec3f(1, 0, 0));
+
+    ASSERT_FLOAT_EQ(intersections::entry_distance(up, floor), 2);
+    ASSERT_FLOAT_EQ(intersections::entry_distance(down, floor), 3);
+    ASSERT_FALSE(intersections::intersects(up, floor, 1.9F));
+    ASSERT_FALSE(intersections::intersects(away, floor));
+    ASSERT_FALSE(intersections::intersects(parallel, floor));
+    ASSERT_FALSE(intersections::intersects(in_plane, floor));
+}
+TEST(Intersection, ShapePacketsMatchScalar)
+{
+    auto rng = std::mt19937(42);
+    std::uniform_real_distribution<float> coordinate(-5, 5);
+    std::uniform_real_distribution<float> radius(0.5F, 3);
+
+    std::vector<spheref> spheres;
+    std::vector<planef>  planes;
+    for (int i = 0; i < 8; ++i)
+    {
+        auto point     = vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+        auto direction = vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+        auto normal    = vector::normalized(direction);
+
+        spheres.emplace_back(point, radius(rng));
+        planes.emplace_back(normal, vector::dot(normal, point));
+    }
+
+    auto spheres_x8 = packet::load<8>(std::span<const spheref>(spheres));
+    auto planes_x8  = packet::load<8>(std::span<const planef>(planes));
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto _ray = rayf(vec3f(coordinate(rng), coordinate(rng), coordinate(rng)),
+                         vec3f(coordinate(rng), coordinate(rng), coordinate(rng)));
+
+        auto sphere_hits = intersections::intersects(_ray, spheres_x8, 2.0F);
+        auto sphere_t    = intersections::entry_distance(_ray, spheres_x8, 2.0F);
+        auto plane_hits  = intersections::intersects(_ray, planes_x8, 2.0F);
+        auto plane_t     = intersections::entry_distance(_ray, planes_x8, 2.0F);
+
+        for (int lane = 0; lane < 8; ++lane)
+        {
+            const auto& _sphere = spheres[static_cast<std::size_t>(lane)];
+            const auto& _plane  = planes[static_cast<std::size_t>(lane)];
+
+            const float t_sphere = intersections::entry_distance(_ray, _sphere, 2.0F);
+            const float t_plane  = intersections::entry_distance(_ray, _plane, 2.0F);
+
+            ASSERT_EQ(sphere_hits[lane], t_sphere != infinity) << i;
+            ASSERT_EQ(plane_hits[lane], t_plane != infinity) << i;
+            if (t_sphere != infinity)
+            {
+                EXPECT_NEAR(sphere_t[lane], t_sphere, 1e-5) << i;
+            }
+            if (t_plane != infinity)
+            {
+                EXPECT_NEAR(plane_t[lane], t_plane, 1e-5) << i;
+            }
+        }
+    }
+}
+
+
+// endregion ray_shapes
+
+
+// region overlaps
+
+
+TEST(Overlap, Spheres)
+{
+    auto a = spheref(vec3f(0), 1);
+
+    ASSERT_TRUE(intersections::overlaps(a, spheref(vec3f(1.5F, 0, 0), 1)));
+    ASSERT_TRUE(intersections::overlaps(a, spheref(vec3f(0, 2, 0), 1)));
+    ASSERT_FALSE(intersections::overlaps(a, spheref(vec3f(0, 2.01F, 0), 1)));
+}
+TEST(Overlap, SphereAndBox)
+{
+    auto touching = spheref(vec3f(2, 0.5F, 0.5F), 1);
+    auto corner   = spheref(vec3f(1.6F), 1);
+    auto inside   = spheref(vec3f(0.5F), 0.1F);
+
+    ASSERT_TRUE(intersections::overlaps(touching, unit_box()));
+    ASSERT_TRUE(intersections::overlaps(unit_box(), touching));
+    ASSERT_TRUE(intersections::overlaps(inside, unit_box()));
+    ASSERT_FALSE(intersections::overlaps(corner, unit_box()));
+    ASSERT_TRUE(intersections::overlaps(spheref(vec3f(1.6F), 1.1F), unit_box()));
+    ASSERT_FALSE(intersections::overlaps(inside, aabbf()));
+}
+TEST(Overlap, Boxes)
+{
+    ASSERT_TRUE(intersections::overlaps(unit_box(), aabbf(vec3f(0.5F), vec3f(2))));
+    ASSERT_TRUE(intersections::overlaps(unit_box(), aabbf(vec3f(1, 0, 0), vec3f(2))));
+    ASSERT_FALSE(
+        intersections::overlaps(unit_box(), aabbf(vec3f(0.5F, 1.1F, 0.5F), vec3f(2))));
+    ASSERT_FALSE(intersections::overlaps(unit_box(), aabbf()));
+    ASSERT_FALSE(intersections::overlaps(aabbf(), aabbf()));
+}
+TEST(Overlap, AxisAlignedOrientedBoxesMatchBoxes)
+{
+    auto rng   = std::mt19937(42);
+    auto boxes = random_boxes(rng, 100);
+
+    // The axes of an oriented box may be any permutation of the coordinate axes,
+    // in either direction
+    auto to_obb = [](const aabbf& box, int i) {
+        const auto  shift = static_cast<std::size_t>(i);
+        const float sign  = i % 2 == 0 ? 1.0F : -1.0F;
+
+        std::array<vec3f, 3> axes = {vec3f(0), vec3f(0), vec3f(0)};
+        auto                 size = box.max - box.min;
+        auto                 half = vec3f(0);
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            const auto from  = (axis + shift) % 3;
+            half[axis]       = size[from] / 2;
+            axes[axis][from] = sign;
+        }
+
+        return obbf((box.min + box.max) / 2, axes[0], axes[1], axes[2], half);
+    };
+
+    int overlapping = 0;
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        for (std::size_t j = 0; j < boxes.size(); ++j)
+        {
+            const bool expected = intersections::overlaps(boxes[i], boxes[j]);
+
+            ASSERT_EQ(intersections::overlaps(to_obb(boxes[i], static_cast<int>(i)),
+                                              to_obb(boxes[j], static_cast<int>(j))),
+                      expected)
+                << i << ", " << j;
+
+            overlapping += expected ? 1 : 0;
+        }
+    }
+
+    ASSERT_GT(overlapping, 150);
+}
+TEST(Overlap, RotatedOrientedBoxes)
+{
+    const float diagonal = std::sqrt(0.5F);
+
+    auto cube = centered_cube();
+
+    // Rotated by 45 degrees around z, so a vertical edge points at the cube
+    auto rotated = [&](float x) {
+        return obbf(vec3f(x, 0, 0),
+                    vec3f(diagonal, diagonal, 0),
+                    vec3f(-diagonal, diagonal, 0),
+                    vec3f(0, 0, 1),
+                    vec3f(1));
+    };
+
+    ASSERT_TRUE(intersections::overlaps(cube, rotated(2.3F)));
+    ASSERT_TRUE(intersections::overlaps(rotated(2.3F), cube));
+    ASSERT_FALSE(intersections::overlaps(cube, rotated(2.5F)));
+    ASSERT_FALSE(intersections::overlaps(rotated(2.5F), cube));
+}
+TEST(Overlap, CapsuleAndSphere)
+{
+    auto _capsule = capsulef(vec3f(0), vec3f(4, 0, 0), 0.5F);
+
+    ASSERT_TRUE(intersections::overlaps(_capsule, spheref(vec3f(2, 1, 0), 0.5F)));
+    ASSERT_TRUE(intersections::overlaps(spheref(vec3f(5, 0, 0), 0.5F), _capsule));
+    ASSERT_FALSE(intersections::overlaps(_capsule, spheref(vec3f(2, 1.1F, 0), 0.5F)));
+    ASSERT_FALSE(intersections::overlaps(_capsule, spheref(vec3f(5.1F, 0, 0), 0.5F)));
+
+    // Capsules with a segment of length zero are spheres
+    auto point = capsulef(vec3f(1), vec3f(1), 1);
+    ASSERT_TRUE(intersections::overlaps(point, spheref(vec3f(1, 1, 3), 1)));
+    ASSERT_FALSE(intersections::overlaps(point, spheref(vec3f(1, 1, 3.1F), 1)));
+}
+TEST(Overlap, Capsules)
+{
+    auto a = capsulef(vec3f(-1, 0, 0), vec3f(1, 0, 0), 0.5F);
+
+    // Parallel, crossing and apart beyond an end
+    ASSERT_TRUE(
+        intersections::overlaps(a, capsulef(vec3f(-3, 1, 0), vec3f(0, 1, 0), 0.5F)));
+    ASSERT_FALSE(intersections::overlaps(
+        a, capsulef(vec3f(-3, 1.1F, 0), vec3f(0, 1.1F, 0), 0.5F)));
+    ASSERT_TRUE(
+        intersections::overlaps(a, capsulef(vec3f(0, -1, 1), vec3f(0, 1, 1), 0.5F)));
+    ASSERT_FALSE(
+        intersections::overlaps(a, capsulef(vec3f(2, -1, 1), vec3f(2, 1, 1), 0.7F)));
+    ASSERT_TRUE(
+        intersections::overlaps(a, capsulef(vec3f(2, -1, 1), vec3f(2, 1, 1), 0.95F)));
+}
+TEST(Overlap, CapsulesMatchSampledDistance)
+{
+    auto rng = std::mt19937(42);
+    std::uniform_real_distribution<float> coordinate(-2, 2);
+
+    constexpr int samples = 256;
+
+    for (int i = 0; i < 200; ++i)
+    {
+        auto p_1 = vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+        auto q_1 = vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+        auto p_2 = vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+        auto q_2 = vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+
+        // The sampled distance is at most the step along both segments too far
+        float sampled = infinity;
+        for (int s = 0; s <= samples; ++s)
+        {
+            for (int t = 0; t <= samples; ++t)
+            {
+                const float u = static_cast<float>(s) / samples;
+                const float v = static_cast<float>(t) / samples;
+
+                auto on_1 = p_1 + (q_1 - p_1) * u;
+                auto on_2 = p_2 + (q_2 - p_2) * v;
+                sampled   = std::min(sampled, vector::distance(on_1, on_2));
+            }
+        }
+        const float step =
+            (vector::distance(p_1, q_1) + vector::distance(p_2, q_2)) / samples;
+
+        auto capsule_1 = [&](float radius) { return capsulef(p_1, q_1, radius); };
+        auto capsule_2 = capsulef(p_2, q_2, 0);
+
+        EXPECT_TRUE(intersections::overlaps(capsule_1(sampled + 1e-4F), capsule_2))
+            << i;
+        if (sampled > step)
+        {
+            EXPECT_FALSE(intersections::overlaps(capsule_1(sampled - step), capsule_2))
+                << i;
+        }
+    }
+}
+
+
+// endregion overlaps
+
+
+// region batches
+
+
+TEST(Batch, OverlapMaskMatchesScalar)
+{
+    auto rng = std::mt19937(42);
+    std::uniform_real_distribution<float> coordinate(-10, 10);
+    std::uniform_real_distribution<float> radius(0.1F, 2);
+
+    std::vector<spheref> spheres;
+    for (int i = 0; i < 150; ++i)
+    {
+        spheres.emplace_back(vec3f(coordinate(rng), coordinate(rng), coordinate(rng)),
+                             radius(rng));
+    }
+    auto boxes = random_boxes(rng, 150);
+
+    std::vector<spheref_x8> spheres_x8;
+    std::vector<aabbf_x4>   boxes_x4;
+    for (std::size_t i = 0; i < spheres.size(); i += 8)
+    {
+        spheres_x8.push_back(
+            packet::load<8>(std::span<const spheref>(spheres).subspan(i)));
+    }
+    for (std::size_t i = 0; i < boxes.size(); i += 4)
+    {
+        boxes_x4.push_back(packet::load<4>(std::span<const aabbf>(boxes).subspan(i)));
+    }
+
+    auto query = spheref(vec3f(1, 2, 3), 5);
+
+    std::vector<std::uint32_t> expected_spheres;
+    std::vector<std::uint32_t> expected_boxes;
+    for (std::uint32_t i = 0; i < 150; ++i)
+    {
+        if (intersections::overlaps(query, spheres[i]))
+        {
+            expected_spheres.push_back(i);
+        }
+        if (intersections::overlaps(query, boxes[i]))
+        {
+            expected_boxes.push_back(i);
+        }
+    }
+    ASSERT_GT(expected_spheres.size(), 5);
+    ASSERT_GT(expected_boxes.size(), 5);
+
+    auto indices = [](std::span<const std::uint64_t> mask) {
+        std::vector<std::uint32_t> set;
+        for (std::uint32_t i = 0; i < mask.size() * 64; ++i)
+        {
+            if (((mask[i / 64] >> (i % 64)) & 1) != 0)
+            {
+                set.push_back(i);
+            }
+        }
+
+        return set;
+    };
+
+    // Filled with ones to check the mask is cleared
+    std::vector<std::uint64_t> mask(3, ~std::uint64_t(0));
+    std::vector<std::uint32_t> hits(152);
+
+    intersections::overlap_mask(query, std::span<const spheref>(spheres), mask);
+    ASSERT_EQ(indices(mask), expected_spheres);
+    intersections::overlap_mask(query, std::span<const spheref_x8>(spheres_x8), mask);
+    ASSERT_EQ(indices(mask), expected_spheres);
+
+    auto x8    = std::span<const spheref_x8>(spheres_x8);
+    auto count = intersections::overlapping(query, x8, hits);
+    ASSERT_EQ(std::vector(hits.begin(), hits.begin() + std::ptrdiff_t(count)),
+              expected_spheres);
+
+    intersections::overlap_mask(query, std::span<const aabbf_x4>(boxes_x4), mask);
+    ASSERT_EQ(indices(mask), expected_boxes);
+
+    count = intersections::overlapping(query, std::span<const aabbf>(boxes), hits);
+    ASSERT_EQ(std::vector(hits.begin(), hits.begin() + std::ptrdiff_t(count)),
+              expected_boxes);
+}
+TEST(Batch, IntersectingMatchesScalar)
+{
+    auto rng = std::mt19937(42);
+    std::uniform_real_distribution<float> coordinate(-10, 10);
+
+    std::vector<spheref> spheres;
+    for (int i = 0; i < 70; ++i)
+    {
+        spheres.emplace_back(vec3f(coordinate(rng), coordinate(rng), coordinate(rng)),
+                             2);
+    }
+    std::vector<spheref_x4> spheres_x4;
+    for (std::size_t i = 0; i < spheres.size(); i += 4)
+    {
+        spheres_x4.push_back(
+            packet::load<4>(std::span<const spheref>(spheres).subspan(i)));
+    }
+
+    std::vector<std::uint64_t> mask(2);
+    std::vector<std::uint32_t> hits(72);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        auto _ray = rayf(vec3f(0), vec3f(coordinate(rng), coordinate(rng), 1));
+
+        std::vector<std::uint32_t> expected;
+        for (std::uint32_t j = 0; j < spheres.size(); ++j)
+        {
+            if (intersections::intersects(_ray, spheres[j], 8.0F))
+            {
+                expected.push_back(j);
+            }
+        }
+
+        auto count = intersections::intersecting(
+            _ray, std::span<const spheref_x4>(spheres_x4), hits, 8.0F);
+        ASSERT_EQ(std::vector(hits.begin(), hits.begin() + std::ptrdiff_t(count)),
+                  expected);
+
+        intersections::intersection_mask(
+            _ray, std::span<const spheref>(spheres), mask, 8.0F);
+        ASSERT_EQ(std::popcount(mask[0]) + std::popcount(mask[1]),
+                  static_cast<int>(expected.size()));
+    }
+}
+TEST(Batch, UndersizedOutputsThrow)
+{
+    std::vector<spheref> spheres(65, spheref(vec3f(0), 1));
+    auto                 candidates = std::span<const spheref>(spheres);
+
+    const auto query = spheref(vec3f(0), 1);
+    const auto _ray  = rayf(vec3f(0), vec3f(0, 0, 1));
+
+    std::vector<std::uint64_t> mask(1);
+    std::vector<std::uint32_t> hits(64);
+
+    ASSERT_THROW(intersections::overlap_mask(query, candidates, mask),
+                 std::invalid_argument);
+    ASSERT_THROW(intersections::overlapping(query, candidates, hits),
+                 std::invalid_argument);
+    ASSERT_THROW(intersections::intersection_mask(_ray, candidates, mask),
+                 std::invalid_argument);
+    ASSERT_THROW(intersections::intersecting(_ray, candidates, hits),
+                 std::invalid_argument);
+
+    mask.resize(2);
+    hits.resize(65);
+    ASSERT_EQ(intersections::overlapping(query, candidates, hits), 65);
+}
+TEST(Batch, LoadFillsMissingLanesWithNan)
+{
+    std::vector<spheref>  spheres;
+    std::vector<capsulef> capsules;
+    std::vector<obbf>     boxes;
+    spheres.emplace_back(vec3f(0), 100);
+    capsules.emplace_back(vec3f(0), vec3f(1), 100);
+    boxes.emplace_back(
+        vec3f(0), vec3f(1, 0, 0), vec3f(0, 1, 0), vec3f(0, 0, 1), vec3f(100));
+
+    auto spheres_x4  = packet::load<4>(std::span<const spheref>(spheres));
+    auto capsules_x4 = packet::load<4>(std::span<const capsulef>(capsules));
+    auto boxes_x4    = packet::load<4>(std::span<const obbf>(boxes));
+
+    auto query = spheref(vec3f(0), 1);
+    auto cube = centered_cube();
+    auto _ray = rayf(vec3f(0), vec3f(1, 0, 0));
+
+    ASSERT_EQ(intersections::overlaps(query, spheres_x4).bits(), 0b0001U);
+    ASSERT_EQ(intersections::overlaps(query, capsules_x4).bits(), 0b0001U);
+    ASSERT_EQ(intersections::overlaps(cube, boxes_x4).bits(), 0b0001U);
+    ASSERT_EQ(intersections::intersects(_ray, spheres_x4).bits(), 0b0001U);
+}
+
+
+// endregion batches
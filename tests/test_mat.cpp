@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "mat.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    template <typename T, int n, int m>
+    void expect_near(const mat<T, n, m>& actual, const mat<T, n, m>& expected)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = 0; j < m; ++j)
+            {
+                EXPECT_NEAR(actual[i][j], expected[i][j], 1e-4) << i << ", " << j;
+            }
+        }
+    }
+
+
+    // Rotation about z, scale and translation, so its inverse is not its transpose
+    constexpr mat44f affine = {0, -2, 0, 5, 2, 0, 0, -3, 0, 0, 0.5F, 1, 0, 0, 0, 1};
+
+    constexpr mat44f general = {4, 7, 2, 3, 0, 5, -1, 2, 3, 1, 6, -4, 2, -3, 1, 8};
+}    // namespace
+
+
+// region constructors
+
+
+TEST(Mat, DefaultIsZero)
+{
+    ASSERT_EQ(mat33f(), mat33f(0));
+    ASSERT_EQ(mat33f::zero(), mat33f(0));
+}
+TEST(Mat, InitializerListIsRowMajor)
+{
+    auto _mat = mat<int, 2, 3>{1, 2, 3, 4};
+
+    ASSERT_EQ(_mat[0][2], 3);
+    ASSERT_EQ(_mat[1][0], 4);
+    ASSERT_EQ(_mat[1][2], 0);
+}
+TEST(Mat, Identity)
+{
+    constexpr auto identity = mat33f::identity();
+
+    ASSERT_EQ(identity, (mat33f{1, 0, 0, 0, 1, 0, 0, 0, 1}));
+}
+TEST(Mat, RowAndColumn)
+{
+    auto _mat = mat<int, 2, 3>{1, 2, 3, 4, 5, 6};
+
+    ASSERT_EQ(_mat.row(1), vec3i(4, 5, 6));
+    ASSERT_EQ(_mat.column(2), vec2i(3, 6));
+}
+TEST(Mat, Alignment)
+{
+    ASSERT_EQ(alignof(mat44f), 64);
+    ASSERT_EQ(alignof(mat44d), 64);
+    ASSERT_EQ(sizeof(mat33f), 9 * sizeof(float));
+}
+
+
+// endregion constructors
+
+
+// region operators
+
+
+TEST(Mat, AddSub)
+{
+    auto a = mat22f{1, 2, 3, 4};
+    auto b = mat22f{4, 3, 2, 1};
+
+    ASSERT_EQ(a + b, mat22f(5));
+    ASSERT_EQ(a - a, mat22f::zero());
+}
+TEST(Mat, Scale)
+{
+    auto _mat = mat<int, 2, 2>{1, 2, 3, 4};
+
+    ASSERT_EQ(_mat * 2, (mat<int, 2, 2>{2, 4, 6, 8}));
+    ASSERT_EQ(2 * _mat, _mat * 2);
+    ASSERT_EQ(_mat / 2.0, (mat22d{0.5, 1, 1.5, 2}));
+}
+TEST(Mat, MultiplyNonSquare)
+{
+    auto a = mat<int, 2, 3>{1, 2, 3, 4, 5, 6};
+    auto b = mat<int, 3, 2>{7, 8, 9, 10, 11, 12};
+
+    ASSERT_EQ(a * b, (mat<int, 2, 2>{58, 64, 139, 154}));
+}
+TEST(Mat, Multiply4x4MatchesScalar)
+{
+    // Calculated by the scalar loop, since constant evaluation does not dispatch
+    constexpr auto expected = general * affine;
+
+    expect_near(general * affine, expected);
+    expect_near(mat44d(general) * mat44d(affine), mat44d(expected));
+}
+TEST(Mat, MultiplyAssign)
+{
+    auto _mat = general;
+    _mat *= mat44f::identity();
+    _mat *= 2;
+
+    ASSERT_EQ(_mat, general * 2);
+}
+TEST(Mat, TransformVector)
+{
+    auto result = affine * vec4f(1, 1, 2, 1);
+
+    ASSERT_EQ(result, vec4f(3, -1, 2, 1));
+    ASSERT_EQ(vec2i(1, 2) * (mat<int, 2, 3>{1, 2, 3, 4, 5, 6}), vec3i(9, 12, 15));
+}
+TEST(Mat, Print)
+{
+    std::stringstream ss;
+    ss << mat22f{1, 2, 3, 4};
+
+    ASSERT_EQ(ss.str(), "((1,2),(3,4))");
+}
+
+
+// endregion operators
+
+
+// region functions
+
+
+TEST(Mat, Transposed)
+{
+    auto _mat = mat<int, 2, 3>{1, 2, 3, 4, 5, 6};
+
+    ASSERT_EQ(matrix::transposed(_mat), (mat<int, 3, 2>{1, 4, 2, 5, 3, 6}));
+}
+TEST(Mat, Determinant)
+{
+    ASSERT_EQ(matrix::determinant(mat<int, 2, 2>{1, 2, 3, 4}), -2);
+    ASSERT_EQ(matrix::determinant(mat<int, 3, 3>{2, 0, 1, 1, 3, 2, 1, 1, 2}), 6);
+    ASSERT_FLOAT_EQ(matrix::determinant(general), 546);
+    ASSERT_FLOAT_EQ(matrix::determinant(affine), 2);
+}
+TEST(Mat, DeterminantByElimination)
+{
+    // Block diagonal, so the determinant is the product of the blocks'
+    auto _mat = mat<int, 5, 5>();
+    _mat[0][0] = 1;
+    _mat[0][1] = 2;
+    _mat[1][0] = 3;
+    _mat[1][1] = 4;
+    _mat[2][2] = 2;
+    _mat[3][3] = 0;
+    _mat[3][4] = 3;
+    _mat[4][3] = 1;
+    _mat[4][4] = 5;
+
+    ASSERT_EQ(matrix::determinant(_mat), -2 * 2 * -3);
+    ASSERT_EQ(matrix::determinant(mat<double, 5, 5>()), 0);
+}
+TEST(Mat, Inverse2x2And3x3)
+{
+    auto a = mat22f{4, 7, 2, 6};
+    auto b = mat33d{2, 0, 1, 1, 3, 2, 1, 1, 2};
+
+    expect_near(a * matrix::inverse(a), mat22f::identity());
+    expect_near(matrix::inverse(b) * b, mat33d::identity());
+}
+TEST(Mat, InverseOfIntIsDouble)
+{
+    auto inverse = matrix::inverse(mat<int, 2, 2>{2, 0, 0, 4});
+
+    ASSERT_TRUE((std::is_same<decltype(inverse), mat22d>::value));
+    ASSERT_EQ(inverse, (mat22d{0.5, 0, 0, 0.25}));
+}
+TEST(Mat, Inverse4x4)
+{
+    constexpr auto expected = matrix::inverse(general);
+
+    expect_near(matrix::inverse(general), expected);
+    expect_near(general * matrix::inverse(general), mat44f::identity());
+    expect_near(matrix::inverse(mat44d(general)) * mat44d(general), mat44d::identity());
+}
+TEST(Mat, InverseByElimination)
+{
+    auto _mat = mat<double, 5, 5>::identity() * 2;
+    _mat[0][4] = 3;
+    _mat[4][1] = -1;
+    _mat[2][3] = 0.5;
+
+    expect_near(_mat * matrix::inverse(_mat), mat<double, 5, 5>::identity());
+}
+TEST(Mat, InverseAffine)
+{
+    ASSERT_TRUE(matrix::is_affine(affine));
+    ASSERT_FALSE(matrix::is_affine(general));
+
+    expect_near(matrix::inverse_affine(affine), matrix::inverse(affine));
+    expect_near(matrix::inverse_affine(affine) * affine, mat44f::identity());
+    expect_near(matrix::inverse_affine(mat33f{0, -1, 4, 1, 0, 2, 0, 0, 1}),
+                mat33f{0, 1, -2, -1, 0, 4, 0, 0, 1});
+}
+TEST(Mat, ThrowIfSingular)
+{
+    ASSERT_THROW(debug::throw_if_singular(0.0F), std::invalid_argument);
+    ASSERT_NO_THROW(debug::throw_if_singular(1.0F));
+    ASSERT_THROW(debug::throw_if_not_affine(general), std::invalid_argument);
+    ASSERT_NO_THROW(debug::throw_if_not_affine(affine));
+}
+
+
+// endregion functions
@@ -0,0 +1,282 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include "packet.hpp"
+#include "test_helpers.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+using namespace ggmath;
+using helpers::expect_near;
+
+
+namespace
+{
+    // 11 vectors, so the second packet of 8 is partially filled
+    std::vector<vec3f> make_vectors(float offset)
+    {
+        std::vector<vec3f> vectors;
+
+        for (int i = 0; i < 11; ++i)
+        {
+            auto x = static_cast<float>(i) + offset;
+            vectors.emplace_back(x, 2 - x, x * x / 4 + 1);
+        }
+
+        return vectors;
+    }
+
+
+    template <typename T, int W>
+    simd::pack<T, W> pack_of(const std::array<T, W>& lanes)
+    {
+        return simd::pack<T, W>::load(lanes.data());
+    }}    // namespace
+
+
+// region pack
+
+
+TEST(Packet, LaneTypeIsScalar)
+{
+    ASSERT_TRUE(Scalar<simd_float<8>>);
+    ASSERT_TRUE(Scalar<simd_double<4>>);
+    ASSERT_TRUE((std::is_same<float_or_double<simd_float<8>>, simd_float<8>>::value));
+}
+TEST(Packet, Broadcast)
+{
+    simd_float<8> a = 3.0F;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        ASSERT_EQ(a[i], 3);
+    }
+}
+TEST(Packet, Arithmetic)
+{
+    auto a = pack_of<float, 4>({1, 2, 3, 4});
+    auto b = pack_of<float, 4>({4, 3, 2, 1});
+
+    auto result = (a + b) * 2 - a / b;
+
+    ASSERT_FLOAT_EQ(result[0], 10 - 0.25F);
+    ASSERT_FLOAT_EQ(result[3], 10 - 4);
+}
+TEST(Packet, ComparisonReturnsMask)
+{
+    auto a = pack_of<float, 4>({1, 2, 3, 4});
+    auto b = pack_of<float, 4>({4, 3, 3, 1});
+
+    auto less = a < b;
+
+    ASSERT_TRUE(less[0]);
+    ASSERT_FALSE(less[2]);
+    ASSERT_EQ(less.bits(), 0b0011);
+    ASSERT_EQ((a == b).bits(), 0b0100);
+    ASSERT_EQ((~less).bits(), 0b1100);
+    ASSERT_TRUE(less.any());
+    ASSERT_FALSE(less.all());
+    ASSERT_TRUE((a == a).all());
+    ASSERT_TRUE((a != a).none());
+}
+TEST(Packet, Select)
+{
+    auto a = pack_of<float, 4>({1, 2, 3, 4});
+    auto b = pack_of<float, 4>({4, 3, 2, 1});
+
+    auto result = select(a < b, a, b);
+
+    ASSERT_EQ(result[0], 1);
+    ASSERT_EQ(result[1], 2);
+    ASSERT_EQ(result[2], 2);
+    ASSERT_EQ(result[3], 1);
+}
+TEST(Packet, MinMaxMatchStd)
+{
+    auto a = pack_of<double, 2>({1, NAN});
+    auto b = pack_of<double, 2>({NAN, 1});
+
+    // std::min(a, b) returns a unless b < a
+    ASSERT_EQ(min(a, b)[0], 1);
+    ASSERT_TRUE(std::isnan(min(a, b)[1]));
+    ASSERT_EQ(max(a, b)[0], 1);
+    ASSERT_TRUE(std::isnan(max(a, b)[1]));
+}
+TEST(Packet, Sqrt)
+{
+    auto result = sqrt(pack_of<float, 4>({1, 4, 9, 16}));
+
+    ASSERT_EQ(result[3], 4);
+}
+
+
+// endregion pack
+
+
+// region packet vectors
+
+
+TEST(Packet, LoadStoreSpan)
+{
+    auto vectors = make_vectors(0);
+    auto packet  = packet::load<8>(std::span<const vec3f>(vectors).subspan(8));
+    auto out     = make_vectors(100);
+
+    packet::store(packet, std::span(out).subspan(0, 3));
+
+    ASSERT_EQ(packet[0][2], 10);
+    // Lanes without a vector are zero
+    ASSERT_EQ(packet[1][3], 0);
+    ASSERT_EQ(out[2], vectors[10]);
+    ASSERT_EQ(out[3], make_vectors(100)[3]);
+}
+TEST(Packet, LoadStoreSoa)
+{
+    auto soa    = vec3f_soa(make_vectors(0));
+    auto packet = packet::load<8>(soa, 8);
+    auto out    = vec3f_soa(11);
+
+    packet::store(packet, out, 8);
+
+    ASSERT_EQ(packet[2][1], soa.column(2)[9]);
+    ASSERT_EQ(packet[2][3], 0);
+    ASSERT_EQ(out[10], std::as_const(soa)[10]);
+    ASSERT_EQ(out[7], vec3f(0, 0, 0));
+}
+TEST(Packet, Cross)
+{
+    auto a        = make_vectors(0);
+    auto b        = make_vectors(-3);
+    auto packet_a = packet::load<8>(std::span<const vec3f>(a));
+    auto packet_b = packet::load<8>(std::span<const vec3f>(b));
+    auto result   = std::vector<vec3f>(8);
+
+    auto packet_result = vector::cross(packet_a, packet_b);
+    packet::store(packet_result, std::span(result));
+
+    ASSERT_TRUE((std::is_same<decltype(packet_result), vec3f_x8>::value));
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        expect_near<float, 3>(result[i], vector::cross(a[i], b[i]), 1e-4);
+    }
+}
+TEST(Packet, DotAndLength)
+{
+    auto a        = make_vectors(0);
+    auto b        = make_vectors(1);
+    auto packet_a = packet::load<8>(std::span<const vec3f>(a));
+    auto packet_b = packet::load<8>(std::span<const vec3f>(b));
+
+    auto dot    = packet_a * packet_b;
+    auto length = vector::length(packet_a);
+
+    ASSERT_TRUE((std::is_same<decltype(length), simd_float<8>>::value));
+    for (int i = 0; i < 8; ++i)
+    {
+        ASSERT_FLOAT_EQ(dot[i], a[i] * b[i]);
+        ASSERT_FLOAT_EQ(length[i], vector::length(a[i]));
+    }
+}
+TEST(Packet, Normalized)
+{
+    auto a      = make_vectors(0);
+    auto result = std::vector<vec3f>(8);
+
+    packet::store(vector::normalized(packet::load<8>(std::span<const vec3f>(a))),
+                  std::span(result));
+
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        expect_near<float, 3>(result[i], vector::normalized(a[i]), 1e-4);
+    }
+}
+TEST(Packet, Lerp)
+{
+    auto a      = make_vectors(0);
+    auto b      = make_vectors(5);
+    auto result = std::vector<vec3f>(8);
+
+    packet::store(vector::lerp(packet::load<8>(std::span<const vec3f>(a)),
+                               packet::load<8>(std::span<const vec3f>(b)),
+                               0.25F),
+                  std::span(result));
+
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        expect_near<float, 3>(result[i], vector::lerp(a[i], b[i], 0.25F), 1e-4);
+    }
+}
+TEST(Packet, Reflect)
+{
+    std::vector<vec3f> directions;
+    std::vector<vec3f> normals;
+    for (int i = 0; i < 4; ++i)
+    {
+        directions.push_back(vector::normalized(vec3f(1, -1 - i, 0.5F * i)));
+        normals.emplace_back(0, 1, 0);
+    }
+    auto result = std::vector<vec3f>(4);
+
+    packet::store(vector::reflect(packet::load<4>(std::span<const vec3f>(directions)),
+                                  packet::load<4>(std::span<const vec3f>(normals))),
+                  std::span(result));
+
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        expect_near<float, 3>(
+            result[i], vector::reflect(directions[i], normals[i]), 1e-4);
+    }
+}
+TEST(Packet, MinMax)
+{
+    auto a        = make_vectors(0);
+    auto b        = make_vectors(-4);
+    auto packet_a = packet::load<16>(std::span<const vec3f>(a));
+    auto packet_b = packet::load<16>(std::span<const vec3f>(b));
+    auto minimum  = std::vector<vec3f>(11);
+    auto maximum  = std::vector<vec3f>(11);
+
+    packet::store(vector::min(packet_a, packet_b), std::span(minimum));
+    packet::store(vector::max(packet_a, packet_b), std::span(maximum));
+
+    for (std::size_t i = 0; i < 11; ++i)
+    {
+        ASSERT_EQ(minimum[i], vector::min(a[i], b[i]));
+        ASSERT_EQ(maximum[i], vector::max(a[i], b[i]));
+    }
+}
+TEST(Packet, VectorComparisonReturnsMask)
+{
+    auto a  = make_vectors(0);
+    auto b  = make_vectors(0);
+    b[1][0] = 100;
+
+    auto packet_a = packet::load<4>(std::span<const vec3f>(a));
+    auto packet_b = packet::load<4>(std::span<const vec3f>(b));
+
+    ASSERT_EQ((packet_a == packet_b).bits(), 0b1101);
+    ASSERT_EQ((packet_a != packet_b).bits(), 0b0010);
+    ASSERT_EQ((packet_a < packet_b).bits(), 0b0010);
+    ASSERT_EQ((packet_a >= packet_b).bits(), 0b1101);
+}
+TEST(Packet, SelectVectors)
+{
+    auto a        = make_vectors(0);
+    auto b        = make_vectors(10);
+    auto packet_a = packet::load<4>(std::span<const vec3f>(a));
+    auto packet_b = packet::load<4>(std::span<const vec3f>(b));
+    auto result   = std::vector<vec3f>(4);
+
+    auto shorter = packet_a < packet_b;
+    packet::store(packet::select(shorter, packet_a, packet_b), std::span(result));
+
+    ASSERT_EQ(result[0], a[0]);
+    ASSERT_EQ(result[3], a[3]);
+}
+
+
+// endregion packet vectors
@@ -0,0 +1,296 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "parallel.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    // Not a multiple of the grains or soa::lanes, so the last grain is partial
+    constexpr std::size_t size = 100'003;
+
+
+    vec3f_soa random_soa(std::uint32_t seed, bool unit)
+    {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> coordinate(-10, 10);
+
+        vec3f_soa soa(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            auto _vec = vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+            soa[i]    = unit ? vector::normalized(_vec) : _vec;
+        }
+
+        return soa;
+    }
+
+
+    void expect_equal(const vec3f_soa& actual, const vec3f_soa& expected)
+    {
+        ASSERT_EQ(actual.size(), expected.size());
+
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            ASSERT_EQ(actual[i], expected[i]) << "at " << i;
+        }
+    }
+}    // namespace
+
+
+// region thread_pool
+
+
+TEST(Parallel, ParallelForCoversEveryIndexOnce)
+{
+    auto pool = parallel::thread_pool(4);
+
+    std::vector<std::atomic<int>> counts(size);
+    parallel::parallel_for(pool, size, 1'000, [&](std::size_t first, std::size_t last) {
+        ASSERT_EQ(first % 1'000, 0);
+        ASSERT_LE(last - first, 1'000);
+
+        for (std::size_t i = first; i < last; ++i)
+        {
+            ++counts[i];
+        }
+    });
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        ASSERT_EQ(counts[i], 1) << "at " << i;
+    }
+}
+TEST(Parallel, SequencedCallsOnceForEverything)
+{
+    int calls = 0;
+    parallel::parallel_for(
+        parallel::sequenced, size, 1'000, [&](std::size_t first, std::size_t last) {
+            ASSERT_EQ(first, 0);
+            ASSERT_EQ(last, size);
+            ++calls;
+        });
+
+    ASSERT_EQ(calls, 1);
+}
+TEST(Parallel, NullPoolRunsOnTheCallingThread)
+{
+    const auto caller = std::this_thread::get_id();
+    int        calls  = 0;
+
+    parallel::parallel_for(static_cast<parallel::thread_pool*>(nullptr),
+                           size,
+                           1'000,
+                           [&](std::size_t first, std::size_t last) {
+                               ASSERT_EQ(std::this_thread::get_id(), caller);
+                               ASSERT_EQ(first, 0);
+                               ASSERT_EQ(last, size);
+                               ++calls;
+                           });
+
+    ASSERT_EQ(calls, 1);
+}
+TEST(Parallel, EmptyRangeCallsNothing)
+{
+    auto pool  = parallel::thread_pool(4);
+    int  calls = 0;
+
+    parallel::parallel_for(pool, 0, 1'000, [&](std::size_t, std::size_t) { ++calls; });
+
+    ASSERT_EQ(calls, 0);
+}
+TEST(Parallel, NestedParallelForCompletes)
+{
+    auto pool = parallel::thread_pool(2);
+
+    std::atomic<std::size_t> sum = 0;
+    parallel::parallel_for(pool, 64, 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            parallel::parallel_for(pool, 64, 1, [&](std::size_t inner, std::size_t) {
+                sum += inner;
+            });
+        }
+    });
+
+    ASSERT_EQ(sum, 64 * (63 * 64 / 2));
+}
+TEST(Parallel, ExceptionsAreRethrown)
+{
+    auto pool = parallel::thread_pool(4);
+
+    const auto throwing = [](std::size_t first, std::size_t) {
+        if (first == 50'000)
+        {
+            throw std::runtime_error("grain failed");
+        }
+    };
+
+    ASSERT_THROW(parallel::parallel_for(pool, size, 1'000, throwing), std::runtime_error);
+
+    // The pool is still usable afterwards
+    std::atomic<std::size_t> covered = 0;
+    parallel::parallel_for(pool, size, 1'000, [&](std::size_t first, std::size_t last) {
+        covered += last - first;
+    });
+    ASSERT_EQ(covered, size);
+}
+TEST(Parallel, ReduceDoesNotDependOnThreads)
+{
+    std::vector<float> values(size);
+    std::mt19937       rng(42);
+    std::uniform_real_distribution<float> value(-1, 1);
+    for (auto& _value : values)
+    {
+        _value = value(rng);
+    }
+
+    const auto sum = [&](auto&& executor) {
+        return parallel::parallel_reduce(
+            executor,
+            values.size(),
+            4'096,
+            0.0F,
+            [&](std::size_t first, std::size_t last) {
+                return std::accumulate(values.begin() + std::ptrdiff_t(first),
+                                       values.begin() + std::ptrdiff_t(last),
+                                       0.0F);
+            },
+            std::plus<>());
+    };
+
+    auto one  = parallel::thread_pool(1);
+    auto four = parallel::thread_pool(4);
+
+    const float expected = sum(parallel::sequenced);
+    ASSERT_EQ(sum(one), expected);
+    ASSERT_EQ(sum(four), expected);
+    ASSERT_EQ(sum(&four), expected);
+    ASSERT_EQ(sum(static_cast<parallel::thread_pool*>(nullptr)), expected);
+    ASSERT_NEAR(expected, std::accumulate(values.begin(), values.end(), 0.0), 1e-2);
+}
+TEST(Parallel, GrainSizeIsAMultiple)
+{
+    ASSERT_EQ(parallel::grain_size(24, 16) % 16, 0);
+    ASSERT_LE(parallel::grain_size(24, 16) * 24, parallel::l2_cache_size);
+    ASSERT_EQ(parallel::grain_size(parallel::l2_cache_size, 16), 16);
+}
+
+
+// endregion thread_pool
+
+
+// region batch functions
+
+
+TEST(Parallel, BatchFunctionsMatchSequenced)
+{
+    auto       pool    = parallel::thread_pool(4);
+    const auto a       = random_soa(1, false);
+    const auto b       = random_soa(2, false);
+    const auto unit_a  = random_soa(3, true);
+    const auto normals = random_soa(4, true);
+
+    vec3f_soa expected;
+    vec3f_soa actual;
+
+    soa::normalized(a, expected);
+    soa::normalized(pool, a, actual);
+    expect_equal(actual, expected);
+
+    soa::lerp(a, b, 0.3F, expected);
+    soa::lerp(pool, a, b, 0.3F, actual);
+    expect_equal(actual, expected);
+
+    soa::reflect(unit_a, normals, expected);
+    soa::reflect(pool, unit_a, normals, actual);
+    expect_equal(actual, expected);
+
+    soa::reflect(unit_a, vec3f(0, 1, 0), expected);
+    soa::reflect(pool, unit_a, vec3f(0, 1, 0), actual);
+    expect_equal(actual, expected);
+
+    soa::min(a, b, expected);
+    soa::min(pool, a, b, actual);
+    expect_equal(actual, expected);
+
+    soa::max(a, b, expected);
+    soa::max(pool, a, b, actual);
+    expect_equal(actual, expected);
+
+    soa::cross(a, b, expected);
+    soa::cross(pool, a, b, actual);
+    expect_equal(actual, expected);
+}
+TEST(Parallel, BatchScalarFunctionsMatchSequenced)
+{
+    auto       pool = parallel::thread_pool(4);
+    const auto a    = random_soa(1, false);
+    const auto b    = random_soa(2, false);
+
+    std::vector<float> expected(size);
+    std::vector<float> actual(size);
+
+    soa::dot(a, b, std::span(expected));
+    soa::dot(pool, a, b, std::span(actual));
+    ASSERT_EQ(actual, expected);
+
+    soa::distance(a, b, std::span(expected));
+    soa::distance(pool, a, b, std::span(actual));
+    ASSERT_EQ(actual, expected);
+
+    soa::length(a, std::span(expected));
+    soa::length(pool, a, std::span(actual));
+    ASSERT_EQ(actual, expected);
+}
+TEST(Parallel, BatchFunctionsInPlace)
+{
+    auto pool     = parallel::thread_pool(4);
+    auto a        = random_soa(1, false);
+    auto expected = vec3f_soa();
+
+    soa::normalized(a, expected);
+    soa::normalized(pool, a, a);
+
+    expect_equal(a, expected);
+}
+TEST(Parallel, BatchFunctionsOfOtherTypes)
+{
+    auto pool = parallel::thread_pool(4);
+
+    vec3i_soa a(size);
+    vec3i_soa b(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const int value = static_cast<int>(i);
+        a[i]            = vec3i(value, -value, value % 7);
+        b[i]            = vec3i(-value, value, value % 5);
+    }
+
+    vec3i_soa expected;
+    vec3i_soa actual;
+    soa::min(a, b, expected);
+    soa::min(pool, a, b, actual);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        ASSERT_EQ(actual[i], expected[i]) << "at " << i;
+    }
+}
+
+
+// endregion batch functions
@@ -0,0 +1,429 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "parallel.hpp"
+#include "physics.hpp"
+#include "test_helpers.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+using namespace ggmath;
+using helpers::expect_near;
+
+
+namespace
+{
+    constexpr float gravity = -9.81F;
+
+
+    /**
+     * @brief Uniform gravity along -y
+     */
+    void falling(const vec3f_soa& /*positions*/,
+                 const vec3f_soa& /*velocities*/,
+                 vec3f_soa& accelerations)
+    {
+        for (std::size_t i = 0; i < accelerations.size(); ++i)
+        {
+            accelerations[i] = vec3f(0, gravity, 0);
+        }
+    }
+
+
+    /**
+     * @brief A spring pulling towards the origin with a period of 2 pi
+     */
+    void oscillating(const vec3f_soa& positions,
+                     const vec3f_soa& /*velocities*/,
+                     vec3f_soa& accelerations)
+    {
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            for (std::size_t i = 0; i < positions.size(); ++i)
+            {
+                accelerations.column(axis)[i] = -positions.column(axis)[i];
+            }
+        }
+    }
+
+
+    physics::particles random_particles(std::size_t size)
+    {
+        std::mt19937                          rng(42);
+        std::uniform_real_distribution<float> coordinate(-1, 1);
+
+        physics::particles particles;
+        particles.resize(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            particles.positions[i] =
+                vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+            particles.velocities[i] =
+                vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+        }
+
+        return particles;
+    }
+
+
+    /**
+     * @brief Advance size particles along oscillating for a second in steps of dt
+     * and return the largest distance in position and velocity of a particle from
+     * the exact solution
+     */
+    template <typename T_Step>
+    float oscillation_error(std::size_t size, float dt, T_Step step)
+    {
+        auto       particles = random_particles(size);
+        const auto start     = random_particles(size);
+        oscillating(particles.positions, particles.velocities, particles.accelerations);
+
+        for (int i = 0; i < static_cast<int>(std::round(1 / dt)); ++i)
+        {
+            step(particles, dt);
+        }
+
+        const auto& positions  = std::as_const(particles).positions;
+        const auto& velocities = std::as_const(particles).velocities;
+
+        const float cos = std::cos(1.0F);
+        const float sin = std::sin(1.0F);
+
+        float error = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const auto& x_0 = start.positions[i];
+            const auto& v_0 = start.velocities[i];
+
+            error = std::max(
+                {error,
+                 vector::distance(positions[i], x_0 * cos + v_0 * sin),
+                 vector::distance(velocities[i], v_0 * cos - x_0 * sin)});
+        }
+
+        return error;
+    }
+
+
+    /**
+     * @brief Return size random unit vectors, the first ones along the axes
+     */
+    vec3f_soa unit_vectors(std::mt19937& rng, std::size_t size)
+    {
+        std::normal_distribution<float> coordinate;
+
+        vec3f_soa vectors(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const auto _vec =
+                i < 3 ? vec3f(float(i == 0), float(i == 1), float(i == 2))
+                      : vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+
+            vectors[i] = vector::normalized(_vec);
+        }
+
+        return vectors;
+    }
+
+
+    void expect_equal(const vec3f_soa& a, const vec3f_soa& b)
+    {
+        ASSERT_EQ(a.size(), b.size());
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            ASSERT_EQ(a[i], b[i]) << i;
+        }
+    }
+}    // namespace
+
+
+// region integrators
+
+
+TEST(Physics, SemiImplicitEulerAdvancesVelocitiesFirst)
+{
+    physics::particles particles;
+    particles.resize(5);
+    particles.positions[4]     = vec3f(1, 2, 3);
+    particles.velocities[4]    = vec3f(1, 0, -1);
+    particles.accelerations[4] = vec3f(0, -10, 2);
+
+    physics::semi_implicit_euler(particles, 0.5F);
+
+    ASSERT_EQ(particles.velocities[4], vec3f(1, -5, 0));
+    ASSERT_EQ(particles.positions[4], vec3f(1.5F, -0.5F, 3));
+    ASSERT_EQ(particles.positions[0], vec3f(0, 0, 0));
+}
+TEST(Physics, VelocityVerletIsExactForConstantAccelerations)
+{
+    auto       particles = random_particles(7);
+    const auto start     = random_particles(7);
+    falling(particles.positions, particles.velocities, particles.accelerations);
+
+    // One second in ten steps
+    for (int i = 0; i < 10; ++i)
+    {
+        physics::velocity_verlet(particles, 0.1F, falling);
+    }
+
+    const auto& positions  = std::as_const(particles).positions;
+    const auto& velocities = std::as_const(particles).velocities;
+    for (std::size_t i = 0; i < particles.size(); ++i)
+    {
+        const auto expected_position = start.positions[i] + start.velocities[i]
+                                       + vec3f(0, gravity / 2, 0);
+        const auto expected_velocity = start.velocities[i] + vec3f(0, gravity, 0);
+
+        ASSERT_LT(vector::distance(positions[i], expected_position), 1e-4F);
+        ASSERT_LT(vector::distance(velocities[i], expected_velocity), 1e-4F);
+    }
+}
+TEST(Physics, HigherOrderMethodsAreMoreAccurate)
+{
+    physics::rk4_workspace workspace;
+
+    const float euler = oscillation_error(100, 0.05F, [](auto& particles, float dt) {
+        oscillating(particles.positions, particles.velocities, particles.accelerations);
+        physics::semi_implicit_euler(particles, dt);
+    });
+    const float verlet = oscillation_error(100, 0.05F, [](auto& particles, float dt) {
+        physics::velocity_verlet(particles, dt, oscillating);
+    });
+    const float rk4 = oscillation_error(100, 0.05F, [&](auto& particles, float dt) {
+        physics::rk4(particles, dt, oscillating, workspace);
+    });
+
+    ASSERT_LT(euler, 0.05F);
+    ASSERT_LT(verlet, 1e-3F);
+    ASSERT_LT(rk4, 1e-5F);
+    ASSERT_LT(verlet, euler / 10);
+}
+TEST(Physics, ThreadsGiveTheSameResults)
+{
+    constexpr std::size_t size = 100'003;
+
+    physics::rk4_workspace workspace;
+
+    const auto step_all = [&](parallel::thread_pool* pool) {
+        auto particles = random_particles(size);
+        auto options   = physics::step_options{pool};
+
+        oscillating(particles.positions, particles.velocities, particles.accelerations);
+        physics::semi_implicit_euler(particles, 0.01F, options);
+        physics::velocity_verlet(particles, 0.01F, oscillating, options);
+        physics::rk4(particles, 0.01F, oscillating, workspace, options);
+
+        return particles;
+    };
+
+    auto pool = parallel::thread_pool(4);
+
+    const auto single = step_all(nullptr);
+    const auto multi  = step_all(&pool);
+
+    expect_equal(single.positions, multi.positions);
+    expect_equal(single.velocities, multi.velocities);
+    expect_equal(single.accelerations, multi.accelerations);
+}
+TEST(Physics, RejectsColumnsOfDifferentSizes)
+{
+    physics::particles particles;
+    particles.resize(4);
+    particles.velocities.resize(3);
+
+    ASSERT_THROW(physics::semi_implicit_euler(particles, 0.1F), std::invalid_argument);
+    ASSERT_THROW(physics::velocity_verlet(particles, 0.1F, falling),
+                 std::invalid_argument);
+}
+
+
+// endregion integrators
+
+
+// region optics
+
+
+TEST(Physics, RefractFollowsSnellsLaw)
+{
+    auto rng        = std::mt19937(42);
+    auto directions = unit_vectors(rng, 200);
+    auto normals    = unit_vectors(rng, 200);
+
+    for (float eta : {1 / 1.5F, 1.0F, 1.33F})
+    {
+        for (std::size_t i = 0; i < directions.size(); ++i)
+        {
+            // Normals point to the side the light comes from
+            const vec3f direction = std::as_const(directions)[i];
+            const vec3f facing    = std::as_const(normals)[i];
+            const float side      = vector::dot(direction, facing) > 0 ? -1.0F : 1.0F;
+            const vec3f normal    = facing * side;
+
+            const float cos_incident = -vector::dot(direction, normal);
+            const float sin_incident = std::sqrt(1 - cos_incident * cos_incident);
+            const auto  refracted    = physics::refract(direction, normal, eta);
+
+            if (eta * sin_incident > 1)
+            {
+                ASSERT_EQ(refracted, vec3f(0));
+                continue;
+            }
+
+            const float cos_transmitted = -vector::dot(refracted, normal);
+            const float sin_transmitted =
+                std::sqrt(std::max(0.0F, 1 - cos_transmitted * cos_transmitted));
+
+            ASSERT_NEAR(vector::length(refracted), 1, 1e-5F);
+            ASSERT_NEAR(sin_transmitted, eta * sin_incident, 1e-3F);
+            ASSERT_NEAR(
+                vector::dot(vector::cross(direction, normal), refracted), 0, 1e-5F);
+            ASSERT_NEAR(physics::snell(cos_incident, eta).cos_transmitted,
+                        cos_transmitted,
+                        1e-5F);
+        }
+    }
+}
+TEST(Physics, SnellsLawReflectsEntirelyBeyondTheCriticalAngle)
+{
+    // The critical angle from glass into air has a sine of 1 / 1.5
+    const float critical = std::sqrt(1 - 1 / (1.5F * 1.5F));
+
+    ASSERT_FALSE(physics::snell(critical + 0.01F, 1.5F).total_internal_reflection);
+    ASSERT_TRUE(physics::snell(critical - 0.01F, 1.5F).total_internal_reflection);
+    ASSERT_EQ(physics::snell(critical - 0.01F, 1.5F).cos_transmitted, 0);
+    ASSERT_FALSE(physics::snell(0.0F, 1 / 1.5F).total_internal_reflection);
+}
+TEST(Physics, RefractBatchMatchesScalar)
+{
+    auto rng        = std::mt19937(42);
+    auto directions = unit_vectors(rng, 203);
+    auto normals    = unit_vectors(rng, 203);
+
+    vec3f_soa                  out;
+    std::vector<std::uint64_t> total_internal_reflection(4, ~std::uint64_t(0));
+
+    physics::refract(directions, normals, 1.5F, out, total_internal_reflection);
+
+    ASSERT_EQ(out.size(), directions.size());
+    for (std::size_t i = 0; i < directions.size(); ++i)
+    {
+        const vec3f direction = std::as_const(directions)[i];
+        const vec3f normal    = std::as_const(normals)[i];
+        const bool  total     = (total_internal_reflection[i / 64] >> (i % 64)) & 1U;
+
+        expect_near<float, 3>(std::as_const(out)[i],
+                              physics::refract(direction, normal, 1.5F));
+        ASSERT_EQ(total,
+                  physics::snell(-vector::dot(direction, normal), 1.5F)
+                      .total_internal_reflection)
+            << i;
+    }
+    ASSERT_EQ(total_internal_reflection[3] >> (203 % 64), 0);
+}
+TEST(Physics, RefractBatchRejectsAnUndersizedMask)
+{
+    auto rng        = std::mt19937(42);
+    auto directions = unit_vectors(rng, 65);
+    auto normals    = unit_vectors(rng, 65);
+
+    vec3f_soa                  out;
+    std::vector<std::uint64_t> total_internal_reflection(1);
+
+    ASSERT_THROW(
+        physics::refract(directions, normals, 1.5F, out, total_internal_reflection),
+        std::invalid_argument);
+}
+TEST(Physics, SchlickMatchesFresnelAtTheLimits)
+{
+    const float r0 = physics::schlick_r0(1.5F);
+
+    ASSERT_NEAR(r0, 0.04F, 1e-6F);
+    ASSERT_FLOAT_EQ(physics::schlick(1.0F, r0), r0);
+    ASSERT_FLOAT_EQ(physics::schlick(0.0F, r0), 1);
+
+    std::vector<float> cos_theta;
+    for (int i = 0; i <= 20; ++i)
+    {
+        cos_theta.push_back(float(i) / 20);
+    }
+    std::vector<float> reflectance(cos_theta.size());
+
+    physics::schlick(cos_theta, r0, reflectance);
+    for (std::size_t i = 0; i < cos_theta.size(); ++i)
+    {
+        ASSERT_FLOAT_EQ(reflectance[i], physics::schlick(cos_theta[i], r0));
+    }
+    ASSERT_TRUE(std::is_sorted(reflectance.rbegin(), reflectance.rend()));
+}
+TEST(Physics, LambertianAndBlinnPhongAreZeroFromBehind)
+{
+    const auto normal = vec3f(0, 0, 1);
+    const auto behind = vec3f(0, 0, -1);
+    const auto above  = vec3f(0, 0, 1);
+
+    ASSERT_FLOAT_EQ(physics::lambertian(normal, above), std::numbers::inv_pi_v<float>);
+    ASSERT_EQ(physics::lambertian(normal, behind), 0);
+    ASSERT_FLOAT_EQ(physics::blinn_phong(normal, above, above, 32.0F),
+                    40 / (8 * std::numbers::pi_v<float>));
+    ASSERT_EQ(physics::blinn_phong(normal, behind, above, 32.0F), 0);
+
+    // Light and viewer opposite each other have no halfway vector
+    ASSERT_EQ(physics::blinn_phong(normal, vec3f(1, 0, 0), vec3f(-1, 0, 0), 32.0F), 0);
+}
+TEST(Physics, LambertianReflectsAllEnergy)
+{
+    // The integral of the BRDF times the cosine over the hemisphere is the albedo
+    constexpr int steps = 400;
+
+    const auto normal = vec3f(0, 0, 1);
+
+    double integral = 0;
+    for (int i = 0; i < steps; ++i)
+    {
+        const double theta = (i + 0.5) / steps * std::numbers::pi / 2;
+        const auto   light = vec3f(float(std::sin(theta)), 0, float(std::cos(theta)));
+
+        // The solid angle of the ring of directions at theta
+        integral += physics::lambertian(normal, light) * 2 * std::numbers::pi
+                    * std::sin(theta) * std::numbers::pi / 2 / steps;
+    }
+
+    ASSERT_NEAR(integral, 1, 1e-3);
+}
+TEST(Physics, ShadingBatchesMatchScalar)
+{
+    auto rng        = std::mt19937(42);
+    auto normals    = unit_vectors(rng, 101);
+    auto to_lights  = unit_vectors(rng, 101);
+    auto to_viewers = unit_vectors(rng, 101);
+
+    std::vector<float> diffuse(normals.size());
+    std::vector<float> specular(normals.size());
+
+    physics::lambertian(normals, to_lights, diffuse);
+    physics::blinn_phong(normals, to_lights, to_viewers, 20, specular);
+
+    for (std::size_t i = 0; i < normals.size(); ++i)
+    {
+        const vec3f normal    = std::as_const(normals)[i];
+        const vec3f to_light  = std::as_const(to_lights)[i];
+        const vec3f to_viewer = std::as_const(to_viewers)[i];
+
+        const float expected = physics::blinn_phong(normal, to_light, to_viewer, 20.0F);
+
+        ASSERT_NEAR(diffuse[i], physics::lambertian(normal, to_light), 1e-6F);
+        ASSERT_NEAR(specular[i], expected, 1e-4F * std::max(1.0F, expected)) << i;
+    }
+}
+
+
+// endregion optics
@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "quat.hpp"
+#include "test_helpers.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+using helpers::expect_near;
+
+
+namespace
+{
+    template <typename T>
+    void expect_near(const quat<T>& actual, const quat<T>& expected)
+    {
+        helpers::expect_near(actual.xyzw, expected.xyzw);
+    }
+
+
+    // The angle of the rotation from a to b
+    template <typename T>
+    T angle_between(const quat<T>& a, const quat<T>& b)
+    {
+        return 2 * std::acos(std::min(std::abs(quaternion::dot(a, b)), T(1)));
+    }
+
+
+    template <typename T>
+    quat<T> random_rotation(std::mt19937& rng)
+    {
+        std::normal_distribution<T> distribution;
+
+        return quaternion::normalized(quat<T>(distribution(rng),
+                                              distribution(rng),
+                                              distribution(rng),
+                                              distribution(rng)));
+    }
+
+
+    const auto quarter_turn_z = quaternion::from_axis_angle_deg(vec3f(0, 0, 1), 90.0F);
+}    // namespace
+
+
+// region constructors
+
+
+TEST(Quat, DefaultIsZero)
+{
+    ASSERT_EQ(quatf(), quatf(0, 0, 0, 0));
+    ASSERT_EQ(quatf::identity(), quatf(vec3f(0), 1));
+}
+TEST(Quat, LayoutMatchesVec4)
+{
+    ASSERT_EQ(sizeof(quatf), sizeof(vec4f));
+    ASSERT_EQ(alignof(quatd), alignof(vec4d));
+    ASSERT_EQ(quatf(vec4f(1, 2, 3, 4)).w, 4);
+    ASSERT_EQ(quatf(1, 2, 3, 4).to_vec(), vec4f(1, 2, 3, 4));
+    ASSERT_EQ(quatf(1, 2, 3, 4).vector(), vec3f(1, 2, 3));
+}
+
+
+// endregion constructors
+
+
+// region operators
+
+
+TEST(Quat, Multiply)
+{
+    auto i = quatf(1, 0, 0, 0);
+    auto j = quatf(0, 1, 0, 0);
+    auto k = quatf(0, 0, 1, 0);
+
+    ASSERT_EQ(i * j, k);
+    ASSERT_EQ(j * i, -k);
+    ASSERT_EQ(i * i, quatf(0, 0, 0, -1));
+    ASSERT_EQ(quatf::identity() * quarter_turn_z, quarter_turn_z);
+}
+TEST(Quat, MultiplyComposesRotations)
+{
+    // Two quarter turns about z are a half turn
+    auto half_turn = quarter_turn_z * quarter_turn_z;
+
+    expect_near(quaternion::rotate(half_turn, vec3f(1, 2, 3)), vec3f(-1, -2, 3));
+}
+TEST(Quat, Print)
+{
+    std::stringstream ss;
+    ss << quatf(1, 2, 3, 4);
+
+    ASSERT_EQ(ss.str(), "(1,2,3,4)");
+}
+
+
+// endregion operators
+
+
+// region functions
+
+
+TEST(Quat, ConjugateAndInverse)
+{
+    auto _quat = quatf(1, 2, 3, 4);
+
+    ASSERT_EQ(quaternion::conjugate(_quat), quatf(-1, -2, -3, 4));
+    expect_near(_quat * quaternion::inverse(_quat), quatf::identity());
+    expect_near(quaternion::inverse(quarter_turn_z),
+                quaternion::conjugate(quarter_turn_z));
+}
+TEST(Quat, Normalized)
+{
+    auto _quat = quaternion::normalized(quatf(1, 2, 3, 4));
+
+    ASSERT_FLOAT_EQ(quaternion::length(_quat), 1);
+    ASSERT_TRUE(quaternion::is_unit_quaternion(_quat));
+    ASSERT_FALSE(quaternion::is_unit_quaternion(quatf(1, 2, 3, 4)));
+}
+TEST(Quat, FromAxisAngle)
+{
+    const auto half_sqrt2   = std::numbers::sqrt2_v<float> / 2;
+    const auto quarter_turn = std::numbers::pi_v<float> / 2;
+
+    expect_near(quarter_turn_z, quatf(0, 0, half_sqrt2, half_sqrt2));
+    expect_near(quaternion::from_axis_angle(vec3f(0, 0, 1), quarter_turn),
+                quarter_turn_z);
+}
+TEST(Quat, Rotate)
+{
+    expect_near(quaternion::rotate(quarter_turn_z, vec3f(1, 0, 0)), vec3f(0, 1, 0));
+    expect_near(quaternion::rotate(quarter_turn_z, vec3f(0, 0, 2)), vec3f(0, 0, 2));
+}
+TEST(Quat, ToMatMatchesRotate)
+{
+    auto rng      = std::mt19937(42);
+    auto rotation = random_rotation<double>(rng);
+    auto _vec     = vec3d(1, -2, 3);
+    auto rotated  = quaternion::rotate(rotation, _vec);
+
+    expect_near(quaternion::to_mat33(rotation) * _vec, rotated);
+    expect_near(quaternion::to_mat44(rotation) * vec4d(_vec, 1), vec4d(rotated, 1));
+}
+TEST(Quat, InterpolationEndpoints)
+{
+    auto a = quatf::identity();
+    auto b = quarter_turn_z;
+
+    expect_near(quaternion::nlerp(a, b, 0.0F), a);
+    expect_near(quaternion::nlerp(a, b, 1.0F), b);
+    expect_near(quaternion::slerp(a, b, 0.0F), a);
+    expect_near(quaternion::slerp(a, b, 1.0F), b);
+    expect_near(quaternion::fast_slerp(a, b, 0.0F), a);
+    expect_near(quaternion::fast_slerp(a, b, 1.0F), b);
+}
+TEST(Quat, SlerpHasConstantAngularVelocity)
+{
+    auto a = quatf::identity();
+    auto b = quarter_turn_z;
+
+    expect_near(quaternion::slerp(a, b, 0.5F),
+                quaternion::from_axis_angle_deg(vec3f(0, 0, 1), 45.0F));
+    expect_near(quaternion::slerp(a, b, 0.25F),
+                quaternion::from_axis_angle_deg(vec3f(0, 0, 1), 22.5F));
+}
+TEST(Quat, SlerpTakesShorterArc)
+{
+    auto a = quatf::identity();
+    auto b = -quarter_turn_z;
+
+    // -b is the same rotation as b, so the result is the same rotation as for b
+    auto result = quaternion::slerp(a, b, 0.5F);
+
+    ASSERT_NEAR(angle_between(result, a), std::numbers::pi_v<float> / 4, 1e-5);
+    ASSERT_NEAR(angle_between(quaternion::nlerp(a, b, 0.5F), result), 0, 1e-3);
+}
+TEST(Quat, FastSlerpIsAccurate)
+{
+    auto  rng       = std::mt19937(42);
+    float max_error = 0;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto a = random_rotation<double>(rng);
+        auto b = random_rotation<double>(rng);
+        auto t = std::uniform_real_distribution<double>()(rng);
+
+        max_error = std::max<float>(max_error,
+                                    angle_between(quaternion::fast_slerp(a, b, t),
+                                                  quaternion::slerp(a, b, t)));
+    }
+
+    ASSERT_LT(max_error, 1e-3);
+}
+
+
+// endregion functions
+
+
+// region batch functions
+
+
+TEST(Quat, BatchMatchesSingle)
+{
+    auto rng = std::mt19937(42);
+
+    std::vector<quatf> a;
+    std::vector<quatf> b;
+    std::vector<vec3f> vectors;
+    for (int i = 0; i < 7; ++i)
+    {
+        a.push_back(random_rotation<float>(rng));
+        b.push_back(random_rotation<float>(rng));
+        vectors.emplace_back(i, 1, -i);
+    }
+
+    auto nlerped     = std::vector<quatf>(a.size());
+    auto slerped     = std::vector<quatf>(a.size());
+    auto fast_slerps = std::vector<quatf>(a.size());
+    auto rotated     = std::vector<vec3f>(a.size());
+    quaternion::nlerp(a, b, 0.3F, nlerped);
+    quaternion::slerp(a, b, 0.3F, slerped);
+    quaternion::fast_slerp(a, b, 0.3F, fast_slerps);
+    quaternion::rotate(std::span<const quatf>(a), vectors, rotated);
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        expect_near(nlerped[i], quaternion::nlerp(a[i], b[i], 0.3F));
+        expect_near(slerped[i], quaternion::slerp(a[i], b[i], 0.3F));
+        expect_near(fast_slerps[i], quaternion::fast_slerp(a[i], b[i], 0.3F));
+        expect_near(rotated[i], quaternion::rotate(a[i], vectors[i]));
+    }
+}
+TEST(Quat, BatchThrowsIfSizesDiffer)
+{
+    auto a   = std::vector<quatf>(3);
+    auto out = std::vector<quatf>(2);
+
+    ASSERT_THROW(quaternion::nlerp(a, a, 0.5F, out), std::invalid_argument);
+}
+
+
+// endregion batch functions
+
+
+TEST(Quat, ThrowIfNotUnit)
+{
+    ASSERT_THROW(debug::throw_if_not_unit(quatf(1, 2, 3, 4)), std::invalid_argument);
+    ASSERT_NO_THROW(debug::throw_if_not_unit(quarter_turn_z));
+}
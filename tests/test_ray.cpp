@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <sstream>
+
+#include "ray.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+TEST(Ray, PrecomputesInverseDirection)
+{
+    auto _ray = rayf(vec3f(1, 2, 3), vec3f(2, -4, 0));
+
+    ASSERT_EQ(_ray.origin, vec3f(1, 2, 3));
+    ASSERT_EQ(_ray.direction, vec3f(2, -4, 0));
+    ASSERT_EQ(_ray.inverse_direction[0], 0.5F);
+    ASSERT_EQ(_ray.inverse_direction[1], -0.25F);
+    ASSERT_EQ(_ray.inverse_direction[2], std::numeric_limits<float>::infinity());
+}
+TEST(Ray, Sign)
+{
+    auto _ray = rayd(vec3d(0), vec3d(2, -4, -0.0));
+
+    ASSERT_EQ(_ray.sign[0], 0);
+    ASSERT_EQ(_ray.sign[1], 1);
+    // -0 has an inverse of -infinity, so it is negative
+    ASSERT_EQ(_ray.sign[2], 1);
+}
+TEST(Ray, At)
+{
+    auto _ray = rayf(vec3f(1, 2, 3), vec3f(2, -4, 0));
+
+    ASSERT_EQ(_ray.at(0), vec3f(1, 2, 3));
+    ASSERT_EQ(_ray.at(1.5F), vec3f(4, -4, 3));
+}
+TEST(Ray, Print)
+{
+    std::stringstream ss;
+    ss << rayf(vec3f(1, 2, 3), vec3f(0, 0, 1));
+
+    ASSERT_EQ(ss.str(), "(1,2,3)->(0,0,1)");
+}
@@ -0,0 +1,275 @@
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include "simd.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    template <typename T>
+    std::array<T, 4> lanes(simd::register4_t<T> a)
+    {
+        std::array<T, 4> result{};
+        simd::store(result.data(), a);
+        return result;
+    }
+
+
+    template <typename T>
+    std::array<T, 16> identity_of()
+    {
+        return {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    }
+
+
+    const std::array<float, 4>  float_a  = {2, 3, 4, 5};
+    const std::array<float, 4>  float_b  = {5, -6, 7, 1};
+    const std::array<double, 4> double_a = {2, 3, 4, 5};
+    const std::array<double, 4> double_b = {5, -6, 7, 1};
+}    // namespace
+
+
+// region float4
+
+
+TEST(Simd, LoadStoreFloat4)
+{
+    ASSERT_EQ(lanes<float>(simd::load(float_a.data())), float_a);
+}
+TEST(Simd, BroadcastFloat4)
+{
+    std::array<float, 4> expected = {3, 3, 3, 3};
+
+    ASSERT_EQ(lanes<float>(simd::broadcast(3.0F)), expected);
+}
+TEST(Simd, AddFloat4)
+{
+    auto result = simd::add(simd::load(float_a.data()), simd::load(float_b.data()));
+    std::array<float, 4> expected = {7, -3, 11, 6};
+
+    ASSERT_EQ(lanes<float>(result), expected);
+}
+TEST(Simd, SubFloat4)
+{
+    auto result = simd::sub(simd::load(float_a.data()), simd::load(float_b.data()));
+    std::array<float, 4> expected = {-3, 9, -3, 4};
+
+    ASSERT_EQ(lanes<float>(result), expected);
+}
+TEST(Simd, ScaleFloat4)
+{
+    auto                 result   = simd::scale(simd::load(float_a.data()), 2.0F);
+    std::array<float, 4> expected = {4, 6, 8, 10};
+
+    ASSERT_EQ(lanes<float>(result), expected);
+}
+TEST(Simd, DivFloat4)
+{
+    auto result = simd::div(simd::load(float_a.data()), simd::broadcast(2.0F));
+    std::array<float, 4> expected = {1, 1.5, 2, 2.5};
+
+    ASSERT_EQ(lanes<float>(result), expected);
+}
+TEST(Simd, MinFloat4)
+{
+    auto result = simd::min(simd::load(float_a.data()), simd::load(float_b.data()));
+    std::array<float, 4> expected = {2, -6, 4, 1};
+
+    ASSERT_EQ(lanes<float>(result), expected);
+}
+TEST(Simd, MaxFloat4)
+{
+    auto result = simd::max(simd::load(float_a.data()), simd::load(float_b.data()));
+    std::array<float, 4> expected = {5, 3, 7, 5};
+
+    ASSERT_EQ(lanes<float>(result), expected);
+}
+TEST(Simd, MinFloat4NanLikeStdMin)
+{
+    std::array<float, 4> a = {std::numeric_limits<float>::quiet_NaN(), 1, 1, 1};
+    std::array<float, 4> b = {1, std::numeric_limits<float>::quiet_NaN(), 1, 1};
+    auto result = lanes<float>(simd::min(simd::load(a.data()), simd::load(b.data())));
+
+    ASSERT_EQ(std::isnan(result[0]), std::isnan(std::min(a[0], b[0])));
+    ASSERT_EQ(std::isnan(result[1]), std::isnan(std::min(a[1], b[1])));
+}
+TEST(Simd, DotFloat4)
+{
+    ASSERT_EQ(simd::dot(simd::load(float_a.data()), simd::load(float_b.data())), 25);
+}
+TEST(Simd, ZeroWFloat4)
+{
+    std::array<float, 4> expected = {2, 3, 4, 0};
+
+    ASSERT_EQ(lanes<float>(simd::zero_w(simd::load(float_a.data()))), expected);
+}
+TEST(Simd, CrossFloat4)
+{
+    auto result = simd::cross(simd::zero_w(simd::load(float_a.data())),
+                              simd::zero_w(simd::load(float_b.data())));
+    std::array<float, 4> expected = {45, 6, -27, 0};
+
+    ASSERT_EQ(lanes<float>(result), expected);
+}
+TEST(Simd, NormalizeFloat4)
+{
+    auto result = simd::normalize(simd::load(float_a.data()));
+
+    ASSERT_FLOAT_EQ(simd::dot(result, result), 1);
+}
+TEST(Simd, LerpFloat4)
+{
+    auto result = simd::lerp(simd::load(float_a.data()),
+                             simd::load(float_b.data()), 0.5F);
+    std::array<float, 4> expected = {3.5, -1.5, 5.5, 3};
+
+    ASSERT_EQ(lanes<float>(result), expected);
+}
+
+
+// endregion float4
+
+
+// region double4
+
+
+TEST(Simd, AddDouble4)
+{
+    auto result = simd::add(simd::load(double_a.data()), simd::load(double_b.data()));
+    std::array<double, 4> expected = {7, -3, 11, 6};
+
+    ASSERT_EQ(lanes<double>(result), expected);
+}
+TEST(Simd, SubDouble4)
+{
+    auto result = simd::sub(simd::load(double_a.data()), simd::load(double_b.data()));
+    std::array<double, 4> expected = {-3, 9, -3, 4};
+
+    ASSERT_EQ(lanes<double>(result), expected);
+}
+TEST(Simd, ScaleDouble4)
+{
+    auto                  result   = simd::scale(simd::load(double_a.data()), 2.0);
+    std::array<double, 4> expected = {4, 6, 8, 10};
+
+    ASSERT_EQ(lanes<double>(result), expected);
+}
+TEST(Simd, MinDouble4)
+{
+    auto result = simd::min(simd::load(double_a.data()), simd::load(double_b.data()));
+    std::array<double, 4> expected = {2, -6, 4, 1};
+
+    ASSERT_EQ(lanes<double>(result), expected);
+}
+TEST(Simd, MaxDouble4)
+{
+    auto result = simd::max(simd::load(double_a.data()), simd::load(double_b.data()));
+    std::array<double, 4> expected = {5, 3, 7, 5};
+
+    ASSERT_EQ(lanes<double>(result), expected);
+}
+TEST(Simd, DotDouble4)
+{
+    ASSERT_EQ(simd::dot(simd::load(double_a.data()), simd::load(double_b.data())), 25);
+}
+TEST(Simd, NormalizeDouble4)
+{
+    auto result = simd::normalize(simd::load(double_a.data()));
+
+    ASSERT_DOUBLE_EQ(simd::dot(result, result), 1);
+}
+TEST(Simd, LerpDouble4)
+{
+    auto result = simd::lerp(simd::load(double_a.data()),
+                             simd::load(double_b.data()), 0.5);
+    std::array<double, 4> expected = {3.5, -1.5, 5.5, 3};
+
+    ASSERT_EQ(lanes<double>(result), expected);
+}
+
+
+// endregion double4
+
+
+// region matrix kernels
+
+
+TEST(Simd, Multiply4x4)
+{
+    std::array<double, 16> a   = {1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2, 3, 4, 5, 6};
+    std::array<double, 16> out = {};
+
+    simd::multiply4x4(a.data(), identity_of<double>().data(), out.data());
+    ASSERT_EQ(out, a);
+
+    // In place, the translation of b is scaled by a
+    std::array<float, 16> b        = {1, 0, 0, 1, 0, 1, 0, 2, 0, 0, 1, 3, 0, 0, 0, 1};
+    std::array<float, 16> scale    = {2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 1};
+    std::array<float, 16> expected = {2, 0, 0, 2, 0, 2, 0, 4, 0, 0, 2, 6, 0, 0, 0, 1};
+    simd::multiply4x4(scale.data(), b.data(), b.data());
+    ASSERT_EQ(b, expected);
+}
+#if GGMATH_SIMD_SSE
+TEST(Simd, Inverse4x4)
+{
+    std::array<float, 16> a = {4, 7, 2, 3, 0, 5, -1, 2, 3, 1, 6, -4, 2, -3, 1, 8};
+    std::array<float, 16> inverse{};
+    std::array<float, 16> product{};
+
+    ASSERT_FLOAT_EQ(simd::inverse4x4(a.data(), inverse.data()), 546);
+
+    simd::multiply4x4(a.data(), inverse.data(), product.data());
+    for (int i = 0; i < 16; ++i)
+    {
+        EXPECT_NEAR(product[i], identity_of<float>()[i], 1e-5) << i;
+    }
+}
+#endif
+
+
+// endregion matrix kernels
+
+
+// region vec
+
+
+TEST(Simd, AlignmentVec4f)
+{
+    ASSERT_EQ(alignof(vec4f), simd::enabled ? 16 : alignof(float));
+}
+TEST(Simd, AlignmentVec4d)
+{
+    ASSERT_EQ(alignof(vec4d), simd::enabled ? 32 : alignof(double));
+}
+TEST(Simd, PaddingVec3f)
+{
+    ASSERT_EQ(sizeof(vec3f), simd::enabled ? 16 : 12);
+}
+TEST(Simd, DotVec3fIgnoresPadding)
+{
+    vec3f a = vec3f(2, 3, 4);
+    vec3f b = vec3f(5, 6, 7);
+
+    ASSERT_EQ(a * b, 56);
+}
+TEST(Simd, CrossVec3fIgnoresPadding)
+{
+    vec3f a = vec3f(2, 3, 4);
+    vec3f b = vec3f(5, 6, 7);
+
+    ASSERT_EQ(vector::cross(a, b), vec3f(-3, 6, -3));
+}
+TEST(Simd, LerpVec4d)
+{
+    vec4d a = vec4d(2, 3, 4, 5);
+    vec4d b = vec4d(4, 5, 6, 7);
+
+    ASSERT_EQ(vector::lerp(a, b, 0.5), vec4d(3, 4, 5, 6));
+}
+
+
+// endregion vec
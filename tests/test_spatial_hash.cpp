@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.hpp"
+#include "spatial_hash.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    std::vector<vec3f> random_points(std::mt19937& rng, int count, float extent)
+    {
+        std::uniform_real_distribution<float> coordinate(-extent, extent);
+
+        std::vector<vec3f> points;
+        for (int i = 0; i < count; ++i)
+        {
+            points.emplace_back(coordinate(rng), coordinate(rng), coordinate(rng));
+        }
+
+        return points;
+    }
+
+
+    std::vector<std::uint32_t> brute_force(const std::vector<vec3f>& points,
+                                           const vec3f&              center,
+                                           float                     radius)
+    {
+        std::vector<std::uint32_t> neighbors;
+        for (std::uint32_t i = 0; i < points.size(); ++i)
+        {
+            if (vector::length_squared(points[i] - center) <= radius * radius)
+            {
+                neighbors.push_back(i);
+            }
+        }
+
+        return neighbors;
+    }
+
+
+    std::vector<std::uint32_t> sorted(std::span<const std::uint32_t> indices)
+    {
+        auto copy = std::vector<std::uint32_t>(indices.begin(), indices.end());
+        std::sort(copy.begin(), copy.end());
+
+        return copy;
+    }
+
+
+    void expect_every_point_in_its_bucket(const spatial_hash::grid& grid,
+                                          const std::vector<vec3f>& points)
+    {
+        ASSERT_TRUE(std::has_single_bit(grid.bucket_starts.size() - 1));
+        ASSERT_GE(grid.bucket_starts.size() - 1, 2 * points.size());
+        ASSERT_EQ(grid.bucket_starts.front(), 0);
+        ASSERT_EQ(grid.bucket_starts.back(), points.size());
+        ASSERT_TRUE(
+            std::is_sorted(grid.bucket_starts.begin(), grid.bucket_starts.end()));
+
+        auto seen = std::vector<bool>(points.size());
+        for (const auto& entry : grid.entries)
+        {
+            const auto& point = points[entry.index];
+
+            ASSERT_FALSE(seen[entry.index]);
+            seen[entry.index] = true;
+            ASSERT_EQ(vec3f(entry.position[0], entry.position[1], entry.position[2]),
+                      point);
+        }
+    }
+}    // namespace
+
+
+TEST(SpatialHash, EmptyGridHasNoNeighbors)
+{
+    auto grid = spatial_hash::build(std::span<const vec3f>(), 1);
+
+    std::vector<std::uint32_t> neighbors;
+    ASSERT_EQ(spatial_hash::within_radius(grid, vec3f(0), 100, neighbors), 0);
+    ASSERT_EQ(spatial_hash::neighbors(grid, 1).size(), 0);
+}
+TEST(SpatialHash, RejectsCellSizesThatAreNotPositive)
+{
+    auto points = std::vector<vec3f>();
+    points.emplace_back(0, 0, 0);
+
+    ASSERT_THROW(spatial_hash::build(points, 0), std::invalid_argument);
+    ASSERT_THROW(spatial_hash::build(points, -1), std::invalid_argument);
+    ASSERT_THROW(spatial_hash::build(points, std::nanf("")), std::invalid_argument);
+}
+TEST(SpatialHash, EveryPointIsInOneBucket)
+{
+    auto rng    = std::mt19937(42);
+    auto points = random_points(rng, 50'000, 20);
+    auto four   = parallel::thread_pool(4);
+
+    for (auto* pool : {static_cast<parallel::thread_pool*>(nullptr), &four})
+    {
+        auto grid = spatial_hash::build(points, 1, {pool});
+        expect_every_point_in_its_bucket(grid, points);
+
+        // A single thread keeps the order of the points within a bucket
+        if (pool == nullptr)
+        {
+            for (std::size_t b = 0; b + 1 < grid.bucket_starts.size(); ++b)
+            {
+                auto first    = grid.entries.begin() + grid.bucket_starts[b];
+                auto last     = grid.entries.begin() + grid.bucket_starts[b + 1];
+                auto by_index = [](const auto& a, const auto& b) {
+                    return a.index < b.index;
+                };
+                ASSERT_TRUE(std::is_sorted(first, last, by_index));
+            }
+        }
+    }
+}
+TEST(SpatialHash, WithinRadiusMatchesBruteForce)
+{
+    auto rng    = std::mt19937(42);
+    auto points = random_points(rng, 3'000, 10);
+    auto grid   = spatial_hash::build(points, 1.5F);
+
+    std::uniform_real_distribution<float> coordinate(-12, 12);
+
+    // Smaller and larger than a cell and larger than the points
+    for (float radius : {0.0F, 0.7F, 1.5F, 4.0F, 50.0F})
+    {
+        for (int i = 0; i < 50; ++i)
+        {
+            auto center = vec3f(coordinate(rng), coordinate(rng), coordinate(rng));
+
+            std::vector<std::uint32_t> neighbors = {12345};
+            auto count = spatial_hash::within_radius(grid, center, radius, neighbors);
+
+            ASSERT_EQ(count, neighbors.size() - 1);
+            ASSERT_EQ(sorted(std::span(neighbors).subspan(1)),
+                      brute_force(points, center, radius))
+                << radius << ", " << i;
+        }
+    }
+}
+TEST(SpatialHash, PointsFarFromTheOrigin)
+{
+    // Cells far beyond the range of int32_t are clamped, which merges them
+    std::vector<vec3f> points;
+    points.emplace_back(1e12F, 0, 0);
+    points.emplace_back(1e12F, 0.5F, 0);
+    points.emplace_back(-1e12F, 0, 0);
+    points.emplace_back(0, 0, 0);
+
+    auto grid = spatial_hash::build(points, 1);
+
+    std::vector<std::uint32_t> neighbors;
+    spatial_hash::within_radius(grid, vec3f(1e12F, 0, 0), 1, neighbors);
+    ASSERT_EQ(sorted(neighbors), (std::vector<std::uint32_t>{0, 1}));
+}
+TEST(SpatialHash, HugeRadiusFindsEveryPoint)
+{
+    // 2^22 cells per axis, whose product overflows 64 bits
+    std::vector<vec3f> points;
+    points.emplace_back(0, 0, 0);
+    points.emplace_back(1'000, -1'000, 1'000);
+    points.emplace_back(-2'000'000, 0, 0);
+
+    auto grid = spatial_hash::build(points, 1);
+
+    std::vector<std::uint32_t> neighbors;
+    spatial_hash::within_radius(grid, vec3f(0.5F), 2'097'151.5F, neighbors);
+    ASSERT_EQ(sorted(neighbors), (std::vector<std::uint32_t>{0, 1, 2}));
+}
+TEST(SpatialHash, NeighborsMatchWithinRadius)
+{
+    auto rng    = std::mt19937(42);
+    auto points = random_points(rng, 40'000, 15);
+    auto four   = parallel::thread_pool(4);
+
+    for (auto* pool : {static_cast<parallel::thread_pool*>(nullptr), &four})
+    {
+        auto grid  = spatial_hash::build(points, 1, {pool});
+        auto lists = spatial_hash::neighbors(grid, 1, {pool});
+
+        ASSERT_EQ(lists.size(), points.size());
+
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < points.size(); i += 97)
+        {
+            std::vector<std::uint32_t> expected;
+            spatial_hash::within_radius(grid, points[i], 1, expected);
+
+            ASSERT_EQ(sorted(lists[i]), sorted(expected)) << i;
+            total += expected.size();
+        }
+
+        // Every point is its own neighbor, and has a few others
+        ASSERT_GT(total, 2 * points.size() / 97);
+    }
+}
+TEST(SpatialHash, SoaMatchesSpan)
+{
+    auto rng    = std::mt19937(42);
+    auto points = random_points(rng, 1'000, 5);
+    auto soa    = vec_soa<float, 3>(points);
+
+    auto from_span = spatial_hash::build(points, 0.5F);
+    auto from_soa  = spatial_hash::build(soa, 0.5F);
+
+    ASSERT_EQ(from_soa.bucket_starts, from_span.bucket_starts);
+    for (std::size_t k = 0; k < points.size(); ++k)
+    {
+        ASSERT_EQ(from_soa.entries[k].index, from_span.entries[k].index);
+        ASSERT_EQ(from_soa.entries[k].position, from_span.entries[k].position);
+    }
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "intersection.hpp"
+#include "sweep_and_prune.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    using sweep_and_prune::pair;
+
+
+    aabbf random_box(std::mt19937& rng, const vec3f& extent, float size)
+    {
+        std::uniform_real_distribution<float> unit(-1, 1);
+        std::uniform_real_distribution<float> half_size(0, size / 2);
+
+        const auto center = vec3f(
+            unit(rng) * extent[0], unit(rng) * extent[1], unit(rng) * extent[2]);
+        const auto half = vec3f(half_size(rng), half_size(rng), half_size(rng));
+
+        return {center - half, center + half};
+    }
+
+
+    std::vector<aabbf>
+        random_boxes(std::mt19937& rng, int count, const vec3f& extent, float size)
+    {
+        std::vector<aabbf> boxes;
+        for (int i = 0; i < count; ++i)
+        {
+            boxes.push_back(random_box(rng, extent, size));
+        }
+
+        return boxes;
+    }
+
+
+    std::vector<pair> brute_force(std::span<const aabbf> boxes)
+    {
+        std::vector<pair> pairs;
+        for (std::uint32_t i = 0; i < boxes.size(); ++i)
+        {
+            for (std::uint32_t j = i + 1; j < boxes.size(); ++j)
+            {
+                if (intersections::overlaps(boxes[i], boxes[j]))
+                {
+                    pairs.push_back({i, j});
+                }
+            }
+        }
+
+        return pairs;
+    }
+
+
+    std::vector<pair> sorted(std::vector<pair> pairs)
+    {
+        std::sort(pairs.begin(), pairs.end());
+
+        return pairs;
+    }
+
+
+    void expect_sorted_along_axis(const sweep_and_prune::broad_phase& broad_phase)
+    {
+        ASSERT_TRUE(std::is_sorted(
+            broad_phase.proxies.begin(),
+            broad_phase.proxies.end(),
+            [axis = broad_phase.axis](const auto& a, const auto& b) {
+                return a.min[axis] < b.min[axis];
+            }));
+    }
+}    // namespace
+
+
+TEST(SweepAndPrune, NoBoxesHaveNoPairs)
+{
+    auto broad_phase = sweep_and_prune::broad_phase();
+    auto pairs       = std::vector<pair>{{0, 1}};
+
+    sweep_and_prune::update(broad_phase, {}, pairs);
+    ASSERT_TRUE(pairs.empty());
+}
+TEST(SweepAndPrune, TouchingBoxesOverlapAndEmptyBoxesDoNot)
+{
+    std::vector<aabbf> boxes;
+    boxes.emplace_back(vec3f(0, 0, 0), vec3f(1, 1, 1));
+    boxes.emplace_back(vec3f(1, 0, 0), vec3f(2, 1, 1));
+    boxes.emplace_back(vec3f(0, 1.5F, 0), vec3f(2, 2, 1));
+    boxes.emplace_back();
+
+    auto broad_phase = sweep_and_prune::broad_phase();
+    auto pairs       = std::vector<pair>();
+
+    sweep_and_prune::update(broad_phase, boxes, pairs);
+    ASSERT_EQ(pairs, (std::vector<pair>{{0, 1}}));
+}
+TEST(SweepAndPrune, MatchesBruteForce)
+{
+    auto rng   = std::mt19937(42);
+    auto boxes = random_boxes(rng, 2'000, vec3f(20, 20, 20), 2);
+
+    auto broad_phase = sweep_and_prune::broad_phase();
+    auto pairs       = std::vector<pair>();
+
+    sweep_and_prune::update(broad_phase, boxes, pairs);
+    expect_sorted_along_axis(broad_phase);
+    ASSERT_EQ(sorted(pairs), brute_force(boxes));
+}
+TEST(SweepAndPrune, SortsAlongTheAxisOfGreatestVariance)
+{
+    auto rng         = std::mt19937(42);
+    auto broad_phase = sweep_and_prune::broad_phase();
+    auto pairs       = std::vector<pair>();
+
+    for (std::size_t axis : {1, 2, 0})
+    {
+        auto extent  = vec3f(2, 2, 2);
+        extent[axis] = 100;
+
+        auto boxes = random_boxes(rng, 1'000, extent, 1);
+        sweep_and_prune::update(broad_phase, boxes, pairs);
+
+        ASSERT_EQ(broad_phase.axis, axis);
+        expect_sorted_along_axis(broad_phase);
+        ASSERT_EQ(sorted(pairs), brute_force(boxes));
+    }
+}
+TEST(SweepAndPrune, MovingBoxesMatchBruteForceEveryFrame)
+{
+    auto rng   = std::mt19937(42);
+    auto boxes = random_boxes(rng, 1'500, vec3f(15, 15, 15), 1.5F);
+
+    std::uniform_real_distribution<float> velocity(-0.2F, 0.2F);
+
+    std::vector<vec3f> velocities;
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        velocities.emplace_back(velocity(rng), velocity(rng), velocity(rng));
+    }
+
+    auto broad_phase = sweep_and_prune::broad_phase();
+    auto pairs       = std::vector<pair>();
+
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        for (std::size_t i = 0; i < boxes.size(); ++i)
+        {
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                boxes[i].min[axis] += velocities[i][axis];
+                boxes[i].max[axis] += velocities[i][axis];
+            }
+        }
+
+        sweep_and_prune::update(broad_phase, boxes, pairs);
+        expect_sorted_along_axis(broad_phase);
+        ASSERT_EQ(sorted(pairs), brute_force(boxes)) << frame;
+    }
+}
+TEST(SweepAndPrune, IncoherentFramesAndNewBoxesMatchBruteForce)
+{
+    auto rng         = std::mt19937(42);
+    auto broad_phase = sweep_and_prune::broad_phase();
+    auto pairs       = std::vector<pair>();
+
+    // Every frame places the boxes anew, then adds some
+    for (int count : {500, 500, 800, 300})
+    {
+        auto boxes = random_boxes(rng, count, vec3f(10, 10, 10), 1.5F);
+
+        sweep_and_prune::update(broad_phase, boxes, pairs);
+        expect_sorted_along_axis(broad_phase);
+        ASSERT_EQ(sorted(pairs), brute_force(boxes)) << count;
+    }
+}
+TEST(SweepAndPrune, SweptBoxEnclosesBothBoxes)
+{
+    auto from = aabbf(vec3f(0, 0, 0), vec3f(1, 1, 1));
+    auto to   = aabbf(vec3f(2, -1, 0.5F), vec3f(3, 0, 1.5F));
+
+    auto box = sweep_and_prune::swept(from, to);
+    ASSERT_EQ(box.min, vec3f(0, -1, 0));
+    ASSERT_EQ(box.max, vec3f(3, 1, 1.5F));
+}
@@ -0,0 +1,162 @@
+// Copyright 2021-2022 Jonas Muehlmann
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify,
+// merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to the following
+// conditions: The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED "AS
+// IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "text.hpp"
+#include "vec.hpp"
+
+using namespace ggmath;
+
+
+namespace
+{
+    template <typename T, int n>
+    std::string to_string(const vec<T, n>& _vec)
+    {
+        char buffer[text::max_chars<vec<T, n>>];    // NOLINT(*-avoid-c-arrays)
+
+        const auto [end, error] =
+            text::to_chars(std::begin(buffer), std::end(buffer), _vec);
+        EXPECT_EQ(error, std::errc());
+
+        return std::string(std::begin(buffer), end);
+    }
+
+
+    template <typename T, int n>
+    std::from_chars_result parse(std::string_view text, vec<T, n>& _vec)
+    {
+        return text::from_chars(text.data(), text.data() + text.size(), _vec);
+    }
+}    // namespace
+
+
+TEST(Text, ToCharsMatchesStreamOutput)
+{
+    std::stringstream ss;
+    ss << vec3i(-1, 20, 300) << vec2d(0.5, -2) << color3(1, 2, 255);
+
+    ASSERT_EQ(to_string(vec3i(-1, 20, 300)) + to_string(vec2d(0.5, -2))
+                  + to_string(color3(1, 2, 255)),
+              ss.str());
+}
+TEST(Text, ToCharsFitsMaxChars)
+{
+    constexpr auto lowest = std::numeric_limits<double>::lowest();
+    constexpr auto denorm = -std::numeric_limits<double>::denorm_min();
+
+    ASSERT_EQ(to_string(vec2d(lowest, denorm)), "(-1.7976931348623157e+308,-5e-324)");
+    ASSERT_EQ(to_string(vec3i(std::numeric_limits<int>::min())),
+              "(-2147483648,-2147483648,-2147483648)");
+}
+TEST(Text, ToCharsBufferTooSmall)
+{
+    char buffer[8];    // NOLINT(*-avoid-c-arrays)
+
+    const auto result =
+        text::to_chars(std::begin(buffer), std::end(buffer), vec3f(1, 2, 3));
+    ASSERT_EQ(result.ptr, std::begin(buffer) + 7);
+    ASSERT_EQ(result.ec, std::errc());
+
+    const auto too_small =
+        text::to_chars(std::begin(buffer), std::end(buffer), vec3f(10, 20, 30));
+    ASSERT_EQ(too_small.ec, std::errc::value_too_large);
+}
+TEST(Text, RoundTripsBulk)
+{
+    std::mt19937                          rng(42);
+    std::uniform_real_distribution<float> coordinate(-1e6, 1e6);
+
+    auto vectors = std::vector<vec3f>();
+    for (int i = 0; i < 1'000; ++i)
+    {
+        vectors.emplace_back(coordinate(rng), coordinate(rng), coordinate(rng));
+    }
+
+    auto buffer = std::string(vectors.size() * (text::max_chars<vec3f> + 1), '\0');
+    const auto [end, error] =
+        text::to_chars(buffer.data(), buffer.data() + buffer.size(), vectors);
+    ASSERT_EQ(error, std::errc());
+
+    auto       parsed = std::vector<vec3f>();
+    const auto result = text::from_chars(buffer.data(), end, parsed);
+
+    ASSERT_EQ(result.ec, std::errc());
+    ASSERT_EQ(result.ptr, end);
+    ASSERT_EQ(parsed, vectors);
+}
+TEST(Text, FromCharsParsesStreamOutput)
+{
+    std::stringstream ss;
+    ss << vec3f(1.5F, -2, 1e6F) << "\n  " << vec3f(0, 0.25F, -1e-3F) << '\n';
+    const auto text = ss.str();
+
+    auto       parsed = std::vector<vec3f>();
+    const auto result =
+        text::from_chars(text.data(), text.data() + text.size(), parsed);
+
+    ASSERT_EQ(result.ec, std::errc());
+    ASSERT_EQ(parsed,
+              (std::vector{vec3f(1.5F, -2, 1e6F), vec3f(0, 0.25F, -1e-3F)}));
+}
+TEST(Text, FromCharsRejectsMalformed)
+{
+    auto _vec = vec3i(7, 8, 9);
+
+    for (std::string_view malformed :
+         {"", "1,2,3)", "(1,2)", "(1,2,3,4)", "(1;2;3)", "(1,2,x)", "(1, 2,3)"})
+    {
+        const auto result = parse(malformed, _vec);
+
+        ASSERT_EQ(result.ec, std::errc::invalid_argument) << malformed;
+        ASSERT_EQ(result.ptr, malformed.data()) << malformed;
+    }
+
+    ASSERT_EQ(parse("(1,2,99999999999)", _vec).ec, std::errc::result_out_of_range);
+    ASSERT_EQ(_vec, vec3i(7, 8, 9));
+
+    const std::string_view rest = "(1,2,3)(4";
+    ASSERT_EQ(parse(rest, _vec).ptr, rest.data() + 7);
+    ASSERT_EQ(_vec, vec3i(1, 2, 3));
+}
+TEST(Text, FromCharsBulkStopsAtMalformed)
+{
+    const std::string_view text = "(1,2) (3,4)\n(5,)";
+
+    auto       parsed = std::vector<vec2i>();
+    const auto result =
+        text::from_chars(text.data(), text.data() + text.size(), parsed);
+
+    ASSERT_EQ(result.ec, std::errc::invalid_argument);
+    ASSERT_EQ(result.ptr, text.data() + 12);
+    ASSERT_EQ(parsed, (std::vector{vec2i(1, 2), vec2i(3, 4)}));
+}
+#ifdef __cpp_lib_format
+TEST(Text, Format)
+{
+    ASSERT_EQ(std::format("{}", vec3i(1, -2, 3)), "(1,-2,3)");
+    ASSERT_EQ(std::format("{:.2f}", vec2f(1, 0.5F)), "(1.00,0.50)");
+    ASSERT_EQ(std::format("{}", color3(1, 2, 255)), "(1,2,255)");
+}
+#endif
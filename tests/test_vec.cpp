@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <numbers>
+#include <vector>
 
 #include "vec.hpp"
 
@@ -30,6 +31,35 @@ TEST(Vec, LengthNegative)
 }
 
 
+TEST(Vec, LengthReturnFloatFromFloat)
+{
+    auto result    = vector::length(vec3f(2, 3, 4));
+    using is_float = std::is_same<decltype(result), float>;
+
+    ASSERT_EQ(is_float::value, true);
+}
+TEST(Vec, LengthReturnDoubleFromDouble)
+{
+    auto result     = vector::length(vec3d(2, 3, 4));
+    using is_double = std::is_same<decltype(result), double>;
+
+    ASSERT_EQ(is_double::value, true);
+}
+TEST(Vec, LengthReturnDoubleFromInt)
+{
+    auto result     = vector::length(vec3i(2, 3, 4));
+    using is_double = std::is_same<decltype(result), double>;
+
+    ASSERT_EQ(is_double::value, true);
+}
+TEST(Vec, LengthDoublePrecision)
+{
+    vec3d a = vec3d(1e-5, 1, 0);
+
+    ASSERT_DOUBLE_EQ(vector::length(a), std::sqrt(1 + 1e-10));
+}
+
+
 TEST(Vec, LengthSquaredAny)
 {
     vec3f a = vec3f(2, 3, 4);
@@ -50,6 +80,16 @@ TEST(Vec, LengthSquaredNegative)
 }
 
 
+TEST(Vec, LengthSquaredReturnIntFromInt)
+{
+    auto result  = vector::length_squared(vec3i(2, 3, 4));
+    using is_int = std::is_same<decltype(result), int>;
+
+    ASSERT_EQ(is_int::value, true);
+    ASSERT_EQ(result, 29);
+}
+
+
 TEST(Vec, NormalizedAny)
 {
     vec3f a          = vec3f(2, 3, 4);
@@ -147,6 +187,15 @@ TEST(Vec, DistanceFromOrigin)
 }
 
 
+TEST(Vec, DistanceReturnDoubleFromDouble)
+{
+    auto result     = vector::distance(vec3d(2, 3, 4), vec3d(5, 6, 7));
+    using is_double = std::is_same<decltype(result), double>;
+
+    ASSERT_EQ(is_double::value, true);
+}
+
+
 TEST(Vec, ParallelAny)
 {
     vec3f a           = vector::normalized(vec3f(2, 3, 4));
@@ -168,7 +217,7 @@ TEST(Vec, ParallelZero)
     vec3f a           = vector::normalized(vec3f(2, 3, 4));
     vec3f zero_vector = vec3f();
 
-#ifdef GGMATH_DEBUG
+#if GGMATH_DEBUG
     ASSERT_THROW(vector::parallel(a, zero_vector), std::invalid_argument);
 #else
     bool is_parallel = vector::parallel(a, zero_vector);
@@ -198,7 +247,7 @@ TEST(Vec, AntiParallelZero)
     vec3f a           = vector::normalized(vec3f(2, 3, 4));
     vec3f zero_vector = vec3f();
 
-#ifdef GGMATH_DEBUG
+#if GGMATH_DEBUG
     ASSERT_THROW(vector::anti_parallel(a, zero_vector), std::invalid_argument);
 #else
     bool is_anti_parallel = vector::anti_parallel(a, zero_vector);
@@ -227,7 +276,7 @@ TEST(Vec, PerpendicularZero)
     vec3f a           = vector::normalized(vec3f(2, 3, 4));
     vec3f zero_vector = vec3f();
 
-#ifdef GGMATH_DEBUG
+#if GGMATH_DEBUG
     ASSERT_THROW(vector::perpendicular(a, zero_vector), std::invalid_argument);
 #else
     bool is_perpendicular = vector::perpendicular(a, zero_vector);
@@ -267,6 +316,23 @@ TEST(Vec, AngleBetweenAntiParallel)
 }
 
 
+TEST(Vec, AngleBetweenReturnFloatFromFloat)
+{
+    auto result    = vector::angle_between(vec3f(2, 3, 4), vec3f(4, 3, 2));
+    using is_float = std::is_same<decltype(result), float>;
+
+    ASSERT_EQ(is_float::value, true);
+}
+TEST(Vec, AngleBetweenReturnDoubleFromDouble)
+{
+    auto result     = vector::angle_between(vec3d(2, 3, 4), vec3d(4, 3, 2));
+    using is_double = std::is_same<decltype(result), double>;
+
+    ASSERT_EQ(is_double::value, true);
+    ASSERT_NEAR(result, 0.531458, 1e-6);
+}
+
+
 TEST(Vec, AngleBetweenUnitAny)
 {
     vec3f a = vector::normalized(vec3f(2, 3, 4));
@@ -295,7 +361,7 @@ TEST(Vec, AngleBetweenUnitAntiParallel)
 
     ASSERT_FLOAT_EQ(vector::angle_between_unit(a, b), std::numbers::pi);
 }
-#ifdef GGMATH_DEBUG
+#if GGMATH_DEBUG
 TEST(Vec, AngleBetweenUnitNotUnit)
 {
     vec3f a = vec3f(2, 3, 4);
@@ -339,6 +405,38 @@ TEST(Vec, MaxAny)
 }
 
 
+TEST(Vec, MinComponentWise)
+{
+    vec3f a = vec3f(4, -3, 2);
+    vec3f b = vec3f(1, 6, 2);
+
+    ASSERT_EQ(vector::min(a, b), vec3f(1, -3, 2));
+}
+TEST(Vec, MinComponentWiseDouble)
+{
+    vec4d a = vec4d(4, -3, 2, 9);
+    vec4d b = vec4d(1, 6, 2, -9);
+
+    ASSERT_EQ(vector::min(a, b), vec4d(1, -3, 2, -9));
+}
+
+
+TEST(Vec, MaxComponentWise)
+{
+    vec3f a = vec3f(4, -3, 2);
+    vec3f b = vec3f(1, 6, 2);
+
+    ASSERT_EQ(vector::max(a, b), vec3f(4, 6, 2));
+}
+TEST(Vec, MaxComponentWiseInt)
+{
+    vec4i a = vec4i(4, -3, 2, 9);
+    vec4i b = vec4i(1, 6, 2, -9);
+
+    ASSERT_EQ(vector::max(a, b), vec4i(4, 6, 2, 9));
+}
+
+
 TEST(Vec, IndexMinAny)
 {
     vec3f a = vec3f(4, 3, 2);
@@ -426,6 +524,13 @@ TEST(Vec, ReflectAntiParallel)
 
     ASSERT_EQ(b, vec3f(-1, 0, 0));
 }
+TEST(Vec, ReflectNoexceptWithoutDebug)
+{
+    vec3f a      = vec3f(1, 0, 0);
+    vec3f normal = vec3f(-1, 0, 0);
+
+    ASSERT_EQ(noexcept(vector::reflect(a, normal)), !debug::enabled);
+}
 TEST(Vec, ReflectParallel)
 {
     vec3f a      = vector::normalized(vec3f(2, 3, 4));
@@ -508,6 +613,45 @@ TEST(Vec, DotProductUnitPerpendicular)
 }
 
 
+TEST(Vec, DotProductReturnFloatFromFloat)
+{
+    auto result    = vec3f(2, 3, 4) * vec3f(5, 6, 7);
+    using is_float = std::is_same<decltype(result), float>;
+
+    ASSERT_EQ(is_float::value, true);
+}
+TEST(Vec, DotProductReturnDoubleFromDouble)
+{
+    auto result     = vec3d(2, 3, 4) * vec3d(5, 6, 7);
+    using is_double = std::is_same<decltype(result), double>;
+
+    ASSERT_EQ(is_double::value, true);
+}
+TEST(Vec, DotProductReturnIntFromInt)
+{
+    auto result  = vec3i(2, 3, 4) * vec3i(5, 6, 7);
+    using is_int = std::is_same<decltype(result), int>;
+
+    ASSERT_EQ(is_int::value, true);
+    ASSERT_EQ(result, 56);
+}
+TEST(Vec, DotProductDoublePrecision)
+{
+    vec3d a = vec3d(0.1, 0.2, 0.3);
+    vec3d b = vec3d(1, 1, 1);
+
+    // A float accumulator would be off by more than 4 ULPs of a double
+    ASSERT_DOUBLE_EQ(vector::dot(a, b), 0.1 + 0.2 + 0.3);
+}
+TEST(Vec, DotProductHigherDimension)
+{
+    vec<int, 5> a = {1, 2, 3, 4, 5};
+    vec<int, 5> b = {5, 4, 3, 2, 1};
+
+    ASSERT_EQ(a * b, 35);
+}
+
+
 TEST(Vec, Addition)
 {
     vec3f a = vec3f(1, 0, 0);
@@ -921,4 +1065,45 @@ TEST(Vec, LengthShorterOrEqualAnyEqual)
 // endregion comparison operators
 
 
-// endregion operator overloads
\ No newline at end of file
+// endregion operator overloads
+
+// region special members
+
+
+TEST(Vec, CopyConstruct)
+{
+    const auto  a = vec3f(2, 3, 4);
+    const vec3f b = a;
+
+    ASSERT_EQ(b, a);
+}
+TEST(Vec, CopyAssignSelf)
+{
+    auto        a    = vec4d(1, 2, 3, 4);
+    const auto& self = a;
+
+    a = self;
+
+    ASSERT_EQ(a, vec4d(1, 2, 3, 4));
+}
+TEST(Vec, CopyStdVector)
+{
+    const auto source = std::vector<vec3f>{vec3f(1, 2, 3), vec3f(4, 5, 6)};
+    const auto copy   = source;
+
+    ASSERT_EQ(copy, source);
+}
+TEST(Vec, UninitializedOverwritten)
+{
+    auto a = vec<int, 5>(uninitialized);
+    for (int i = 0; i < 5; ++i)
+    {
+        a[i] = i;
+    }
+
+    const auto expected = vec<int, 5>({0, 1, 2, 3, 4});
+    ASSERT_EQ(a, expected);
+}
+
+
+// endregion special members
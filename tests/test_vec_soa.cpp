@@ -0,0 +1,330 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "test_helpers.hpp"
+#include "vec.hpp"
+#include "vec_soa.hpp"
+
+using namespace ggmath;
+using helpers::expect_near;
+
+
+namespace
+{
+    // 7 elements, so the last block of every column is partially filled
+    vec3f_soa make_a()
+    {
+        return {vec3f(1, 2, 3),
+                vec3f(-4, 5, 6),
+                vec3f(7, -8, 9),
+                vec3f(0, 0, 1),
+                vec3f(3, 4, 0),
+                vec3f(-1, -1, -1),
+                vec3f(10, 0, -10)};
+    }
+
+
+    vec3f_soa make_b()
+    {
+        return {vec3f(3, 2, 1),
+                vec3f(6, 5, -4),
+                vec3f(0, 1, 0),
+                vec3f(2, 2, 2),
+                vec3f(-3, 4, 5),
+                vec3f(1, 1, 1),
+                vec3f(0, 10, 0)};
+    }}    // namespace
+
+
+// region container
+
+
+TEST(VecSoa, ConstructFromInitializerList)
+{
+    auto soa = make_a();
+
+    ASSERT_EQ(soa.size(), 7);
+    ASSERT_EQ(soa.column(0)[1], -4);
+    ASSERT_EQ(soa.column(1)[2], -8);
+    ASSERT_EQ(soa.column(2)[6], -10);
+}
+TEST(VecSoa, ConstructFromRange)
+{
+    std::vector<vec3f> aos;
+    aos.emplace_back(1, 2, 3);
+    aos.emplace_back(4, 5, 6);
+
+    auto soa = vec3f_soa(aos);
+
+    ASSERT_EQ(soa.size(), 2);
+    ASSERT_EQ(soa[1], vec3f(4, 5, 6));
+}
+TEST(VecSoa, ColumnsAreAligned)
+{
+    auto soa = make_a();
+
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(soa.data(axis)) % 64, 0);
+    }
+}
+TEST(VecSoa, ProxyRead)
+{
+    auto  soa    = make_a();
+    vec3f result = soa[1];
+
+    ASSERT_EQ(result, vec3f(-4, 5, 6));
+    ASSERT_EQ(soa[1][2], 6);
+}
+TEST(VecSoa, ProxyWrite)
+{
+    auto soa = make_a();
+
+    soa[2]    = vec3f(1, 1, 1);
+    soa[3][0] = 5;
+
+    ASSERT_EQ(soa[2], vec3f(1, 1, 1));
+    ASSERT_EQ(soa[3], vec3f(5, 0, 1));
+}
+TEST(VecSoa, ProxyAssignsValues)
+{
+    auto soa = make_a();
+
+    soa[0] = soa[1];
+    soa[1] = vec3f(0, 0, 0);
+
+    ASSERT_EQ(soa[0], vec3f(-4, 5, 6));
+}
+TEST(VecSoa, ConstAccessReturnsVec)
+{
+    const auto soa = make_a();
+
+    ASSERT_TRUE((std::is_same<decltype(soa[0]), vec3f>::value));
+    ASSERT_EQ(soa[6], vec3f(10, 0, -10));
+}
+TEST(VecSoa, PushBack)
+{
+    auto soa = vec3f_soa();
+
+    soa.push_back(vec3f(1, 2, 3));
+    soa.push_back(vec3f(4, 5, 6));
+
+    ASSERT_EQ(soa.size(), 2);
+    ASSERT_EQ(soa[0], vec3f(1, 2, 3));
+    ASSERT_EQ(soa[1], vec3f(4, 5, 6));
+}
+TEST(VecSoa, ResizeZeroesPadding)
+{
+    auto soa = make_a();
+
+    // Writes into the padding element 7
+    soa::normalized(soa, soa);
+    soa.resize(8);
+
+    ASSERT_EQ(soa[7], vec3f(0, 0, 0));
+}
+
+
+// endregion container
+
+
+// region functions
+
+
+TEST(VecSoa, Dot)
+{
+    const auto         a = make_a();
+    const auto         b = make_b();
+    std::vector<float> result(a.size());
+
+    soa::dot(a, b, std::span(result));
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        ASSERT_FLOAT_EQ(result[i], vector::dot(a[i], b[i]));
+    }
+}
+TEST(VecSoa, DotInt)
+{
+    auto a = vec3i_soa{vec3i(1, 2, 3), vec3i(4, 5, 6)};
+    auto b = vec3i_soa{vec3i(1, 1, 1), vec3i(-1, 0, 1)};
+    std::vector<int> result(2);
+
+    soa::dot(a, b, std::span(result));
+
+    ASSERT_EQ(result, (std::vector<int>{6, 2}));
+}
+TEST(VecSoa, Cross)
+{
+    const auto a      = make_a();
+    const auto b      = make_b();
+    auto       result = vec3f_soa();
+
+    soa::cross(a, b, result);
+
+    ASSERT_EQ(result.size(), a.size());
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        ASSERT_EQ(result[i], vector::cross(a[i], b[i]));
+    }
+}
+TEST(VecSoa, CrossInt)
+{
+    auto a      = vec3i_soa{vec3i(1, 0, 0)};
+    auto b      = vec3i_soa{vec3i(0, 1, 0)};
+    auto result = vec3i_soa();
+
+    soa::cross(a, b, result);
+
+    ASSERT_EQ(result[0], vec3i(0, 0, 1));
+}
+TEST(VecSoa, Length)
+{
+    const auto         a = make_a();
+    std::vector<float> result(a.size());
+
+    soa::length(a, std::span(result));
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        ASSERT_FLOAT_EQ(result[i], vector::length(a[i]));
+    }
+}
+TEST(VecSoa, LengthInt)
+{
+    auto                a = vec2i_soa{vec2i(3, 4)};
+    std::vector<double> result(1);
+
+    soa::length(a, std::span(result));
+
+    ASSERT_DOUBLE_EQ(result[0], 5);
+}
+TEST(VecSoa, LengthSquared)
+{
+    const auto         a = make_a();
+    std::vector<float> result(a.size());
+
+    soa::length_squared(a, std::span(result));
+
+    ASSERT_FLOAT_EQ(result[4], 25);
+}
+TEST(VecSoa, Distance)
+{
+    const auto         a = make_a();
+    const auto         b = make_b();
+    std::vector<float> result(a.size());
+
+    soa::distance(a, b, std::span(result));
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        ASSERT_FLOAT_EQ(result[i], vector::distance(a[i], b[i]));
+    }
+}
+TEST(VecSoa, Normalized)
+{
+    const auto a      = make_a();
+    auto       result = vec3f_soa();
+
+    soa::normalized(a, result);
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        expect_near<float, 3>(std::as_const(result)[i], vector::normalized(a[i]));
+    }
+}
+TEST(VecSoa, NormalizedInPlace)
+{
+    auto a = make_a();
+
+    soa::normalized(a, a);
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        ASSERT_TRUE(vector::is_unit_vector(std::as_const(a)[i]));
+    }
+}
+TEST(VecSoa, ScaledBy)
+{
+    auto a      = make_a();
+    auto result = vec3f_soa();
+
+    soa::scaled_by(a, 2.0F, result);
+
+    ASSERT_EQ(result[1], vec3f(-8, 10, 12));
+}
+TEST(VecSoa, MinMax)
+{
+    const auto a       = make_a();
+    const auto b       = make_b();
+    auto       minimum = vec3f_soa();
+    auto       maximum = vec3f_soa();
+
+    soa::min(a, b, minimum);
+    soa::max(a, b, maximum);
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        ASSERT_EQ(minimum[i], vector::min(a[i], b[i]));
+        ASSERT_EQ(maximum[i], vector::max(a[i], b[i]));
+    }
+}
+TEST(VecSoa, Lerp)
+{
+    const auto a      = make_a();
+    const auto b      = make_b();
+    auto       result = vec3d_soa();
+    auto       a_d    = vec3d_soa{vec3d(0, 0, 0), vec3d(1, 2, 3)};
+    auto       b_d    = vec3d_soa{vec3d(2, 4, 6), vec3d(1, 2, 3)};
+
+    soa::lerp(a_d, b_d, 0.5, result);
+
+    ASSERT_EQ(result[0], vec3d(1, 2, 3));
+    ASSERT_EQ(result[1], vec3d(1, 2, 3));
+
+    auto result_f = vec3f_soa();
+    soa::lerp(a, b, 0.25F, result_f);
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        expect_near<float, 3>(std::as_const(result_f)[i],
+                              vector::lerp(a[i], b[i], 0.25F));
+    }
+}
+TEST(VecSoa, Reflect)
+{
+    auto a       = vec3f_soa{vec3f(0, -1, 0), vec3f(1, 0, 0), vec3f(0, 0, 1)};
+    auto normals = vec3f_soa{vec3f(0, 1, 0), vec3f(-1, 0, 0), vec3f(0, 1, 0)};
+    auto result  = vec3f_soa();
+
+    soa::reflect(a, normals, result);
+
+    ASSERT_EQ(result[0], vec3f(0, 1, 0));
+    ASSERT_EQ(result[1], vec3f(-1, 0, 0));
+    ASSERT_EQ(result[2], vec3f(0, 0, 1));
+}
+TEST(VecSoa, ReflectAboutOneNormal)
+{
+    auto a      = vec3f_soa{vec3f(0, -1, 0), vec3f(0, 0, 1)};
+    auto result = vec3f_soa();
+
+    soa::reflect(a, vec3f(0, 1, 0), result);
+
+    ASSERT_EQ(result[0], vec3f(0, 1, 0));
+    ASSERT_EQ(result[1], vec3f(0, 0, 1));
+}
+TEST(VecSoa, SizeMismatchThrows)
+{
+    auto               a = make_a();
+    auto               b = vec3f_soa(3);
+    std::vector<float> result(a.size());
+
+    ASSERT_THROW(soa::dot(a, b, std::span(result)), std::invalid_argument);
+}
+
+
+// endregion functions